@@ -0,0 +1,144 @@
+/*
+This file belongs to Ashes.
+See LICENSE file in root folder.
+*/
+#include "Benchmark.hpp"
+#include "Scene.hpp"
+
+#include <ashespp/Sync/Fence.hpp>
+
+#include <ostream>
+
+namespace bench
+{
+	namespace
+	{
+		// Frames run before the measures, so that lazily created objects and caches are there.
+		uint32_t constexpr WarmUpFrames = 8u;
+		uint32_t constexpr MeasuredFrames = 64u;
+
+		struct Frame
+		{
+			explicit Frame( Context & context )
+				: scene{ context }
+				, fence{ context.getDevice().createFence() }
+			{
+			}
+
+			Scene scene;
+			ashes::FencePtr fence;
+		};
+
+		void recordAshespp( Frame const & frame )
+		{
+			auto & scene = frame.scene;
+			scene.beginBatch( 0u );
+			scene.commandBuffer->bindVertexBuffer( 0u, *scene.vertexBuffer, 0u );
+			scene.commandBuffer->bindDescriptorSet( *scene.descriptorSet
+				, *scene.pipelineLayout );
+			scene.commandBuffer->draw( 3u );
+			scene.endBatch();
+			scene.context.getQueue().submit( *scene.commandBuffer
+				, frame.fence.get() );
+			frame.fence->wait( ashes::MaxTimeout );
+			frame.fence->reset();
+		}
+
+		void recordRaw( Frame const & frame )
+		{
+			auto & scene = frame.scene;
+			auto & device = scene.device;
+			VkCommandBuffer commandBuffer = *scene.commandBuffer;
+			VkBuffer buffer = *scene.vertexBuffer;
+			VkDeviceSize offset = 0u;
+			VkDescriptorSet set = *scene.descriptorSet;
+			VkFence fence = *frame.fence;
+			VkCommandBufferBeginInfo beginInfo
+			{
+				VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+				nullptr,
+				0u,
+				nullptr,
+			};
+			VkRenderPassBeginInfo renderPassInfo
+			{
+				VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
+				nullptr,
+				scene.context.getRenderPass(),
+				scene.context.getFrameBuffer(),
+				{ { 0, 0 }, scene.context.getFrameBuffer().getDimensions() },
+				0u,
+				nullptr,
+			};
+			VkSubmitInfo submitInfo
+			{
+				VK_STRUCTURE_TYPE_SUBMIT_INFO,
+				nullptr,
+				0u,
+				nullptr,
+				nullptr,
+				1u,
+				&commandBuffer,
+				0u,
+				nullptr,
+			};
+			device.vkBeginCommandBuffer( commandBuffer, &beginInfo );
+			device.vkCmdBeginRenderPass( commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE );
+			device.vkCmdBindPipeline( commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, *scene.pipeline );
+			device.vkCmdBindVertexBuffers( commandBuffer, 0u, 1u, &buffer, &offset );
+			device.vkCmdBindDescriptorSets( commandBuffer
+				, VK_PIPELINE_BIND_POINT_GRAPHICS
+				, *scene.pipelineLayout
+				, 0u
+				, 1u
+				, &set
+				, 0u
+				, nullptr );
+			device.vkCmdDraw( commandBuffer, 3u, 1u, 0u, 0u );
+			device.vkCmdEndRenderPass( commandBuffer );
+			device.vkEndCommandBuffer( commandBuffer );
+			device.vkQueueSubmit( scene.context.getQueue(), 1u, &submitInfo, fence );
+			device.vkWaitForFences( device, 1u, &fence, VK_TRUE, ashes::MaxTimeout );
+			device.vkResetFences( device, 1u, &fence );
+		}
+
+		template< typename RecordT >
+		uint64_t countAllocations( Frame const & frame
+			, RecordT record )
+		{
+			for ( uint32_t i = 0u; i < WarmUpFrames; ++i )
+			{
+				record( frame );
+			}
+
+			auto before = getAllocationCounters();
+
+			for ( uint32_t i = 0u; i < MeasuredFrames; ++i )
+			{
+				record( frame );
+			}
+
+			return getAllocationCounters().count - before.count;
+		}
+	}
+
+	bool checkSteadyStateAllocations( Context & context
+		, std::ostream & stream )
+	{
+		Frame frame{ context };
+		// The plugin may allocate while recording and submitting, the raw loop gives its share.
+		auto raw = countAllocations( frame, recordRaw );
+		auto ashespp = countAllocations( frame, recordAshespp );
+		stream << "Steady state frame, " << MeasuredFrames << " frames: "
+			<< ashespp << " allocations through ashespp, "
+			<< raw << " through the raw entry points." << std::endl;
+
+		if ( ashespp != raw )
+		{
+			stream << "The ashespp wrappers allocate in a steady state frame loop." << std::endl;
+			return false;
+		}
+
+		return true;
+	}
+}
@@ -0,0 +1,296 @@
+/*
+This file belongs to Ashes.
+See LICENSE file in root folder.
+*/
+#include "Benchmark.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+
+namespace bench
+{
+	namespace
+	{
+		std::atomic< uint64_t > g_allocationCount{ 0u };
+		std::atomic< uint64_t > g_allocationBytes{ 0u };
+
+		struct Benchmark
+		{
+			std::string name;
+			Setup setup;
+			uint64_t processedBytes;
+		};
+
+		std::vector< Benchmark > & getRegistry()
+		{
+			static std::vector< Benchmark > result;
+			return result;
+		}
+
+		bool matches( std::string const & name
+			, std::string const & filter )
+		{
+			return filter.empty()
+				|| name.find( filter ) != std::string::npos;
+		}
+
+		struct Measure
+		{
+			double ns{ 0.0 };
+			AllocationCounters allocations;
+		};
+
+		Measure measure( Operation const & operation
+			, uint64_t count )
+		{
+			auto allocations = getAllocationCounters();
+			auto begin = std::chrono::steady_clock::now();
+			operation( count );
+			auto end = std::chrono::steady_clock::now();
+			auto after = getAllocationCounters();
+			return Measure
+			{
+				double( std::chrono::duration_cast< std::chrono::nanoseconds >( end - begin ).count() ),
+				{ after.count - allocations.count, after.bytes - allocations.bytes },
+			};
+		}
+
+		Result run( Benchmark const & benchmark
+			, Operation const & operation
+			, double minTimeMs )
+		{
+			static uint64_t constexpr MaxIterations = 1ull << 30;
+			auto minTimeNs = minTimeMs * 1000000.0;
+			// Warm up, so that lazily created objects and caches don't weigh on the measures.
+			operation( 1u );
+			uint64_t count{ 1u };
+			auto current = measure( operation, count );
+
+			while ( current.ns < minTimeNs
+				&& count < MaxIterations )
+			{
+				// Aim a bit higher than the minimal time, without growing too fast on short runs.
+				auto estimate = current.ns > 0.0
+					? uint64_t( double( count ) * minTimeNs * 1.2 / current.ns )
+					: count * 10u;
+				count = std::min( MaxIterations
+					, std::clamp( estimate, count * 2u, count * 10u ) );
+				current = measure( operation, count );
+			}
+
+			auto nsPerOp = current.ns / double( count );
+			return Result
+			{
+				benchmark.name,
+				count,
+				nsPerOp,
+				double( current.allocations.count ) / double( count ),
+				double( current.allocations.bytes ) / double( count ),
+				( ( benchmark.processedBytes && nsPerOp > 0.0 )
+					? ( double( benchmark.processedBytes ) / ( 1024.0 * 1024.0 ) ) / ( nsPerOp / 1000000000.0 )
+					: 0.0 ),
+			};
+		}
+
+		std::string escape( std::string const & value )
+		{
+			std::string result;
+			result.reserve( value.size() );
+
+			for ( auto c : value )
+			{
+				if ( c == '"' || c == '\\' )
+				{
+					result += '\\';
+				}
+
+				result += c;
+			}
+
+			return result;
+		}
+	}
+
+	void registerBenchmark( std::string name
+		, Setup setup
+		, uint64_t processedBytes )
+	{
+		getRegistry().push_back( { std::move( name ), std::move( setup ), processedBytes } );
+	}
+
+	std::vector< std::string > listBenchmarks( std::string const & filter )
+	{
+		std::vector< std::string > result;
+
+		for ( auto & benchmark : getRegistry() )
+		{
+			if ( matches( benchmark.name, filter ) )
+			{
+				result.push_back( benchmark.name );
+			}
+		}
+
+		return result;
+	}
+
+	std::vector< Result > runBenchmarks( Context & context
+		, Options const & options )
+	{
+		std::vector< Result > result;
+
+		for ( auto & benchmark : getRegistry() )
+		{
+			if ( matches( benchmark.name, options.filter ) )
+			{
+				auto operation = benchmark.setup( context );
+				result.push_back( run( benchmark
+					, operation
+					, options.minTimeMs ) );
+				std::clog << "  " << benchmark.name << " done" << std::endl;
+			}
+		}
+
+		return result;
+	}
+
+	AllocationCounters getAllocationCounters()
+	{
+		return AllocationCounters
+		{
+			g_allocationCount.load( std::memory_order_relaxed ),
+			g_allocationBytes.load( std::memory_order_relaxed ),
+		};
+	}
+
+	void writeText( std::ostream & stream
+		, std::vector< Result > const & results )
+	{
+		size_t width = 9u;
+
+		for ( auto & result : results )
+		{
+			width = std::max( width, result.name.size() );
+		}
+
+		stream << std::left << std::setw( int( width ) ) << "Benchmark"
+			<< std::right
+			<< std::setw( 14 ) << "Iterations"
+			<< std::setw( 14 ) << "ns/op"
+			<< std::setw( 14 ) << "allocs/op"
+			<< std::setw( 14 ) << "bytes/op"
+			<< std::setw( 14 ) << "MiB/s" << "\n";
+		stream << std::string( width + 70u, '-' ) << "\n";
+
+		for ( auto & result : results )
+		{
+			stream << std::left << std::setw( int( width ) ) << result.name
+				<< std::right
+				<< std::setw( 14 ) << result.iterations
+				<< std::fixed
+				<< std::setw( 14 ) << std::setprecision( 1 ) << result.nsPerOp
+				<< std::setw( 14 ) << std::setprecision( 2 ) << result.allocsPerOp
+				<< std::setw( 14 ) << std::setprecision( 1 ) << result.bytesPerOp
+				<< std::setw( 14 );
+
+			if ( result.mibPerSecond > 0.0 )
+			{
+				stream << std::setprecision( 1 ) << result.mibPerSecond;
+			}
+			else
+			{
+				stream << "-";
+			}
+
+			stream << "\n";
+		}
+
+		stream << std::flush;
+	}
+
+	void writeJson( std::ostream & stream
+		, Options const & options
+		, std::vector< Result > const & results )
+	{
+		stream << "{\n";
+		stream << "  \"context\": {\n";
+		stream << "    \"plugin\": \"" << escape( options.plugin ) << "\",\n";
+		stream << "    \"filter\": \"" << escape( options.filter ) << "\",\n";
+		stream << "    \"headless\": " << ( options.headless ? "true" : "false" ) << ",\n";
+		stream << "    \"software\": " << ( options.software ? "true" : "false" ) << ",\n";
+		stream << "    \"min_time_ms\": " << options.minTimeMs << "\n";
+		stream << "  },\n";
+		stream << "  \"benchmarks\": [";
+		auto first = true;
+
+		for ( auto & result : results )
+		{
+			stream << ( first ? "\n" : ",\n" );
+			stream << "    {\n";
+			stream << "      \"name\": \"" << escape( result.name ) << "\",\n";
+			stream << "      \"iterations\": " << result.iterations << ",\n";
+			stream << "      \"ns_per_op\": " << result.nsPerOp << ",\n";
+			stream << "      \"allocs_per_op\": " << result.allocsPerOp << ",\n";
+			stream << "      \"bytes_per_op\": " << result.bytesPerOp;
+
+			if ( result.mibPerSecond > 0.0 )
+			{
+				stream << ",\n      \"mib_per_s\": " << result.mibPerSecond;
+			}
+
+			stream << "\n";
+			stream << "    }";
+			first = false;
+		}
+
+		stream << "\n  ]\n";
+		stream << "}\n";
+	}
+}
+
+//*************************************************************************************************
+// The replaced global allocation functions count the heap usage of the whole process.
+// On platforms where each module has its own heap (Windows), the allocations
+// made inside the renderer plugins are not counted.
+
+void * operator new( std::size_t size )
+{
+	bench::g_allocationCount.fetch_add( 1u, std::memory_order_relaxed );
+	bench::g_allocationBytes.fetch_add( size, std::memory_order_relaxed );
+
+	if ( auto result = std::malloc( size ? size : 1u ) )
+	{
+		return result;
+	}
+
+	throw std::bad_alloc{};
+}
+
+void * operator new[]( std::size_t size )
+{
+	return ::operator new( size );
+}
+
+void operator delete( void * ptr )noexcept
+{
+	std::free( ptr );
+}
+
+void operator delete[]( void * ptr )noexcept
+{
+	std::free( ptr );
+}
+
+void operator delete( void * ptr, std::size_t )noexcept
+{
+	std::free( ptr );
+}
+
+void operator delete[]( void * ptr, std::size_t )noexcept
+{
+	std::free( ptr );
+}
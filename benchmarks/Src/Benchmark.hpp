@@ -0,0 +1,156 @@
+/*
+This file belongs to Ashes.
+See LICENSE file in root folder.
+*/
+#ifndef ___AshesBenchmarks_Benchmark_HPP___
+#define ___AshesBenchmarks_Benchmark_HPP___
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace bench
+{
+	class Context;
+	/**
+	*\brief
+	*	The measured operation, runs the benchmarked code \p count times in a row.
+	*/
+	using Operation = std::function< void( uint64_t count ) >;
+	/**
+	*\brief
+	*	Creates the objects needed by a benchmark, and returns its measured operation.
+	*\remarks
+	*	Allocations and time spent in the setup are not measured.
+	*/
+	using Setup = std::function< Operation( Context & context ) >;
+	/**
+	*\brief
+	*	The heap usage counters, updated by the global allocation operators.
+	*/
+	struct AllocationCounters
+	{
+		uint64_t count{ 0u };
+		uint64_t bytes{ 0u };
+	};
+	/**
+	*\brief
+	*	The measures of a benchmark.
+	*/
+	struct Result
+	{
+		std::string name;
+		uint64_t iterations{ 0u };
+		double nsPerOp{ 0.0 };
+		double allocsPerOp{ 0.0 };
+		double bytesPerOp{ 0.0 };
+		// The data throughput, for benchmarks processing a known amount of data per operation.
+		double mibPerSecond{ 0.0 };
+	};
+	/**
+	*\brief
+	*	The benchmarks run options.
+	*/
+	struct Options
+	{
+		// Only the benchmarks which name contains this string are run.
+		std::string filter;
+		// The minimal duration of the measured run of each benchmark.
+		double minTimeMs{ 250.0 };
+		// The renderer plugin the benchmarks run on.
+		std::string plugin{ "test" };
+		// The JSON report path, none if empty.
+		std::string jsonPath;
+		// Lists the benchmarks instead of running them.
+		bool list{ false };
+		// Runs the allocation checks instead of the benchmarks.
+		bool checkAllocations{ false };
+		// Requests a context without window system (ASHES_GL_HEADLESS).
+		bool headless{ false };
+		// Requests the software rasteriser (LIBGL_ALWAYS_SOFTWARE, llvmpipe with Mesa).
+		bool software{ false };
+	};
+	/**
+	*\brief
+	*	Registers a benchmark.
+	*\param[in] name
+	*	The benchmark name, "group/case".
+	*\param[in] setup
+	*	The benchmark setup function.
+	*\param[in] processedBytes
+	*	The amount of data processed by each operation, used to report a throughput.
+	*/
+	void registerBenchmark( std::string name
+		, Setup setup
+		, uint64_t processedBytes = 0u );
+	/**
+	*\return
+	*	The names of the registered benchmarks, matching given filter.
+	*/
+	std::vector< std::string > listBenchmarks( std::string const & filter );
+	/**
+	*\brief
+	*	Runs the registered benchmarks matching the options filter.
+	*\remarks
+	*	The iterations count of each benchmark is doubled until the run
+	*	lasts at least the options minimal time.
+	*/
+	std::vector< Result > runBenchmarks( Context & context
+		, Options const & options );
+	/**
+	*\return
+	*	The allocation counters, since the program start.
+	*/
+	AllocationCounters getAllocationCounters();
+	/**
+	*\brief
+	*	Checks that a steady state frame loop (record, submit, wait) going through
+	*	the ashespp wrappers makes no more allocations than the same loop going
+	*	through the raw entry points.
+	*\return
+	*	\p false if the wrappers allocated, the details being written to \p stream.
+	*/
+	bool checkSteadyStateAllocations( Context & context
+		, std::ostream & stream );
+	/**
+	*\brief
+	*	Writes the results as a human readable table.
+	*/
+	void writeText( std::ostream & stream
+		, std::vector< Result > const & results );
+	/**
+	*\brief
+	*	Writes the results as JSON, meant to be compared between runs by CI.
+	*/
+	void writeJson( std::ostream & stream
+		, Options const & options
+		, std::vector< Result > const & results );
+	/**
+	*\brief
+	*	Registers a benchmark at static initialisation time.
+	*/
+	struct Registrar
+	{
+		Registrar( std::string name
+			, Setup setup
+			, uint64_t processedBytes = 0u )
+		{
+			registerBenchmark( std::move( name ), std::move( setup ), processedBytes );
+		}
+	};
+	/**
+	*\brief
+	*	Prevents the compiler from optimising away a computed value.
+	*/
+	template< typename ValueT >
+	inline void doNotOptimise( ValueT const & value )
+	{
+		static ValueT const * volatile sink;
+		sink = &value;
+	}
+}
+
+#endif
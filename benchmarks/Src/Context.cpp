@@ -0,0 +1,275 @@
+/*
+This file belongs to Ashes.
+See LICENSE file in root folder.
+*/
+#include "Context.hpp"
+#include "Shaders.hpp"
+
+#include <ashespp/Command/CommandBuffer.hpp>
+#include <ashespp/Core/Instance.hpp>
+#include <ashespp/Core/PhysicalDevice.hpp>
+#include <ashespp/Image/Image.hpp>
+#include <ashespp/Shader/ShaderModule.hpp>
+
+#include <cstring>
+
+namespace bench
+{
+	namespace
+	{
+		ashes::InstancePtr createInstance( ashes::RendererList const & renderers
+			, std::string const & name )
+		{
+			auto plugin = renderers.selectPlugin( name );
+			return std::make_unique< ashes::Instance >( std::move( plugin )
+				, ashes::InstanceCreateInfo
+				{
+					0u,
+					ashes::ApplicationInfo
+					{
+						"AshesBenchmarks",
+						ashes::makeVersion( 1, 0, 0 ),
+						"Ashes",
+						ashes::makeVersion( 1, 0, 0 ),
+						VK_API_VERSION_1_0,
+					},
+					{},
+					{},
+				} );
+		}
+
+		ashes::PhysicalDevicePtrArray enumerateGpus( ashes::Instance const & instance )
+		{
+			auto result = instance.enumeratePhysicalDevices();
+
+			if ( result.empty() )
+			{
+				throw std::runtime_error{ "No physical device exposed by the plugin" };
+			}
+
+			return result;
+		}
+
+		uint32_t getGraphicsQueueFamily( ashes::PhysicalDevice const & gpu )
+		{
+			auto families = gpu.getQueueFamilyProperties();
+
+			for ( uint32_t index = 0u; index < families.size(); ++index )
+			{
+				if ( ashes::checkFlag( families[index].queueFlags, VK_QUEUE_GRAPHICS_BIT ) )
+				{
+					return index;
+				}
+			}
+
+			throw std::runtime_error{ "No graphics queue family exposed by the plugin" };
+		}
+
+		ashes::DevicePtr createDevice( ashes::Instance const & instance
+			, ashes::PhysicalDevice const & gpu
+			, uint32_t queueFamilyIndex )
+		{
+			ashes::DeviceQueueCreateInfoArray queueCreateInfos;
+			queueCreateInfos.push_back(
+				{
+					0u,
+					queueFamilyIndex,
+					{ 1.0f },
+				} );
+			return instance.createDevice( gpu
+				, ashes::DeviceCreateInfo
+				{
+					0u,
+					std::move( queueCreateInfos ),
+					{},
+					{},
+					gpu.getFeatures(),
+				} );
+		}
+
+		ashes::RenderPassPtr createRenderPass( ashes::Device const & device )
+		{
+			ashes::VkAttachmentDescriptionArray attaches
+			{
+				{
+					0u,
+					VK_FORMAT_R8G8B8A8_UNORM,
+					VK_SAMPLE_COUNT_1_BIT,
+					VK_ATTACHMENT_LOAD_OP_DONT_CARE,
+					VK_ATTACHMENT_STORE_OP_STORE,
+					VK_ATTACHMENT_LOAD_OP_DONT_CARE,
+					VK_ATTACHMENT_STORE_OP_DONT_CARE,
+					VK_IMAGE_LAYOUT_UNDEFINED,
+					VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+				}
+			};
+			ashes::SubpassDescriptionArray subpasses;
+			subpasses.emplace_back( ashes::SubpassDescription
+				{
+					0u,
+					VK_PIPELINE_BIND_POINT_GRAPHICS,
+					{},
+					{ { 0u, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL } },
+					{},
+					ashes::nullopt,
+					{},
+				} );
+			return device.createRenderPass( ashes::RenderPassCreateInfo
+				{
+					0u,
+					std::move( attaches ),
+					std::move( subpasses ),
+					{},
+				} );
+		}
+	}
+
+	Context::Context( std::string const & plugin )
+		: m_instance{ createInstance( m_renderers, plugin ) }
+		, m_gpus{ enumerateGpus( *m_instance ) }
+		, m_queueFamilyIndex{ getGraphicsQueueFamily( *m_gpus[0] ) }
+		, m_device{ createDevice( *m_instance, *m_gpus[0], m_queueFamilyIndex ) }
+		, m_allocator{ std::make_unique< ashes::MemoryAllocator >( *m_device ) }
+		, m_queue{ m_device->getQueue( m_queueFamilyIndex, 0u ) }
+		, m_commandPool{ m_device->createCommandPool( m_queueFamilyIndex
+			, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT ) }
+		, m_image{ m_device->createImage( ashes::ImageCreateInfo
+			{
+				0u,
+				VK_IMAGE_TYPE_2D,
+				VK_FORMAT_R8G8B8A8_UNORM,
+				{ m_extent.width, m_extent.height, 1u },
+				1u,
+				1u,
+				VK_SAMPLE_COUNT_1_BIT,
+				VK_IMAGE_TILING_OPTIMAL,
+				VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT,
+			} ) }
+		, m_renderPass{ createRenderPass( *m_device ) }
+		, m_texture{ m_device->createImage( ashes::ImageCreateInfo
+			{
+				0u,
+				VK_IMAGE_TYPE_2D,
+				VK_FORMAT_R8G8B8A8_UNORM,
+				{ 16u, 16u, 1u },
+				1u,
+				1u,
+				VK_SAMPLE_COUNT_1_BIT,
+				VK_IMAGE_TILING_OPTIMAL,
+				VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT,
+			} ) }
+		, m_sampler{ m_device->createSampler( VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE
+			, VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE
+			, VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE
+			, VK_FILTER_NEAREST
+			, VK_FILTER_NEAREST ) }
+		, m_vertexShader{ createShaderModule( VK_SHADER_STAGE_VERTEX_BIT ) }
+		, m_fragmentShader{ createShaderModule( VK_SHADER_STAGE_FRAGMENT_BIT ) }
+	{
+		m_image->bindMemory( m_allocator->allocate( *m_image
+			, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT ) );
+		m_view = m_image->createView( VK_IMAGE_VIEW_TYPE_2D
+			, VK_FORMAT_R8G8B8A8_UNORM );
+		ashes::ImageViewCRefArray views;
+		views.emplace_back( m_view );
+		m_frameBuffer = m_renderPass->createFrameBuffer( m_extent
+			, std::move( views ) );
+		m_texture->bindMemory( m_allocator->allocate( *m_texture
+			, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT ) );
+		m_textureView = m_texture->createView( VK_IMAGE_VIEW_TYPE_2D
+			, VK_FORMAT_R8G8B8A8_UNORM );
+
+		auto commandBuffer = m_commandPool->createCommandBuffer();
+		commandBuffer->begin( VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT );
+		commandBuffer->memoryBarrier( VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT
+			, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT
+			, m_textureView.makeShaderInputResource( VK_IMAGE_LAYOUT_UNDEFINED ) );
+		commandBuffer->end();
+		m_queue->submit( *commandBuffer, nullptr );
+		m_queue->waitIdle();
+	}
+
+	Context::~Context()
+	{
+		m_device->waitIdle();
+	}
+
+	ashes::ShaderModulePtr Context::createShaderModule( VkShaderStageFlagBits stage )const
+	{
+		return m_device->createShaderModule( getShaderCode( stage ) );
+	}
+
+	ashes::GraphicsPipelineCreateInfo Context::getGraphicsPipelineCreateInfo( ashes::PipelineLayout const & layout
+		, int32_t colourIndex )const
+	{
+		ashes::ByteArray specialisationData( sizeof( int32_t ) );
+		std::memcpy( specialisationData.data(), &colourIndex, sizeof( int32_t ) );
+		ashes::PipelineShaderStageCreateInfoArray shaderStages;
+		shaderStages.push_back( ashes::PipelineShaderStageCreateInfo
+			{
+				0u,
+				VK_SHADER_STAGE_VERTEX_BIT,
+				m_vertexShader,
+				"main",
+				ashes::nullopt,
+			} );
+		shaderStages.push_back( ashes::PipelineShaderStageCreateInfo
+			{
+				0u,
+				VK_SHADER_STAGE_FRAGMENT_BIT,
+				m_fragmentShader,
+				"main",
+				ashes::SpecializationInfo
+				{
+					{ { 0u, 0u, sizeof( int32_t ) } },
+					std::move( specialisationData ),
+				},
+			} );
+		return ashes::GraphicsPipelineCreateInfo
+		{
+			0u,
+			std::move( shaderStages ),
+			ashes::PipelineVertexInputStateCreateInfo
+			{
+				0u,
+				{ { 0u, 6u * sizeof( float ), VK_VERTEX_INPUT_RATE_VERTEX } },
+				{
+					{ 0u, 0u, VK_FORMAT_R32G32B32A32_SFLOAT, 0u },
+					{ 1u, 0u, VK_FORMAT_R32G32_SFLOAT, 4u * sizeof( float ) },
+				},
+			},
+			ashes::PipelineInputAssemblyStateCreateInfo{ 0u, VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST },
+			ashes::nullopt,
+			ashes::PipelineViewportStateCreateInfo
+			{
+				0u,
+				1u,
+				ashes::VkViewportArray{ { 0.0f, 0.0f, float( m_extent.width ), float( m_extent.height ), 0.0f, 1.0f } },
+				1u,
+				ashes::VkScissorArray{ { { 0, 0 }, m_extent } },
+			},
+			ashes::PipelineRasterizationStateCreateInfo{},
+			ashes::PipelineMultisampleStateCreateInfo{},
+			ashes::nullopt,
+			ashes::PipelineColorBlendStateCreateInfo{},
+			ashes::nullopt,
+			layout,
+			*m_renderPass,
+		};
+	}
+
+	ashes::VkDescriptorSetLayoutBindingArray Context::getDescriptorBindings()
+	{
+		return
+		{
+			{ 0u, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1u, VK_SHADER_STAGE_FRAGMENT_BIT, nullptr },
+			{ 1u, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1u, VK_SHADER_STAGE_VERTEX_BIT, nullptr },
+			{ 2u, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1u, VK_SHADER_STAGE_VERTEX_BIT, nullptr },
+		};
+	}
+
+	VkPushConstantRange Context::getPushConstantRange()
+	{
+		return { VK_SHADER_STAGE_FRAGMENT_BIT, 0u, 4u * sizeof( float ) };
+	}
+}
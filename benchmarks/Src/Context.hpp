@@ -0,0 +1,134 @@
+/*
+This file belongs to Ashes.
+See LICENSE file in root folder.
+*/
+#ifndef ___AshesBenchmarks_Context_HPP___
+#define ___AshesBenchmarks_Context_HPP___
+#pragma once
+
+#include <ashespp/Command/CommandPool.hpp>
+#include <ashespp/Command/Queue.hpp>
+#include <ashespp/Core/Device.hpp>
+#include <ashespp/Core/Instance.hpp>
+#include <ashespp/Core/RendererList.hpp>
+#include <ashespp/Image/ImageView.hpp>
+#include <ashespp/Image/Sampler.hpp>
+#include <ashespp/Miscellaneous/MemoryAllocator.hpp>
+#include <ashespp/RenderPass/FrameBuffer.hpp>
+#include <ashespp/RenderPass/RenderPass.hpp>
+
+namespace bench
+{
+	/**
+	*\brief
+	*	The objects shared by all benchmarks: a device created on the selected
+	*	plugin, its queue, a render pass with a matching framebuffer, and the
+	*	shaders and texture used by the benchmark pipelines.
+	*/
+	class Context
+	{
+	public:
+		/**
+		*\brief
+		*	Constructor.
+		*\param[in] plugin
+		*	The name of the renderer plugin to load through the Ashes loader.
+		*/
+		explicit Context( std::string const & plugin );
+		~Context();
+		/**
+		*\brief
+		*	Creates a shader module, from the embedded SPIR-V code for given stage.
+		*/
+		ashes::ShaderModulePtr createShaderModule( VkShaderStageFlagBits stage )const;
+		/**
+		*\brief
+		*	Creates the creation informations of a graphics pipeline, drawing into
+		*	the context render pass, using the context vertex and fragment shaders.
+		*\param[in] layout
+		*	The pipeline layout, compatible with getDescriptorBindings()
+		*	and getPushConstantRange().
+		*\param[in] colourIndex
+		*	The fragment shader specialisation constant value.
+		*/
+		ashes::GraphicsPipelineCreateInfo getGraphicsPipelineCreateInfo( ashes::PipelineLayout const & layout
+			, int32_t colourIndex = 0 )const;
+		/**
+		*\return
+		*	The descriptor bindings expected by the context shaders.
+		*/
+		static ashes::VkDescriptorSetLayoutBindingArray getDescriptorBindings();
+		/**
+		*\return
+		*	The push constants range expected by the context shaders.
+		*/
+		static VkPushConstantRange getPushConstantRange();
+
+		inline ashes::Device const & getDevice()const
+		{
+			return *m_device;
+		}
+
+		inline ashes::MemoryAllocator & getAllocator()const
+		{
+			return *m_allocator;
+		}
+
+		inline ashes::Queue const & getQueue()const
+		{
+			return *m_queue;
+		}
+
+		inline ashes::CommandPool const & getCommandPool()const
+		{
+			return *m_commandPool;
+		}
+
+		inline ashes::RenderPass const & getRenderPass()const
+		{
+			return *m_renderPass;
+		}
+
+		inline ashes::FrameBuffer const & getFrameBuffer()const
+		{
+			return *m_frameBuffer;
+		}
+
+		inline VkExtent2D const & getExtent()const
+		{
+			return m_extent;
+		}
+
+		inline ashes::ImageView const & getTextureView()const
+		{
+			return m_textureView;
+		}
+
+		inline ashes::Sampler const & getSampler()const
+		{
+			return *m_sampler;
+		}
+
+	private:
+		ashes::RendererList m_renderers;
+		ashes::InstancePtr m_instance;
+		ashes::PhysicalDevicePtrArray m_gpus;
+		uint32_t m_queueFamilyIndex{ 0u };
+		ashes::DevicePtr m_device;
+		ashes::MemoryAllocatorPtr m_allocator;
+		ashes::QueuePtr m_queue;
+		ashes::CommandPoolPtr m_commandPool;
+		VkExtent2D m_extent{ 64u, 64u };
+		ashes::ImagePtr m_image;
+		ashes::ImageView m_view;
+		ashes::RenderPassPtr m_renderPass;
+		ashes::FrameBufferPtr m_frameBuffer;
+		ashes::ImagePtr m_texture;
+		ashes::ImageView m_textureView;
+		ashes::SamplerPtr m_sampler;
+		ashes::ShaderModulePtr m_vertexShader;
+		ashes::ShaderModulePtr m_fragmentShader;
+	};
+}
+
+#endif
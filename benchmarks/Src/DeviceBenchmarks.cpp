@@ -0,0 +1,367 @@
+/*
+This file belongs to Ashes.
+See LICENSE file in root folder.
+*/
+#include "Benchmark.hpp"
+#include "Scene.hpp"
+
+#include <ashespp/Image/Image.hpp>
+#include <ashespp/Miscellaneous/QueryPool.hpp>
+#include <ashespp/Pipeline/PipelineCache.hpp>
+#include <ashespp/Sync/Fence.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+
+namespace bench
+{
+	namespace
+	{
+		// Draws submitted at once, in the state changes benchmarks.
+		uint32_t constexpr DrawBatchSize = 1024u;
+		VkDeviceSize constexpr BufferUploadSize = 4u * 1024u * 1024u;
+		VkExtent2D constexpr TextureUploadExtent{ 512u, 512u };
+		VkDeviceSize constexpr TextureUploadSize = TextureUploadExtent.width * TextureUploadExtent.height * 4u;
+
+		/**
+		*\brief
+		*	A scene, with a fence to wait for its submissions.
+		*/
+		struct Submitter
+		{
+			explicit Submitter( Context & context )
+				: scene{ context }
+				, fence{ context.getDevice().createFence() }
+			{
+			}
+
+			void submitAndWait()const
+			{
+				scene.context.getQueue().submit( *scene.commandBuffer
+					, fence.get() );
+				fence->wait( ashes::MaxTimeout );
+				fence->reset();
+			}
+
+			Scene scene;
+			ashes::FencePtr fence;
+		};
+
+		ashes::BufferBasePtr createBuffer( Context & context
+			, VkDeviceSize size
+			, VkBufferUsageFlags usage
+			, VkMemoryPropertyFlags flags )
+		{
+			auto result = context.getDevice().createBuffer( size, usage );
+			result->bindMemory( context.getAllocator().allocate( *result, flags ) );
+			return result;
+		}
+
+		//*********************************************************************************************
+		// Draw throughput, against the frequency of pipeline changes.
+		// Each operation is a draw, recorded, submitted and waited for by batches.
+
+		Setup drawWithStateChanges( uint32_t drawsPerState )
+		{
+			return [drawsPerState]( Context & context )
+			{
+				struct Objects
+				{
+					explicit Objects( Context & context )
+						: submitter{ context }
+						, alternate{ context.getDevice().createPipeline( context.getGraphicsPipelineCreateInfo( *submitter.scene.pipelineLayout, 1 ) ) }
+					{
+					}
+
+					Submitter submitter;
+					ashes::GraphicsPipelinePtr alternate;
+				};
+				auto objects = std::make_shared< Objects >( context );
+				return Operation{ [objects, drawsPerState]( uint64_t count )
+				{
+					auto & scene = objects->submitter.scene;
+					auto & commandBuffer = *scene.commandBuffer;
+
+					while ( count )
+					{
+						auto batch = uint32_t( std::min< uint64_t >( count, DrawBatchSize ) );
+						count -= batch;
+						scene.beginBatch();
+						commandBuffer.bindVertexBuffer( 0u, *scene.vertexBuffer, 0u );
+						commandBuffer.bindDescriptorSet( *scene.descriptorSet
+							, *scene.pipelineLayout );
+
+						for ( uint32_t i = 0u; i < batch; ++i )
+						{
+							if ( i && drawsPerState && ( i % drawsPerState ) == 0u )
+							{
+								commandBuffer.bindPipeline( ( ( i / drawsPerState ) % 2u )
+									? *objects->alternate
+									: *scene.pipeline );
+							}
+
+							commandBuffer.draw( 3u );
+						}
+
+						scene.endBatch();
+						objects->submitter.submitAndWait();
+					}
+				} };
+			};
+		}
+
+		Registrar const drawStateEvery1{ "Draw/PipelineChange/every-1", drawWithStateChanges( 1u ) };
+		Registrar const drawStateEvery4{ "Draw/PipelineChange/every-4", drawWithStateChanges( 4u ) };
+		Registrar const drawStateEvery16{ "Draw/PipelineChange/every-16", drawWithStateChanges( 16u ) };
+		Registrar const drawStateEvery64{ "Draw/PipelineChange/every-64", drawWithStateChanges( 64u ) };
+		Registrar const drawStateNever{ "Draw/PipelineChange/never", drawWithStateChanges( 0u ) };
+
+		//*********************************************************************************************
+		// Graphics pipeline creation.
+		// Cold: each pipeline gets a specialisation constant value never used before, so that
+		// neither the backend nor the driver (Mesa shader cache, for example) can reuse a program.
+		// Warm: the same pipeline is created again, with a pipeline cache.
+
+		Registrar const pipelineCold{ "Pipeline/CreateGraphics/cold"
+			, []( Context & context )
+			{
+				auto scene = std::make_shared< Scene >( context );
+				// Random base, so that the values also differ between runs, for on-disk driver caches.
+				auto next = std::make_shared< int32_t >( int32_t( std::random_device{}() & 0x3fffffffu ) + 3 );
+				return Operation{ [scene, next]( uint64_t count )
+				{
+					for ( uint64_t i = 0u; i < count; ++i )
+					{
+						auto pipeline = scene->device.createPipeline( scene->context.getGraphicsPipelineCreateInfo( *scene->pipelineLayout
+							, ( *next )++ ) );
+						doNotOptimise( pipeline );
+					}
+				} };
+			} };
+		Registrar const pipelineWarm{ "Pipeline/CreateGraphics/warm"
+			, []( Context & context )
+			{
+				auto scene = std::make_shared< Scene >( context );
+				std::shared_ptr< ashes::PipelineCache > cache{ scene->device.createPipelineCache() };
+				return Operation{ [scene, cache]( uint64_t count )
+				{
+					for ( uint64_t i = 0u; i < count; ++i )
+					{
+						auto createInfo = scene->context.getGraphicsPipelineCreateInfo( *scene->pipelineLayout );
+						createInfo.pipelineCache = *cache;
+						auto pipeline = scene->device.createPipeline( std::move( createInfo ) );
+						doNotOptimise( pipeline );
+					}
+				} };
+			} };
+
+		//*********************************************************************************************
+		// Upload bandwidth.
+
+		Registrar const uploadBufferMap{ "Upload/Buffer/map"
+			, []( Context & context )
+			{
+				auto buffer = std::shared_ptr< ashes::BufferBase >{ createBuffer( context
+					, BufferUploadSize
+					, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT
+					, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT ) };
+				auto data = std::make_shared< ashes::ByteArray >( BufferUploadSize, uint8_t( 0x7f ) );
+				return Operation{ [buffer, data]( uint64_t count )
+				{
+					for ( uint64_t i = 0u; i < count; ++i )
+					{
+						if ( auto mapped = buffer->lock( 0u, BufferUploadSize, 0u ) )
+						{
+							std::memcpy( mapped, data->data(), BufferUploadSize );
+							buffer->flush( 0u, BufferUploadSize );
+							buffer->unlock();
+						}
+					}
+				} };
+			}
+			, BufferUploadSize };
+
+		struct Staging
+		{
+			Staging( Context & context
+				, VkDeviceSize size )
+				: submitter{ context }
+				, buffer{ createBuffer( context
+					, size
+					, VK_BUFFER_USAGE_TRANSFER_SRC_BIT
+					, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT ) }
+				, data( size, uint8_t( 0x7f ) )
+			{
+			}
+			/**
+			*\brief
+			*	Writes the data to the staging buffer, through a mapping.
+			*/
+			void write()const
+			{
+				auto size = VkDeviceSize( data.size() );
+
+				if ( auto mapped = buffer->lock( 0u, size, 0u ) )
+				{
+					std::memcpy( mapped, data.data(), size );
+					buffer->flush( 0u, size );
+					buffer->unlock();
+				}
+			}
+
+			Submitter submitter;
+			ashes::BufferBasePtr buffer;
+			ashes::ByteArray data;
+		};
+
+		Registrar const uploadBufferCopy{ "Upload/Buffer/copy"
+			, []( Context & context )
+			{
+				auto staging = std::make_shared< Staging >( context, BufferUploadSize );
+				std::shared_ptr< ashes::BufferBase > buffer{ createBuffer( context
+					, BufferUploadSize
+					, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT
+					, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT ) };
+				auto & commandBuffer = *staging->submitter.scene.commandBuffer;
+				commandBuffer.begin();
+				commandBuffer.memoryBarrier( VK_PIPELINE_STAGE_VERTEX_INPUT_BIT
+					, VK_PIPELINE_STAGE_TRANSFER_BIT
+					, buffer->makeTransferDestination() );
+				commandBuffer.copyBuffer( *staging->buffer
+					, *buffer
+					, uint32_t( BufferUploadSize ) );
+				commandBuffer.memoryBarrier( VK_PIPELINE_STAGE_TRANSFER_BIT
+					, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT
+					, buffer->makeVertexShaderInputResource() );
+				commandBuffer.end();
+				return Operation{ [staging, buffer]( uint64_t count )
+				{
+					for ( uint64_t i = 0u; i < count; ++i )
+					{
+						staging->write();
+						staging->submitter.submitAndWait();
+					}
+				} };
+			}
+			, BufferUploadSize };
+
+		Registrar const uploadTextureCopy{ "Upload/Texture/copy"
+			, []( Context & context )
+			{
+				auto staging = std::make_shared< Staging >( context, TextureUploadSize );
+				std::shared_ptr< ashes::Image > image{ context.getDevice().createImage( ashes::ImageCreateInfo
+					{
+						0u,
+						VK_IMAGE_TYPE_2D,
+						VK_FORMAT_R8G8B8A8_UNORM,
+						{ TextureUploadExtent.width, TextureUploadExtent.height, 1u },
+						1u,
+						1u,
+						VK_SAMPLE_COUNT_1_BIT,
+						VK_IMAGE_TILING_OPTIMAL,
+						VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+					} ) };
+				image->bindMemory( context.getAllocator().allocate( *image
+					, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT ) );
+				auto view = image->createView( VK_IMAGE_VIEW_TYPE_2D
+					, VK_FORMAT_R8G8B8A8_UNORM );
+				auto & commandBuffer = *staging->submitter.scene.commandBuffer;
+				commandBuffer.begin();
+				commandBuffer.memoryBarrier( VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT
+					, VK_PIPELINE_STAGE_TRANSFER_BIT
+					, view.makeTransferDestination( VK_IMAGE_LAYOUT_UNDEFINED ) );
+				commandBuffer.copyToImage( VkBufferImageCopy
+					{
+						0u,
+						0u,
+						0u,
+						{ VK_IMAGE_ASPECT_COLOR_BIT, 0u, 0u, 1u },
+						{},
+						{ TextureUploadExtent.width, TextureUploadExtent.height, 1u },
+					}
+					, *staging->buffer
+					, *image );
+				commandBuffer.memoryBarrier( VK_PIPELINE_STAGE_TRANSFER_BIT
+					, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT
+					, view.makeShaderInputResource( VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL ) );
+				commandBuffer.end();
+				return Operation{ [staging, image]( uint64_t count )
+				{
+					for ( uint64_t i = 0u; i < count; ++i )
+					{
+						staging->write();
+						staging->submitter.submitAndWait();
+					}
+				} };
+			}
+			, TextureUploadSize };
+
+		//*********************************************************************************************
+		// Query readback latency: from the submission to the availability of the results.
+
+		Registrar const queryTimestamp{ "Query/Timestamp/readback"
+			, []( Context & context )
+			{
+				auto submitter = std::make_shared< Submitter >( context );
+				std::shared_ptr< ashes::QueryPool > pool{ context.getDevice().createQueryPool( VK_QUERY_TYPE_TIMESTAMP, 2u, 0u ) };
+				auto & commandBuffer = *submitter->scene.commandBuffer;
+				commandBuffer.begin();
+				commandBuffer.resetQueryPool( *pool, 0u, 2u );
+				commandBuffer.writeTimestamp( VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, *pool, 0u );
+				commandBuffer.writeTimestamp( VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, *pool, 1u );
+				commandBuffer.end();
+				return Operation{ [submitter, pool]( uint64_t count )
+				{
+					ashes::UInt64Array results( 2u );
+
+					for ( uint64_t i = 0u; i < count; ++i )
+					{
+						submitter->submitAndWait();
+						pool->getResults( 0u
+							, 2u
+							, 0u
+							, VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT
+							, results );
+					}
+				} };
+			} };
+		Registrar const queryOcclusion{ "Query/Occlusion/readback"
+			, []( Context & context )
+			{
+				auto submitter = std::make_shared< Submitter >( context );
+				std::shared_ptr< ashes::QueryPool > pool{ context.getDevice().createQueryPool( VK_QUERY_TYPE_OCCLUSION, 1u, 0u ) };
+				auto & scene = submitter->scene;
+				auto & commandBuffer = *scene.commandBuffer;
+				commandBuffer.begin();
+				commandBuffer.resetQueryPool( *pool, 0u, 1u );
+				commandBuffer.beginRenderPass( context.getRenderPass()
+					, context.getFrameBuffer()
+					, {}
+					, VK_SUBPASS_CONTENTS_INLINE );
+				commandBuffer.bindPipeline( *scene.pipeline );
+				commandBuffer.bindVertexBuffer( 0u, *scene.vertexBuffer, 0u );
+				commandBuffer.bindDescriptorSet( *scene.descriptorSet
+					, *scene.pipelineLayout );
+				commandBuffer.beginQuery( *pool, 0u, 0u );
+				commandBuffer.draw( 3u );
+				commandBuffer.endQuery( *pool, 0u );
+				commandBuffer.endRenderPass();
+				commandBuffer.end();
+				return Operation{ [submitter, pool]( uint64_t count )
+				{
+					ashes::UInt64Array results( 1u );
+
+					for ( uint64_t i = 0u; i < count; ++i )
+					{
+						submitter->submitAndWait();
+						pool->getResults( 0u
+							, 1u
+							, 0u
+							, VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT
+							, results );
+					}
+				} };
+			} };
+	}
+}
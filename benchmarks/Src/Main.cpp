@@ -0,0 +1,154 @@
+/*
+This file belongs to Ashes.
+See LICENSE file in root folder.
+*/
+#include "Benchmark.hpp"
+#include "Context.hpp"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+namespace
+{
+	void printUsage( std::string const & program )
+	{
+		std::cout << "Usage: " << program << " [options]\n"
+			<< "  --filter <text>    Only runs the benchmarks which name contains <text>.\n"
+			<< "  --min-time <ms>    Minimal duration of each benchmark measured run (default: 250).\n"
+			<< "  --plugin <name>    The renderer plugin to run on (default: test).\n"
+			<< "  --json <file>      Writes the results to <file>, as JSON.\n"
+			<< "  --list             Lists the benchmarks, and exits.\n"
+			<< "  --check-allocations\n"
+			<< "                     Checks that the ashespp frame loop doesn't allocate, and exits.\n"
+			<< "  --headless         Creates the GL contexts without window system (EGL).\n"
+			<< "  --software         Requests the software rasteriser (llvmpipe with Mesa).\n";
+	}
+
+	void setEnvironment( char const * name
+		, char const * value )
+	{
+#if defined( _WIN32 )
+		_putenv_s( name, value );
+#else
+		setenv( name, value, 1 );
+#endif
+	}
+
+	bool parseOptions( int argc
+		, char * argv[]
+		, bench::Options & options )
+	{
+		for ( int i = 1; i < argc; ++i )
+		{
+			std::string arg = argv[i];
+			auto hasValue = i + 1 < argc;
+
+			if ( arg == "--filter" && hasValue )
+			{
+				options.filter = argv[++i];
+			}
+			else if ( arg == "--min-time" && hasValue )
+			{
+				options.minTimeMs = std::stod( argv[++i] );
+			}
+			else if ( arg == "--plugin" && hasValue )
+			{
+				options.plugin = argv[++i];
+			}
+			else if ( arg == "--json" && hasValue )
+			{
+				options.jsonPath = argv[++i];
+			}
+			else if ( arg == "--list" )
+			{
+				options.list = true;
+			}
+			else if ( arg == "--check-allocations" )
+			{
+				options.checkAllocations = true;
+			}
+			else if ( arg == "--headless" )
+			{
+				options.headless = true;
+			}
+			else if ( arg == "--software" )
+			{
+				options.software = true;
+			}
+			else
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
+
+int main( int argc, char * argv[] )
+{
+	bench::Options options;
+
+	if ( !parseOptions( argc, argv, options ) )
+	{
+		printUsage( argv[0] );
+		return EXIT_FAILURE;
+	}
+
+	if ( options.list )
+	{
+		for ( auto & name : bench::listBenchmarks( options.filter ) )
+		{
+			std::cout << name << "\n";
+		}
+
+		return EXIT_SUCCESS;
+	}
+
+	// Must be set before the plugins are loaded, since the plugins read them when probed.
+	if ( options.headless )
+	{
+		setEnvironment( "ASHES_GL_HEADLESS", "1" );
+	}
+
+	if ( options.software )
+	{
+		setEnvironment( "LIBGL_ALWAYS_SOFTWARE", "1" );
+	}
+
+	try
+	{
+		bench::Context context{ options.plugin };
+
+		if ( options.checkAllocations )
+		{
+			return bench::checkSteadyStateAllocations( context, std::cout )
+				? EXIT_SUCCESS
+				: EXIT_FAILURE;
+		}
+
+		auto results = bench::runBenchmarks( context, options );
+		bench::writeText( std::cout, results );
+
+		if ( !options.jsonPath.empty() )
+		{
+			std::ofstream file{ options.jsonPath };
+
+			if ( !file )
+			{
+				std::cerr << "Couldn't open " << options.jsonPath << std::endl;
+				return EXIT_FAILURE;
+			}
+
+			bench::writeJson( file, options, results );
+		}
+	}
+	catch ( std::exception & exc )
+	{
+		std::cerr << exc.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
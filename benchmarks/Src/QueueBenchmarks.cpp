@@ -0,0 +1,89 @@
+/*
+This file belongs to Ashes.
+See LICENSE file in root folder.
+*/
+#include "Benchmark.hpp"
+#include "Scene.hpp"
+
+#include <ashespp/Sync/Fence.hpp>
+
+namespace bench
+{
+	namespace
+	{
+		// Draws in the submitted command buffer.
+		uint32_t constexpr DrawCount = 16u;
+
+		struct Submission
+		{
+			explicit Submission( Context & context )
+				: scene{ context }
+				, fence{ context.getDevice().createFence() }
+			{
+				scene.beginBatch( 0u );
+
+				for ( uint32_t i = 0u; i < DrawCount; ++i )
+				{
+					scene.commandBuffer->bindVertexBuffer( 0u, *scene.vertexBuffer, 0u );
+					scene.commandBuffer->bindDescriptorSet( *scene.descriptorSet
+						, *scene.pipelineLayout );
+					scene.commandBuffer->draw( 3u );
+				}
+
+				scene.endBatch();
+			}
+
+			Scene scene;
+			ashes::FencePtr fence;
+		};
+
+		template< typename SubmitT >
+		Setup submit( SubmitT submit )
+		{
+			return [submit]( Context & context )
+			{
+				auto submission = std::make_shared< Submission >( context );
+				return Operation{ [submission, submit]( uint64_t count )
+				{
+					for ( uint64_t i = 0u; i < count; ++i )
+					{
+						submit( *submission );
+					}
+				} };
+			};
+		}
+
+		//*********************************************************************************************
+
+		Registrar const submitAshespp{ "Queue/SubmitWait/ashespp"
+			, submit( []( Submission const & submission )
+			{
+				submission.scene.context.getQueue().submit( *submission.scene.commandBuffer
+					, submission.fence.get() );
+				submission.fence->wait( ashes::MaxTimeout );
+				submission.fence->reset();
+			} ) };
+		Registrar const submitRaw{ "Queue/SubmitWait/raw"
+			, submit( []( Submission const & submission )
+			{
+				auto & device = submission.scene.device;
+				VkCommandBuffer commandBuffer = *submission.scene.commandBuffer;
+				VkFence fence = *submission.fence;
+				VkSubmitInfo submitInfo
+				{
+					VK_STRUCTURE_TYPE_SUBMIT_INFO,
+					nullptr,
+					0u,
+					nullptr,
+					nullptr,
+					1u,
+					&commandBuffer,
+					0u,
+					nullptr,
+				};
+				device.vkQueueSubmit( submission.scene.context.getQueue(), 1u, &submitInfo, fence );
+				device.vkWaitForFences( device, 1u, &fence, VK_TRUE, ashes::MaxTimeout );
+				device.vkResetFences( device, 1u, &fence );
+			} ) };
+	}
+}
@@ -0,0 +1,149 @@
+/*
+This file belongs to Ashes.
+See LICENSE file in root folder.
+*/
+#include "Benchmark.hpp"
+#include "Scene.hpp"
+
+#include <algorithm>
+#include <array>
+
+namespace bench
+{
+	namespace
+	{
+		// Commands recorded between two begin/end of the command buffer.
+		uint64_t constexpr BatchSize = 1024u;
+
+		template< typename RecordT >
+		Setup record( RecordT record )
+		{
+			return [record]( Context & context )
+			{
+				auto scene = std::make_shared< Scene >( context );
+				return Operation{ [scene, record]( uint64_t count )
+				{
+					while ( count )
+					{
+						auto batch = std::min( count, BatchSize );
+						count -= batch;
+						scene->beginBatch();
+
+						for ( uint64_t i = 0u; i < batch; ++i )
+						{
+							record( *scene );
+						}
+
+						scene->endBatch();
+					}
+				} };
+			};
+		}
+
+		std::array< uint8_t, Scene::PushConstantsSize > const pushConstantsData{};
+
+		//*********************************************************************************************
+
+		Registrar const drawAshespp{ "Record/Draw/ashespp"
+			, record( []( Scene const & scene )
+			{
+				scene.commandBuffer->draw( 3u );
+			} ) };
+		Registrar const drawRaw{ "Record/Draw/raw"
+			, record( []( Scene const & scene )
+			{
+				scene.device.vkCmdDraw( *scene.commandBuffer, 3u, 1u, 0u, 0u );
+			} ) };
+
+		//*********************************************************************************************
+
+		Registrar const bindPipelineAshespp{ "Record/BindPipeline/ashespp"
+			, record( []( Scene const & scene )
+			{
+				scene.commandBuffer->bindPipeline( *scene.pipeline );
+			} ) };
+		Registrar const bindPipelineRaw{ "Record/BindPipeline/raw"
+			, record( []( Scene const & scene )
+			{
+				scene.device.vkCmdBindPipeline( *scene.commandBuffer
+					, VK_PIPELINE_BIND_POINT_GRAPHICS
+					, *scene.pipeline );
+			} ) };
+
+		//*********************************************************************************************
+
+		Registrar const bindVertexBufferAshespp{ "Record/BindVertexBuffer/ashespp"
+			, record( []( Scene const & scene )
+			{
+				scene.commandBuffer->bindVertexBuffer( 0u, *scene.vertexBuffer, 0u );
+			} ) };
+		Registrar const bindVertexBufferRaw{ "Record/BindVertexBuffer/raw"
+			, record( []( Scene const & scene )
+			{
+				VkBuffer buffer = *scene.vertexBuffer;
+				VkDeviceSize offset = 0u;
+				scene.device.vkCmdBindVertexBuffers( *scene.commandBuffer, 0u, 1u, &buffer, &offset );
+			} ) };
+
+		//*********************************************************************************************
+
+		Registrar const bindDescriptorSetAshespp{ "Record/BindDescriptorSet/ashespp"
+			, record( []( Scene const & scene )
+			{
+				scene.commandBuffer->bindDescriptorSet( *scene.descriptorSet
+					, *scene.pipelineLayout );
+			} ) };
+		Registrar const bindDescriptorSetRaw{ "Record/BindDescriptorSet/raw"
+			, record( []( Scene const & scene )
+			{
+				VkDescriptorSet set = *scene.descriptorSet;
+				scene.device.vkCmdBindDescriptorSets( *scene.commandBuffer
+					, VK_PIPELINE_BIND_POINT_GRAPHICS
+					, *scene.pipelineLayout
+					, 0u
+					, 1u
+					, &set
+					, 0u
+					, nullptr );
+			} ) };
+
+		//*********************************************************************************************
+
+		Registrar const pushConstantsAshespp{ "Record/PushConstants/ashespp"
+			, record( []( Scene const & scene )
+			{
+				scene.commandBuffer->pushConstants( *scene.pipelineLayout
+					, VK_SHADER_STAGE_FRAGMENT_BIT
+					, 0u
+					, Scene::PushConstantsSize
+					, pushConstantsData.data() );
+			} ) };
+		Registrar const pushConstantsRaw{ "Record/PushConstants/raw"
+			, record( []( Scene const & scene )
+			{
+				scene.device.vkCmdPushConstants( *scene.commandBuffer
+					, *scene.pipelineLayout
+					, VK_SHADER_STAGE_FRAGMENT_BIT
+					, 0u
+					, Scene::PushConstantsSize
+					, pushConstantsData.data() );
+			} ) };
+
+		//*********************************************************************************************
+
+		Registrar const drawCallAshespp{ "Record/DrawCall/ashespp"
+			, record( []( Scene const & scene )
+			{
+				auto & commandBuffer = *scene.commandBuffer;
+				commandBuffer.bindVertexBuffer( 0u, *scene.vertexBuffer, 0u );
+				commandBuffer.bindDescriptorSet( *scene.descriptorSet
+					, *scene.pipelineLayout );
+				commandBuffer.pushConstants( *scene.pipelineLayout
+					, VK_SHADER_STAGE_FRAGMENT_BIT
+					, 0u
+					, Scene::PushConstantsSize
+					, pushConstantsData.data() );
+				commandBuffer.draw( 3u );
+			} ) };
+	}
+}
@@ -0,0 +1,188 @@
+/*
+This file belongs to Ashes.
+See LICENSE file in root folder.
+*/
+#include "Benchmark.hpp"
+#include "Scene.hpp"
+
+#include <ashespp/Pipeline/ComputePipeline.hpp>
+#include <ashespp/Shader/ShaderModule.hpp>
+
+#include <array>
+
+namespace bench
+{
+	namespace
+	{
+		template< typename SetupT >
+		Setup repeat( SetupT setup )
+		{
+			return [setup]( Context & context )
+			{
+				auto scene = std::make_shared< Scene >( context );
+				return Operation{ [scene, action = setup( *scene )]( uint64_t count )
+				{
+					for ( uint64_t i = 0u; i < count; ++i )
+					{
+						action();
+					}
+				} };
+			};
+		}
+
+		//*********************************************************************************************
+
+		Registrar const descriptorUpdateAshespp{ "Descriptor/Update/ashespp"
+			, repeat( []( Scene & scene )
+			{
+				return [&scene]()
+				{
+					scene.descriptorSet->update();
+				};
+			} ) };
+		Registrar const descriptorUpdateRaw{ "Descriptor/Update/raw"
+			, repeat( []( Scene & scene )
+			{
+				return [&scene
+					, imageInfo = VkDescriptorImageInfo{ scene.context.getSampler(), scene.context.getTextureView(), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL }
+					, bufferInfos = std::array< VkDescriptorBufferInfo, 2u >
+					{
+						VkDescriptorBufferInfo{ *scene.uniformBuffer, 0u, Scene::UniformSize },
+						VkDescriptorBufferInfo{ *scene.uniformBuffer, scene.uniformStride, Scene::UniformSize },
+					}]()
+				{
+					std::array< VkWriteDescriptorSet, 3u > writes
+					{
+						VkWriteDescriptorSet{ VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr, *scene.descriptorSet, 0u, 0u, 1u, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, &imageInfo, nullptr, nullptr },
+						VkWriteDescriptorSet{ VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr, *scene.descriptorSet, 1u, 0u, 1u, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, nullptr, &bufferInfos[0], nullptr },
+						VkWriteDescriptorSet{ VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr, *scene.descriptorSet, 2u, 0u, 1u, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, nullptr, &bufferInfos[1], nullptr },
+					};
+					scene.device.vkUpdateDescriptorSets( scene.device, uint32_t( writes.size() ), writes.data(), 0u, nullptr );
+				};
+			} ) };
+		Registrar const descriptorRewriteAshespp{ "Descriptor/Rewrite/ashespp"
+			, repeat( []( Scene & scene )
+			{
+				return [&scene]()
+				{
+					scene.descriptorSet->setBindings( {} );
+					scene.writeBindings();
+					scene.descriptorSet->update();
+				};
+			} ) };
+		Registrar const descriptorAllocateAshespp{ "Descriptor/AllocateFree/ashespp"
+			, repeat( []( Scene & scene )
+			{
+				std::shared_ptr< ashes::DescriptorSetPool > pool{ scene.descriptorLayout->createPool( 1u, false ) };
+				return [pool]()
+				{
+					pool->freeDescriptorSet( pool->createDescriptorSet( 0u ) );
+				};
+			} ) };
+
+		//*********************************************************************************************
+
+		Registrar const graphicsPipelineAshespp{ "Pipeline/CreateGraphics/ashespp"
+			, repeat( []( Scene & scene )
+			{
+				return [&scene]()
+				{
+					auto pipeline = scene.device.createPipeline( scene.context.getGraphicsPipelineCreateInfo( *scene.pipelineLayout ) );
+					doNotOptimise( pipeline );
+				};
+			} ) };
+		Registrar const graphicsPipelineRaw{ "Pipeline/CreateGraphics/raw"
+			, repeat( []( Scene & scene )
+			{
+				auto createInfo = std::make_shared< ashes::GraphicsPipelineCreateInfo >( scene.context.getGraphicsPipelineCreateInfo( *scene.pipelineLayout ) );
+				return [&scene, createInfo]()
+				{
+					VkPipeline pipeline{};
+					scene.device.vkCreateGraphicsPipelines( scene.device
+						, VK_NULL_HANDLE
+						, 1u
+						, &static_cast< VkGraphicsPipelineCreateInfo const & >( *createInfo )
+						, nullptr
+						, &pipeline );
+					scene.device.vkDestroyPipeline( scene.device, pipeline, nullptr );
+				};
+			} ) };
+		Registrar const computePipelineAshespp{ "Pipeline/CreateCompute/ashespp"
+			, repeat( []( Scene & scene )
+			{
+				return [&scene, module = scene.context.createShaderModule( VK_SHADER_STAGE_COMPUTE_BIT )]()
+				{
+					auto pipeline = scene.device.createPipeline( ashes::ComputePipelineCreateInfo
+						{
+							0u,
+							ashes::PipelineShaderStageCreateInfo
+							{
+								0u,
+								VK_SHADER_STAGE_COMPUTE_BIT,
+								module,
+								"main",
+								ashes::nullopt,
+							},
+							*scene.pipelineLayout,
+						} );
+					doNotOptimise( pipeline );
+				};
+			} ) };
+
+		//*********************************************************************************************
+
+		ashes::DeviceMemoryPtr allocateHostVisible( ashes::Device const & device
+			, VkDeviceSize size )
+		{
+			return device.allocateMemory( VkMemoryAllocateInfo
+				{
+					VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+					nullptr,
+					size,
+					device.deduceMemoryType( ~( 0u ), VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT ),
+				} );
+		}
+
+		Registrar const mapAshespp{ "Memory/MapUnmap/ashespp"
+			, repeat( []( Scene & scene )
+			{
+				std::shared_ptr< ashes::DeviceMemory > memory{ allocateHostVisible( scene.device, 64u * 1024u ) };
+				return [memory]()
+				{
+					doNotOptimise( memory->lock( 0u, ashes::WholeSize, 0u ) );
+					memory->unlock();
+				};
+			} ) };
+		Registrar const mapRaw{ "Memory/MapUnmap/raw"
+			, repeat( []( Scene & scene )
+			{
+				std::shared_ptr< ashes::DeviceMemory > memory{ allocateHostVisible( scene.device, 64u * 1024u ) };
+				return [&scene, memory]()
+				{
+					void * data{};
+					scene.device.vkMapMemory( scene.device, *memory, 0u, VK_WHOLE_SIZE, 0u, &data );
+					doNotOptimise( data );
+					scene.device.vkUnmapMemory( scene.device, *memory );
+				};
+			} ) };
+		Registrar const allocateAshespp{ "Memory/AllocateFree/ashespp"
+			, repeat( []( Scene & scene )
+			{
+				return [&scene]()
+				{
+					doNotOptimise( allocateHostVisible( scene.device, 4096u ) );
+				};
+			} ) };
+		Registrar const allocateSuballocator{ "Memory/AllocateFree/allocator"
+			, repeat( []( Scene & scene )
+			{
+				return [&scene
+					, requirements = scene.vertexBuffer->getMemoryRequirements()]()
+				{
+					doNotOptimise( scene.context.getAllocator().allocate( requirements
+						, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT
+						, true ) );
+				};
+			} ) };
+	}
+}
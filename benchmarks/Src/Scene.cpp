@@ -0,0 +1,75 @@
+/*
+This file belongs to Ashes.
+See LICENSE file in root folder.
+*/
+#include "Scene.hpp"
+
+namespace bench
+{
+	namespace
+	{
+		ashes::BufferBasePtr createBuffer( Context & context
+			, VkDeviceSize size
+			, VkBufferUsageFlags usage )
+		{
+			auto result = context.getDevice().createBuffer( size, usage );
+			result->bindMemory( context.getAllocator().allocate( *result
+				, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT ) );
+			return result;
+		}
+	}
+
+	Scene::Scene( Context & context )
+		: context{ context }
+		, device{ context.getDevice() }
+		, vertexBuffer{ createBuffer( context
+			, 3u * 6u * sizeof( float )
+			, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT ) }
+		, uniformStride{ uint32_t( ashes::getAlignedSize( UniformSize
+			, device.getProperties().limits.minUniformBufferOffsetAlignment ) ) }
+		, uniformBuffer{ createBuffer( context
+			, 2u * uniformStride
+			, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT ) }
+		, descriptorLayout{ device.createDescriptorSetLayout( Context::getDescriptorBindings() ) }
+		, descriptorPool{ descriptorLayout->createPool( 1u ) }
+		, descriptorSet{ descriptorPool->createDescriptorSet( 0u ) }
+		, pipelineLayout{ device.createPipelineLayout( *descriptorLayout
+			, Context::getPushConstantRange() ) }
+		, pipeline{ device.createPipeline( context.getGraphicsPipelineCreateInfo( *pipelineLayout ) ) }
+		, commandBuffer{ context.getCommandPool().createCommandBuffer( VK_COMMAND_BUFFER_LEVEL_PRIMARY ) }
+	{
+		writeBindings();
+		descriptorSet->update();
+	}
+
+	void Scene::writeBindings()const
+	{
+		descriptorSet->createBinding( descriptorLayout->getBinding( 0u )
+			, context.getTextureView()
+			, context.getSampler() );
+		descriptorSet->createBinding( descriptorLayout->getBinding( 1u )
+			, *uniformBuffer
+			, 0u
+			, UniformSize );
+		descriptorSet->createBinding( descriptorLayout->getBinding( 2u )
+			, *uniformBuffer
+			, uniformStride
+			, UniformSize );
+	}
+
+	void Scene::beginBatch( VkCommandBufferUsageFlags flags )const
+	{
+		commandBuffer->begin( flags );
+		commandBuffer->beginRenderPass( context.getRenderPass()
+			, context.getFrameBuffer()
+			, {}
+			, VK_SUBPASS_CONTENTS_INLINE );
+		commandBuffer->bindPipeline( *pipeline );
+	}
+
+	void Scene::endBatch()const
+	{
+		commandBuffer->endRenderPass();
+		commandBuffer->end();
+	}
+}
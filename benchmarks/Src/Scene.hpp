@@ -0,0 +1,64 @@
+/*
+This file belongs to Ashes.
+See LICENSE file in root folder.
+*/
+#ifndef ___AshesBenchmarks_Scene_HPP___
+#define ___AshesBenchmarks_Scene_HPP___
+#pragma once
+
+#include "Context.hpp"
+
+#include <ashespp/Buffer/Buffer.hpp>
+#include <ashespp/Command/CommandBuffer.hpp>
+#include <ashespp/Descriptor/DescriptorSet.hpp>
+#include <ashespp/Descriptor/DescriptorSetLayout.hpp>
+#include <ashespp/Descriptor/DescriptorSetPool.hpp>
+#include <ashespp/Pipeline/GraphicsPipeline.hpp>
+#include <ashespp/Pipeline/PipelineLayout.hpp>
+
+namespace bench
+{
+	/**
+	*\brief
+	*	The objects used to record a typical draw: a graphics pipeline,
+	*	a vertex buffer, a descriptor set holding a texture and two uniform
+	*	buffer ranges, and push constants.
+	*/
+	struct Scene
+	{
+		// A mat4 per uniform buffer binding.
+		static uint32_t constexpr UniformSize = 16u * sizeof( float );
+		static uint32_t constexpr PushConstantsSize = 4u * sizeof( float );
+
+		explicit Scene( Context & context );
+		/**
+		*\brief
+		*	Begins the command buffer, and the render pass, and binds the pipeline.
+		*/
+		void beginBatch( VkCommandBufferUsageFlags flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT )const;
+		/**
+		*\brief
+		*	Ends the render pass and the command buffer.
+		*/
+		void endBatch()const;
+		/**
+		*\brief
+		*	Appends the texture and uniform buffers writes to the descriptor set.
+		*/
+		void writeBindings()const;
+
+		Context & context;
+		ashes::Device const & device;
+		ashes::BufferBasePtr vertexBuffer;
+		uint32_t uniformStride;
+		ashes::BufferBasePtr uniformBuffer;
+		ashes::DescriptorSetLayoutPtr descriptorLayout;
+		ashes::DescriptorSetPoolPtr descriptorPool;
+		ashes::DescriptorSetPtr descriptorSet;
+		ashes::PipelineLayoutPtr pipelineLayout;
+		ashes::GraphicsPipelinePtr pipeline;
+		ashes::CommandBufferPtr commandBuffer;
+	};
+}
+
+#endif
@@ -0,0 +1,150 @@
+/*
+This file belongs to Ashes.
+See LICENSE file in root folder.
+*/
+#include "Shaders.hpp"
+
+#include <stdexcept>
+
+namespace bench
+{
+	namespace
+	{
+		// test/23-SPIRVSpecialisationConstants/Shaders/offscreen.vert
+		uint32_t const VertexShader[]
+		{
+			0x07230203, 0x00010000, 0x00080001, 0x00000026, 0x00000000, 0x00020011, 0x00000001, 0x0006000b,
+			0x00000001, 0x4c534c47, 0x6474732e, 0x3035342e, 0x00000000, 0x0003000e, 0x00000000, 0x00000001,
+			0x0009000f, 0x00000000, 0x00000004, 0x6e69616d, 0x00000000, 0x0000000a, 0x0000001b, 0x00000022,
+			0x00000024, 0x00030003, 0x00000002, 0x000001c2, 0x00040005, 0x00000004, 0x6e69616d, 0x00000000,
+			0x00060005, 0x00000008, 0x505f6c67, 0x65567265, 0x78657472, 0x00000000, 0x00060006, 0x00000008,
+			0x00000000, 0x505f6c67, 0x7469736f, 0x006e6f69, 0x00030005, 0x0000000a, 0x00000000, 0x00040005,
+			0x0000000e, 0x7274614d, 0x00007869, 0x00070006, 0x0000000e, 0x00000000, 0x5078746d, 0x656a6f72,
+			0x6f697463, 0x0000006e, 0x00030005, 0x00000010, 0x00000000, 0x00040005, 0x00000014, 0x656a624f,
+			0x00007463, 0x00060006, 0x00000014, 0x00000000, 0x4d78746d, 0x6c65646f, 0x00000000, 0x00030005,
+			0x00000016, 0x00000000, 0x00050005, 0x0000001b, 0x69736f70, 0x6e6f6974, 0x00000000, 0x00060005,
+			0x00000022, 0x5f787476, 0x63786574, 0x64726f6f, 0x00000000, 0x00050005, 0x00000024, 0x63786574,
+			0x64726f6f, 0x00000000, 0x00050048, 0x00000008, 0x00000000, 0x0000000b, 0x00000000, 0x00030047,
+			0x00000008, 0x00000002, 0x00040048, 0x0000000e, 0x00000000, 0x00000005, 0x00050048, 0x0000000e,
+			0x00000000, 0x00000023, 0x00000000, 0x00050048, 0x0000000e, 0x00000000, 0x00000007, 0x00000010,
+			0x00030047, 0x0000000e, 0x00000002, 0x00040047, 0x00000010, 0x00000022, 0x00000000, 0x00040047,
+			0x00000010, 0x00000021, 0x00000001, 0x00040048, 0x00000014, 0x00000000, 0x00000005, 0x00050048,
+			0x00000014, 0x00000000, 0x00000023, 0x00000000, 0x00050048, 0x00000014, 0x00000000, 0x00000007,
+			0x00000010, 0x00030047, 0x00000014, 0x00000002, 0x00040047, 0x00000016, 0x00000022, 0x00000000,
+			0x00040047, 0x00000016, 0x00000021, 0x00000002, 0x00040047, 0x0000001b, 0x0000001e, 0x00000000,
+			0x00040047, 0x00000022, 0x0000001e, 0x00000000, 0x00040047, 0x00000024, 0x0000001e, 0x00000001,
+			0x00020013, 0x00000002, 0x00030021, 0x00000003, 0x00000002, 0x00030016, 0x00000006, 0x00000020,
+			0x00040017, 0x00000007, 0x00000006, 0x00000004, 0x0003001e, 0x00000008, 0x00000007, 0x00040020,
+			0x00000009, 0x00000003, 0x00000008, 0x0004003b, 0x00000009, 0x0000000a, 0x00000003, 0x00040015,
+			0x0000000b, 0x00000020, 0x00000001, 0x0004002b, 0x0000000b, 0x0000000c, 0x00000000, 0x00040018,
+			0x0000000d, 0x00000007, 0x00000004, 0x0003001e, 0x0000000e, 0x0000000d, 0x00040020, 0x0000000f,
+			0x00000002, 0x0000000e, 0x0004003b, 0x0000000f, 0x00000010, 0x00000002, 0x00040020, 0x00000011,
+			0x00000002, 0x0000000d, 0x0003001e, 0x00000014, 0x0000000d, 0x00040020, 0x00000015, 0x00000002,
+			0x00000014, 0x0004003b, 0x00000015, 0x00000016, 0x00000002, 0x00040020, 0x0000001a, 0x00000001,
+			0x00000007, 0x0004003b, 0x0000001a, 0x0000001b, 0x00000001, 0x00040020, 0x0000001e, 0x00000003,
+			0x00000007, 0x00040017, 0x00000020, 0x00000006, 0x00000002, 0x00040020, 0x00000021, 0x00000003,
+			0x00000020, 0x0004003b, 0x00000021, 0x00000022, 0x00000003, 0x00040020, 0x00000023, 0x00000001,
+			0x00000020, 0x0004003b, 0x00000023, 0x00000024, 0x00000001, 0x00050036, 0x00000002, 0x00000004,
+			0x00000000, 0x00000003, 0x000200f8, 0x00000005, 0x00050041, 0x00000011, 0x00000012, 0x00000010,
+			0x0000000c, 0x0004003d, 0x0000000d, 0x00000013, 0x00000012, 0x00050041, 0x00000011, 0x00000017,
+			0x00000016, 0x0000000c, 0x0004003d, 0x0000000d, 0x00000018, 0x00000017, 0x00050092, 0x0000000d,
+			0x00000019, 0x00000013, 0x00000018, 0x0004003d, 0x00000007, 0x0000001c, 0x0000001b, 0x00050091,
+			0x00000007, 0x0000001d, 0x00000019, 0x0000001c, 0x00050041, 0x0000001e, 0x0000001f, 0x0000000a,
+			0x0000000c, 0x0003003e, 0x0000001f, 0x0000001d, 0x0004003d, 0x00000020, 0x00000025, 0x00000024,
+			0x0003003e, 0x00000022, 0x00000025, 0x000100fd, 0x00010038,
+		};
+		// test/23-SPIRVSpecialisationConstants/Shaders/offscreen.frag
+		uint32_t const FragmentShader[]
+		{
+			0x07230203, 0x00010000, 0x00080001, 0x00000031, 0x00000000, 0x00020011, 0x00000001, 0x0006000b,
+			0x00000001, 0x4c534c47, 0x6474732e, 0x3035342e, 0x00000000, 0x0003000e, 0x00000000, 0x00000001,
+			0x0007000f, 0x00000004, 0x00000004, 0x6e69616d, 0x00000000, 0x0000001d, 0x0000002d, 0x00030010,
+			0x00000004, 0x00000007, 0x00030003, 0x00000002, 0x000001c2, 0x00040005, 0x00000004, 0x6e69616d,
+			0x00000000, 0x00060005, 0x00000007, 0x4f4c4f43, 0x495f5255, 0x5845444e, 0x00000000, 0x00040005,
+			0x00000010, 0x6f6c6f63, 0x00007275, 0x00050005, 0x0000001d, 0x5f6c7870, 0x6f6c6f63, 0x00007275,
+			0x00060005, 0x0000001f, 0x68737550, 0x736e6f43, 0x746e6174, 0x00000073, 0x00050006, 0x0000001f,
+			0x00000000, 0x6f6c6f63, 0x00007275, 0x00060005, 0x00000021, 0x68737570, 0x736e6f43, 0x746e6174,
+			0x00000073, 0x00050005, 0x00000029, 0x4370616d, 0x756f6c6f, 0x00000072, 0x00060005, 0x0000002d,
+			0x5f787476, 0x63786574, 0x64726f6f, 0x00000000, 0x00040047, 0x00000007, 0x00000001, 0x00000000,
+			0x00040047, 0x0000001d, 0x0000001e, 0x00000000, 0x00050048, 0x0000001f, 0x00000000, 0x00000023,
+			0x00000000, 0x00030047, 0x0000001f, 0x00000002, 0x00040047, 0x00000029, 0x00000022, 0x00000000,
+			0x00040047, 0x00000029, 0x00000021, 0x00000000, 0x00040047, 0x0000002d, 0x0000001e, 0x00000000,
+			0x00020013, 0x00000002, 0x00030021, 0x00000003, 0x00000002, 0x00040015, 0x00000006, 0x00000020,
+			0x00000001, 0x00040032, 0x00000006, 0x00000007, 0x00000000, 0x0004002b, 0x00000006, 0x00000008,
+			0x00000000, 0x00020014, 0x00000009, 0x00060034, 0x00000009, 0x0000000a, 0x000000aa, 0x00000007,
+			0x00000008, 0x00030016, 0x0000000d, 0x00000020, 0x00040017, 0x0000000e, 0x0000000d, 0x00000004,
+			0x00040020, 0x0000000f, 0x00000007, 0x0000000e, 0x0004002b, 0x0000000d, 0x00000011, 0x3f800000,
+			0x0004002b, 0x0000000d, 0x00000012, 0x00000000, 0x0007002c, 0x0000000e, 0x00000013, 0x00000011,
+			0x00000012, 0x00000012, 0x00000011, 0x0004002b, 0x00000006, 0x00000015, 0x00000001, 0x00060034,
+			0x00000009, 0x00000016, 0x000000aa, 0x00000007, 0x00000015, 0x0007002c, 0x0000000e, 0x00000019,
+			0x00000012, 0x00000011, 0x00000012, 0x00000011, 0x0007002c, 0x0000000e, 0x0000001b, 0x00000012,
+			0x00000012, 0x00000011, 0x00000011, 0x00040020, 0x0000001c, 0x00000003, 0x0000000e, 0x0004003b,
+			0x0000001c, 0x0000001d, 0x00000003, 0x0003001e, 0x0000001f, 0x0000000e, 0x00040020, 0x00000020,
+			0x00000009, 0x0000001f, 0x0004003b, 0x00000020, 0x00000021, 0x00000009, 0x00040020, 0x00000022,
+			0x00000009, 0x0000000e, 0x00090019, 0x00000026, 0x0000000d, 0x00000001, 0x00000000, 0x00000000,
+			0x00000000, 0x00000001, 0x00000000, 0x0003001b, 0x00000027, 0x00000026, 0x00040020, 0x00000028,
+			0x00000000, 0x00000027, 0x0004003b, 0x00000028, 0x00000029, 0x00000000, 0x00040017, 0x0000002b,
+			0x0000000d, 0x00000002, 0x00040020, 0x0000002c, 0x00000001, 0x0000002b, 0x0004003b, 0x0000002c,
+			0x0000002d, 0x00000001, 0x00050036, 0x00000002, 0x00000004, 0x00000000, 0x00000003, 0x000200f8,
+			0x00000005, 0x0004003b, 0x0000000f, 0x00000010, 0x00000007, 0x000300f7, 0x0000000c, 0x00000000,
+			0x000400fa, 0x0000000a, 0x0000000b, 0x00000014, 0x000200f8, 0x0000000b, 0x0003003e, 0x00000010,
+			0x00000013, 0x000200f9, 0x0000000c, 0x000200f8, 0x00000014, 0x000300f7, 0x00000018, 0x00000000,
+			0x000400fa, 0x00000016, 0x00000017, 0x0000001a, 0x000200f8, 0x00000017, 0x0003003e, 0x00000010,
+			0x00000019, 0x000200f9, 0x00000018, 0x000200f8, 0x0000001a, 0x0003003e, 0x00000010, 0x0000001b,
+			0x000200f9, 0x00000018, 0x000200f8, 0x00000018, 0x000200f9, 0x0000000c, 0x000200f8, 0x0000000c,
+			0x0004003d, 0x0000000e, 0x0000001e, 0x00000010, 0x00050041, 0x00000022, 0x00000023, 0x00000021,
+			0x00000008, 0x0004003d, 0x0000000e, 0x00000024, 0x00000023, 0x00050085, 0x0000000e, 0x00000025,
+			0x0000001e, 0x00000024, 0x0004003d, 0x00000027, 0x0000002a, 0x00000029, 0x0004003d, 0x0000002b,
+			0x0000002e, 0x0000002d, 0x00050057, 0x0000000e, 0x0000002f, 0x0000002a, 0x0000002e, 0x00050085,
+			0x0000000e, 0x00000030, 0x00000025, 0x0000002f, 0x0003003e, 0x0000001d, 0x00000030, 0x000100fd,
+			0x00010038,
+		};
+		// An empty compute shader, with a 1x1x1 local size.
+		uint32_t const ComputeShader[]
+		{
+			// Header: magic number, version 1.0, generator, bound, schema.
+			0x07230203, 0x00010000, 0x00000000, 0x00000006, 0x00000000,
+			// OpCapability Shader
+			0x00020011, 0x00000001,
+			// OpMemoryModel Logical GLSL450
+			0x0003000e, 0x00000000, 0x00000001,
+			// OpEntryPoint GLCompute %4 "main"
+			0x0005000f, 0x00000005, 0x00000004, 0x6e69616d, 0x00000000,
+			// OpExecutionMode %4 LocalSize 1 1 1
+			0x00060010, 0x00000004, 0x00000011, 0x00000001, 0x00000001, 0x00000001,
+			// %2 = OpTypeVoid
+			0x00020013, 0x00000002,
+			// %3 = OpTypeFunction %2
+			0x00030021, 0x00000003, 0x00000002,
+			// %4 = OpFunction %2 None %3
+			0x00050036, 0x00000002, 0x00000004, 0x00000000, 0x00000003,
+			// %5 = OpLabel
+			0x000200f8, 0x00000005,
+			// OpReturn
+			0x000100fd,
+			// OpFunctionEnd
+			0x00010038,
+		};
+
+		template< size_t SizeT >
+		ashes::UInt32Array toArray( uint32_t const ( & words )[SizeT] )
+		{
+			return ashes::UInt32Array( words, words + SizeT );
+		}
+	}
+
+	ashes::UInt32Array getShaderCode( VkShaderStageFlagBits stage )
+	{
+		switch ( stage )
+		{
+		case VK_SHADER_STAGE_VERTEX_BIT:
+			return toArray( VertexShader );
+		case VK_SHADER_STAGE_FRAGMENT_BIT:
+			return toArray( FragmentShader );
+		case VK_SHADER_STAGE_COMPUTE_BIT:
+			return toArray( ComputeShader );
+		default:
+			throw std::runtime_error{ "No benchmark shader for this stage" };
+		}
+	}
+}
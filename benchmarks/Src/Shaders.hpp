@@ -0,0 +1,27 @@
+/*
+This file belongs to Ashes.
+See LICENSE file in root folder.
+*/
+#ifndef ___AshesBenchmarks_Shaders_HPP___
+#define ___AshesBenchmarks_Shaders_HPP___
+#pragma once
+
+#include <ashes/ashes.hpp>
+
+namespace bench
+{
+	/**
+	*\brief
+	*	Retrieves the SPIR-V code embedded for given stage.
+	*\remarks
+	*	The vertex and fragment shaders are the offscreen ones from the
+	*	SPIRVSpecialisationConstants test: two uniform buffers (bindings 1 and 2),
+	*	a combined image sampler (binding 0), a vec4 push constant, a position
+	*	and a texcoord vertex input, and an int specialisation constant (id 0).
+	*	They are embedded, so that plugins compiling the shaders (gl, d3d11)
+	*	can run the benchmarks without any asset folder.
+	*/
+	ashes::UInt32Array getShaderCode( VkShaderStageFlagBits stage );
+}
+
+#endif
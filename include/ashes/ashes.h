@@ -160,10 +160,19 @@ extern "C"
 	typedef void( VKAPI_PTR * PFN_ashEnumeratePluginsDescriptions )( uint32_t *, AshPluginDescription * );
 	typedef VkResult( VKAPI_PTR * PFN_ashGetPluginDescription )( AshPluginDescription * );
 	typedef VkResult( VKAPI_PTR * PFN_ashSelectPlugin )( AshPluginDescription );
+	typedef VkResult( VKAPI_PTR * PFN_ashSelectPluginByName )( char const * );
 
 	Ashes_API void VKAPI_PTR ashEnumeratePluginsDescriptions( uint32_t * count
 		, AshPluginDescription * pDescriptions );
 	Ashes_API VkResult VKAPI_PTR ashSelectPlugin( AshPluginDescription description );
+	/**
+	*\brief
+	*	Selects a plugin from its name ("gl", "vk", "d3d11", "test", ...).
+	*\remarks
+	*	When called before any other Ashes function, only this plugin is loaded.
+	*	The ASHES_PLUGIN environment variable has the same effect.
+	*/
+	Ashes_API VkResult VKAPI_PTR ashSelectPluginByName( char const * name );
 	Ashes_API VkResult VKAPI_PTR ashGetCurrentPluginDescription( AshPluginDescription * description );
 
 #ifdef __cplusplus
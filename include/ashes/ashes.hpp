@@ -17,6 +17,7 @@ See LICENSE file in root folder.
 #include "common/FlagCombination.hpp"
 #include "common/Optional.hpp"
 #include "common/Signal.hpp"
+#include "common/SmallArray.hpp"
 #include "common/Format.hpp"
 
 #if defined( MemoryBarrier )
@@ -123,6 +124,21 @@ namespace ashes
 		return result;
 	}
 
+	/**
+	*\brief
+	*	Fills \p result with the Vulkan handles of \p input, without heap allocation
+	*	as long as \p input holds at most \p CountT elements.
+	*/
+	template< typename VkType, size_t CountT, typename LibType >
+	inline void fillVkArray( std::vector< std::reference_wrapper< LibType const > > const & input
+		, SmallArray< VkType, CountT > & result )
+	{
+		for ( auto const & element : input )
+		{
+			result.push_back( VkType( element.get() ) );
+		}
+	}
+
 	inline CharPtrArray convert( StringArray const & values )
 	{
 		CharPtrArray result;
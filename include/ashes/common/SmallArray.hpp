@@ -0,0 +1,178 @@
+/*
+This file belongs to Ashes.
+See LICENSE file in root folder
+*/
+#ifndef ___Ashes_common_SmallArray_HPP___
+#define ___Ashes_common_SmallArray_HPP___
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+namespace ashes
+{
+	/**
+	*\brief
+	*	Contiguous array that stores up to \p CountT elements inline,
+	*	and only falls back to heap storage beyond that.
+	*\remarks
+	*	Meant to be used as a local variable, to gather Vulkan handles
+	*	without touching the heap in per-frame paths.
+	*/
+	template< typename ValueT, size_t CountT = 8u >
+	class SmallArray
+	{
+	public:
+		using value_type = ValueT;
+		using reference = ValueT &;
+		using const_reference = ValueT const &;
+		using pointer = ValueT *;
+		using const_pointer = ValueT const *;
+		using iterator = pointer;
+		using const_iterator = const_pointer;
+
+	public:
+		SmallArray() = default;
+		SmallArray( SmallArray const & ) = delete;
+		SmallArray & operator=( SmallArray const & ) = delete;
+
+		explicit SmallArray( size_t size )
+		{
+			resize( size );
+		}
+
+		void resize( size_t size )
+		{
+			if ( size > CountT )
+			{
+				if ( m_heap.empty() )
+				{
+					// Leaving the inline storage, the current elements follow.
+					m_heap.reserve( size );
+					m_heap.assign( std::make_move_iterator( m_inline.begin() )
+						, std::make_move_iterator( m_inline.begin() + m_size ) );
+				}
+
+				m_heap.resize( size );
+				m_data = m_heap.data();
+			}
+			else
+			{
+				if ( !m_heap.empty() )
+				{
+					// Back to the inline storage, the remaining elements follow, and the heap block is freed.
+					std::move( m_heap.begin()
+						, m_heap.begin() + size
+						, m_inline.begin() );
+					std::vector< ValueT >{}.swap( m_heap );
+				}
+				else if ( size > m_size )
+				{
+					std::fill( m_inline.begin() + m_size
+						, m_inline.begin() + size
+						, ValueT{} );
+				}
+
+				m_data = m_inline.data();
+			}
+
+			m_size = size;
+		}
+
+		void push_back( ValueT const & value )
+		{
+			if ( m_size < CountT )
+			{
+				m_inline[m_size] = value;
+				m_data = m_inline.data();
+			}
+			else
+			{
+				if ( m_heap.empty() )
+				{
+					m_heap.reserve( 2u * CountT );
+					m_heap.assign( m_inline.begin(), m_inline.end() );
+				}
+
+				m_heap.push_back( value );
+				m_data = m_heap.data();
+			}
+
+			++m_size;
+		}
+
+		reference operator[]( size_t index )
+		{
+			assert( index < m_size );
+			return m_data[index];
+		}
+
+		const_reference operator[]( size_t index )const
+		{
+			assert( index < m_size );
+			return m_data[index];
+		}
+
+		bool empty()const noexcept
+		{
+			return m_size == 0u;
+		}
+
+		size_t size()const noexcept
+		{
+			return m_size;
+		}
+		/**
+		*\return
+		*	The elements buffer, \p nullptr if the array is empty.
+		*/
+		pointer data()noexcept
+		{
+			return empty()
+				? nullptr
+				: m_data;
+		}
+		/**
+		*\return
+		*	The elements buffer, \p nullptr if the array is empty.
+		*/
+		const_pointer data()const noexcept
+		{
+			return empty()
+				? nullptr
+				: m_data;
+		}
+
+		iterator begin()noexcept
+		{
+			return m_data;
+		}
+
+		const_iterator begin()const noexcept
+		{
+			return m_data;
+		}
+
+		iterator end()noexcept
+		{
+			return m_data + m_size;
+		}
+
+		const_iterator end()const noexcept
+		{
+			return m_data + m_size;
+		}
+
+	private:
+		std::array< ValueT, CountT > m_inline{};
+		std::vector< ValueT > m_heap;
+		ValueT * m_data{ m_inline.data() };
+		size_t m_size{ 0u };
+	};
+}
+
+#endif
@@ -487,6 +487,21 @@ namespace ashes
 		static VkStructureType constexpr TypeValue = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_INLINE_UNIFORM_BLOCK_CREATE_INFO_EXT;
 	};
 
+#endif
+#if VK_EXT_descriptor_indexing
+
+	template<>
+	struct VkStructureTypeTraits< VkDescriptorSetLayoutBindingFlagsCreateInfoEXT >
+	{
+		static VkStructureType constexpr TypeValue = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT;
+	};
+
+	template<>
+	struct VkStructureTypeTraits< VkDescriptorSetVariableDescriptorCountAllocateInfoEXT >
+	{
+		static VkStructureType constexpr TypeValue = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_VARIABLE_DESCRIPTOR_COUNT_ALLOCATE_INFO_EXT;
+	};
+
 #endif
 
 	template< typename T >
@@ -506,6 +521,20 @@ namespace ashes
 
 		return result;
 	}
+
+	template< typename T >
+	T const * tryFind( void const * next )
+	{
+		auto base = reinterpret_cast< VkBaseInStructure const * >( next );
+
+		while ( base
+			&& base->sType != VkStructureTypeTraits< T >::TypeValue )
+		{
+			base = base->pNext;
+		}
+
+		return reinterpret_cast< T const * >( base );
+	}
 }
 
 #endif
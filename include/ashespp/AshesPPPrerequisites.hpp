@@ -137,7 +137,11 @@ namespace ashes
 	class Image;
 	class Instance;
 	class IWindowHandle;
+	class LinearMemoryPool;
+	class MemoryAllocation;
+	class MemoryAllocator;
 	class PhysicalDevice;
+	class PipelineCache;
 	class PipelineLayout;
 	class PushConstantsBufferBase;
 	class QueryPool;
@@ -153,6 +157,7 @@ namespace ashes
 	class Surface;
 	class SwapChain;
 	class UniformBuffer;
+	class UploadRing;
 	class VertexBufferBase;
 
 	/**
@@ -186,7 +191,11 @@ namespace ashes
 	using ImagePtr = std::unique_ptr< Image >;
 	using InstancePtr = std::unique_ptr< Instance >;
 	using IWindowHandlePtr = std::unique_ptr< IWindowHandle >;
+	using LinearMemoryPoolPtr = std::unique_ptr< LinearMemoryPool >;
+	using MemoryAllocationPtr = std::unique_ptr< MemoryAllocation >;
+	using MemoryAllocatorPtr = std::unique_ptr< MemoryAllocator >;
 	using PhysicalDevicePtr = std::unique_ptr< PhysicalDevice >;
+	using PipelineCachePtr = std::unique_ptr< PipelineCache >;
 	using PipelineLayoutPtr = std::unique_ptr< PipelineLayout >;
 	using PipelineVertexInputStateCreateInfoPtr = std::unique_ptr< PipelineVertexInputStateCreateInfo >;
 	using PushConstantsBufferPtr = std::unique_ptr< PushConstantsBufferBase >;
@@ -201,6 +210,7 @@ namespace ashes
 	using SwapChainPtr = std::unique_ptr< SwapChain >;
 	using VertexBufferBasePtr = std::unique_ptr< VertexBufferBase >;
 	using UniformBufferPtr = std::unique_ptr< UniformBuffer >;
+	using UploadRingPtr = std::unique_ptr< UploadRing >;
 
 	using DevicePtr = std::shared_ptr< Device >;
 	using ShaderModulePtr = std::shared_ptr< ShaderModule >;
@@ -233,6 +243,7 @@ namespace ashes
 	using SurfaceCRef = std::reference_wrapper< Surface const >;
 	using ImageViewCRef = std::reference_wrapper< ImageView const >;
 	using VertexBufferCRef = std::reference_wrapper< VertexBufferBase const >;
+	using PipelineCacheCRef = std::reference_wrapper< PipelineCache const >;
 	using PipelineVertexInputStateCreateInfoCRef = std::reference_wrapper< PipelineVertexInputStateCreateInfo const >;
 
 	using BufferCRefArray = std::vector< BufferCRef >;
@@ -245,6 +256,7 @@ namespace ashes
 	using SwapChainCRefArray = std::vector< SwapChainCRef >;
 	using ImageViewCRefArray = std::vector< ImageViewCRef >;
 	using VertexBufferCRefArray = std::vector< VertexBufferCRef >;
+	using PipelineCacheCRefArray = std::vector< PipelineCacheCRef >;
 	using PipelineVertexInputStateCreateInfoCRefArray = std::vector< PipelineVertexInputStateCreateInfoCRef >;
 
 	struct DebugBlockInfo
@@ -7,7 +7,7 @@ See LICENSE file in root folder.
 #pragma once
 
 #include "ashespp/Core/Device.hpp"
-#include "ashespp/Miscellaneous/DeviceMemory.hpp"
+#include "ashespp/Miscellaneous/MemoryAllocator.hpp"
 #include "ashespp/Miscellaneous/QueueShare.hpp"
 
 #include <ashes/common/Exception.hpp>
@@ -75,6 +75,13 @@ namespace ashes
 		void bindMemory( DeviceMemoryPtr memory );
 		/**
 		*\brief
+		*	Binds this buffer to given memory allocation.
+		*\param[in] allocation
+		*	The allocation, from a MemoryAllocator or a LinearMemoryPool.
+		*/
+		void bindMemory( MemoryAllocationPtr allocation );
+		/**
+		*\brief
 		*	Maps a range of the buffer's memory in RAM.
 		*\param[in] offset
 		*	The range beginning offset.
@@ -224,7 +231,7 @@ namespace ashes
 		QueueShare m_sharingMode;
 		VkBufferCreateInfo m_createInfo;
 		VkBuffer m_internal{ VK_NULL_HANDLE };
-		DeviceMemoryPtr m_storage;
+		MemoryAllocationPtr m_storage;
 		mutable VkAccessFlags m_currentAccessFlags{ VK_ACCESS_MEMORY_WRITE_BIT };
 		mutable VkPipelineStageFlags m_compatibleStageFlags{ VK_PIPELINE_STAGE_HOST_BIT };
 	};
@@ -293,6 +300,16 @@ namespace ashes
 			m_buffer->bindMemory( std::move( memory ) );
 		}
 		/**
+		*\brief
+		*	Binds this buffer to given memory allocation.
+		*\param[in] allocation
+		*	The allocation.
+		*/
+		void bindMemory( MemoryAllocationPtr allocation )
+		{
+			m_buffer->bindMemory( std::move( allocation ) );
+		}
+		/**
 		*\return
 		*	The elements count.
 		*/
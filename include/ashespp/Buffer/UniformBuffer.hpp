@@ -41,6 +41,13 @@ namespace ashes
 		*/
 		void bindMemory( DeviceMemoryPtr memory );
 		/**
+		*\brief
+		*	Binds this buffer to given memory allocation.
+		*\param[in] allocation
+		*	The allocation.
+		*/
+		void bindMemory( MemoryAllocationPtr allocation );
+		/**
 		*\return
 		*	The memory requirements for this buffer.
 		*/
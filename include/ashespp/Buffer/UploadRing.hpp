@@ -0,0 +1,221 @@
+/*
+This file belongs to Ashes.
+See LICENSE file in root folder.
+*/
+#ifndef ___AshesPP_UploadRing_HPP___
+#define ___AshesPP_UploadRing_HPP___
+#pragma once
+
+#include "ashespp/Buffer/Buffer.hpp"
+
+namespace ashes
+{
+	/**
+	*\brief
+	*	Asynchronous uploader, suballocating from a persistently mapped ring buffer.
+	*\remarks
+	*	Uploads are recorded in a single command buffer per batch, which is submitted
+	*	by flush(), or when the ring runs out of space.
+	*	Ring regions are reclaimed when the fence of the batch using them is signaled.
+	*	Contrary to StagingBuffer, nothing waits unless the caller asks for it,
+	*	or the ring is full.
+	*/
+	class UploadRing
+	{
+	public:
+		/**
+		*\brief
+		*	Identifies the batch holding an upload, used to wait for its completion.
+		*/
+		struct Ticket
+		{
+			uint64_t batch{ 0u };
+		};
+
+	public:
+		/**
+		*\brief
+		*	Constructor.
+		*\param[in] device
+		*	The logical device.
+		*\param[in] queue
+		*	The queue used to submit the batches.
+		*\param[in] size
+		*	The ring buffer size.
+		*\param[in] batchCount
+		*	The maximum number of batches in flight.
+		*/
+		UploadRing( Device const & device
+			, Queue const & queue
+			, VkDeviceSize size = 64u * 1024u * 1024u
+			, uint32_t batchCount = 3u );
+		/**
+		*\brief
+		*	Destructor, waits for all pending uploads.
+		*/
+		~UploadRing();
+		/**
+		*\brief
+		*	Copies data into the ring, and records its transfer to given buffer.
+		*\param[in] data
+		*	The data to upload.
+		*\param[in] size
+		*	The data byte size.
+		*\param[in] offset
+		*	The byte offset in the destination buffer.
+		*\param[in] buffer
+		*	The destination buffer.
+		*\param[in] dstAccessFlags
+		*	The access flags for the buffer, after the upload.
+		*\param[in] dstStageFlags
+		*	The pipeline stages that will use the buffer, after the upload.
+		*\return
+		*	The ticket to wait for the upload completion.
+		*/
+		Ticket uploadBufferData( uint8_t const * const data
+			, VkDeviceSize size
+			, VkDeviceSize offset
+			, BufferBase const & buffer
+			, VkAccessFlags dstAccessFlags
+			, VkPipelineStageFlags dstStageFlags );
+		/**
+		*\brief
+		*	Copies data into the ring, and records its transfer to given buffer.
+		*\param[in] data
+		*	The data to upload.
+		*\param[in] offset
+		*	The offset, in elements, in the destination buffer.
+		*\param[in] buffer
+		*	The destination buffer.
+		*\param[in] dstAccessFlags
+		*	The access flags for the buffer, after the upload.
+		*\param[in] dstStageFlags
+		*	The pipeline stages that will use the buffer, after the upload.
+		*\return
+		*	The ticket to wait for the upload completion.
+		*/
+		template< typename T >
+		inline Ticket uploadBufferData( std::vector< T > const & data
+			, VkDeviceSize offset
+			, Buffer< T > const & buffer
+			, VkAccessFlags dstAccessFlags
+			, VkPipelineStageFlags dstStageFlags )
+		{
+			return uploadBufferData( reinterpret_cast< uint8_t const * >( data.data() )
+				, VkDeviceSize( data.size() * sizeof( T ) )
+				, VkDeviceSize( offset * sizeof( T ) )
+				, buffer.getBuffer()
+				, dstAccessFlags
+				, dstStageFlags );
+		}
+		/**
+		*\brief
+		*	Copies tightly packed texels into the ring, and records their transfer to given image region.
+		*\param[in] subresourceLayers
+		*	The destination mip level and layers.
+		*\param[in] format
+		*	The texels format.
+		*\param[in] offset
+		*	The destination region offset.
+		*\param[in] extent
+		*	The destination region extent.
+		*\param[in] data
+		*	The texels.
+		*\param[in] view
+		*	The destination image view.
+		*\param[in] dstStageFlags
+		*	The pipeline stages that will use the image, after the upload.
+		*\return
+		*	The ticket to wait for the upload completion.
+		*/
+		Ticket uploadTextureData( VkImageSubresourceLayers const & subresourceLayers
+			, VkFormat format
+			, VkOffset3D const & offset
+			, VkExtent3D const & extent
+			, uint8_t const * const data
+			, ImageView const & view
+			, VkPipelineStageFlags dstStageFlags );
+		/**
+		*\brief
+		*	Copies tightly packed texels into the ring, and records their transfer
+		*	to the whole base mip level of given view.
+		*\param[in] format
+		*	The texels format.
+		*\param[in] data
+		*	The texels.
+		*\param[in] view
+		*	The destination image view.
+		*\param[in] dstStageFlags
+		*	The pipeline stages that will use the image, after the upload.
+		*\return
+		*	The ticket to wait for the upload completion.
+		*/
+		Ticket uploadTextureData( VkFormat format
+			, uint8_t const * const data
+			, ImageView const & view
+			, VkPipelineStageFlags dstStageFlags );
+		/**
+		*\brief
+		*	Submits the batch being recorded, if any.
+		*\remarks
+		*	Meant to be called once per frame.
+		*\return
+		*	The ticket of the last submitted batch.
+		*/
+		Ticket flush();
+		/**
+		*\return
+		*	\p true if the batch identified by given ticket has completed.
+		*/
+		bool isComplete( Ticket const & ticket );
+		/**
+		*\brief
+		*	Waits for the batch identified by given ticket, submitting it if needed.
+		*/
+		void wait( Ticket const & ticket );
+		/**
+		*\brief
+		*	Submits the pending uploads and waits for all of them.
+		*/
+		void waitIdle();
+
+	private:
+		struct Batch
+		{
+			CommandBufferPtr commandBuffer;
+			FencePtr fence;
+			uint64_t id{ 0u };
+			uint64_t end{ 0u };
+		};
+
+		CommandBuffer const & doGetCommandBuffer();
+		VkDeviceSize doAllocate( VkDeviceSize size
+			, VkDeviceSize alignment );
+		void doCopy( uint8_t const * const data
+			, VkDeviceSize size
+			, VkDeviceSize offset );
+		void doSubmit();
+		void doRetire( uint64_t id );
+		void doPoll();
+
+	private:
+		Device const & m_device;
+		Queue const & m_queue;
+		VkDeviceSize m_size;
+		CommandPoolPtr m_commandPool;
+		BufferBasePtr m_buffer;
+		// Must be declared before m_storage, which initialises it.
+		bool m_coherent;
+		DeviceMemoryPtr m_storage;
+		uint8_t * m_mapped{ nullptr };
+		std::vector< Batch > m_batches;
+		Batch * m_recording{ nullptr };
+		uint64_t m_nextId{ 1u };
+		uint64_t m_completed{ 0u };
+		// Monotonic positions in the ring, the physical offset is the position modulo m_size.
+		uint64_t m_head{ 0u };
+		uint64_t m_tail{ 0u };
+	};
+}
+
+#endif
@@ -48,6 +48,13 @@ namespace ashes
 		*/
 		void bindMemory( DeviceMemoryPtr memory );
 		/**
+		*\brief
+		*	Binds this buffer to given memory allocation.
+		*\param[in] allocation
+		*	The allocation.
+		*/
+		void bindMemory( MemoryAllocationPtr allocation );
+		/**
 		*\name
 		*	Getters.
 		**/
@@ -149,6 +156,16 @@ namespace ashes
 		}
 		/**
 		*\brief
+		*	Binds this buffer to given memory allocation.
+		*\param[in] allocation
+		*	The allocation.
+		*/
+		inline void bindMemory( MemoryAllocationPtr allocation )
+		{
+			m_buffer->bindMemory( std::move( allocation ) );
+		}
+		/**
+		*\brief
 		*	Maps a range of the buffer's memory in RAM.
 		*\param[in] offset
 		*	The range elements beginning offset.
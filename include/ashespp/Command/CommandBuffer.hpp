@@ -224,7 +224,20 @@ namespace ashes
 		*/
 		void bindVertexBuffers( uint32_t firstBinding
 			, BufferCRefArray const & buffers
-			, UInt64Array offsets )const;
+			, UInt64Array const & offsets )const;
+		/**
+		*\brief
+		*	Binds vertex buffers to the command buffer, without allocation.
+		*\param[in] firstBinding
+		*	The index of the first vertex input binding whose state is updated by the command.
+		*\param[in] buffers
+		*	The array of buffer handles.
+		*\param[in] offsets
+		*	The array of buffer offsets.
+		*/
+		void bindVertexBuffers( uint32_t firstBinding
+			, ArrayView< VkBuffer const > buffers
+			, ArrayView< VkDeviceSize const > offsets )const;
 		/**
 		*\brief
 		*	Binds an index buffer to the command buffer.
@@ -256,6 +269,25 @@ namespace ashes
 			, VkPipelineBindPoint bindingPoint = VkPipelineBindPoint::VK_PIPELINE_BIND_POINT_GRAPHICS )const;
 		/**
 		*\brief
+		*	Binds descriptor sets to the command buffer, without allocation.
+		*\param[in] firstSet
+		*	The set number of the first descriptor set to be bound.
+		*\param[in] descriptorSets
+		*	The descriptor sets handles.
+		*\param[in] layout
+		*	The pipeline layout used to program the binding.
+		*\param[in] dynamicOffsets
+		*	The dynamic offsets for dynamic buffers.
+		*\param[in] bindingPoint
+		*	Indicates whether the descriptor wil be used by graphics or compute pipeline.
+		*/
+		void bindDescriptorSets( uint32_t firstSet
+			, ArrayView< VkDescriptorSet const > descriptorSets
+			, PipelineLayout const & layout
+			, ArrayView< uint32_t const > dynamicOffsets
+			, VkPipelineBindPoint bindingPoint = VkPipelineBindPoint::VK_PIPELINE_BIND_POINT_GRAPHICS )const;
+		/**
+		*\brief
 		*	Defines the currently bound pipeline viewport.
 		*\remarks
 		*	This action is possible only if the viewport is dynamic, in the pipeline.
@@ -268,6 +300,18 @@ namespace ashes
 			, VkViewportArray const & viewports )const;
 		/**
 		*\brief
+		*	Defines the currently bound pipeline viewport, without allocation.
+		*\remarks
+		*	This action is possible only if the viewport is dynamic, in the pipeline.
+		*\param[in] firstViewport
+		*	The first viewport index.
+		*\param[in] viewports
+		*	The viewports.
+		*/
+		void setViewport( uint32_t firstViewport
+			, ArrayView< VkViewport const > viewports )const;
+		/**
+		*\brief
 		*	Defines the currently bound pipeline viewport.
 		*\remarks
 		*	This action is possible only if the viewport is dynamic, in the pipeline.
@@ -276,7 +320,7 @@ namespace ashes
 		*/
 		inline void setViewport( VkViewport const & viewport )const
 		{
-			setViewport( 0u, VkViewportArray{ viewport } );
+			setViewport( 0u, ArrayView< VkViewport const >{ &viewport, &viewport + 1u } );
 		}
 		/**
 		*\brief
@@ -292,6 +336,18 @@ namespace ashes
 			, VkScissorArray const & scissors )const;
 		/**
 		*\brief
+		*	Defines the currently bound pipeline scissor, without allocation.
+		*\remarks
+		*	This action is possible only if the scissor is dynamic, in the pipeline.
+		*\param[in] firstScissor
+		*	The first scissor index.
+		*\param[in] scissors
+		*	The scissors.
+		*/
+		void setScissor( uint32_t firstScissor
+			, ArrayView< VkRect2D const > scissors )const;
+		/**
+		*\brief
 		*	Defines the currently bound pipeline scissor.
 		*\remarks
 		*	This action is possible only if the scissor is dynamic, in the pipeline.
@@ -300,7 +356,7 @@ namespace ashes
 		*/
 		inline void setScissor( VkRect2D const & scissor )const
 		{
-			setScissor( 0u, VkScissorArray{ scissor } );
+			setScissor( 0u, ArrayView< VkRect2D const >{ &scissor, &scissor + 1u } );
 		}
 		/**
 		*\brief
@@ -662,16 +718,10 @@ namespace ashes
 		*\param[in] bindingPoint
 		*	Indicates whether the descriptor wil be used by graphics or compute pipeline.
 		*/
-		inline void bindDescriptorSet( DescriptorSet const & descriptorSet
+		void bindDescriptorSet( DescriptorSet const & descriptorSet
 			, PipelineLayout const & layout
 			, UInt32Array const & dynamicOffsets
-			, VkPipelineBindPoint bindingPoint = VkPipelineBindPoint::VK_PIPELINE_BIND_POINT_GRAPHICS )const
-		{
-			bindDescriptorSets( DescriptorSetCRefArray{ descriptorSet }
-				, layout
-				, dynamicOffsets
-				, bindingPoint );
-		}
+			, VkPipelineBindPoint bindingPoint = VkPipelineBindPoint::VK_PIPELINE_BIND_POINT_GRAPHICS )const;
 		/**
 		*\brief
 		*	Binds a descriptor set to the command buffer.
@@ -682,15 +732,9 @@ namespace ashes
 		*\param[in] bindingPoint
 		*	Indicates whether the descriptor wil be used by graphics or compute pipeline.
 		*/
-		inline void bindDescriptorSet( DescriptorSet const & descriptorSet
+		void bindDescriptorSet( DescriptorSet const & descriptorSet
 			, PipelineLayout const & layout
-			, VkPipelineBindPoint bindingPoint = VkPipelineBindPoint::VK_PIPELINE_BIND_POINT_GRAPHICS )const
-		{
-			bindDescriptorSets( DescriptorSetCRefArray{ descriptorSet }
-				, layout
-				, UInt32Array{}
-				, bindingPoint );
-		}
+			, VkPipelineBindPoint bindingPoint = VkPipelineBindPoint::VK_PIPELINE_BIND_POINT_GRAPHICS )const;
 		/**
 		*\brief
 		*	Binds descriptor sets to the command buffer.
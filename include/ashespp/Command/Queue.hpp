@@ -44,6 +44,56 @@ namespace ashes
 			, Fence const * fence )const;
 		/**
 		*\brief
+		*	Submits given command buffers.
+		*\remarks
+		*	Doesn't allocate, meant for per-frame submissions.
+		*\param[in] commandBuffers
+		*	The command buffers.
+		*\param[in] semaphoresToWait
+		*	The semaphores to wait.
+		*\param[in] semaphoresStage
+		*	The semaphores respective stages.
+		*\param[in] semaphoresToSignal
+		*	The semaphores to signal.
+		*\param[in] fence
+		*	An optional fence.
+		*/
+		void submit( ArrayView< VkCommandBuffer const > commandBuffers
+			, ArrayView< VkSemaphore const > semaphoresToWait
+			, ArrayView< VkPipelineStageFlags const > semaphoresStage
+			, ArrayView< VkSemaphore const > semaphoresToSignal
+			, VkFence fence )const;
+		/**
+		*\brief
+		*	Submits given command buffer.
+		*\param[in] commandBuffer
+		*	The command buffer.
+		*\param[in] fence
+		*	An optional fence.
+		*/
+		void submit( CommandBuffer const & commandBuffer
+			, Fence const * fence )const;
+		/**
+		*\brief
+		*	Submits given command buffer.
+		*\param[in] commandBuffer
+		*	The command buffer.
+		*\param[in] semaphoreToWait
+		*	The semaphore to wait.
+		*\param[in] semaphoreStage
+		*	The semaphore respective stages.
+		*\param[in] semaphoreToSignal
+		*	The semaphore to signal.
+		*\param[in] fence
+		*	An optional fence.
+		*/
+		void submit( CommandBuffer const & commandBuffer
+			, Semaphore const & semaphoreToWait
+			, VkPipelineStageFlags const & semaphoreStage
+			, Semaphore const & semaphoreToSignal
+			, Fence const * fence )const;
+		/**
+		*\brief
 		*	Presents the swapchains.
 		*\param[in] swapChains
 		*	The swapchains.
@@ -59,6 +109,26 @@ namespace ashes
 			, SemaphoreCRefArray const & semaphoresToWait )const;
 		/**
 		*\brief
+		*	Presents the swapchains.
+		*\remarks
+		*	Doesn't allocate, meant for per-frame presentations.
+		*\param[in] swapChains
+		*	The swapchains.
+		*\param[in] imagesIndex
+		*	The image to present for each swapchain.
+		*\param[in] semaphoresToWait
+		*	The semaphores to wait.
+		*\param[out] results
+		*	Optional, receives the result for each swapchain presentation.
+		*\return
+		*	The global presentation result.
+		*/
+		VkResult present( ArrayView< VkSwapchainKHR const > swapChains
+			, ArrayView< uint32_t const > imagesIndex
+			, ArrayView< VkSemaphore const > semaphoresToWait
+			, VkResult * results = nullptr )const;
+		/**
+		*\brief
 		*	Presents a swapchain.
 		*\param[in] swapChain
 		*	The swapchain.
@@ -118,53 +188,6 @@ namespace ashes
 		}
 		/**
 		*\brief
-		*	Submits given command buffer.
-		*\param[in] commandBuffer
-		*	The command buffer.
-		*\param[in] fence
-		*	An optional fence.
-		*\return
-		*	\p true on ok.
-		*/
-		inline void submit( CommandBuffer const & commandBuffer
-			, Fence const * fence )const
-		{
-			submit( { commandBuffer }
-				, SemaphoreCRefArray{}
-				, VkPipelineStageFlagsArray{}
-				, SemaphoreCRefArray{}
-				, fence );
-		}
-		/**
-		*\brief
-		*	Submits given command buffer.
-		*\param[in] commandBuffer
-		*	The command buffer.
-		*\param[in] semaphoreToWait
-		*	The semaphore to wait.
-		*\param[in] semaphoreStage
-		*	The semaphore respective stages.
-		*\param[in] semaphoreToSignal
-		*	The semaphore to signal.
-		*\param[in] fence
-		*	An optional fence.
-		*\return
-		*	\p true on ok.
-		*/
-		inline void submit( CommandBuffer const & commandBuffer
-			, Semaphore const & semaphoreToWait
-			, VkPipelineStageFlags const & semaphoreStage
-			, Semaphore const & semaphoreToSignal
-			, Fence const * fence )const
-		{
-			submit( { commandBuffer }
-				, SemaphoreCRefArray{ semaphoreToWait }
-				, VkPipelineStageFlagsArray{ semaphoreStage }
-				, SemaphoreCRefArray{ semaphoreToSignal }
-				, fence );
-		}
-		/**
-		*\brief
 		*	VkQueue implicit cast operator.
 		*/
 		inline operator VkQueue const &()const
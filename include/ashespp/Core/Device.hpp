@@ -159,6 +159,34 @@ namespace ashes
 		ComputePipelinePtr createPipeline( ComputePipelineCreateInfo createInfo )const;
 		/**
 		*\brief
+		*	Creates a pipeline cache.
+		*\param[in] initialData
+		*	The previously retrieved cache data, discarded if it doesn't match this device.
+		*\return
+		*	The created cache.
+		*/
+		PipelineCachePtr createPipelineCache( ByteArray const & initialData = {} )const;
+		/**
+		*\brief
+		*	Creates a pipeline cache, from a file written by PipelineCache::save().
+		*\param[in] filePath
+		*	The file path, its content is ignored if it wasn't written for this device and driver.
+		*\return
+		*	The created cache.
+		*/
+		PipelineCachePtr createPipelineCache( std::string const & filePath )const;
+		/**
+		*\brief
+		*	Defines the cache used by the pipelines created without an explicit one.
+		*\param[in] cache
+		*	The cache, must outlive the pipelines creation.
+		*/
+		inline void setPipelineCache( VkPipelineCache cache )
+		{
+			m_pipelineCache = cache;
+		}
+		/**
+		*\brief
 		*	Creates a pipeline layout.
 		*\param[in] setLayouts
 		*	The descriptor sets layouts.
@@ -637,6 +665,11 @@ namespace ashes
 		{
 			return m_queueFamilyProperties;
 		}
+
+		inline VkPipelineCache getPipelineCache()const
+		{
+			return m_pipelineCache;
+		}
 		/**@}*/
 		/**
 		*\brief
@@ -662,6 +695,7 @@ namespace ashes
 		VkPhysicalDeviceProperties m_properties;
 		VkPhysicalDeviceFeatures m_features;
 		VkQueueFamilyPropertiesArray m_queueFamilyProperties;
+		VkPipelineCache m_pipelineCache{ VK_NULL_HANDLE };
 
 #ifndef NDEBUG
 		struct ObjectAllocation
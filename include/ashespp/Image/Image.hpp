@@ -7,7 +7,7 @@ See LICENSE file in root folder.
 #pragma once
 
 #include "ashespp/Image/ImageCreateInfo.hpp"
-#include "ashespp/Miscellaneous/DeviceMemory.hpp"
+#include "ashespp/Miscellaneous/MemoryAllocator.hpp"
 
 namespace ashes
 {
@@ -75,6 +75,13 @@ namespace ashes
 		void bindMemory( DeviceMemoryPtr memory );
 		/**
 		*\brief
+		*	Binds this image to given memory allocation.
+		*\param[in] allocation
+		*	The allocation, from a MemoryAllocator or a LinearMemoryPool.
+		*/
+		void bindMemory( MemoryAllocationPtr allocation );
+		/**
+		*\brief
 		*	Maps the buffer's memory in RAM.
 		*\param[in] offset
 		*	The memory mapping starting offset.
@@ -229,7 +236,7 @@ namespace ashes
 		Device const * m_device{ nullptr };
 		ImageCreateInfo m_createInfo{ 0u, VK_IMAGE_TYPE_2D, VK_FORMAT_UNDEFINED, { 1u, 1u, 1u }, 1u, 1u, VK_SAMPLE_COUNT_1_BIT, VK_IMAGE_TILING_OPTIMAL, 0u };
 		VkImage m_internal{ VK_NULL_HANDLE };
-		DeviceMemoryPtr m_storage;
+		MemoryAllocationPtr m_storage;
 		bool m_ownInternal{ true };
 		mutable std::map< VkImageView, std::unique_ptr< VkImageViewCreateInfo > > m_views;
 	};
@@ -63,6 +63,14 @@ namespace ashes
 		*/
 		void unlock()const;
 		/**
+		*\return
+		*	The memory object size.
+		*/
+		inline VkDeviceSize getSize()const
+		{
+			return m_allocateInfo.allocationSize;
+		}
+		/**
 		*\brief
 		*	Conversion implicite vers VkDeviceMemory.
 		*/
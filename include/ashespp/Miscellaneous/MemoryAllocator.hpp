@@ -0,0 +1,286 @@
+/*
+This file belongs to Ashes.
+See LICENSE file in root folder.
+*/
+#ifndef ___AshesPP_MemoryAllocator_HPP___
+#define ___AshesPP_MemoryAllocator_HPP___
+#pragma once
+
+#include "ashespp/Miscellaneous/DeviceMemory.hpp"
+
+#include <array>
+#include <functional>
+#include <mutex>
+
+namespace ashes
+{
+	/**
+	*\brief
+	*	Memory usage figures of a MemoryAllocator.
+	*/
+	struct MemoryStatistics
+	{
+		// Device memory objects holding suballocations.
+		uint32_t blockCount{ 0u };
+		// Device memory objects dedicated to a single resource.
+		uint32_t dedicatedCount{ 0u };
+		// Live suballocations.
+		uint32_t allocationCount{ 0u };
+		// Bytes reserved by the blocks.
+		VkDeviceSize blockBytes{ 0u };
+		// Bytes reserved by the dedicated allocations.
+		VkDeviceSize dedicatedBytes{ 0u };
+		// Bytes of the blocks used by live suballocations, rounding included.
+		VkDeviceSize usedBytes{ 0u };
+		// Bytes actually requested by live suballocations.
+		VkDeviceSize requestedBytes{ 0u };
+	};
+	/**
+	*\brief
+	*	A range of a device memory object, bound to a single resource.
+	*\remarks
+	*	Memory of host visible blocks is persistently mapped, since several
+	*	resources can share a block, and a device memory object can only
+	*	be mapped once at a time.
+	*/
+	class MemoryAllocation
+	{
+	public:
+		/**
+		*\brief
+		*	Constructor.
+		*\param[in] memory
+		*	The memory object.
+		*\param[in] offset
+		*	The range offset in the memory object.
+		*\param[in] size
+		*	The range size.
+		*\param[in] mapped
+		*	The persistent mapping of the memory object, if any.
+		*\param[in] release
+		*	Called on destruction to give the range back.
+		*/
+		MemoryAllocation( DeviceMemoryPtr memory
+			, VkDeviceSize offset
+			, VkDeviceSize size
+			, uint8_t * mapped = nullptr
+			, std::function< void() > release = nullptr );
+		~MemoryAllocation();
+		/**
+		*\brief
+		*	Maps a range of the allocation in RAM.
+		*\param[in] offset
+		*	The range beginning offset, relative to the allocation.
+		*\param[in] size
+		*	The range size.
+		*\param[in] flags
+		*	The mapping flags.
+		*\return
+		*	\p nullptr if mapping failed.
+		*/
+		uint8_t * lock( VkDeviceSize offset
+			, VkDeviceSize size
+			, VkMemoryMapFlags flags )const;
+		/**
+		*\brief
+		*	Invalidates a range of the allocation.
+		*\param[in] offset
+		*	The range beginning offset, relative to the allocation.
+		*\param[in] size
+		*	The range size.
+		*/
+		void invalidate( VkDeviceSize offset
+			, VkDeviceSize size )const;
+		/**
+		*\brief
+		*	Flushes a range of the allocation.
+		*\param[in] offset
+		*	The range beginning offset, relative to the allocation.
+		*\param[in] size
+		*	The range size.
+		*/
+		void flush( VkDeviceSize offset
+			, VkDeviceSize size )const;
+		/**
+		*\brief
+		*	Unmaps the allocation.
+		*/
+		void unlock()const;
+
+		inline DeviceMemory const & getMemory()const
+		{
+			return *m_memory;
+		}
+
+		inline VkDeviceSize getOffset()const
+		{
+			return m_offset;
+		}
+
+		inline VkDeviceSize getSize()const
+		{
+			return m_size;
+		}
+
+	private:
+		VkDeviceSize doGetSize( VkDeviceSize offset
+			, VkDeviceSize size )const;
+
+	private:
+		DeviceMemoryPtr m_memory;
+		VkDeviceSize m_offset;
+		VkDeviceSize m_size;
+		uint8_t * m_mapped;
+		std::function< void() > m_release;
+	};
+	/**
+	*\brief
+	*	Bump allocator over a single device memory object, for transient resources.
+	*\remarks
+	*	Allocations are never given back one by one, reset() recycles the whole pool
+	*	once the user knows the device doesn't use its resources anymore.
+	*/
+	class LinearMemoryPool
+	{
+	public:
+		LinearMemoryPool( Device const & device
+			, uint32_t memoryTypeIndex
+			, VkDeviceSize size );
+		~LinearMemoryPool();
+		/**
+		*\return
+		*	The allocation, \p nullptr if the pool is full or the memory type doesn't match.
+		*/
+		MemoryAllocationPtr allocate( VkMemoryRequirements const & requirements );
+		/**
+		*\brief
+		*	Makes the whole pool available again.
+		*/
+		void reset();
+
+		inline VkDeviceSize getUsedSize()const
+		{
+			return m_head;
+		}
+
+		inline VkDeviceSize getSize()const
+		{
+			return m_size;
+		}
+
+	private:
+		uint32_t m_memoryTypeIndex;
+		VkDeviceSize m_size;
+		VkDeviceSize m_atomSize;
+		DeviceMemoryPtr m_memory;
+		uint8_t * m_mapped{ nullptr };
+		VkDeviceSize m_head{ 0u };
+	};
+	/**
+	*\brief
+	*	General purpose device memory allocator.
+	*\remarks
+	*	Small resources are suballocated, using a buddy allocator, from large blocks,
+	*	pooled per memory type and per resource kind (linear or optimal) to honour
+	*	bufferImageGranularity.
+	*	Resources larger than the dedicated threshold get their own memory object.
+	*/
+	class MemoryAllocator
+	{
+	public:
+		/**
+		*\brief
+		*	Constructor.
+		*\param[in] device
+		*	The logical device.
+		*\param[in] blockSize
+		*	The preferred size of the blocks, rounded to a power of two,
+		*	and reduced for small heaps.
+		*\param[in] dedicatedThreshold
+		*	The size from which a resource gets a dedicated memory object.
+		*/
+		MemoryAllocator( Device const & device
+			, VkDeviceSize blockSize = 64u * 1024u * 1024u
+			, VkDeviceSize dedicatedThreshold = 16u * 1024u * 1024u );
+		~MemoryAllocator();
+		/**
+		*\brief
+		*	Allocates memory matching given requirements.
+		*\param[in] requirements
+		*	The resource memory requirements.
+		*\param[in] flags
+		*	The wanted memory properties.
+		*\param[in] linear
+		*	\p true for buffers and linear images, \p false for optimal images.
+		*/
+		MemoryAllocationPtr allocate( VkMemoryRequirements const & requirements
+			, VkMemoryPropertyFlags flags
+			, bool linear );
+		/**
+		*\brief
+		*	Allocates memory for given buffer, which must then be bound to it.
+		*/
+		MemoryAllocationPtr allocate( BufferBase const & buffer
+			, VkMemoryPropertyFlags flags );
+		/**
+		*\brief
+		*	Allocates memory for given image, which must then be bound to it.
+		*/
+		MemoryAllocationPtr allocate( Image const & image
+			, VkMemoryPropertyFlags flags );
+		/**
+		*\brief
+		*	Allocates a memory object for a single resource.
+		*/
+		MemoryAllocationPtr allocateDedicated( VkMemoryRequirements const & requirements
+			, VkMemoryPropertyFlags flags );
+		/**
+		*\brief
+		*	Creates a linear pool for transient resources.
+		*\param[in] size
+		*	The pool size.
+		*\param[in] memoryTypeBits
+		*	The memory types supported by the resources that will live in the pool.
+		*\param[in] flags
+		*	The wanted memory properties.
+		*/
+		LinearMemoryPoolPtr createLinearPool( VkDeviceSize size
+			, uint32_t memoryTypeBits
+			, VkMemoryPropertyFlags flags )const;
+		/**
+		*\brief
+		*	Frees the blocks that don't hold any allocation anymore.
+		*/
+		void trim();
+		/**
+		*\return
+		*	The statistics for all memory types.
+		*/
+		MemoryStatistics getStatistics()const;
+		/**
+		*\return
+		*	The statistics for given memory type.
+		*/
+		MemoryStatistics getStatistics( uint32_t memoryTypeIndex )const;
+
+	private:
+		class Block;
+		using BlockPtr = std::shared_ptr< Block >;
+		struct State
+		{
+			std::mutex mutex;
+			std::array< MemoryStatistics, VK_MAX_MEMORY_TYPES > statistics;
+		};
+		using StatePtr = std::shared_ptr< State >;
+
+	private:
+		Device const & m_device;
+		VkDeviceSize m_blockSize;
+		VkDeviceSize m_dedicatedThreshold;
+		StatePtr m_state;
+		// Indexed by memory type index * 2 + ( linear ? 1 : 0 ).
+		std::array< std::vector< BlockPtr >, VK_MAX_MEMORY_TYPES * 2u > m_pools;
+	};
+}
+
+#endif
@@ -40,6 +40,7 @@ namespace ashes
 
 		ComputePipelineCreateInfo( ComputePipelineCreateInfo && rhs )noexcept
 			: stage{ std::move( rhs.stage ) }
+			, pipelineCache{ rhs.pipelineCache }
 			, vk
 			{
 				VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
@@ -56,6 +57,7 @@ namespace ashes
 		ComputePipelineCreateInfo & operator=( ComputePipelineCreateInfo && rhs )noexcept
 		{
 			stage = std::move( rhs.stage );
+			pipelineCache = rhs.pipelineCache;
 			vk =
 			{
 				VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
@@ -76,6 +78,8 @@ namespace ashes
 		}
 
 		PipelineShaderStageCreateInfo stage;
+		// The cache used to create the pipeline, the device's default one if null.
+		VkPipelineCache pipelineCache{ VK_NULL_HANDLE };
 
 	private:
 		VkComputePipelineCreateInfo vk;
@@ -99,6 +99,7 @@ namespace ashes
 			, depthStencilState{ std::move( rhs.depthStencilState ) }
 			, colorBlendState{ std::move( rhs.colorBlendState ) }
 			, dynamicState{ std::move( rhs.dynamicState ) }
+			, pipelineCache{ rhs.pipelineCache }
 			, vkStages{ makeVkArray< VkPipelineShaderStageCreateInfo >( stages ) }
 			, vk
 			{
@@ -143,6 +144,7 @@ namespace ashes
 			depthStencilState = std::move( rhs.depthStencilState );
 			colorBlendState = std::move( rhs.colorBlendState );
 			dynamicState = std::move( rhs.dynamicState );
+			pipelineCache = rhs.pipelineCache;
 			vkStages = makeVkArray< VkPipelineShaderStageCreateInfo >( stages );
 			vk =
 			{
@@ -191,6 +193,8 @@ namespace ashes
 		Optional< PipelineDepthStencilStateCreateInfo > depthStencilState;
 		PipelineColorBlendStateCreateInfo colorBlendState;
 		Optional< PipelineDynamicStateCreateInfo > dynamicState;
+		// The cache used to create the pipeline, the device's default one if null.
+		VkPipelineCache pipelineCache{ VK_NULL_HANDLE };
 
 	private:
 		VkPipelineShaderStageCreateInfoArray vkStages;
@@ -0,0 +1,102 @@
+/*
+This file belongs to Ashes.
+See LICENSE file in root folder.
+*/
+#ifndef ___AshesPP_PipelineCache_HPP___
+#define ___AshesPP_PipelineCache_HPP___
+#pragma once
+
+#include "ashespp/AshesPPPrerequisites.hpp"
+
+#include <string>
+
+namespace ashes
+{
+	/**
+	*\brief
+	*	A pipeline cache, allowing pipeline creation to reuse the results
+	*	of previous compilations, possibly from an earlier run.
+	*\remarks
+	*	The cache data is only reused if it was created by the same driver,
+	*	on the same device.
+	*/
+	class PipelineCache
+	{
+	public:
+		/**
+		*\brief
+		*	Constructor.
+		*\param[in] device
+		*	The parent logical device.
+		*\param[in] initialData
+		*	The previously retrieved cache data, discarded if it doesn't
+		*	match the device.
+		*/
+		PipelineCache( Device const & device
+			, ByteArray const & initialData = {} );
+		/**
+		*\brief
+		*	Destructor.
+		*/
+		~PipelineCache();
+		/**
+		*\return
+		*	The cache data.
+		*/
+		ByteArray getData()const;
+		/**
+		*\brief
+		*	Merges the content of other caches into this one.
+		*\param[in] caches
+		*	The source caches.
+		*/
+		void merge( PipelineCacheCRefArray const & caches )const;
+		/**
+		*\brief
+		*	Writes the cache data to a file, preceded by a header identifying
+		*	the device and the driver that produced it.
+		*\param[in] filePath
+		*	The file path.
+		*\return
+		*	\p false if the file could not be written.
+		*/
+		bool save( std::string const & filePath )const;
+		/**
+		*\brief
+		*	Reads cache data written by save().
+		*\param[in] properties
+		*	The properties of the device that will use the cache.
+		*\param[in] filePath
+		*	The file path.
+		*\return
+		*	The cache data, empty if the file doesn't exist,
+		*	or if it was written for another device or driver.
+		*/
+		static ByteArray load( VkPhysicalDeviceProperties const & properties
+			, std::string const & filePath );
+		/**
+		*\brief
+		*	Checks that cache data was produced by given device.
+		*\param[in] properties
+		*	The device properties.
+		*\param[in] data
+		*	The cache data, as returned by getData().
+		*/
+		static bool isCompatible( VkPhysicalDeviceProperties const & properties
+			, ByteArray const & data );
+		/**
+		*\brief
+		*	VkPipelineCache implicit cast operator.
+		*/
+		inline operator VkPipelineCache const & ()const
+		{
+			return m_internal;
+		}
+
+	private:
+		Device const & m_device;
+		VkPipelineCache m_internal{ VK_NULL_HANDLE };
+	};
+}
+
+#endif
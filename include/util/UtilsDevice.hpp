@@ -11,6 +11,8 @@ See LICENSE file in root folder.
 #include <ashespp/Buffer/VertexBuffer.hpp>
 #include <ashespp/Core/Device.hpp>
 #include <ashespp/Image/ImageCreateInfo.hpp>
+#include <ashespp/Miscellaneous/MemoryAllocator.hpp>
+#include <ashespp/Pipeline/PipelineCache.hpp>
 
 namespace utils
 {
@@ -25,8 +27,30 @@ namespace utils
 	class Device
 	{
 	public:
+		/**
+		*\~english
+		*\brief
+		*	Constructor.
+		*\param[in] instance
+		*	The instance.
+		*\param[in] surface
+		*	The presentation surface.
+		*\param[in] pipelineCachePath
+		*	The file the pipeline cache is loaded from and saved to, no cache if empty.
+		*\~french
+		*\brief
+		*	Constructeur.
+		*\param[in] instance
+		*	L'instance.
+		*\param[in] surface
+		*	La surface de présentation.
+		*\param[in] pipelineCachePath
+		*	Le fichier depuis lequel le cache de pipelines est chargé, et dans lequel il est sauvegardé, pas de cache si vide.
+		*/
 		Device( ashes::Instance const & instance
-			, ashes::Surface const & surface );
+			, ashes::Surface const & surface
+			, std::string pipelineCachePath = {} );
+		~Device();
 		/**
 		*\~english
 		*\brief
@@ -123,6 +147,11 @@ namespace utils
 			return *m_device;
 		}
 
+		inline ashes::MemoryAllocator & getAllocator()const
+		{
+			return *m_allocator;
+		}
+
 		inline uint32_t getPresentQueueFamily()const
 		{
 			return m_presentQueueFamilyIndex;
@@ -146,6 +175,9 @@ namespace utils
 		VkPhysicalDeviceMemoryProperties m_memoryProperties;
 		ashes::DeviceCreateInfo m_createInfos;
 		ashes::DevicePtr m_device;
+		std::string m_pipelineCachePath;
+		ashes::PipelineCachePtr m_pipelineCache;
+		ashes::MemoryAllocatorPtr m_allocator;
 	};
 
 	using DevicePtr = std::unique_ptr< Device >;
@@ -160,8 +192,7 @@ namespace utils
 			, count
 			, usage );
 		auto requirements = result->getMemoryRequirements();
-		auto deduced = device.deduceMemoryType( requirements.memoryTypeBits, flags );
-		result->bindMemory( device.getDevice().allocateMemory( { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO, 0u, requirements.size, deduced } ) );
+		result->bindMemory( device.getAllocator().allocate( requirements, flags, true ) );
 		return result;
 	}
 
@@ -175,8 +206,7 @@ namespace utils
 			, count
 			, usage );
 		auto requirements = result->getMemoryRequirements();
-		auto deduced = device.deduceMemoryType( requirements.memoryTypeBits, flags );
-		result->bindMemory( device.getDevice().allocateMemory( { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO, 0u, requirements.size, deduced } ) );
+		result->bindMemory( device.getAllocator().allocate( requirements, flags, true ) );
 		return result;
 	}
 
@@ -191,8 +221,7 @@ namespace utils
 			, elemSize
 			, usage );
 		auto requirements = result->getMemoryRequirements();
-		auto deduced = device.deduceMemoryType( requirements.memoryTypeBits, flags );
-		result->bindMemory( device.getDevice().allocateMemory( { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO, 0u, requirements.size, deduced } ) );
+		result->bindMemory( device.getAllocator().allocate( requirements, flags, true ) );
 		return result;
 	}
 }
@@ -9,11 +9,11 @@
 #include <algorithm>
 #include <cassert>
 #include <cstring>
-#include <functional>
 #include <iostream>
 #include <memory>
 #include <regex>
 #include <set>
+#include <string>
 #include <vector>
 
 struct Plugin
@@ -58,28 +58,40 @@ using PluginArray = std::vector< Plugin >;
 namespace details
 {
 	Plugin * findFirstSupportedPlugin( PluginArray & plugins );
+	Plugin * findPlugin( PluginArray & plugins
+		, std::string const & name );
+	/**
+	*\brief
+	*	Loads and probes every available plugin, and updates the probe cache.
+	*/
 	PluginArray listPlugins();
+	/**
+	*\brief
+	*	Loads only the plugins needed to select one.
+	*\remarks
+	*	If ASHES_PLUGIN environment variable is set, only the matching plugin is loaded.
+	*	Otherwise, if the probe cache is still valid, only the best cached plugin is loaded.
+	*	Falls back to listPlugins().
+	*\param[out] complete
+	*	Receives \p false if some available plugins were not loaded.
+	*/
+	PluginArray listPluginsLazy( bool & complete );
+	/**
+	*\brief
+	*	Loads only the plugin matching given name (case insensitive).
+	*/
+	PluginArray listNamedPlugins( std::string const & name );
 }
 
 struct PluginLibrary
 {
-	inline PluginLibrary()
-	{
-		getSelectedDesc = [this]() -> AshPluginDescription &
-		{
-			auto res = init();
-			assert( res == VK_SUCCESS );
-			return getSelectedDesc();
-		};
-	}
-
 	inline VkResult init()
 	{
 		VkResult result = VK_SUCCESS;
 
 		if ( !selectedPlugin )
 		{
-			plugins = details::listPlugins();
+			plugins = details::listPluginsLazy( complete );
 
 			if ( plugins.empty() )
 			{
@@ -88,22 +100,47 @@ struct PluginLibrary
 			else
 			{
 				selectedPlugin = details::findFirstSupportedPlugin( plugins );
-				result = VK_SUCCESS;
+				result = selectedPlugin
+					? VK_SUCCESS
+					: VK_ERROR_INCOMPATIBLE_DRIVER;
+				doUpdateDispatch();
 			}
-
-			getSelectedDesc = [this]() -> AshPluginDescription &
-			{
-				return selectedPlugin->description;
-			};
 		}
 
 		return result;
 	}
 
+	inline AshPluginDescription & getSelectedDesc()
+	{
+		auto res = init();
+		assert( res == VK_SUCCESS );
+		return selectedPlugin->description;
+	}
+	/**
+	*\brief
+	*	Retrieves the dispatch table, making sure the plugins are loaded.
+	*\remarks
+	*	Only meant for the global functions, which can be called before any instance exists.
+	*/
+	inline AshPluginStaticFunction const & getGlobalFunctions()
+	{
+		auto res = init();
+		assert( res == VK_SUCCESS );
+		return functions;
+	}
+
+	inline PluginArray const & getPlugins()
+	{
+		init();
+		doEnsureComplete();
+		return plugins;
+	}
+
 	inline VkResult selectDesc( AshPluginDescription const & description )
 	{
 		auto res = init();
 		assert( res == VK_SUCCESS );
+		doEnsureComplete();
 		auto it = std::find_if( plugins.begin()
 			, plugins.end()
 			, [&description]( Plugin const & lookup )
@@ -117,11 +154,86 @@ struct PluginLibrary
 		}
 
 		selectedPlugin = &( *it );
+		doUpdateDispatch();
 		return VK_SUCCESS;
 	}
 
-	using SelectedDescGetter = std::function< AshPluginDescription & () >;
+	inline VkResult selectName( std::string const & name )
+	{
+		if ( !selectedPlugin )
+		{
+			// Nothing loaded yet, hence only load the requested plugin.
+			plugins = details::listNamedPlugins( name );
+			complete = true;
+			selectedPlugin = details::findPlugin( plugins, name );
+		}
+		else
+		{
+			auto plugin = details::findPlugin( plugins, name );
+
+			if ( !plugin && !complete )
+			{
+				doEnsureComplete();
+				plugin = details::findPlugin( plugins, name );
+			}
+
+			if ( plugin )
+			{
+				selectedPlugin = plugin;
+			}
+			else
+			{
+				return VK_ERROR_INITIALIZATION_FAILED;
+			}
+		}
+
+		doUpdateDispatch();
+		return selectedPlugin
+			? VK_SUCCESS
+			: VK_ERROR_INITIALIZATION_FAILED;
+	}
+
 	PluginArray plugins;
 	Plugin * selectedPlugin{ nullptr };
-	SelectedDescGetter getSelectedDesc;
+	// false when only a part of the available plugins has been loaded.
+	bool complete{ true };
+	// Flat copy of the selected plugin's functions, resolved once at plugin selection,
+	// so that the exported entry points only pay for an indirect call.
+	AshPluginStaticFunction functions{};
+
+private:
+	inline void doEnsureComplete()
+	{
+		if ( complete )
+		{
+			return;
+		}
+
+		// The libraries already loaded stay loaded while the full list is built,
+		// so the currently selected plugin's functions remain valid.
+		std::string selectedPath = selectedPlugin
+			? selectedPlugin->library->getPath()
+			: std::string{};
+		auto all = details::listPlugins();
+		plugins = std::move( all );
+		complete = true;
+		auto it = std::find_if( plugins.begin()
+			, plugins.end()
+			, [&selectedPath]( Plugin const & lookup )
+			{
+				return lookup.library->getPath() == selectedPath;
+			} );
+		selectedPlugin = it != plugins.end()
+			? &( *it )
+			: details::findFirstSupportedPlugin( plugins );
+		doUpdateDispatch();
+	}
+
+	inline void doUpdateDispatch()
+	{
+		if ( selectedPlugin )
+		{
+			functions = selectedPlugin->description.functions;
+		}
+	}
 };
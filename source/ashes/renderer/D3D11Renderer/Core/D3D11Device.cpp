@@ -164,10 +164,27 @@ namespace ashes::d3d11
 				VK_BORDER_COLOR_FLOAT_OPAQUE_BLACK,
 				VK_FALSE,
 			} );
+		m_inlineUbos = std::make_unique< InlineUboAllocator >( get( this )
+			, Instance::getMemoryProperties()
+			, getLimits().minUniformBufferOffsetAlignment
+			, InlineUboFunctions
+			{
+				ashes::d3d11::vkCreateBuffer,
+				ashes::d3d11::vkDestroyBuffer,
+				ashes::d3d11::vkGetBufferMemoryRequirements,
+				ashes::d3d11::vkAllocateMemory,
+				ashes::d3d11::vkFreeMemory,
+				ashes::d3d11::vkBindBufferMemory,
+				ashes::d3d11::vkMapMemory,
+				ashes::d3d11::vkFlushMappedMemoryRanges,
+				ashes::d3d11::vkUnmapMemory,
+			} );
 	}
 
 	Device::~Device()
 	{
+		m_inlineUbos.reset();
+
 		for ( auto creates : m_queues )
 		{
 			for ( auto queue : creates.second.queues )
@@ -9,6 +9,8 @@ See LICENSE file in root folder
 #include "renderer/D3D11Renderer/Buffer/D3D11Buffer.hpp"
 #include "renderer/D3D11Renderer/Core/D3D11Surface.hpp"
 
+#include <renderer/RendererCommon/InlineUniformBlocks.hpp>
+
 namespace ashes::d3d11
 {
 	VkExtent3D getTexelBlockExtent( VkFormat format );
@@ -116,6 +118,11 @@ namespace ashes::d3d11
 			return m_sampler;
 		}
 
+		inline InlineUboAllocator & getInlineUboAllocator()const
+		{
+			return *m_inlineUbos;
+		}
+
 #if !defined( NDEBUG )
 
 		inline ID3D11Debug * getDebug()
@@ -160,5 +167,6 @@ namespace ashes::d3d11
 		Buffer m_dummyIndexed;
 		VkSampler m_sampler;
 		std::unordered_map< size_t, std::pair< VkImage, VkDeviceMemory > > m_stagingTextures;
+		InlineUboAllocatorPtr m_inlineUbos;
 	};
 }
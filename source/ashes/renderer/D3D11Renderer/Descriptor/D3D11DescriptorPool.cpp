@@ -19,7 +19,7 @@ namespace ashes::d3d11
 
 	DescriptorPool::~DescriptorPool()
 	{
-		for ( auto & set : m_sets )
+		for ( auto & set : m_allSets )
 		{
 			deallocate( set, nullptr );
 		}
@@ -59,6 +59,9 @@ namespace ashes::d3d11
 
 				if ( it != m_sets.end() )
 				{
+					m_allSets.erase( std::find( m_allSets.begin()
+						, m_allSets.end()
+						, set ) );
 					deallocate( *it, nullptr );
 					m_sets.erase( it );
 				}
@@ -12,6 +12,8 @@
 
 #include <ashes/common/VkTypeTraits.hpp>
 
+#include <algorithm>
+
 namespace ashes::d3d11
 {
 	DescriptorSet::DescriptorSet( VkDevice device
@@ -91,17 +93,25 @@ namespace ashes::d3d11
 			} );
 	}
 
-	DescriptorSet::~DescriptorSet()
+	void DescriptorSet::mergeWrites( LayoutBindingWrites & writes, VkWriteDescriptorSet const & write )
 	{
-		for ( auto & inlineUbo : m_inlineUbos )
+#if VK_EXT_inline_uniform_block
+
+		if ( tryGet< VkWriteDescriptorSetInlineUniformBlockEXT >( write.pNext ) )
 		{
-			deallocate( inlineUbo->buffer, nullptr );
-			deallocate( inlineUbo->memory, nullptr );
+			// The previous write of this block is replaced, and its storage recycled.
+			auto end = std::remove_if( writes.writes.begin()
+				, writes.writes.end()
+				, [&write]( VkWriteDescriptorSet const & lookup )
+				{
+					return lookup.dstArrayElement == write.dstArrayElement;
+				} );
+			writes.writes.erase( end, writes.writes.end() );
+			m_inlineUbos.erase( makeInlineUboKey( write.dstBinding, write.dstArrayElement ) );
 		}
-	}
 
-	void DescriptorSet::mergeWrites( LayoutBindingWrites & writes, VkWriteDescriptorSet const & write )
-	{
+#endif
+
 		writes.writes.push_back( write );
 		auto & myWrite = writes.writes.back();
 
@@ -119,18 +129,10 @@ namespace ashes::d3d11
 		{
 			myWrite.descriptorCount /= inlineUniform->dataSize;
 			auto device = get( m_pool )->getDevice();
-			auto inlineUbo = createInlineUbo( device
-				, *inlineUniform
-				, Instance::getMemoryProperties()
-				, ashes::d3d11::vkCreateBuffer
-				, ashes::d3d11::vkGetBufferMemoryRequirements
-				, ashes::d3d11::vkAllocateMemory
-				, ashes::d3d11::vkBindBufferMemory
-				, ashes::d3d11::vkMapMemory
-				, ashes::d3d11::vkFlushMappedMemoryRanges
-				, ashes::d3d11::vkUnmapMemory );
+			auto & inlineUbo = m_inlineUbos[makeInlineUboKey( myWrite.dstBinding, myWrite.dstArrayElement )];
+			inlineUbo = get( device )->getInlineUboAllocator().allocate( *inlineUniform );
+			assert( inlineUbo );
 			myWrite.pBufferInfo = &inlineUbo->info;
-			m_inlineUbos.emplace_back( std::move( inlineUbo ) );
 		}
 
 #endif
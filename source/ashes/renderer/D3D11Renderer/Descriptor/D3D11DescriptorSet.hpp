@@ -22,7 +22,6 @@ namespace ashes::d3d11
 		DescriptorSet( VkDevice device
 			, VkDescriptorPool pool
 			, VkDescriptorSetLayout layout );
-		~DescriptorSet();
 
 		void update( VkWriteDescriptorSet const & write );
 		void update( VkCopyDescriptorSet const & write );
@@ -95,7 +94,7 @@ namespace ashes::d3d11
 		VkDescriptorSetLayout m_layout;
 		std::vector< std::vector< VkDescriptorImageInfo > > m_imagesInfos;
 		std::vector< std::vector< VkDescriptorBufferInfo > > m_buffersInfos;
-		InlineUboArray m_inlineUbos;
+		InlineUboMap m_inlineUbos;
 		LayoutBindingWritesMap m_writes;
 		LayoutBindingWritesArray m_combinedTextureSamplers;
 		LayoutBindingWritesArray m_samplers;
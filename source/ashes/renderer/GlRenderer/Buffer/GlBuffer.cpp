@@ -2,6 +2,8 @@
 
 #include "Core/GlContextLock.hpp"
 #include "Core/GlDevice.hpp"
+#include "Core/GlPhysicalDevice.hpp"
+#include "Miscellaneous/GlCallLogger.hpp"
 #include "Miscellaneous/GlDeviceMemory.hpp"
 
 #include "ashesgl_api.hpp"
@@ -16,10 +18,46 @@ namespace ashes::gl
 		, m_target{ getTargetFromUsageFlags( m_createInfo.usage ) }
 	{
 		m_createInfo.pQueueFamilyIndices = m_queueFamilyIndices.data();
+
+		if ( checkFlag( m_createInfo.flags, VK_BUFFER_CREATE_SPARSE_BINDING_BIT )
+			&& hasSparseResources( m_device ) )
+		{
+			// The virtual storage is owned by the buffer, the pages are then committed by vkQueueBindSparse.
+			auto context = get( m_device )->getContext();
+			m_sparseSize = ashes::getAlignedSize( m_createInfo.size
+				, get( get( m_device )->getPhysicalDevice() )->getSparseBufferPageSize() );
+			glLogCall( context
+				, glGenBuffers
+				, 1
+				, &m_internal );
+			glLogCall( context
+				, glBindBuffer
+				, GL_BUFFER_TARGET_COPY_WRITE
+				, m_internal );
+			glLogCall( context
+				, glBufferStorage
+				, GL_BUFFER_TARGET_COPY_WRITE
+				, GLsizeiptr( m_sparseSize )
+				, nullptr
+				, gl4::GL_MEMORY_PROPERTY_SPARSE_STORAGE_BIT | gl4::GL_MEMORY_PROPERTY_DYNAMIC_STORAGE_BIT );
+			glLogCall( context
+				, glBindBuffer
+				, GL_BUFFER_TARGET_COPY_WRITE
+				, 0u );
+		}
 	}
 
 	Buffer::~Buffer()
 	{
+		if ( isSparse() )
+		{
+			auto context = get( m_device )->getContext();
+			glLogCall( context
+				, glDeleteBuffers
+				, 1
+				, &m_internal );
+		}
+
 		m_copyTarget = GlBufferTarget( 0u );
 		m_memory = VK_NULL_HANDLE;
 		m_target = GlBufferTarget( 0u );
@@ -42,12 +80,24 @@ namespace ashes::gl
 			result.alignment = get( m_device )->getLimits().minUniformBufferOffsetAlignment;
 		}
 
+		if ( isSparse() )
+		{
+			// The sparse block is a page, and the sparse storage is device local only.
+			result.alignment = physicalDevice->getSparseBufferPageSize();
+			result.memoryTypeBits = physicalDevice->getMemoryTypeBits( VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT );
+		}
+
 		result.size = ashes::getAlignedSize( m_createInfo.size, result.alignment );
 		return result;
 	}
 
 	bool Buffer::isMapped()const
 	{
+		if ( isSparse() )
+		{
+			return false;
+		}
+
 		assert( m_memory != VK_NULL_HANDLE );
 		return get( m_memory )->isMapped();
 	}
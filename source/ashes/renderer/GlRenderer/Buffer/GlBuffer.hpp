@@ -32,6 +32,11 @@ namespace ashes::gl
 			return m_internalOffset;
 		}
 
+		inline VkDeviceSize getSize()const
+		{
+			return m_createInfo.size;
+		}
+
 		inline GlBufferTarget getTarget()const
 		{
 			return m_target;
@@ -51,6 +56,22 @@ namespace ashes::gl
 		{
 			return m_device;
 		}
+		/**
+		*\return
+		*	\p true if the buffer has its own ARB_sparse_buffer storage, committed through vkQueueBindSparse.
+		*/
+		inline bool isSparse()const
+		{
+			return m_sparseSize != 0u;
+		}
+		/**
+		*\return
+		*	The size of the sparse storage, aligned on the sparse buffer page size.
+		*/
+		inline VkDeviceSize getSparseSize()const
+		{
+			return m_sparseSize;
+		}
 
 	private:
 		inline void setInternal( GLuint value, VkDeviceSize internalOffset )
@@ -68,6 +89,7 @@ namespace ashes::gl
 		GlBufferTarget m_target;
 		VkDeviceMemory m_memory{ VK_NULL_HANDLE };
 		mutable GlBufferTarget m_copyTarget;
+		VkDeviceSize m_sparseSize{ 0u };
 	};
 }
 
@@ -56,6 +56,17 @@ namespace ashes::gl
 			, glBindTexture
 			, GL_TEXTURE_BUFFER
 			, 0u );
+
+		if ( auto capture = get( m_device )->getCapture() )
+		{
+			capture->registerTextureBuffer( m_internal
+				, { uint32_t( getInternalFormat( m_format ) )
+					, get( createInfo.buffer )->getInternal()
+					, offset
+					, ( get( getInstance( device ) )->getFeatures().hasTexBufferRange
+						? m_range
+						: 0u ) } );
+		}
 	}
 
 	BufferView::~BufferView()
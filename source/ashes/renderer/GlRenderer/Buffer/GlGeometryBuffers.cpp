@@ -193,7 +193,7 @@ namespace ashes::gl
 		}
 	}
 
-	void GeometryBuffers::enableAttribute( ContextLock & context
+	capture::VertexAttribDesc GeometryBuffers::enableAttribute( ContextLock & context
 		, VkVertexInputBindingDescription const & binding
 		, VkVertexInputAttributeDescription const & attribute
 		, VkDeviceSize offset
@@ -203,8 +203,17 @@ namespace ashes::gl
 		glLogCall( context
 			, glEnableVertexAttribArray
 			, attribute.location );
+		capture::VertexAttribDesc result{ attribute.location
+			, 0u
+			, GLint( ashes::getCount( attribute.format ) )
+			, uint32_t( getType( getInternalFormat( attribute.format ) ) )
+			, ( isNormalized( attribute.format ) ? 1u : 0u )
+			, ( isInteger( pAttribute->format ) ? 1u : 0u )
+			, GLint( binding.stride )
+			, 0u
+			, offset + attribute.offset };
 
-		if ( isInteger( pAttribute->format ) )
+		if ( result.integer )
 		{
 			glLogCall( context
 				, glVertexAttribIPointer
@@ -225,6 +234,8 @@ namespace ashes::gl
 				, binding.stride
 				, getBufferOffset( offset + attribute.offset ) );
 		}
+
+		return result;
 	}
 
 	void GeometryBuffers::initialise( ContextLock & context )
@@ -249,6 +260,8 @@ namespace ashes::gl
 		glLogCall( context
 			, glBindVertexArray
 			, m_vao );
+		// Kept for the capture, if any.
+		std::vector< capture::VertexAttribDesc > attributes;
 
 		for ( auto & vbo : m_vbos )
 		{
@@ -276,12 +289,14 @@ namespace ashes::gl
 
 					if ( it == vbo.programAttributes.end() )
 					{
-						enableAttribute( context, vbo.binding, attribute, bufferOffset + vbo.offset, nullptr );
+						attributes.push_back( enableAttribute( context, vbo.binding, attribute, bufferOffset + vbo.offset, nullptr ) );
 					}
 					else
 					{
-						enableAttribute( context, vbo.binding, attribute, bufferOffset + vbo.offset, &( *it ) );
+						attributes.push_back( enableAttribute( context, vbo.binding, attribute, bufferOffset + vbo.offset, &( *it ) ) );
 					}
+
+					attributes.back().buffer = get( vbo.vbo )->getInternal();
 				}
 			}
 			else
@@ -292,17 +307,20 @@ namespace ashes::gl
 
 					if ( it == vbo.programAttributes.end() )
 					{
-						enableAttribute( context, vbo.binding, attribute, bufferOffset + vbo.offset, nullptr );
+						attributes.push_back( enableAttribute( context, vbo.binding, attribute, bufferOffset + vbo.offset, nullptr ) );
 					}
 					else
 					{
-						enableAttribute( context, vbo.binding, attribute, bufferOffset + vbo.offset, &( *it ) );
+						attributes.push_back( enableAttribute( context, vbo.binding, attribute, bufferOffset + vbo.offset, &( *it ) ) );
 					}
 
+					attributes.back().buffer = get( vbo.vbo )->getInternal();
+
 					glLogCall( context
 						, glVertexAttribDivisor
 						, attribute.location
 						, 1u );
+					attributes.back().divisor = 1u;
 				}
 			}
 		}
@@ -315,6 +333,13 @@ namespace ashes::gl
 				, get( m_ibo->ibo )->getInternal() );
 		}
 
+		if ( auto capture = get( m_device )->getCapture() )
+		{
+			capture->registerVertexArray( m_vao
+				, ( m_ibo ? get( m_ibo->ibo )->getInternal() : 0u )
+				, std::move( attributes ) );
+		}
+
 		glLogCall( context
 			, glBindVertexArray
 			, 0u );
@@ -8,6 +8,7 @@ See LICENSE file in root folder.
 
 #include "renderer/GlRenderer/GlRendererPrerequisites.hpp"
 
+#include "renderer/GlRenderer/Miscellaneous/GlCaptureFormat.hpp"
 #include "renderer/GlRenderer/Shader/GlShaderDesc.hpp"
 
 namespace ashes::gl
@@ -90,7 +91,7 @@ namespace ashes::gl
 		}
 
 	private:
-		void enableAttribute( ContextLock & context
+		capture::VertexAttribDesc enableAttribute( ContextLock & context
 			, VkVertexInputBindingDescription const & binding
 			, VkVertexInputAttributeDescription const & attribute
 			, VkDeviceSize offset
@@ -188,6 +188,14 @@ namespace ashes::gl
 		auto references = makeArrayView( get( renderPass )->begin()
 			, get( renderPass )->end() );
 		list.push_back( makeCmd< OpType::eDrawBuffers >( get( frameBuffer )->getDrawBuffers( references ) ) );
+		auto discarded = get( frameBuffer )->getDiscardedAttaches( renderPass, true );
+
+		if ( !discarded.empty() )
+		{
+			list.push_back( makeCmd< OpType::eInvalidateFramebuffer >( GL_FRAMEBUFFER
+				, discarded ) );
+		}
+
 		clearAttaches( frameBuffer, renderPass, rtClearValues, dsClearValue, list, false );
 	}
 }
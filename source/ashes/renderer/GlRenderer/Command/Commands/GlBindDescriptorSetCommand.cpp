@@ -204,6 +204,20 @@ namespace ashes::gl
 			}
 		}
 
+		void bindBindlessTextures( BindlessBinding const & bindless
+			, ShaderBindingMap const & bindings
+			, uint32_t setIndex
+			, CmdList & list )
+		{
+			auto it = bindings.find( makeShaderBindingKey( setIndex, bindless.binding ) );
+			assert( it != bindings.end() );
+			list.push_back( makeCmd< OpType::eBindBufferRange >( it->second
+				, GL_BUFFER_TARGET_SHADER_STORAGE
+				, bindless.buffer
+				, int64_t( 0 )
+				, int64_t( std::max( 1u, bindless.descriptorCount ) * sizeof( GLuint64 ) ) ) );
+		}
+
 		void bindUniformBuffer( LayoutBindingWrites const * writes
 			, ShaderBindingMap const & bindings
 			, uint32_t setIndex
@@ -745,6 +759,11 @@ namespace ashes::gl
 					gl4::bindCombinedSampler( write, bindings.tex, setIndex, list );
 				}
 
+				for ( auto & bindless : get( descriptorSet )->getBindlessTextures() )
+				{
+					common::bindBindlessTextures( bindless, bindings.sbo, setIndex, list );
+				}
+
 				for ( auto & write : get( descriptorSet )->getSamplers() )
 				{
 					gl4::bindSampler( write, bindings.tex, setIndex, list );
@@ -841,4 +860,99 @@ namespace ashes::gl
 			}
 		}
 	}
+
+	namespace
+	{
+		void pushWrite( VkDevice device
+			, VkWriteDescriptorSet const & write
+			, ShaderBindings const & bindings
+			, uint32_t setIndex
+			, CmdList & list )
+		{
+			auto textureViews = hasTextureViews( device );
+
+			switch ( write.descriptorType )
+			{
+			case VK_DESCRIPTOR_TYPE_SAMPLER:
+				if ( textureViews )
+				{
+					gl4::bindSampler( write, bindings.tex, setIndex, list );
+				}
+				else
+				{
+					gl3::bindSampler( write, bindings.tex, setIndex, list );
+				}
+				break;
+			case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
+				if ( textureViews )
+				{
+					gl4::bindCombinedSampler( write, bindings.tex, setIndex, list );
+				}
+				else
+				{
+					gl3::bindCombinedSampler( write, bindings.tex, setIndex, list );
+				}
+				break;
+			case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+				if ( textureViews )
+				{
+					gl4::bindSampledTexture( write, bindings.tex, setIndex, list );
+				}
+				else
+				{
+					gl3::bindSampledTexture( write, bindings.tex, setIndex, list );
+				}
+				break;
+			case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+				if ( textureViews )
+				{
+					gl4::bindStorageTexture( write, bindings.img, setIndex, list );
+				}
+				else
+				{
+					gl3::bindStorageTexture( write, bindings.img, setIndex, list );
+				}
+				break;
+			case VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT:
+				if ( textureViews )
+				{
+					gl4::bindInputAttachment( write, bindings.tex, setIndex, get( device )->getSampler(), list );
+				}
+				else
+				{
+					gl3::bindInputAttachment( write, bindings.tex, setIndex, get( device )->getSampler(), list );
+				}
+				break;
+			case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
+			case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:
+				common::bindTexelBuffer( write, bindings.tbo, setIndex, list );
+				break;
+			case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+				common::bindUniformBuffer( write, bindings.ubo, setIndex, list );
+				break;
+			case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+				common::bindStorageBuffer( write, bindings.sbo, setIndex, list );
+				break;
+			default:
+				// Dynamic buffers and inline uniform blocks can't be pushed.
+				assert( false && "Unsupported push descriptor type" );
+				break;
+			}
+		}
+	}
+
+	void buildPushDescriptorSetCommand( VkDevice device
+		, ArrayView< VkWriteDescriptorSet const > const & writes
+		, uint32_t setIndex
+		, VkPipeline pipeline
+		, CmdList & list )
+	{
+		glLogCommand( list, "PushDescriptorSetCommand" );
+		auto & bindings = get( pipeline )->getPushDescriptorSetBindings( writes, setIndex );
+
+		for ( auto & write : writes )
+		{
+			pushWrite( device, write, bindings, setIndex, list );
+		}
+	}
 }
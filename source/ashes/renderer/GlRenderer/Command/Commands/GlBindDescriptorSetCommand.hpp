@@ -184,6 +184,17 @@ namespace ashes::gl
 		, ArrayView< uint32_t const > const & dynamicOffsets
 		, VkPipelineBindPoint bindingPoint
 		, CmdList & list );
+	/**
+	*\brief
+	*	Turns push descriptor writes directly into bind commands.
+	*\remarks
+	*	The GL bindings are resolved through \p pipeline, as for bound descriptor sets.
+	*/
+	void buildPushDescriptorSetCommand( VkDevice device
+		, ArrayView< VkWriteDescriptorSet const > const & writes
+		, uint32_t setIndex
+		, VkPipeline pipeline
+		, CmdList & list );
 
 	//*************************************************************************
 }
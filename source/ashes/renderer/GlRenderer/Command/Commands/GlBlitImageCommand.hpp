@@ -73,8 +73,7 @@ namespace ashes::gl
 		, VkImage dstImage
 		, VkImageBlit region
 		, VkFilter filter
-		, CmdList & list
-		, VkImageViewArray & views );
+		, CmdList & list );
 
 	//*************************************************************************
 }
@@ -6,6 +6,8 @@ See LICENSE file in root folder.
 
 #include "Core/GlContextLock.hpp"
 #include "Miscellaneous/GlDeviceMemory.hpp"
+#include "Miscellaneous/GlFramebufferCache.hpp"
+#include "Miscellaneous/GlProfiler.hpp"
 
 #include "ashesgl_api.hpp"
 
@@ -177,6 +179,16 @@ namespace ashes::gl
 		}
 	}
 
+	void apply( ContextLock const & context
+		, CmdBindCachedFramebuffer const & cmd )
+	{
+		auto fbo = cmd.cache->getFramebuffer( context, cmd.attach );
+		glLogCall( context
+			, glBindFramebuffer
+			, cmd.target
+			, fbo );
+	}
+
 	void apply( ContextLock const & context
 		, CmdBindBuffer const & cmd )
 	{
@@ -417,6 +429,18 @@ namespace ashes::gl
 		
 	}
 
+	void apply( ContextLock const & context
+		, CmdBeginProfileRegion const & cmd )
+	{
+		cmd.profiler->beginGpuRegion( context, cmd.name );
+	}
+
+	void apply( ContextLock const & context
+		, CmdEndProfileRegion const & cmd )
+	{
+		cmd.profiler->endGpuRegion( context );
+	}
+
 	void apply( ContextLock const & context
 		, CmdStencilFunc const & cmd )
 	{
@@ -483,6 +507,19 @@ namespace ashes::gl
 			, cmd.arrayLayer );
 	}
 
+	void apply( ContextLock const & context
+		, CmdInvalidateFramebuffer const & cmd )
+	{
+		if ( context->hasInvalidateFramebuffer() )
+		{
+			glLogCall( context
+				, glInvalidateFramebuffer
+				, cmd.target
+				, GLsizei( cmd.count )
+				, cmd.points.data() );
+		}
+	}
+
 	void apply( ContextLock const & context
 		, CmdActiveTexture const & cmd )
 	{
@@ -494,13 +531,13 @@ namespace ashes::gl
 	void apply( ContextLock const & context
 		, CmdUploadMemory const & cmd )
 	{
-		get( cmd.memory )->upload( context, 0u, WholeSize );
+		get( cmd.memory )->upload( context, cmd.offset, cmd.size );
 	}
 
 	void apply( ContextLock const & context
 		, CmdDownloadMemory const & cmd )
 	{
-		get( cmd.memory )->download( context, 0u, WholeSize );
+		get( cmd.memory )->download( context, cmd.offset, cmd.size );
 	}
 
 	void apply( ContextLock const & context
@@ -536,4 +573,45 @@ namespace ashes::gl
 			get( cmd.memory )->unlock( context );
 		}
 	}
+
+	void apply( ContextLock const & context
+		, CmdBufferSubData const & cmd )
+	{
+		glLogCall( context
+			, glBindBuffer
+			, GL_BUFFER_TARGET_COPY_WRITE
+			, cmd.name );
+		glLogCall( context
+			, glBufferSubData
+			, GL_BUFFER_TARGET_COPY_WRITE
+			, GLintptr( cmd.offset )
+			, GLsizeiptr( cmd.dataSize )
+			, cmd.pData );
+		glLogCall( context
+			, glBindBuffer
+			, GL_BUFFER_TARGET_COPY_WRITE
+			, 0u );
+	}
+
+	void apply( ContextLock const & context
+		, CmdClearBufferSubData const & cmd )
+	{
+		glLogCall( context
+			, glBindBuffer
+			, GL_BUFFER_TARGET_COPY_WRITE
+			, cmd.name );
+		glLogCall( context
+			, glClearBufferSubData
+			, GL_BUFFER_TARGET_COPY_WRITE
+			, GL_INTERNAL_R32_UINT
+			, GLintptr( cmd.offset )
+			, GLsizeiptr( cmd.dataSize )
+			, GL_FORMAT_R_INTEGER
+			, GL_TYPE_UI32
+			, &cmd.data );
+		glLogCall( context
+			, glBindBuffer
+			, GL_BUFFER_TARGET_COPY_WRITE
+			, 0u );
+	}
 }
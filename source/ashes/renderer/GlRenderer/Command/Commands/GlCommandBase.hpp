@@ -24,9 +24,11 @@ namespace ashes::gl
 		eApplyScissors,
 		eApplyViewport,
 		eApplyViewports,
+		eBeginProfileRegion,
 		eBeginQuery,
 		eBindBuffer,
 		eBindBufferRange,
+		eBindCachedFramebuffer,
 		eBindContextState,
 		eBindFramebuffer,
 		eBindImage,
@@ -38,7 +40,9 @@ namespace ashes::gl
 		eBlendEquation,
 		eBlendFunc,
 		eBlitFramebuffer,
+		eBufferSubData,
 		eCleanupFramebuffer,
+		eClearBufferSubData,
 		eClearBack,
 		eClearBackColour,
 		eClearBackDepth,
@@ -78,6 +82,7 @@ namespace ashes::gl
 		eDrawIndexedIndirect,
 		eDrawIndirect,
 		eEnable,
+		eEndProfileRegion,
 		eEndQuery,
 		eFillBuffer,
 		eFramebufferTexture,
@@ -88,11 +93,14 @@ namespace ashes::gl
 		eGetQueryResults,
 		eGetTexImage,
 		eInitFramebuffer,
+		eInvalidateFramebuffer,
 		eLineWidth,
 		eLogCommand,
 		eLogicOp,
 		eMemoryBarrier,
 		eMinSampleShading,
+		eMultiDraw,
+		eMultiDrawIndexed,
 		ePatchParameter,
 		ePixelStore,
 		ePolygonMode,
@@ -769,6 +777,40 @@ namespace ashes::gl
 
 	//*************************************************************************
 
+	template<>
+	struct CmdConfig< OpType::eBindCachedFramebuffer >
+	{
+		static Op constexpr value = { OpType::eBindCachedFramebuffer, 10u };
+	};
+	/**
+	*\brief
+	*	Binds the FramebufferCache framebuffer with the given attachment, created on first use.
+	*/
+	template<>
+	struct alignas( uint64_t ) CmdT< OpType::eBindCachedFramebuffer >
+	{
+		inline CmdT( GlFrameBufferTarget target
+			, FramebufferCache * cache
+			, CachedAttachment attach )
+			: cmd{ { OpType::eBindCachedFramebuffer, sizeof( CmdT ) / sizeof( uint32_t ) } }
+			, target{ std::move( target ) }
+			, cache{ cache }
+			, attach{ std::move( attach ) }
+		{
+		}
+
+		Command cmd;
+		GlFrameBufferTarget target;
+		FramebufferCache * cache;
+		CachedAttachment attach;
+	};
+	using CmdBindCachedFramebuffer = CmdT< OpType::eBindCachedFramebuffer >;
+
+	void apply( ContextLock const & context
+		, CmdBindCachedFramebuffer const & cmd );
+
+	//*************************************************************************
+
 	template<>
 	struct CmdConfig< OpType::eBindBuffer >
 	{
@@ -1474,6 +1516,63 @@ namespace ashes::gl
 
 	//*************************************************************************
 
+	template<>
+	struct CmdConfig< OpType::eBeginProfileRegion >
+	{
+		static Op constexpr value = { OpType::eBeginProfileRegion, 68u };
+	};
+
+	template<>
+	struct alignas( uint64_t ) CmdT< OpType::eBeginProfileRegion >
+	{
+		inline CmdT( Profiler * profiler
+			, std::string const & name )
+			: cmd{ { OpType::eBeginProfileRegion, sizeof( CmdT ) / sizeof( uint32_t ) } }
+			, profiler{ profiler }
+		{
+			auto length = std::min( name.size(), size_t( 255u ) );
+			strncpy( this->name
+				, name.c_str()
+				, length );
+			this->name[length] = 0;
+		}
+
+		Command cmd;
+		Profiler * profiler;
+		char name[256];
+	};
+	using CmdBeginProfileRegion = CmdT< OpType::eBeginProfileRegion >;
+
+	void apply( ContextLock const & context
+		, CmdBeginProfileRegion const & cmd );
+
+	//*************************************************************************
+
+	template<>
+	struct CmdConfig< OpType::eEndProfileRegion >
+	{
+		static Op constexpr value = { OpType::eEndProfileRegion, 4u };
+	};
+
+	template<>
+	struct alignas( uint64_t ) CmdT< OpType::eEndProfileRegion >
+	{
+		inline CmdT( Profiler * profiler )
+			: cmd{ { OpType::eEndProfileRegion, sizeof( CmdT ) / sizeof( uint32_t ) } }
+			, profiler{ profiler }
+		{
+		}
+
+		Command cmd;
+		Profiler * profiler;
+	};
+	using CmdEndProfileRegion = CmdT< OpType::eEndProfileRegion >;
+
+	void apply( ContextLock const & context
+		, CmdEndProfileRegion const & cmd );
+
+	//*************************************************************************
+
 	template<>
 	struct CmdConfig< OpType::eStencilFunc >
 	{
@@ -1678,6 +1777,38 @@ namespace ashes::gl
 
 	//*************************************************************************
 
+	template<>
+	struct CmdConfig< OpType::eInvalidateFramebuffer >
+	{
+		static Op constexpr value = { OpType::eInvalidateFramebuffer, 20u };
+	};
+
+	template<>
+	struct alignas( uint64_t ) CmdT< OpType::eInvalidateFramebuffer >
+	{
+		inline CmdT( GlFrameBufferTarget target
+			, UInt32Array const & points )
+			: cmd{ { OpType::eInvalidateFramebuffer, sizeof( CmdT ) / sizeof( uint32_t ) } }
+			, target{ target }
+			, count{ std::min( 17u, uint32_t( points.size() ) ) }
+		{
+			std::copy( points.begin()
+				, points.begin() + count
+				, this->points.begin() );
+		}
+
+		Command cmd;
+		GlFrameBufferTarget target;
+		uint32_t count;
+		std::array< uint32_t, 17u > points{ 0u };
+	};
+	using CmdInvalidateFramebuffer = CmdT< OpType::eInvalidateFramebuffer >;
+
+	void apply( ContextLock const & context
+		, CmdInvalidateFramebuffer const & cmd );
+
+	//*************************************************************************
+
 	template<>
 	struct CmdConfig< OpType::eActiveTexture >
 	{
@@ -1712,14 +1843,20 @@ namespace ashes::gl
 	template<>
 	struct alignas( uint64_t ) CmdT< OpType::eUploadMemory >
 	{
-		inline CmdT( VkDeviceMemory memory )
+		inline CmdT( VkDeviceMemory memory
+			, VkDeviceSize offset = 0u
+			, VkDeviceSize size = WholeSize )
 			: cmd{ { OpType::eUploadMemory, sizeof( CmdT ) / sizeof( uint32_t ) } }
 			, memory{ memory }
+			, offset{ offset }
+			, size{ size }
 		{
 		}
 
 		Command cmd;
 		VkDeviceMemory memory;
+		VkDeviceSize offset;
+		VkDeviceSize size;
 	};
 	using CmdUploadMemory = CmdT< OpType::eUploadMemory >;
 
@@ -1737,14 +1874,20 @@ namespace ashes::gl
 	template<>
 	struct alignas( uint64_t ) CmdT< OpType::eDownloadMemory >
 	{
-		inline CmdT( VkDeviceMemory memory )
+		inline CmdT( VkDeviceMemory memory
+			, VkDeviceSize offset = 0u
+			, VkDeviceSize size = WholeSize )
 			: cmd{ { OpType::eDownloadMemory, sizeof( CmdT ) / sizeof( uint32_t ) } }
 			, memory{ memory }
+			, offset{ offset }
+			, size{ size }
 		{
 		}
 
 		Command cmd;
 		VkDeviceMemory memory;
+		VkDeviceSize offset;
+		VkDeviceSize size;
 	};
 	using CmdDownloadMemory = CmdT< OpType::eDownloadMemory >;
 
@@ -1846,6 +1989,74 @@ namespace ashes::gl
 
 	//*************************************************************************
 
+	template<>
+	struct CmdConfig< OpType::eBufferSubData >
+	{
+		static Op constexpr value = { OpType::eBufferSubData, 8 };
+	};
+
+	template<>
+	struct alignas( uint64_t ) CmdT< OpType::eBufferSubData >
+	{
+		inline CmdT( uint32_t name
+			, VkDeviceSize offset
+			, VkDeviceSize dataSize
+			, void * pData )
+			: cmd{ { OpType::eBufferSubData, sizeof( CmdT ) / sizeof( uint32_t ) } }
+			, name{ std::move( name ) }
+			, offset{ std::move( offset ) }
+			, dataSize{ std::move( dataSize ) }
+			, pData{ std::move( pData ) }
+		{
+		}
+
+		Command cmd;
+		uint32_t name;
+		VkDeviceSize offset;
+		VkDeviceSize dataSize;
+		void * pData;
+	};
+	using CmdBufferSubData = CmdT< OpType::eBufferSubData >;
+
+	void apply( ContextLock const & context
+		, CmdBufferSubData const & cmd );
+
+	//*************************************************************************
+
+	template<>
+	struct CmdConfig< OpType::eClearBufferSubData >
+	{
+		static Op constexpr value = { OpType::eClearBufferSubData, 8 };
+	};
+
+	template<>
+	struct alignas( uint64_t ) CmdT< OpType::eClearBufferSubData >
+	{
+		inline CmdT( uint32_t name
+			, VkDeviceSize offset
+			, VkDeviceSize dataSize
+			, uint32_t data )
+			: cmd{ { OpType::eClearBufferSubData, sizeof( CmdT ) / sizeof( uint32_t ) } }
+			, name{ std::move( name ) }
+			, offset{ std::move( offset ) }
+			, dataSize{ std::move( dataSize ) }
+			, data{ std::move( data ) }
+		{
+		}
+
+		Command cmd;
+		uint32_t name;
+		VkDeviceSize offset;
+		VkDeviceSize dataSize;
+		uint32_t data;
+	};
+	using CmdClearBufferSubData = CmdT< OpType::eClearBufferSubData >;
+
+	void apply( ContextLock const & context
+		, CmdClearBufferSubData const & cmd );
+
+	//*************************************************************************
+
 	template< OpType OpT, typename ... ParamsT >
 	CmdBuffer makeCmd( ParamsT && ... params )
 	{
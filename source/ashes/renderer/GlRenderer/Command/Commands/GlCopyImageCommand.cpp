@@ -37,31 +37,24 @@ namespace ashes::gl
 			return result;
 		}
 
-		ByteArray allocateData( VkImage src )
+		ByteArray allocateData( VkFormat format
+			, VkExtent3D const & dimensions )
 		{
-			auto dimensions = get( src )->getDimensions();
 			auto texels = dimensions.width * dimensions.height * dimensions.depth;
-			return ByteArray( texels * ashes::getSize( get( src )->getFormat() ), uint8_t( 0 ) );
-		}
-
-		ByteArray allocateData( VkImage src
-			, VkImageCopy const & copyInfo )
-		{
-			auto dimensions = copyInfo.extent;
-			auto texels = dimensions.width * dimensions.height * dimensions.depth;
-			return ByteArray( texels * ashes::getSize( get( src )->getFormat() ), uint8_t( 0 ) );
+			return ByteArray( texels * ashes::getSize( format ), uint8_t( 0 ) );
 		}
 
 		void copyData( ashes::ByteArray const & srcData
-			, VkImage const & src
+			, VkFormat srcFormat
+			, VkExtent3D const & srcExtent
 			, VkImageCopy const & copyInfo
 			, ByteArray & dstData )
 		{
 			auto dimensions = copyInfo.extent;
-			auto texelSize = ashes::getSize( get( src )->getFormat() );
+			auto texelSize = ashes::getSize( srcFormat );
 			auto dstRowSize = dimensions.width * texelSize;
-			auto srcRowSize = get( src )->getDimensions().width * texelSize;
-			auto planeSize = get( src )->getDimensions().height * srcRowSize;
+			auto srcRowSize = srcExtent.width * texelSize;
+			auto planeSize = srcExtent.height * srcRowSize;
 			auto plane = srcData.data() + planeSize * copyInfo.srcOffset.z;
 			auto buffer = dstData.data();
 
@@ -80,33 +73,32 @@ namespace ashes::gl
 			}
 		}
 
+		template< typename CmdT >
 		ByteArray retrieveData( ContextLock const & context
-			, VkImage src
-			, VkImageCopy copy
-			, GlTextureType srcTarget
-			, GLuint srcName )
+			, CmdT const & cmd )
 		{
-			auto srcData = allocateData( src );
-			auto dstData = allocateData( src, copy );
-			auto srcInternal{ getInternalFormat( get( src )->getFormat() ) };
+			auto srcData = allocateData( cmd.srcFormat, cmd.srcExtent );
+			auto dstData = allocateData( cmd.srcFormat, cmd.copy.extent );
+			auto srcInternal{ getInternalFormat( cmd.srcFormat ) };
 			glLogCall( context
 				, glBindTexture
-				, srcTarget
-				, srcName );
+				, cmd.srcTarget
+				, cmd.srcName );
 			glLogCall( context
 				, glGetTexImage
-				, srcTarget
-				, copy.srcSubresource.mipLevel
+				, cmd.srcTarget
+				, cmd.copy.srcSubresource.mipLevel
 				, getFormat( srcInternal )
 				, getType( srcInternal )
 				, srcData.data() );
 			glLogCall( context
 				, glBindTexture
-				, srcTarget
+				, cmd.srcTarget
 				, 0u );
 			copyData( srcData
-				, src
-				, copy
+				, cmd.srcFormat
+				, cmd.srcExtent
+				, cmd.copy
 				, dstData );
 			return dstData;
 		}
@@ -143,12 +135,8 @@ namespace ashes::gl
 	void apply( ContextLock const & context
 		, CmdCopyImageSubData1D const & cmd )
 	{
-		auto srcInternal{ getInternalFormat( get( cmd.src )->getFormat() ) };
-		auto dstData = retrieveData( context
-			, cmd.src
-			, cmd.copy
-			, cmd.srcTarget
-			, cmd.srcName );
+		auto srcInternal{ getInternalFormat( cmd.srcFormat ) };
+		auto dstData = retrieveData( context, cmd );
 		glLogCall( context
 			, glBindTexture
 			, cmd.dstTarget
@@ -171,12 +159,8 @@ namespace ashes::gl
 	void apply( ContextLock const & context
 		, CmdCopyImageSubData2D const & cmd )
 	{
-		auto srcInternal{ getInternalFormat( get( cmd.src )->getFormat() ) };
-		auto dstData = retrieveData( context
-			, cmd.src
-			, cmd.copy
-			, cmd.srcTarget
-			, cmd.srcName );
+		auto srcInternal{ getInternalFormat( cmd.srcFormat ) };
+		auto dstData = retrieveData( context, cmd );
 		glLogCall( context
 			, glBindTexture
 			, cmd.dstTarget
@@ -201,12 +185,8 @@ namespace ashes::gl
 	void apply( ContextLock const & context
 		, CmdCopyImageSubData3D const & cmd )
 	{
-		auto srcInternal{ getInternalFormat( get( cmd.src )->getFormat() ) };
-		auto dstData = retrieveData( context
-			, cmd.src
-			, cmd.copy
-			, cmd.srcTarget
-			, cmd.srcName );
+		auto srcInternal{ getInternalFormat( cmd.srcFormat ) };
+		auto dstData = retrieveData( context, cmd );
 		glLogCall( context
 			, glBindTexture
 			, cmd.dstTarget
@@ -369,19 +349,12 @@ namespace ashes::gl
 			}
 		}
 
-		if ( get( get( dstImage )->getMemory() )->getBuffer() != GL_INVALID_INDEX )
+		// Refresh the host copy of the image, the readback is done by the memory, through the staging ring.
+		if ( get( get( dstImage )->getMemory() )->isHostVisible() )
 		{
-			auto dstTarget = convert( device
-				, get( dstImage )->getType()
-				, get( dstImage )->getArrayLayers()
-				, get( dstImage )->getCreateFlags() );
-			list.push_back( makeCmd< OpType::eBindBuffer >( GL_BUFFER_TARGET_PIXEL_PACK, get( get( dstImage )->getMemory() )->getBuffer() ) );
-			list.push_back( makeCmd< OpType::eBindTexture >( dstTarget, get( dstImage )->getInternal() ) );
-			auto internal = getInternalFormat( get( dstImage )->getFormat() );
-			list.push_back( makeCmd< OpType::eGetTexImage >( dstTarget, getFormat( internal ), getType( internal ) ) );
-			list.push_back( makeCmd< OpType::eBindTexture >( dstTarget, 0u ) );
-			list.push_back( makeCmd< OpType::eBindBuffer >( GL_BUFFER_TARGET_PIXEL_PACK, 0u ) );
-			list.push_back( makeCmd< OpType::eDownloadMemory >( get( dstImage )->getMemory() ) );
+			list.push_back( makeCmd< OpType::eDownloadMemory >( get( dstImage )->getMemory()
+				, get( dstImage )->getMemoryOffset()
+				, get( dstImage )->getMemoryRequirements().size ) );
 		}
 	}
 }
@@ -56,18 +56,18 @@ namespace ashes::gl
 	template<>
 	struct alignas( uint64_t ) CmdT< OpType::eCopyImageSubData1D >
 	{
-		inline CmdT( VkImage src
+		inline CmdT( VkFormat srcFormat
+			, VkExtent3D srcExtent
 			, uint32_t srcName
 			, GlTextureType srcTarget
-			, VkImage dst
 			, uint32_t dstName
 			, GlTextureType dstTarget
 			, VkImageCopy copy )
 			: cmd{ { OpType::eCopyImageSubData1D, sizeof( CmdT ) / sizeof( uint32_t ) } }
-			, src{ std::move( src ) }
+			, srcFormat{ std::move( srcFormat ) }
+			, srcExtent{ std::move( srcExtent ) }
 			, srcName{ std::move( srcName ) }
 			, srcTarget{ std::move( srcTarget ) }
-			, dst{ std::move( dst ) }
 			, dstName{ std::move( dstName ) }
 			, dstTarget{ std::move( dstTarget ) }
 			, copy{ std::move( copy ) }
@@ -75,10 +75,10 @@ namespace ashes::gl
 		}
 
 		Command cmd;
-		VkImage src;
+		VkFormat srcFormat;
+		VkExtent3D srcExtent;
 		uint32_t srcName;
 		GlTextureType srcTarget;
-		VkImage dst;
 		uint32_t dstName;
 		GlTextureType dstTarget;
 		VkImageCopy copy;
@@ -99,10 +99,10 @@ namespace ashes::gl
 	template<>
 	struct alignas( uint64_t ) CmdT< OpType::eCopyImageSubData2D >
 	{
-		inline CmdT( VkImage src
+		inline CmdT( VkFormat srcFormat
+			, VkExtent3D srcExtent
 			, uint32_t srcName
 			, GlTextureType srcTarget
-			, VkImage dst
 			, uint32_t dstName
 			, GlTextureType dstTarget
 			, GlTextureType dstLayerTarget
@@ -110,10 +110,10 @@ namespace ashes::gl
 			, uint32_t dstExtentY
 			, VkImageCopy copy )
 			: cmd{ { OpType::eCopyImageSubData2D, sizeof( CmdT ) / sizeof( uint32_t ) } }
-			, src{ std::move( src ) }
+			, srcFormat{ std::move( srcFormat ) }
+			, srcExtent{ std::move( srcExtent ) }
 			, srcName{ std::move( srcName ) }
 			, srcTarget{ std::move( srcTarget ) }
-			, dst{ std::move( dst ) }
 			, dstName{ std::move( dstName ) }
 			, dstTarget{ std::move( dstTarget ) }
 			, dstLayerTarget{ std::move( dstLayerTarget ) }
@@ -124,10 +124,10 @@ namespace ashes::gl
 		}
 
 		Command cmd;
-		VkImage src;
+		VkFormat srcFormat;
+		VkExtent3D srcExtent;
 		uint32_t srcName;
 		GlTextureType srcTarget;
-		VkImage dst;
 		uint32_t dstName;
 		GlTextureType dstTarget;
 		GlTextureType dstLayerTarget;
@@ -151,10 +151,10 @@ namespace ashes::gl
 	template<>
 	struct alignas( uint64_t ) CmdT< OpType::eCopyImageSubData3D >
 	{
-		inline CmdT( VkImage src
+		inline CmdT( VkFormat srcFormat
+			, VkExtent3D srcExtent
 			, uint32_t srcName
 			, GlTextureType srcTarget
-			, VkImage dst
 			, uint32_t dstName
 			, GlTextureType dstTarget
 			, GlTextureType dstLayerTarget
@@ -162,10 +162,10 @@ namespace ashes::gl
 			, uint32_t dstExtentZ
 			, VkImageCopy copy )
 			: cmd{ { OpType::eCopyImageSubData3D, sizeof( CmdT ) / sizeof( uint32_t ) } }
-			, src{ std::move( src ) }
+			, srcFormat{ std::move( srcFormat ) }
+			, srcExtent{ std::move( srcExtent ) }
 			, srcName{ std::move( srcName ) }
 			, srcTarget{ std::move( srcTarget ) }
-			, dst{ std::move( dst ) }
 			, dstName{ std::move( dstName ) }
 			, dstTarget{ std::move( dstTarget ) }
 			, dstLayerTarget{ std::move( dstLayerTarget ) }
@@ -176,10 +176,10 @@ namespace ashes::gl
 		}
 
 		Command cmd;
-		VkImage src;
+		VkFormat srcFormat;
+		VkExtent3D srcExtent;
 		uint32_t srcName;
 		GlTextureType srcTarget;
-		VkImage dst;
 		uint32_t dstName;
 		GlTextureType dstTarget;
 		GlTextureType dstLayerTarget;
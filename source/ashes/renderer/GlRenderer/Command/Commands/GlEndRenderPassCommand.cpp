@@ -11,10 +11,23 @@ See LICENSE file in root folder.
 namespace ashes::gl
 {
 	void buildEndRenderPassCommand( ContextStateStack & stack
+		, VkRenderPass renderPass
+		, VkFramebuffer frameBuffer
 		, CmdList & list )
 	{
 		if ( stack.hasCurrentFramebuffer() )
 		{
+			auto discarded = get( frameBuffer )->getDiscardedAttaches( renderPass, false );
+
+			if ( !discarded.empty() )
+			{
+				// The subpass resolves may have unbound the framebuffer.
+				list.push_back( makeCmd< OpType::eBindFramebuffer >( GL_FRAMEBUFFER
+					, frameBuffer ) );
+				list.push_back( makeCmd< OpType::eInvalidateFramebuffer >( GL_FRAMEBUFFER
+					, discarded ) );
+			}
+
 			list.push_back( makeCmd< OpType::eBindFramebuffer >( GL_FRAMEBUFFER
 				, nullptr ) );
 			stack.setCurrentFramebuffer( VK_NULL_HANDLE );
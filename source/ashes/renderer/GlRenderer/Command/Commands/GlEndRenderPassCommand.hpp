@@ -9,5 +9,7 @@ See LICENSE file in root folder
 namespace ashes::gl
 {
 	void buildEndRenderPassCommand( ContextStateStack & stack
+		, VkRenderPass renderPass
+		, VkFramebuffer frameBuffer
 		, CmdList & list );
 }
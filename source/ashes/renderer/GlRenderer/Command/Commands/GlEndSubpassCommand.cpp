@@ -37,39 +37,13 @@ namespace ashes::gl
 				if ( srcAttach.originalObject != dstAttach.originalObject
 					|| srcAttach.originalMipLevel != dstAttach.originalMipLevel )
 				{
-					// Setup source FBO
-					auto srcFbo = get( device )->getBlitSrcFbo();
-					list.push_back( makeCmd< OpType::eInitFramebuffer >( &get( srcFbo )->getInternal() ) );
-					list.push_back( makeCmd< OpType::eBindFramebuffer >( GL_FRAMEBUFFER
-						, srcFbo ) );
-					list.push_back( makeCmd< OpType::eFramebufferTexture2D >( GL_FRAMEBUFFER
-						, srcAttach.point
-						, srcAttach.target
-						, srcAttach.object
-						, srcAttach.mipLevel ) );
-					list.push_back( makeCmd< OpType::eBindFramebuffer >( GL_FRAMEBUFFER
-						, nullptr ) );
-
-					// Setup dst FBO
-					auto dstFbo = get( device )->getBlitDstFbo();
-					list.push_back( makeCmd< OpType::eInitFramebuffer >( &get( dstFbo )->getInternal() ) );
-					list.push_back( makeCmd< OpType::eBindFramebuffer >( GL_FRAMEBUFFER
-						, dstFbo ) );
-					list.push_back( makeCmd< OpType::eFramebufferTexture2D >( GL_FRAMEBUFFER
-						, dstAttach.point
-						, dstAttach.target
-						, dstAttach.object
-						, dstAttach.mipLevel ) );
-					list.push_back( makeCmd< OpType::eBindFramebuffer >( GL_FRAMEBUFFER
-						, nullptr ) );
-
-					// Perform blit
-					list.push_back( makeCmd< OpType::eBindFramebuffer >( GL_READ_FRAMEBUFFER
-						, get( device )->getBlitSrcFbo() ) );
-					list.push_back( makeCmd< OpType::eReadBuffer >( uint32_t( srcAttach.point ) ) );
-					list.push_back( makeCmd< OpType::eBindFramebuffer >( GL_DRAW_FRAMEBUFFER
-						, get( device )->getBlitDstFbo() ) );
-					list.push_back( makeCmd< OpType::eDrawBuffers >( uint32_t( dstAttach.point ) ) );
+					auto & cache = get( device )->getFramebufferCache();
+					list.push_back( makeCmd< OpType::eBindCachedFramebuffer >( GL_READ_FRAMEBUFFER
+						, &cache
+						, makeCachedAttachment( srcAttach ) ) );
+					list.push_back( makeCmd< OpType::eBindCachedFramebuffer >( GL_DRAW_FRAMEBUFFER
+						, &cache
+						, makeCachedAttachment( dstAttach ) ) );
 					list.push_back( makeCmd< OpType::eBlitFramebuffer >(
 						0, 0, int32_t( get( frameBuffer )->getWidth() ), int32_t( get( frameBuffer )->getHeight() ),
 						0, 0, int32_t( get( frameBuffer )->getWidth() ), int32_t( get( frameBuffer )->getHeight() ),
@@ -36,7 +36,11 @@ namespace ashes::gl
 					|| checkFlag( barrier.srcAccessMask, VK_ACCESS_HOST_WRITE_BIT )
 					|| checkFlag( barrier.srcAccessMask, VK_ACCESS_TRANSFER_WRITE_BIT ) )
 				{
-					list.push_back( makeCmd< OpType::eUploadMemory >( get( barrier.buffer )->getMemory() ) );
+					list.push_back( makeCmd< OpType::eUploadMemory >( get( barrier.buffer )->getMemory()
+						, get( barrier.buffer )->getInternalOffset() + barrier.offset
+						, ( barrier.size == WholeSize
+							? get( barrier.buffer )->getSize() - barrier.offset
+							: barrier.size ) ) );
 				}
 			}
 		}
@@ -51,7 +55,11 @@ namespace ashes::gl
 					|| checkFlag( barrier.dstAccessMask, VK_ACCESS_HOST_READ_BIT )
 					|| checkFlag( barrier.dstAccessMask, VK_ACCESS_MEMORY_READ_BIT ) )
 				{
-					list.push_back( makeCmd< OpType::eDownloadMemory >( get( barrier.buffer )->getMemory() ) );
+					list.push_back( makeCmd< OpType::eDownloadMemory >( get( barrier.buffer )->getMemory()
+						, get( barrier.buffer )->getInternalOffset() + barrier.offset
+						, ( barrier.size == WholeSize
+							? get( barrier.buffer )->getSize() - barrier.offset
+							: barrier.size ) ) );
 				}
 			}
 		}
@@ -0,0 +1,174 @@
+/*
+This file belongs to Ashes.
+See LICENSE file in root folder.
+*/
+#include "Command/Commands/GlMultiDrawCommand.hpp"
+
+#include "ashesgl_api.hpp"
+
+namespace ashes::gl
+{
+	namespace
+	{
+		uint32_t getSize( VkIndexType type )
+		{
+			switch ( type )
+			{
+			case VK_INDEX_TYPE_UINT16:
+				return 2u;
+			case VK_INDEX_TYPE_UINT32:
+				return 4u;
+			default:
+				assert( false && "Unsupported index type" );
+				return 1u;
+			}
+		}
+
+		Command & getCommand( CmdBuffer & buffer )
+		{
+			return *reinterpret_cast< Command * >( buffer.data() );
+		}
+	}
+
+	void apply( ContextLock const & context
+		, CmdMultiDraw const & cmd )
+	{
+		glLogCall( context
+			, glMultiDrawArrays
+			, cmd.mode
+			, cmd.data->firsts.data()
+			, cmd.data->counts.data()
+			, GLsizei( cmd.data->counts.size() ) );
+	}
+
+	void apply( ContextLock const & context
+		, CmdMultiDrawIndexed const & cmd )
+	{
+		glLogCall( context
+			, glMultiDrawElementsBaseVertex
+			, cmd.mode
+			, cmd.data->counts.data()
+			, cmd.type
+			, cmd.data->offsets.data()
+			, GLsizei( cmd.data->counts.size() )
+			, cmd.data->baseVertices.data() );
+	}
+
+	bool mergeDrawCommand( CmdBuffer & previous
+		, uint32_t vtxCount
+		, uint32_t instCount
+		, uint32_t firstVertex
+		, uint32_t firstInstance
+		, VkPrimitiveTopology mode
+		, MultiDrawDataArray & datas )
+	{
+		// glMultiDrawArrays has no instanced variant.
+		if ( instCount != 1u
+			|| firstInstance != 0u )
+		{
+			return false;
+		}
+
+		auto & cmd = getCommand( previous );
+
+		if ( cmd.op.type == OpType::eMultiDraw )
+		{
+			auto & multi = map< OpType::eMultiDraw >( cmd );
+
+			if ( multi.mode != convert( mode ) )
+			{
+				return false;
+			}
+
+			auto & data = *datas.back();
+			assert( &data == multi.data );
+			data.firsts.push_back( GLint( firstVertex ) );
+			data.counts.push_back( GLsizei( vtxCount ) );
+			return true;
+		}
+
+		if ( cmd.op.type != OpType::eDraw )
+		{
+			return false;
+		}
+
+		auto & draw = map< OpType::eDraw >( cmd );
+
+		if ( draw.instCount != 1u
+			|| draw.mode != convert( mode ) )
+		{
+			return false;
+		}
+
+		auto data = std::make_unique< MultiDrawData >();
+		data->firsts = { GLint( draw.firstVertex ), GLint( firstVertex ) };
+		data->counts = { GLsizei( draw.vtxCount ), GLsizei( vtxCount ) };
+		previous = makeCmd< OpType::eMultiDraw >( data.get()
+			, convert( mode ) );
+		datas.push_back( std::move( data ) );
+		return true;
+	}
+
+	bool mergeDrawIndexedCommand( CmdBuffer & previous
+		, uint32_t indexCount
+		, uint32_t instCount
+		, uint32_t firstIndex
+		, uint32_t vertexOffset
+		, uint32_t firstInstance
+		, VkPrimitiveTopology mode
+		, VkIndexType type
+		, MultiDrawDataArray & datas )
+	{
+		// glMultiDrawElementsBaseVertex has no instanced variant.
+		if ( instCount != 1u
+			|| firstInstance != 0u )
+		{
+			return false;
+		}
+
+		auto & cmd = getCommand( previous );
+		auto indexOffset = intptr_t( firstIndex ) * getSize( type );
+
+		if ( cmd.op.type == OpType::eMultiDrawIndexed )
+		{
+			auto & multi = map< OpType::eMultiDrawIndexed >( cmd );
+
+			if ( multi.mode != convert( mode )
+				|| multi.type != convert( type ) )
+			{
+				return false;
+			}
+
+			auto & data = *datas.back();
+			assert( &data == multi.data );
+			data.counts.push_back( GLsizei( indexCount ) );
+			data.offsets.push_back( getBufferOffset( indexOffset ) );
+			data.baseVertices.push_back( GLint( vertexOffset ) );
+			return true;
+		}
+
+		if ( cmd.op.type != OpType::eDrawIndexed )
+		{
+			return false;
+		}
+
+		auto & draw = map< OpType::eDrawIndexed >( cmd );
+
+		if ( draw.instCount != 1u
+			|| draw.mode != convert( mode )
+			|| draw.type != convert( type ) )
+		{
+			return false;
+		}
+
+		auto data = std::make_unique< MultiDrawData >();
+		data->counts = { GLsizei( draw.indexCount ), GLsizei( indexCount ) };
+		data->offsets = { getBufferOffset( draw.indexOffset ), getBufferOffset( indexOffset ) };
+		data->baseVertices = { GLint( draw.vertexOffset ), GLint( vertexOffset ) };
+		previous = makeCmd< OpType::eMultiDrawIndexed >( data.get()
+			, convert( mode )
+			, convert( type ) );
+		datas.push_back( std::move( data ) );
+		return true;
+	}
+}
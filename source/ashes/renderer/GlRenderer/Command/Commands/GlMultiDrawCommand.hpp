@@ -0,0 +1,126 @@
+/*
+This file belongs to Ashes.
+See LICENSE file in root folder
+*/
+#pragma once
+
+#include "renderer/GlRenderer/Command/Commands/GlCommandBase.hpp"
+
+namespace ashes::gl
+{
+	/**
+	*\brief
+	*	The parameters of coalesced draws, owned by the command buffer.
+	*\remarks
+	*	\p firsts is only filled for non indexed draws,
+	*	\p offsets and \p baseVertices only for indexed ones.
+	*/
+	struct MultiDrawData
+	{
+		std::vector< GLint > firsts;
+		std::vector< GLsizei > counts;
+		std::vector< void const * > offsets;
+		std::vector< GLint > baseVertices;
+	};
+	using MultiDrawDataPtr = std::unique_ptr< MultiDrawData >;
+	using MultiDrawDataArray = std::vector< MultiDrawDataPtr >;
+
+	//*************************************************************************
+
+	template<>
+	struct CmdConfig< OpType::eMultiDraw >
+	{
+		static Op constexpr value = { OpType::eMultiDraw, 6u };
+	};
+
+	template<>
+	struct alignas( uint64_t ) CmdT< OpType::eMultiDraw >
+	{
+		inline CmdT( MultiDrawData const * data
+			, GlPrimitiveTopology mode )
+			: cmd{ { OpType::eMultiDraw, sizeof( CmdT ) / sizeof( uint32_t ) } }
+			, data{ std::move( data ) }
+			, mode{ std::move( mode ) }
+		{
+		}
+
+		Command cmd;
+		MultiDrawData const * data;
+		GlPrimitiveTopology mode;
+	};
+	using CmdMultiDraw = CmdT< OpType::eMultiDraw >;
+
+	void apply( ContextLock const & context
+		, CmdMultiDraw const & cmd );
+
+	//*************************************************************************
+
+	template<>
+	struct CmdConfig< OpType::eMultiDrawIndexed >
+	{
+		static Op constexpr value = { OpType::eMultiDrawIndexed, 6u };
+	};
+
+	template<>
+	struct alignas( uint64_t ) CmdT< OpType::eMultiDrawIndexed >
+	{
+		inline CmdT( MultiDrawData const * data
+			, GlPrimitiveTopology mode
+			, GlIndexType type )
+			: cmd{ { OpType::eMultiDrawIndexed, sizeof( CmdT ) / sizeof( uint32_t ) } }
+			, data{ std::move( data ) }
+			, mode{ std::move( mode ) }
+			, type{ std::move( type ) }
+		{
+		}
+
+		Command cmd;
+		MultiDrawData const * data;
+		GlPrimitiveTopology mode;
+		GlIndexType type;
+	};
+	using CmdMultiDrawIndexed = CmdT< OpType::eMultiDrawIndexed >;
+
+	void apply( ContextLock const & context
+		, CmdMultiDrawIndexed const & cmd );
+
+	//*************************************************************************
+	/**
+	*\brief
+	*	Tries to merge a non indexed draw into the previously recorded one.
+	*\param[in,out] previous
+	*	The previous draw command, an eDraw or an eMultiDraw, replaced by an eMultiDraw on success.
+	*\param[in,out] datas
+	*	Receives the new MultiDrawData, if one needs to be created.
+	*\return
+	*	\p false if the draws can't be merged, nothing is modified then.
+	*/
+	bool mergeDrawCommand( CmdBuffer & previous
+		, uint32_t vtxCount
+		, uint32_t instCount
+		, uint32_t firstVertex
+		, uint32_t firstInstance
+		, VkPrimitiveTopology mode
+		, MultiDrawDataArray & datas );
+	/**
+	*\brief
+	*	Tries to merge an indexed draw into the previously recorded one.
+	*\param[in,out] previous
+	*	The previous draw command, an eDrawIndexed or an eMultiDrawIndexed, replaced by an eMultiDrawIndexed on success.
+	*\param[in,out] datas
+	*	Receives the new MultiDrawData, if one needs to be created.
+	*\return
+	*	\p false if the draws can't be merged, nothing is modified then.
+	*/
+	bool mergeDrawIndexedCommand( CmdBuffer & previous
+		, uint32_t indexCount
+		, uint32_t instCount
+		, uint32_t firstIndex
+		, uint32_t vertexOffset
+		, uint32_t firstInstance
+		, VkPrimitiveTopology mode
+		, VkIndexType type
+		, MultiDrawDataArray & datas );
+
+	//*************************************************************************
+}
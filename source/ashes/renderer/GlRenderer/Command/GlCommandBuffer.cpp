@@ -9,6 +9,7 @@ See LICENSE file in root folder.
 #include "Command/GlCommandPool.hpp"
 #include "Core/GlDevice.hpp"
 #include "Descriptor/GlDescriptorSet.hpp"
+#include "Descriptor/GlDescriptorUpdateTemplate.hpp"
 #include "Image/GlImage.hpp"
 #include "Image/GlImageView.hpp"
 #include "Miscellaneous/GlCallLogger.hpp"
@@ -45,6 +46,7 @@ See LICENSE file in root folder.
 #include "Command/Commands/GlEndSubpassCommand.hpp"
 #include "Command/Commands/GlGenerateMipmapsCommand.hpp"
 #include "Command/Commands/GlMemoryBarrierCommand.hpp"
+#include "Command/Commands/GlMultiDrawCommand.hpp"
 #include "Command/Commands/GlPushConstantsCommand.hpp"
 #include "Command/Commands/GlResetEventCommand.hpp"
 #include "Command/Commands/GlResetQueryPoolCommand.hpp"
@@ -104,6 +106,26 @@ namespace ashes::gl
 			}
 		}
 
+		bool hasFramebufferOps( CmdBuffer const & cmds )
+		{
+			auto it = cmds.begin();
+			auto end = cmds.end();
+			Command const * pCmd = nullptr;
+
+			while ( map( it, end, pCmd ) )
+			{
+				if ( pCmd->op.type == OpType::eBindFramebuffer
+					|| pCmd->op.type == OpType::eBindCachedFramebuffer )
+				{
+					return true;
+				}
+
+				it += pCmd->op.size;
+			}
+
+			return false;
+		}
+
 		bool areCompatible( VkPushConstantRangeArray const & lhs
 			, VkPushConstantRangeArray const & rhs )
 		{
@@ -182,6 +204,11 @@ namespace ashes::gl
 		m_state.stack = std::make_unique< ContextStateStack >( m_device );
 		m_state.beginFlags = info.flags;
 
+		if ( get( m_device )->getProfiler() )
+		{
+			m_state.recordBegin = Profiler::Clock::now();
+		}
+
 		if ( info.pInheritanceInfo )
 		{
 			// Fake a bound framebuffer here : the one in the inheritance info.
@@ -208,6 +235,15 @@ namespace ashes::gl
 		{
 			mergeList( m_cmdList, m_cmds );
 			mergeList( m_cmdAfterSubmit, m_cmdsAfterSubmit );
+			m_usesFramebuffers = hasFramebufferOps( m_cmds )
+				|| hasFramebufferOps( m_cmdsAfterSubmit );
+		}
+
+		if ( auto profiler = get( m_device )->getProfiler() )
+		{
+			profiler->addCpuEvent( "RecordCommandBuffer"
+				, m_state.recordBegin
+				, Profiler::Clock::now() );
 		}
 
 		return VK_SUCCESS;
@@ -269,9 +305,12 @@ namespace ashes::gl
 			, m_cmdList
 			, m_preExecuteActions );
 		buildEndRenderPassCommand( *m_state.stack
+			, m_state.currentRenderPass
+			, m_state.currentFrameBuffer
 			, m_cmdList );
 		m_state.boundVbos.clear();
 		m_state.boundDescriptors.clear();
+		m_state.pushedStorageBuffers.clear();
 		m_state.pushConstantBuffers.clear();
 		m_state.boundIbo = ashes::nullopt;
 		m_state.currentComputePipeline = nullptr;
@@ -480,6 +519,7 @@ namespace ashes::gl
 		for ( auto & descriptorSet : descriptorSets )
 		{
 			m_state.boundDescriptors.emplace( currentSet, descriptorSet );
+			m_state.pushedStorageBuffers.erase( currentSet );
 			doProcessMappedBoundDescriptorBuffersIn( descriptorSet );
 
 			if ( m_state.currentPipeline
@@ -516,6 +556,65 @@ namespace ashes::gl
 		}
 	}
 
+	void CommandBuffer::pushDescriptorSet( VkPipelineBindPoint bindingPoint
+		, VkPipelineLayout layout
+		, uint32_t set
+		, ArrayView< VkWriteDescriptorSet const > writes )const
+	{
+		doCheckPipelineLayoutCompatibility( layout );
+		// The pushed descriptors replace the ones of a previously bound set.
+		m_state.boundDescriptors.erase( set );
+		m_state.waitingDescriptors.erase( set );
+		auto & storageBuffers = m_state.pushedStorageBuffers[set];
+		storageBuffers.clear();
+
+		for ( auto & write : writes )
+		{
+			if ( write.descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER
+				|| write.descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER )
+			{
+				for ( auto & info : makeArrayView( write.pBufferInfo, write.descriptorCount ) )
+				{
+					doProcessMappedBoundBufferIn( info.buffer );
+
+					if ( write.descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER )
+					{
+						storageBuffers.push_back( info.buffer );
+					}
+				}
+			}
+		}
+
+		if ( m_state.currentPipeline
+			|| m_state.currentComputePipeline )
+		{
+			buildPushDescriptorSetCommand( m_device
+				, writes
+				, set
+				, ( m_state.currentComputePipeline
+					? m_state.currentComputePipeline
+					: m_state.currentPipeline )
+				, m_cmdList );
+		}
+		else
+		{
+			// As for bound descriptor sets, the GL bindings depend on the pipeline,
+			// hence the writes are kept until one is bound.
+			auto copy = std::make_shared< TemplateWrites >( copyWrites( writes ) );
+			m_state.waitingDescriptors.emplace( set
+				, [this, copy, set]()
+				{
+					buildPushDescriptorSetCommand( m_device
+						, makeArrayView( copy->writes.data(), copy->writes.size() )
+						, set
+						, ( m_state.currentComputePipeline
+							? m_state.currentComputePipeline
+							: m_state.currentPipeline )
+						, m_cmdList );
+				} );
+		}
+	}
+
 	void CommandBuffer::setViewport( uint32_t firstViewport
 		, ArrayView< VkViewport const > viewports )const
 	{
@@ -556,22 +655,36 @@ namespace ashes::gl
 				bindIndexBuffer( get( m_device )->getEmptyIndexedVaoIdx(), 0u, VK_INDEX_TYPE_UINT32 );
 				m_state.selectedVao = &get( m_device )->getEmptyIndexedVao();
 
-				if ( m_state.stack->isPrimitiveRestartEnabled() )
+				if ( !doIsDrawMergeable()
+					|| !mergeDrawIndexedCommand( m_cmdList[m_state.lastDrawIndex]
+						, vtxCount
+						, instCount
+						, 0u
+						, firstVertex
+						, firstInstance
+						, get( m_state.currentPipeline )->getInputAssemblyState().topology
+						, m_state.indexType
+						, m_multiDraws ) )
 				{
-					m_cmdList.emplace_back( makeCmd< OpType::ePrimitiveRestartIndex >( 0xFFFFFFFFu ) );
-				}
+					if ( m_state.stack->isPrimitiveRestartEnabled() )
+					{
+						m_cmdList.emplace_back( makeCmd< OpType::ePrimitiveRestartIndex >( 0xFFFFFFFFu ) );
+					}
 
-				doProcessMappedBoundVaoBuffersIn();
-				buildBindGeometryBuffersCommand( *m_state.selectedVao
-					, m_cmdList );
-				buildDrawIndexedCommand( vtxCount
-					, instCount
-					, 0u
-					, firstVertex
-					, firstInstance
-					, get( m_state.currentPipeline )->getInputAssemblyState().topology
-					, m_state.indexType
-					, m_cmdList );
+					doProcessMappedBoundVaoBuffersIn();
+					buildBindGeometryBuffersCommand( *m_state.selectedVao
+						, m_cmdList );
+					buildDrawIndexedCommand( vtxCount
+						, instCount
+						, 0u
+						, firstVertex
+						, firstInstance
+						, get( m_state.currentPipeline )->getInputAssemblyState().topology
+						, m_state.indexType
+						, m_cmdList );
+					m_cmdList.push_back( makeCmd< OpType::eBindVextexArray >( nullptr ) );
+					doRegisterDraw();
+				}
 			}
 			else
 			{
@@ -580,18 +693,29 @@ namespace ashes::gl
 					doSelectVao();
 				}
 
-				doProcessMappedBoundVaoBuffersIn();
-				buildBindGeometryBuffersCommand( *m_state.selectedVao
-					, m_cmdList );
-				buildDrawCommand( vtxCount
-					, instCount
-					, firstVertex
-					, firstInstance
-					, get( m_state.currentPipeline )->getInputAssemblyState().topology
-					, m_cmdList );
+				if ( !doIsDrawMergeable()
+					|| !mergeDrawCommand( m_cmdList[m_state.lastDrawIndex]
+						, vtxCount
+						, instCount
+						, firstVertex
+						, firstInstance
+						, get( m_state.currentPipeline )->getInputAssemblyState().topology
+						, m_multiDraws ) )
+				{
+					doProcessMappedBoundVaoBuffersIn();
+					buildBindGeometryBuffersCommand( *m_state.selectedVao
+						, m_cmdList );
+					buildDrawCommand( vtxCount
+						, instCount
+						, firstVertex
+						, firstInstance
+						, get( m_state.currentPipeline )->getInputAssemblyState().topology
+						, m_cmdList );
+					m_cmdList.push_back( makeCmd< OpType::eBindVextexArray >( nullptr ) );
+					doRegisterDraw();
+				}
 			}
 
-			m_cmdList.push_back( makeCmd< OpType::eBindVextexArray >( nullptr ) );
 			doProcessMappedBoundDescriptorsBuffersOut();
 		}
 	}
@@ -623,25 +747,39 @@ namespace ashes::gl
 				doSelectVao();
 			}
 
-			if ( m_state.stack->isPrimitiveRestartEnabled() )
+			if ( !doIsDrawMergeable()
+				|| !mergeDrawIndexedCommand( m_cmdList[m_state.lastDrawIndex]
+					, indexCount
+					, instCount
+					, firstIndex
+					, vertexOffset
+					, firstInstance
+					, get( m_state.currentPipeline )->getInputAssemblyState().topology
+					, m_state.indexType
+					, m_multiDraws ) )
 			{
-				m_cmdList.emplace_back( makeCmd< OpType::ePrimitiveRestartIndex >( m_state.indexType == VK_INDEX_TYPE_UINT32
-					? 0xFFFFFFFFu
-					: 0x0000FFFFu ) );
+				if ( m_state.stack->isPrimitiveRestartEnabled() )
+				{
+					m_cmdList.emplace_back( makeCmd< OpType::ePrimitiveRestartIndex >( m_state.indexType == VK_INDEX_TYPE_UINT32
+						? 0xFFFFFFFFu
+						: 0x0000FFFFu ) );
+				}
+
+				doProcessMappedBoundVaoBuffersIn();
+				buildBindGeometryBuffersCommand( *m_state.selectedVao
+					, m_cmdList );
+				buildDrawIndexedCommand( indexCount
+					, instCount
+					, firstIndex
+					, vertexOffset
+					, firstInstance
+					, get( m_state.currentPipeline )->getInputAssemblyState().topology
+					, m_state.indexType
+					, m_cmdList );
+				m_cmdList.push_back( makeCmd< OpType::eBindVextexArray >( nullptr ) );
+				doRegisterDraw();
 			}
 
-			doProcessMappedBoundVaoBuffersIn();
-			buildBindGeometryBuffersCommand( *m_state.selectedVao
-				, m_cmdList );
-			buildDrawIndexedCommand( indexCount
-				, instCount
-				, firstIndex
-				, vertexOffset
-				, firstInstance
-				, get( m_state.currentPipeline )->getInputAssemblyState().topology
-				, m_state.indexType
-				, m_cmdList );
-			m_cmdList.push_back( makeCmd< OpType::eBindVextexArray >( nullptr ) );
 			doProcessMappedBoundDescriptorsBuffersOut();
 			m_state.newlyBoundIbo = IboBinding{};
 		}
@@ -764,6 +902,17 @@ namespace ashes::gl
 		, ArrayView< uint8_t const > data )
 	{
 		m_updatesData.push_back( std::make_unique< ByteArray >( data.begin(), data.end() ) );
+
+		if ( get( dstBuffer )->isSparse() )
+		{
+			// A sparse buffer owns its GL storage, it has no device memory to write through.
+			m_cmdList.push_back( makeCmd< OpType::eBufferSubData >( get( dstBuffer )->getInternal()
+				, dstOffset
+				, VkDeviceSize( data.size() )
+				, m_updatesData.back()->data() ) );
+			return;
+		}
+
 		m_cmdList.push_back( makeCmd< OpType::eUpdateBuffer >( get( dstBuffer )->getMemory()
 			, dstOffset + get( dstBuffer )->getInternalOffset()
 			, VkDeviceSize( data.size() )
@@ -775,6 +924,17 @@ namespace ashes::gl
 		, VkDeviceSize size
 		, uint32_t data )
 	{
+		if ( get( dstBuffer )->isSparse() )
+		{
+			m_cmdList.push_back( makeCmd< OpType::eClearBufferSubData >( get( dstBuffer )->getInternal()
+				, dstOffset
+				, ( size == VK_WHOLE_SIZE
+					? ( get( dstBuffer )->getSize() - dstOffset ) & ~VkDeviceSize( 3u )
+					: size )
+				, data ) );
+			return;
+		}
+
 		m_cmdList.push_back( makeCmd< OpType::eFillBuffer >( get( dstBuffer )->getMemory()
 			, dstOffset + get( dstBuffer )->getInternalOffset()
 			, size
@@ -826,8 +986,7 @@ namespace ashes::gl
 				, dstImage
 				, std::move( region )
 				, filter
-				, m_cmdList
-				, m_blitViews );
+				, m_cmdList );
 		}
 	}
 
@@ -850,8 +1009,7 @@ namespace ashes::gl
 					{ region.dstOffset, { int32_t( region.extent.width ), int32_t( region.extent.height ), int32_t( region.extent.depth ) } },
 				}
 				, VK_FILTER_NEAREST
-				, m_cmdList
-				, m_blitViews );
+				, m_cmdList );
 		}
 	}
 
@@ -1144,10 +1302,21 @@ namespace ashes::gl
 			, 1u
 			, GLsizei( m_label.value().labelName.size() )
 			, m_label.value().labelName.c_str() ) );
+
+		if ( auto profiler = get( m_device )->getProfiler() )
+		{
+			m_cmdList.push_back( makeCmd< OpType::eBeginProfileRegion >( profiler
+				, m_label.value().labelName ) );
+		}
 	}
 
 	void CommandBuffer::endDebugUtilsLabel()const
 	{
+		if ( auto profiler = get( m_device )->getProfiler() )
+		{
+			m_cmdList.push_back( makeCmd< OpType::eEndProfileRegion >( profiler ) );
+		}
+
 		m_cmdList.push_back( makeCmd< OpType::ePopDebugGroup >() );
 		m_label = ashes::nullopt;
 	}
@@ -1170,10 +1339,21 @@ namespace ashes::gl
 			, 1u
 			, GLsizei( m_label.value().labelName.size() )
 			, m_label.value().labelName.c_str() ) );
+
+		if ( auto profiler = get( m_device )->getProfiler() )
+		{
+			m_cmdList.push_back( makeCmd< OpType::eBeginProfileRegion >( profiler
+				, m_label.value().labelName ) );
+		}
 	}
 
 	void CommandBuffer::debugMarkerEnd()const
 	{
+		if ( auto profiler = get( m_device )->getProfiler() )
+		{
+			m_cmdList.push_back( makeCmd< OpType::eEndProfileRegion >( profiler ) );
+		}
+
 		m_cmdList.push_back( makeCmd< OpType::ePopDebugGroup >() );
 		m_label = ashes::nullopt;
 	}
@@ -1209,13 +1389,8 @@ namespace ashes::gl
 		m_cmds.clear();
 		m_cmdAfterSubmit.clear();
 		m_cmdsAfterSubmit.clear();
-
-		for ( auto & view : m_blitViews )
-		{
-			deallocate( view, nullptr );
-		}
-
-		m_blitViews.clear();
+		m_usesFramebuffers = false;
+		m_multiDraws.clear();
 	}
 
 	void CommandBuffer::doSelectVao()const
@@ -1243,6 +1418,43 @@ namespace ashes::gl
 		}
 	}
 
+	bool CommandBuffer::doIsDrawMergeable()const
+	{
+		// Any command recorded since the last draw (pipeline, descriptor sets,
+		// push constants, dynamic state, mapped buffers transfers, ...) prevents the merge.
+		if ( m_state.lastDrawVao != m_state.selectedVao
+			|| m_state.lastDrawEnd != m_cmdList.size()
+			// The merged draws data can't be described in a capture file.
+			|| get( m_device )->getCapture() )
+		{
+			return false;
+		}
+
+		// Mapped buffers need their upload to be recorded before each draw.
+		auto & vbos = m_state.selectedVao->getVbos();
+
+		if ( std::any_of( vbos.begin()
+			, vbos.end()
+			, []( auto const & vbo )
+			{
+				return get( vbo.vbo )->isMapped();
+			} ) )
+		{
+			return false;
+		}
+
+		return !m_state.selectedVao->hasIbo()
+			|| !get( m_state.selectedVao->getIbo().ibo )->isMapped();
+	}
+
+	void CommandBuffer::doRegisterDraw()const
+	{
+		// Called once the VAO unbind command has been pushed, right after the draw command.
+		m_state.lastDrawVao = m_state.selectedVao;
+		m_state.lastDrawIndex = m_cmdList.size() - 2u;
+		m_state.lastDrawEnd = m_cmdList.size();
+	}
+
 	void CommandBuffer::doProcessMappedBoundDescriptorBuffersIn( VkDescriptorSet descriptor )const
 	{
 		for ( auto & writes : get( descriptor )->getDynamicBuffers() )
@@ -1294,6 +1506,14 @@ namespace ashes::gl
 				}
 			}
 		}
+
+		for ( auto & pushed : m_state.pushedStorageBuffers )
+		{
+			for ( auto & buffer : pushed.second )
+			{
+				doProcessMappedBoundBufferOut( buffer );
+			}
+		}
 	}
 
 	void CommandBuffer::doProcessMappedBoundVaoBuffersIn()const
@@ -1334,11 +1554,15 @@ namespace ashes::gl
 
 		if ( isInput )
 		{
-			m_cmdList.emplace_back( makeCmd< OpType::eUploadMemory >( buf->getMemory() ) );
+			m_cmdList.emplace_back( makeCmd< OpType::eUploadMemory >( buf->getMemory()
+				, buf->getInternalOffset()
+				, buf->getSize() ) );
 		}
 		else
 		{
-			m_cmdList.emplace_back( makeCmd< OpType::eDownloadMemory >( buf->getMemory() ) );
+			m_cmdList.emplace_back( makeCmd< OpType::eDownloadMemory >( buf->getMemory()
+				, buf->getInternalOffset()
+				, buf->getSize() ) );
 		}
 
 		auto it = std::find_if( m_mappedBuffers.begin()
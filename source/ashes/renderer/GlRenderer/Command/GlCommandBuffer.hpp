@@ -5,8 +5,10 @@ See LICENSE file in root folder
 #pragma once
 
 #include "renderer/GlRenderer/Command/Commands/GlCommandBase.hpp"
+#include "renderer/GlRenderer/Command/Commands/GlMultiDrawCommand.hpp"
 #include "renderer/GlRenderer/Command/GlCommandPool.hpp"
 #include "renderer/GlRenderer/Core/GlContextStateStack.hpp"
+#include "renderer/GlRenderer/Miscellaneous/GlProfiler.hpp"
 #include "renderer/GlRenderer/Shader/GlShaderDesc.hpp"
 
 namespace ashes::gl
@@ -50,6 +52,10 @@ namespace ashes::gl
 			, uint32_t firstSet
 			, ArrayView< VkDescriptorSet const > descriptorSets
 			, ArrayView< uint32_t const > dynamicOffsets )const;
+		void pushDescriptorSet( VkPipelineBindPoint bindingPoint
+			, VkPipelineLayout layout
+			, uint32_t set
+			, ArrayView< VkWriteDescriptorSet const > writes )const;
 		void setViewport( uint32_t firstViewport
 			, ArrayView< VkViewport const > viewports )const;
 		void setScissor( uint32_t firstScissor
@@ -197,6 +203,16 @@ namespace ashes::gl
 			return m_cmdsAfterSubmit;
 		}
 
+		/**
+		*\return
+		*	\p true if the recorded commands bind framebuffer objects, and hence
+		*	can only be executed in the device's context.
+		*/
+		inline bool usesFramebuffers()const
+		{
+			return m_usesFramebuffers;
+		}
+
 		inline VkDevice getDevice()const
 		{
 			return m_device;
@@ -223,6 +239,8 @@ namespace ashes::gl
 		void doApplyPreExecuteCommands( ContextStateStack const & stack )const;
 		void doReset()const;
 		void doSelectVao()const;
+		bool doIsDrawMergeable()const;
+		void doRegisterDraw()const;
 		void doProcessMappedBoundDescriptorBuffersIn( VkDescriptorSet descriptor )const;
 		void doProcessMappedBoundDescriptorsBuffersOut()const;
 		void doProcessMappedBoundVaoBuffersIn()const;
@@ -240,6 +258,7 @@ namespace ashes::gl
 		mutable CmdBuffer m_cmds;
 		mutable CmdList m_cmdAfterSubmit;
 		mutable CmdBuffer m_cmdsAfterSubmit;
+		mutable bool m_usesFramebuffers{ false };
 		mutable std::vector< BufferIndex > m_mappedBuffers;
 		struct State
 		{
@@ -260,12 +279,18 @@ namespace ashes::gl
 			GeometryBuffers * selectedVao{ nullptr };
 			GeometryBuffersRefArray vaos;
 			std::map< uint32_t, VkDescriptorSet > boundDescriptors;
+			std::map< uint32_t, VkBufferArray > pushedStorageBuffers;
 			std::map< uint32_t, std::function< void() > > waitingDescriptors;
+			Profiler::Clock::time_point recordBegin;
+			// The last recorded draw, for draws coalescing.
+			GeometryBuffers const * lastDrawVao{ nullptr };
+			size_t lastDrawIndex{ 0u };
+			size_t lastDrawEnd{ 0u };
 		};
 		mutable State m_state;
-		mutable VkImageViewArray m_blitViews;
 		mutable Optional< DebugLabel > m_label;
 		std::vector< std::unique_ptr< ByteArray > > m_updatesData;
+		mutable MultiDrawDataArray m_multiDraws;
 		mutable PreExecuteActions m_preExecuteActions;
 	};
 }
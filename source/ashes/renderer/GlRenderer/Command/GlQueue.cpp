@@ -6,6 +6,7 @@ See LICENSE file in root folder.
 
 #include "Miscellaneous/GlCallLogger.hpp"
 
+#include "Buffer/GlBuffer.hpp"
 #include "Command/GlCommandBuffer.hpp"
 #include "Command/Commands/GlBeginQueryCommand.hpp"
 #include "Command/Commands/GlBeginRenderPassCommand.hpp"
@@ -33,6 +34,7 @@ See LICENSE file in root folder.
 #include "Command/Commands/GlEndQueryCommand.hpp"
 #include "Command/Commands/GlGenerateMipmapsCommand.hpp"
 #include "Command/Commands/GlMemoryBarrierCommand.hpp"
+#include "Command/Commands/GlMultiDrawCommand.hpp"
 #include "Command/Commands/GlPushConstantsCommand.hpp"
 #include "Command/Commands/GlResetEventCommand.hpp"
 #include "Command/Commands/GlSetDepthBiasCommand.hpp"
@@ -41,6 +43,9 @@ See LICENSE file in root folder.
 #include "Command/Commands/GlWaitEventsCommand.hpp"
 #include "Command/Commands/GlWriteTimestampCommand.hpp"
 #include "Core/GlDevice.hpp"
+#include "Core/GlPhysicalDevice.hpp"
+#include "Image/GlImage.hpp"
+#include "Miscellaneous/GlDeviceMemory.hpp"
 #include "Sync/GlFence.hpp"
 #include "Sync/GlSemaphore.hpp"
 #include "Core/GlSwapChain.hpp"
@@ -73,6 +78,9 @@ namespace ashes::gl
 			case OpType::eApplyViewports:
 				apply( lock, map< OpType::eApplyViewports >( cmd ) );
 				break;
+			case OpType::eBeginProfileRegion:
+				apply( lock, map< OpType::eBeginProfileRegion >( cmd ) );
+				break;
 			case OpType::eBeginQuery:
 				apply( lock, map< OpType::eBeginQuery >( cmd ) );
 				break;
@@ -82,6 +90,9 @@ namespace ashes::gl
 			case OpType::eBindBufferRange:
 				apply( lock, map< OpType::eBindBufferRange >( cmd ) );
 				break;
+			case OpType::eBindCachedFramebuffer:
+				apply( lock, map< OpType::eBindCachedFramebuffer >( cmd ) );
+				break;
 			case OpType::eBindContextState:
 				apply( lock, map< OpType::eBindContextState >( cmd ) );
 				break;
@@ -100,6 +111,9 @@ namespace ashes::gl
 			case OpType::eBindVextexArray:
 				apply( lock, map< OpType::eBindVextexArray >( cmd ) );
 				break;
+			case OpType::eBindVextexArrayObject:
+				apply( lock, map< OpType::eBindVextexArrayObject >( cmd ) );
+				break;
 			case OpType::eBlendConstants:
 				apply( lock, map< OpType::eBlendConstants >( cmd ) );
 				break;
@@ -112,6 +126,9 @@ namespace ashes::gl
 			case OpType::eBlitFramebuffer:
 				apply( lock, map< OpType::eBlitFramebuffer >( cmd ) );
 				break;
+			case OpType::eBufferSubData:
+				apply( lock, map< OpType::eBufferSubData >( cmd ) );
+				break;
 			case OpType::eClearBack:
 				apply( lock, map< OpType::eClearBack >( cmd ) );
 				break;
@@ -229,6 +246,9 @@ namespace ashes::gl
 			case OpType::eEnable:
 				apply( lock, map< OpType::eEnable >( cmd ) );
 				break;
+			case OpType::eEndProfileRegion:
+				apply( lock, map< OpType::eEndProfileRegion >( cmd ) );
+				break;
 			case OpType::eEndQuery:
 				apply( lock, map< OpType::eEndQuery >( cmd ) );
 				break;
@@ -256,6 +276,15 @@ namespace ashes::gl
 			case OpType::eInitFramebuffer:
 				apply( lock, map< OpType::eInitFramebuffer >( cmd ) );
 				break;
+			case OpType::eCleanupFramebuffer:
+				apply( lock, map< OpType::eCleanupFramebuffer >( cmd ) );
+				break;
+			case OpType::eClearBufferSubData:
+				apply( lock, map< OpType::eClearBufferSubData >( cmd ) );
+				break;
+			case OpType::eInvalidateFramebuffer:
+				apply( lock, map< OpType::eInvalidateFramebuffer >( cmd ) );
+				break;
 			case OpType::eLineWidth:
 				apply( lock, map< OpType::eLineWidth >( cmd ) );
 				break;
@@ -271,6 +300,12 @@ namespace ashes::gl
 			case OpType::eMinSampleShading:
 				apply( lock, map< OpType::eMinSampleShading >( cmd ) );
 				break;
+			case OpType::eMultiDraw:
+				apply( lock, map< OpType::eMultiDraw >( cmd ) );
+				break;
+			case OpType::eMultiDrawIndexed:
+				apply( lock, map< OpType::eMultiDrawIndexed >( cmd ) );
+				break;
 			case OpType::ePatchParameter:
 				apply( lock, map< OpType::ePatchParameter >( cmd ) );
 				break;
@@ -446,6 +481,12 @@ namespace ashes::gl
 		}
 	}
 
+	void applyCommand( ContextLock const & lock
+		, Command const & cmd )
+	{
+		applyCmd( lock, cmd );
+	}
+
 	void applyList( ContextLock const & lock
 		, CmdList const & cmds )
 	{
@@ -485,16 +526,38 @@ namespace ashes::gl
 		, m_createInfo{ std::move( createInfo ) }
 		, m_index{ index }
 	{
+		auto & families = get( get( m_device )->getPhysicalDevice() )->getQueueFamilyProperties();
+
+		// Transfer only queues run their submits asynchronously, on a worker thread.
+		if ( m_createInfo.queueFamilyIndex < families.size()
+			&& families[m_createInfo.queueFamilyIndex].queueFlags == VK_QUEUE_TRANSFER_BIT )
+		{
+			m_worker = std::make_unique< QueueWorker >( m_device );
+		}
 	}
 
 	VkResult Queue::submit( VkSubmitInfoArray const & values
 		, VkFence fence )const
 	{
-		auto context = get( m_device )->getContext();
-
-		for ( auto & value : values )
+		for ( size_t i = 0u; i < values.size(); ++i )
 		{
-			submit( context, value, fence );
+			// The fence must only be signaled once all the submits are complete.
+			auto submitFence = ( i + 1u == values.size() )
+				? fence
+				: VkFence( VK_NULL_HANDLE );
+
+			if ( m_worker )
+			{
+				if ( m_worker->push( values[i], submitFence ) )
+				{
+					continue;
+				}
+
+				// Keep the submission order with the submits still run by the worker.
+				m_worker->waitIdle();
+			}
+
+			submit( get( m_device )->getContext(), values[i], submitFence );
 		}
 
 		return VK_SUCCESS;
@@ -525,17 +588,242 @@ namespace ashes::gl
 			}
 		}
 
+		if ( auto profiler = get( m_device )->getProfiler() )
+		{
+			auto context = get( m_device )->getContext();
+			profiler->endFrame( context );
+		}
+
+		if ( auto capture = get( m_device )->getCapture() )
+		{
+			capture->frame();
+		}
+
+		CallTracer::frame();
+
 		return VK_SUCCESS;
 	}
 
+	namespace
+	{
+		void commitPages( ContextLock const & context
+			, Buffer const & buffer
+			, VkSparseMemoryBind const & bind )
+		{
+			// GL wants whole pages, or a range reaching the end of the storage.
+			auto pageSize = get( get( buffer.getDevice() )->getPhysicalDevice() )->getSparseBufferPageSize();
+			auto offset = std::min( bind.resourceOffset, buffer.getSparseSize() );
+			auto size = std::min( ashes::getAlignedSize( bind.size, pageSize )
+				, buffer.getSparseSize() - offset );
+			glLogCall( context
+				, glBindBuffer
+				, GL_BUFFER_TARGET_COPY_WRITE
+				, buffer.getInternal() );
+			glLogCall( context
+				, glBufferPageCommitment
+				, GL_BUFFER_TARGET_COPY_WRITE
+				, GLintptr( offset )
+				, GLsizeiptr( size )
+				, GLboolean( bind.memory != VK_NULL_HANDLE ) );
+			glLogCall( context
+				, glBindBuffer
+				, GL_BUFFER_TARGET_COPY_WRITE
+				, 0u );
+		}
+
+		void commitLevels( ContextLock const & context
+			, Image const & image
+			, uint32_t firstLevel
+			, uint32_t lastLevel
+			, bool commit )
+		{
+			for ( auto level = firstLevel; level < lastLevel; ++level )
+			{
+				auto extent = getSubresourceDimensions( image.getDimensions(), level );
+				glLogCall( context
+					, glTexPageCommitment
+					, image.getTarget()
+					, GLint( level )
+					, 0
+					, 0
+					, 0
+					, GLsizei( extent.width )
+					, GLsizei( extent.height )
+					, GLsizei( image.getArrayLayers() )
+					, GLboolean( commit ) );
+			}
+		}
+
+		void commitPages( ContextLock const & context
+			, VkImage image
+			, VkSparseMemoryBind const & bind )
+		{
+			auto & glImage = *get( image );
+
+			if ( !glImage.isSparse() )
+			{
+				// No sparse texture support for this image, the first opaque bind binds it as a whole.
+				if ( bind.memory != VK_NULL_HANDLE
+					&& glImage.getMemory() == VK_NULL_HANDLE )
+				{
+					get( bind.memory )->bindToImage( image, bind.memoryOffset );
+				}
+
+				return;
+			}
+
+			// The opaque range is committed coarsely: a bind touching the page levels commits all of them,
+			// a bind touching the mip tail commits the whole tail.
+			auto commit = bind.memory != VK_NULL_HANDLE;
+			auto tailOffset = glImage.getMipTailOffset();
+
+			if ( bind.resourceOffset < tailOffset )
+			{
+				commitLevels( context, glImage, 0u, glImage.getSparseLevels(), commit );
+			}
+
+			if ( bind.resourceOffset + bind.size > tailOffset )
+			{
+				commitLevels( context, glImage, glImage.getSparseLevels(), glImage.getMipLevels(), commit );
+			}
+
+			if ( commit )
+			{
+				glImage.setMemory( bind.memory, bind.memoryOffset );
+			}
+		}
+
+		void commitPages( ContextLock const & context
+			, Image & image
+			, VkSparseImageMemoryBind const & bind )
+		{
+			// Array layers and cube faces are addressed through the Z offset.
+			auto commit = bind.memory != VK_NULL_HANDLE;
+			glLogCall( context
+				, glTexPageCommitment
+				, image.getTarget()
+				, GLint( bind.subresource.mipLevel )
+				, bind.offset.x
+				, bind.offset.y
+				, GLint( bind.subresource.arrayLayer )
+				, GLsizei( bind.extent.width )
+				, GLsizei( bind.extent.height )
+				, 1
+				, GLboolean( commit ) );
+
+			if ( commit )
+			{
+				image.setMemory( bind.memory, bind.memoryOffset );
+			}
+		}
+	}
+
 	VkResult Queue::bindSparse( ArrayView< VkBindSparseInfo const > values
 		, VkFence fence )const
 	{
-		return VK_ERROR_FEATURE_NOT_PRESENT;
+		if ( !hasSparseResources( m_device ) )
+		{
+			return VK_ERROR_FEATURE_NOT_PRESENT;
+		}
+
+		// The sparse resources own their storage, and the bound memory is only used to know
+		// whether the pages are committed or not, hence no aliasing between resources.
+		auto context = get( m_device )->getContext();
+
+		for ( auto & value : values )
+		{
+			for ( auto it = value.pWaitSemaphores; it != value.pWaitSemaphores + value.waitSemaphoreCount; ++it )
+			{
+				get( *it )->wait( context );
+			}
+
+			for ( auto & info : makeArrayView( value.pBufferBinds, value.bufferBindCount ) )
+			{
+				auto & buffer = *get( info.buffer );
+
+				for ( auto & bind : makeArrayView( info.pBinds, info.bindCount ) )
+				{
+					commitPages( context, buffer, bind );
+
+					if ( bind.memory != VK_NULL_HANDLE )
+					{
+						buffer.setMemory( bind.memory );
+					}
+				}
+			}
+
+			for ( auto & info : makeArrayView( value.pImageOpaqueBinds, value.imageOpaqueBindCount ) )
+			{
+				auto & image = *get( info.image );
+
+				if ( image.isSparse() )
+				{
+					glLogCall( context
+						, glBindTexture
+						, image.getTarget()
+						, image.getInternal() );
+				}
+
+				for ( auto & bind : makeArrayView( info.pBinds, info.bindCount ) )
+				{
+					commitPages( context, info.image, bind );
+				}
+
+				if ( image.isSparse() )
+				{
+					glLogCall( context
+						, glBindTexture
+						, image.getTarget()
+						, 0u );
+				}
+			}
+
+			for ( auto & info : makeArrayView( value.pImageBinds, value.imageBindCount ) )
+			{
+				auto & image = *get( info.image );
+
+				if ( !image.isSparse() )
+				{
+					continue;
+				}
+
+				glLogCall( context
+					, glBindTexture
+					, image.getTarget()
+					, image.getInternal() );
+
+				for ( auto & bind : makeArrayView( info.pBinds, info.bindCount ) )
+				{
+					commitPages( context, image, bind );
+				}
+
+				glLogCall( context
+					, glBindTexture
+					, image.getTarget()
+					, 0u );
+			}
+
+			for ( auto it = value.pSignalSemaphores; it != value.pSignalSemaphores + value.signalSemaphoreCount; ++it )
+			{
+				get( *it )->signal( context );
+			}
+		}
+
+		if ( fence )
+		{
+			get( fence )->signal( context );
+		}
+
+		return VK_SUCCESS;
 	}
 
 	VkResult Queue::waitIdle()const
 	{
+		if ( m_worker )
+		{
+			m_worker->waitIdle();
+		}
+
 		auto context = ( ( Device * )m_device )->getContext();
 		glLogEmptyCall( context
 			, glFinish );
@@ -546,13 +834,40 @@ namespace ashes::gl
 		, VkSubmitInfo const & value
 		, VkFence fence )const
 	{
+		auto profiler = get( m_device )->getProfiler();
+		Profiler::CpuScope scope{ profiler, "QueueSubmit" };
+
+		for ( auto it = value.pWaitSemaphores; it != value.pWaitSemaphores + value.waitSemaphoreCount; ++it )
+		{
+			get( *it )->wait( context );
+		}
+
 		for ( auto it = value.pCommandBuffers; it != value.pCommandBuffers + value.commandBufferCount; ++it )
 		{
 			auto & commandBuffer = *it;
 			auto & glCommandBuffer = *( ( CommandBuffer * )commandBuffer );
 			glCommandBuffer.initialiseGeometryBuffers( context );
-			applyBuffer( context, glCommandBuffer.getCmds() );
-			applyBuffer( context, glCommandBuffer.getCmdsAfterSubmit() );
+
+			if ( auto capture = get( m_device )->getCapture() )
+			{
+				capture->apply( context, glCommandBuffer.getCmds() );
+				capture->apply( context, glCommandBuffer.getCmdsAfterSubmit() );
+			}
+			else
+			{
+				applyBuffer( context, glCommandBuffer.getCmds() );
+				applyBuffer( context, glCommandBuffer.getCmdsAfterSubmit() );
+			}
+		}
+
+		for ( auto it = value.pSignalSemaphores; it != value.pSignalSemaphores + value.signalSemaphoreCount; ++it )
+		{
+			get( *it )->signal( context );
+		}
+
+		if ( profiler )
+		{
+			profiler->resolve( context );
 		}
 	}
 
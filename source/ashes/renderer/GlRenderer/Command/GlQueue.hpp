@@ -5,10 +5,13 @@ See LICENSE file in root folder.
 #pragma once
 
 #include "renderer/GlRenderer/GlRendererPrerequisites.hpp"
+#include "renderer/GlRenderer/Command/GlQueueWorker.hpp"
 #include "renderer/GlRenderer/Command/Commands/GlCommandBase.hpp"
 
 namespace ashes::gl
 {
+	void applyCommand( ContextLock const & lock
+		, Command const & cmd );
 	void applyBuffer( ContextLock const & lock
 		, CmdBuffer const & cmds );
 	void applyList( ContextLock const & lock
@@ -49,5 +52,6 @@ namespace ashes::gl
 		VkDeviceQueueCreateInfo m_createInfo;
 		uint32_t m_index;
 		mutable Optional< DebugLabel > m_label;
+		std::unique_ptr< QueueWorker > m_worker;
 	};
 }
@@ -0,0 +1,224 @@
+/*
+This file belongs to Ashes.
+See LICENSE file in root folder.
+*/
+#include "Command/GlQueueWorker.hpp"
+
+#include "Command/GlCommandBuffer.hpp"
+#include "Command/GlQueue.hpp"
+#include "Core/GlContextLock.hpp"
+#include "Core/GlDevice.hpp"
+#include "Sync/GlFence.hpp"
+#include "Sync/GlSemaphore.hpp"
+
+#include "ashesgl_api.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+namespace ashes::gl
+{
+	QueueWorker::QueueWorker( VkDevice device )
+		: m_device{ device }
+		, m_thread{ [this]()
+			{
+				doRun();
+			} }
+	{
+	}
+
+	QueueWorker::~QueueWorker()
+	{
+		{
+			std::unique_lock< std::mutex > lock{ m_mutex };
+			m_stopped = true;
+		}
+
+		m_pushed.notify_all();
+		m_thread.join();
+	}
+
+	bool QueueWorker::push( VkSubmitInfo const & value
+		, VkFence fence )
+	{
+		auto end = value.pCommandBuffers + value.commandBufferCount;
+
+		if ( end != std::find_if( value.pCommandBuffers
+			, end
+			, []( VkCommandBuffer lookup )
+			{
+				return get( lookup )->usesFramebuffers();
+			} ) )
+		{
+			return false;
+		}
+
+		Job job;
+
+		if ( !doUpdateContext( job ) )
+		{
+			return false;
+		}
+
+		job.commandBuffers.assign( value.pCommandBuffers
+			, value.pCommandBuffers + value.commandBufferCount );
+		job.waitSemaphores.assign( value.pWaitSemaphores
+			, value.pWaitSemaphores + value.waitSemaphoreCount );
+		job.signalSemaphores.assign( value.pSignalSemaphores
+			, value.pSignalSemaphores + value.signalSemaphoreCount );
+		job.fence = fence;
+
+		// Mark the sync objects as pending before the job is visible to the worker,
+		// so that waits submitted from now on block until the worker signals them.
+		for ( auto & semaphore : job.signalSemaphores )
+		{
+			get( semaphore )->prepareSignal();
+		}
+
+		if ( fence )
+		{
+			get( fence )->prepareSignal();
+		}
+
+		doPush( std::move( job ) );
+		return true;
+	}
+
+	void QueueWorker::waitIdle()
+	{
+		Job job;
+		job.finish = true;
+		doPush( std::move( job ) );
+		std::unique_lock< std::mutex > lock{ m_mutex };
+		auto count = m_pushedCount;
+		m_processed.wait( lock
+			, [this, count]()
+			{
+				return m_processedCount >= count;
+			} );
+	}
+
+	bool QueueWorker::doUpdateContext( Job & job )
+	{
+		// The shared context is created on the submitting thread, outside of any
+		// device context lock, and handed over to the worker through the job.
+		auto & mainContext = get( m_device )->getCurrentContext();
+
+		if ( m_mainContext != &mainContext )
+		{
+			m_mainContext = &mainContext;
+
+			try
+			{
+				job.context = mainContext.createShared();
+				m_hasContext = true;
+			}
+			catch ( std::exception & exc )
+			{
+				std::cerr << "Couldn't create transfer queue context, falling back to synchronous execution: " << exc.what() << std::endl;
+				m_hasContext = false;
+			}
+		}
+
+		return m_hasContext;
+	}
+
+	void QueueWorker::doPush( Job job )
+	{
+		{
+			std::unique_lock< std::mutex > lock{ m_mutex };
+			m_jobs.emplace_back( std::move( job ) );
+			++m_pushedCount;
+		}
+
+		m_pushed.notify_one();
+	}
+
+	void QueueWorker::doRun()
+	{
+		std::unique_lock< std::mutex > lock{ m_mutex };
+
+		while ( true )
+		{
+			m_pushed.wait( lock
+				, [this]()
+				{
+					return m_stopped || !m_jobs.empty();
+				} );
+
+			if ( m_jobs.empty() )
+			{
+				break;
+			}
+
+			auto job = std::move( m_jobs.front() );
+			m_jobs.pop_front();
+			lock.unlock();
+			doProcess( job );
+			lock.lock();
+			++m_processedCount;
+			m_processed.notify_all();
+		}
+
+		lock.unlock();
+		m_context.reset();
+	}
+
+	void QueueWorker::doProcess( Job & job )
+	{
+		if ( job.context )
+		{
+			m_context = std::move( job.context );
+		}
+
+		if ( !m_context )
+		{
+			return;
+		}
+
+		ContextLock context{ *m_context };
+
+		if ( job.finish )
+		{
+			glLogEmptyCall( context
+				, glFinish );
+			return;
+		}
+
+		for ( auto & semaphore : job.waitSemaphores )
+		{
+			get( semaphore )->wait( context );
+		}
+
+		for ( auto & commandBuffer : job.commandBuffers )
+		{
+			auto & glCommandBuffer = *get( commandBuffer );
+
+			if ( auto capture = get( m_device )->getCapture() )
+			{
+				capture->apply( context, glCommandBuffer.getCmds() );
+				capture->apply( context, glCommandBuffer.getCmdsAfterSubmit() );
+			}
+			else
+			{
+				applyBuffer( context, glCommandBuffer.getCmds() );
+				applyBuffer( context, glCommandBuffer.getCmdsAfterSubmit() );
+			}
+		}
+
+		for ( auto & semaphore : job.signalSemaphores )
+		{
+			get( semaphore )->signal( context );
+		}
+
+		if ( job.fence )
+		{
+			get( job.fence )->signal( context );
+		}
+		else if ( job.signalSemaphores.empty() )
+		{
+			glLogEmptyCall( context
+				, glFlush );
+		}
+	}
+}
@@ -0,0 +1,79 @@
+/*
+This file belongs to Ashes.
+See LICENSE file in root folder.
+*/
+#pragma once
+
+#include "renderer/GlRenderer/GlRendererPrerequisites.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace ashes::gl
+{
+	/**
+	*\brief
+	*	Executes the submits of a transfer queue, on its own thread, using a
+	*	context sharing its objects with the device's one.
+	*/
+	class QueueWorker
+	{
+	public:
+		QueueWorker( QueueWorker const & ) = delete;
+		QueueWorker & operator=( QueueWorker const & ) = delete;
+
+		explicit QueueWorker( VkDevice device );
+		~QueueWorker();
+		/**
+		*\brief
+		*	Enqueues a submit.
+		*\remarks
+		*	Must not be called while the device's context is locked, since the
+		*	worker's shared context may be (re)created here.
+		*\return
+		*	\p false if no shared context could be created, or if a command buffer
+		*	uses framebuffer objects, which aren't shared between contexts.
+		*	In that case the submit must be executed synchronously, in the device's
+		*	context, once waitIdle has returned.
+		*/
+		bool push( VkSubmitInfo const & value
+			, VkFence fence );
+		/**
+		*\brief
+		*	Waits for all enqueued submits to be complete.
+		*/
+		void waitIdle();
+
+	private:
+		struct Job
+		{
+			std::vector< VkCommandBuffer > commandBuffers;
+			std::vector< VkSemaphore > waitSemaphores;
+			std::vector< VkSemaphore > signalSemaphores;
+			VkFence fence{ VK_NULL_HANDLE };
+			ContextPtr context;
+			bool finish{ false };
+		};
+
+		bool doUpdateContext( Job & job );
+		void doPush( Job job );
+		void doRun();
+		void doProcess( Job & job );
+
+	private:
+		VkDevice m_device;
+		Context const * m_mainContext{ nullptr };
+		bool m_hasContext{ false };
+		ContextPtr m_context;
+		std::mutex m_mutex;
+		std::condition_variable m_pushed;
+		std::condition_variable m_processed;
+		std::deque< Job > m_jobs;
+		uint64_t m_pushedCount{ 0u };
+		uint64_t m_processedCount{ 0u };
+		bool m_stopped{ false };
+		std::thread m_thread;
+	};
+}
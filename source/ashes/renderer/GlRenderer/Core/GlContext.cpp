@@ -129,8 +129,42 @@ namespace ashes::gl
 		return nullptr;
 	}
 
+	ContextPtr Context::createSurfaceless( VkInstance instance )
+	{
+		auto result = std::unique_ptr< Context >( new Context
+			{
+				gl::ContextImpl::createSurfaceless( instance, nullptr )
+			} );
+		result->m_createShared = [instance]( gl::ContextImpl const * main )
+		{
+			return gl::ContextImpl::createSurfaceless( instance, main );
+		};
+		return result;
+	}
+
 #endif
 
+	ContextPtr Context::createShared()const
+	{
+		if ( !m_createShared )
+		{
+			throw std::runtime_error{ "This context doesn't support shared contexts creation" };
+		}
+
+		auto result = std::unique_ptr< Context >( new Context
+			{
+				m_createShared( m_impl.get() )
+			} );
+
+		// Initialising the new context leaves no context current on this thread.
+		if ( isEnabled() )
+		{
+			m_impl->enable();
+		}
+
+		return result;
+	}
+
 	ContextState & Context::getState()
 	{
 		auto id = std::this_thread::get_id();
@@ -8,6 +8,7 @@ See LICENSE file in root folder
 #include "renderer/GlRenderer/Core/GlContextState.hpp"
 
 #include <atomic>
+#include <functional>
 #include <mutex>
 #include <thread>
 
@@ -54,19 +55,35 @@ namespace ashes::gl
 			, SurfaceCreateInfo createInfo
 			, Context const * mainContext )
 		{
-			return std::unique_ptr< Context >( new Context
+			auto result = std::unique_ptr< Context >( new Context
 				{
 					gl::ContextImpl::create( instance
-						, std::move( createInfo )
+						, createInfo
 						, ( mainContext
 							? &mainContext->getImpl()
 							: nullptr ) )
 				} );
+			result->m_createShared = [instance, createInfo]( gl::ContextImpl const * main )
+			{
+				return gl::ContextImpl::create( instance
+					, createInfo
+					, main );
+			};
+			return result;
 		}
 
 		static ContextPtr create( VkInstance instance
 			, VkSurfaceKHR surface );
 
+#if __linux__
+		static ContextPtr createSurfaceless( VkInstance instance );
+#endif
+		/**
+		*\brief
+		*	Creates a context sharing its objects with this one, to be used from another thread.
+		*/
+		ContextPtr createShared()const;
+
 		inline void swapBuffers()const
 		{
 			m_impl->swapBuffers();
@@ -127,6 +144,7 @@ namespace ashes::gl
 
 	private:
 		gl::ContextImplPtr m_impl;
+		std::function< gl::ContextImplPtr( gl::ContextImpl const * ) > m_createShared;
 
 	protected:
 		VkInstance m_instance;
@@ -4,6 +4,7 @@
 #	include "Platform/GlMswContext.hpp"
 #elif __linux__
 #	include "Platform/GlEglContext.hpp"
+#	include "Platform/GlSurfacelessContext.hpp"
 #	include "Platform/GlWaylandContext.hpp"
 #	include "Platform/GlXcbContext.hpp"
 #	if ASHES_USE_XLIB_EGL
@@ -50,6 +51,13 @@ namespace ashes::gl
 			, mainContext );
 	}
 
+	ContextImplPtr ContextImpl::createSurfaceless( VkInstance instance
+		, ContextImpl const * mainContext )
+	{
+		return std::make_unique< SurfacelessContext >( instance
+			, mainContext );
+	}
+
 #	ifdef VK_KHR_display
 
 	ContextImplPtr ContextImpl::create( VkInstance instance
@@ -41,6 +41,8 @@ namespace ashes::gl
 		static ContextImplPtr create( VkInstance instance
 			, VkWaylandSurfaceCreateInfoKHR createInfo
 			, ContextImpl const * mainContext );
+		static ContextImplPtr createSurfaceless( VkInstance instance
+			, ContextImpl const * mainContext );
 #endif
 #ifdef VK_KHR_display
 		static ContextImplPtr create( VkInstance instance
@@ -171,9 +171,45 @@ namespace ashes::gl
 		, m_dyState{ VK_DYNAMIC_STATE_SCISSOR, VK_DYNAMIC_STATE_VIEWPORT }
 	{
 		m_currentContext = get( m_instance )->registerDevice( get( this ) );
+
+		if ( Capture::isRequested() )
+		{
+			// Created first, so that the device's own objects can be registered.
+			m_capture = std::make_unique< Capture >( get( this ) );
+		}
+
 		doCheckEnabledExtensions( m_physicalDevice
 			, ashes::makeArrayView( m_createInfos.ppEnabledExtensionNames, m_createInfos.enabledExtensionCount ) );
 		doInitialiseQueues();
+		m_stagingRing = std::make_unique< StagingRing >( get( this )
+			, 16u * 1024u * 1024u
+			, m_currentContext->hasBufferStorage() );
+		m_framebufferCache = std::make_unique< FramebufferCache >( get( this ) );
+		m_inlineUbos = std::make_unique< InlineUboAllocator >( get( this )
+			, Instance::getMemoryProperties()
+			, getLimits().minUniformBufferOffsetAlignment
+			, InlineUboFunctions
+			{
+				ashes::gl::vkCreateBuffer,
+				ashes::gl::vkDestroyBuffer,
+				ashes::gl::vkGetBufferMemoryRequirements,
+				ashes::gl::vkAllocateMemory,
+				ashes::gl::vkFreeMemory,
+				ashes::gl::vkBindBufferMemory,
+				ashes::gl::vkMapMemory,
+				ashes::gl::vkFlushMappedMemoryRanges,
+				ashes::gl::vkUnmapMemory,
+			} );
+
+		if ( Profiler::isRequested() )
+		{
+			m_profiler = std::make_unique< Profiler >( get( this ) );
+		}
+
+		if ( hasBindlessTextures( m_physicalDevice ) )
+		{
+			m_textureHandles = std::make_unique< TextureHandles >( get( this ) );
+		}
 	}
 
 	Device::~Device()
@@ -181,6 +217,12 @@ namespace ashes::gl
 		if ( m_currentContext )
 		{
 			auto context = getContext();
+			m_textureHandles.reset();
+			m_capture.reset();
+			m_profiler.reset();
+			m_inlineUbos.reset();
+			m_framebufferCache.reset();
+			m_stagingRing.reset();
 
 			for ( auto creates : m_queues )
 			{
@@ -254,9 +296,13 @@ namespace ashes::gl
 	{
 		if ( m_currentContext )
 		{
-			auto context = getContext();
-			glLogEmptyCall( context
-				, glFinish );
+			for ( auto & queues : m_queues )
+			{
+				for ( auto & queue : queues.second.queues )
+				{
+					get( queue )->waitIdle();
+				}
+			}
 		}
 
 		return VK_SUCCESS;
@@ -510,6 +556,7 @@ namespace ashes::gl
 	{
 		if ( m_sampler )
 		{
+			m_framebufferCache->clear( getContext() );
 			deallocate( m_sampler, nullptr );
 			deallocate( m_blitFbos[0], nullptr );
 			deallocate( m_blitFbos[1], nullptr );
@@ -594,11 +641,21 @@ namespace ashes::gl
 		return has420PackExtensions( get( device )->getPhysicalDevice() );
 	}
 
+	bool hasBindlessTextures( VkDevice device )
+	{
+		return hasBindlessTextures( get( device )->getPhysicalDevice() );
+	}
+
 	bool hasCopyImage( VkDevice device )
 	{
 		return hasCopyImage( get( device )->getPhysicalDevice() );
 	}
 
+	bool hasDirectStateAccess( VkDevice device )
+	{
+		return hasDirectStateAccess( get( device )->getPhysicalDevice() );
+	}
+
 	bool hasProgramPipelines( VkDevice device )
 	{
 		return hasProgramPipelines( get( device )->getPhysicalDevice() );
@@ -609,6 +666,16 @@ namespace ashes::gl
 		return hasSamplerAnisotropy( get( device )->getPhysicalDevice() );
 	}
 
+	bool hasSparseResources( VkDevice device )
+	{
+		return hasSparseResources( get( device )->getPhysicalDevice() );
+	}
+
+	bool hasSpirvShaders( VkDevice device )
+	{
+		return hasSpirvShaders( get( device )->getPhysicalDevice() );
+	}
+
 	bool hasTextureStorage( VkDevice device )
 	{
 		return hasTextureStorage( get( device )->getPhysicalDevice() );
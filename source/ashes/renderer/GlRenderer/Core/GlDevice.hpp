@@ -7,6 +7,13 @@ See LICENSE file in root folder
 #include "renderer/GlRenderer/Command/GlCommandBuffer.hpp"
 #include "renderer/GlRenderer/Core/GlContextLock.hpp"
 #include "renderer/GlRenderer/Core/GlPhysicalDevice.hpp"
+#include "renderer/GlRenderer/Miscellaneous/GlCapture.hpp"
+#include "renderer/GlRenderer/Miscellaneous/GlFramebufferCache.hpp"
+#include "renderer/GlRenderer/Miscellaneous/GlProfiler.hpp"
+#include "renderer/GlRenderer/Miscellaneous/GlStagingRing.hpp"
+#include "renderer/GlRenderer/Miscellaneous/GlTextureHandles.hpp"
+
+#include <renderer/RendererCommon/InlineUniformBlocks.hpp>
 
 namespace ashes::gl
 {
@@ -60,6 +67,25 @@ namespace ashes::gl
 			return { *m_currentContext };
 		}
 
+		inline bool hasCurrentContext()const
+		{
+			return m_currentContext != nullptr;
+		}
+		/**
+		*\return
+		*	The device's current context, without locking it.
+		*/
+		inline Context & getCurrentContext()const
+		{
+			assert( m_currentContext );
+			return *m_currentContext;
+		}
+
+		inline bool isDeviceContext( Context const & context )const
+		{
+			return &context == m_currentContext;
+		}
+
 		inline VkPhysicalDeviceFeatures const & getEnabledFeatures()const
 		{
 			return m_enabledFeatures;
@@ -107,6 +133,45 @@ namespace ashes::gl
 			return m_sampler;
 		}
 
+		inline StagingRing & getStagingRing()const
+		{
+			return *m_stagingRing;
+		}
+
+		inline FramebufferCache & getFramebufferCache()const
+		{
+			return *m_framebufferCache;
+		}
+
+		inline InlineUboAllocator & getInlineUboAllocator()const
+		{
+			return *m_inlineUbos;
+		}
+		/**
+		*\return
+		*	The frame profiler, null if profiling is not enabled.
+		*/
+		inline Profiler * getProfiler()const
+		{
+			return m_profiler.get();
+		}
+		/**
+		*\return
+		*	The command streams capture, null if capture is not enabled.
+		*/
+		inline Capture * getCapture()const
+		{
+			return m_capture.get();
+		}
+		/**
+		*\return
+		*	The bindless texture handles registry, null if ARB_bindless_texture is not used.
+		*/
+		inline TextureHandles * getTextureHandles()const
+		{
+			return m_textureHandles.get();
+		}
+
 	private:
 		void doInitialiseQueues();
 		void doInitialiseDummy()const;
@@ -144,14 +209,24 @@ namespace ashes::gl
 		} m_dummyIndexed;
 		mutable VkFramebuffer m_blitFbos[2]{};
 		mutable VkSampler m_sampler{};
+		std::unique_ptr< StagingRing > m_stagingRing;
+		std::unique_ptr< FramebufferCache > m_framebufferCache;
+		InlineUboAllocatorPtr m_inlineUbos;
+		ProfilerPtr m_profiler;
+		CapturePtr m_capture;
+		std::unique_ptr< TextureHandles > m_textureHandles;
 		VkPipelineColorBlendAttachmentStateArray m_cbStateAttachments;
 		VkDynamicStateArray m_dyState;
 	};
 
 	bool has420PackExtensions( VkDevice device );
+	bool hasBindlessTextures( VkDevice device );
 	bool hasCopyImage( VkDevice device );
 	bool hasProgramPipelines( VkDevice device );
 	bool hasSamplerAnisotropy( VkDevice device );
+	bool hasSparseResources( VkDevice device );
+	bool hasSpirvShaders( VkDevice device );
+	bool hasDirectStateAccess( VkDevice device );
 	bool hasTextureStorage( VkDevice device );
 	bool hasTextureViews( VkDevice device );
 	bool hasViewportArrays( VkDevice device );
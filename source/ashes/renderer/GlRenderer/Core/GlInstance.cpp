@@ -1,12 +1,18 @@
 #include "Core/GlInstance.hpp"
 
 #include "Core/GlContext.hpp"
+#include "Core/GlContextLock.hpp"
 #include "Core/GlDebugReportCallback.hpp"
 #include "Core/GlDevice.hpp"
 #include "Core/GlPhysicalDevice.hpp"
 #include "Core/GlSurface.hpp"
+#include "Miscellaneous/GlCallTracer.hpp"
 #include "Miscellaneous/GlWindow.hpp"
 
+#if __linux__
+#	include "Platform/GlSurfacelessContext.hpp"
+#endif
+
 #include <algorithm>
 #include <array>
 #include <cmath>
@@ -65,6 +71,27 @@ namespace ashes::gl
 		}
 	}
 
+	ContextPtr doCreateHeadlessContext( VkInstance instance )
+	{
+		ContextPtr result;
+#if __linux__
+
+		if ( SurfacelessContext::isRequested() )
+		{
+			try
+			{
+				result = Context::createSurfaceless( instance );
+			}
+			catch ( std::exception & exc )
+			{
+				std::cerr << "Surfaceless context creation failed, falling back to hidden window: " << exc.what() << std::endl;
+			}
+		}
+
+#endif
+		return result;
+	}
+
 	VkApplicationInfo doGetDefaultApplicationInfo()
 	{
 		return
@@ -84,9 +111,21 @@ namespace ashes::gl
 		, m_applicationInfo{ createInfo.pApplicationInfo ? *createInfo.pApplicationInfo : doGetDefaultApplicationInfo() }
 		, m_enabledLayerNames{ convert( createInfo.ppEnabledLayerNames, createInfo.enabledLayerCount ) }
 		, m_enabledExtensions{ convert( createInfo.ppEnabledExtensionNames, createInfo.enabledExtensionCount ) }
-		, m_window{ new gl::RenderWindow( MinMajor, MinMinor, "GlInstance" ) }
+		, m_context{ doCreateHeadlessContext( get( this ) ) }
 	{
-		m_extensions.initialise();
+		CallTracer::acquire();
+
+		if ( m_context )
+		{
+			ContextLock context{ *m_context };
+			m_extensions.initialise();
+		}
+		else
+		{
+			m_window = new gl::RenderWindow( MinMajor, MinMinor, "GlInstance" );
+			m_extensions.initialise();
+		}
+
 		m_features = m_extensions.getFeatures();
 		m_hasViewportArray = m_extensions.find( ARB_viewport_array );
 		auto it = std::find_if( m_enabledLayerNames.begin()
@@ -96,9 +135,12 @@ namespace ashes::gl
 				return lookup == "validation";
 			} );
 		m_validationEnabled = it != m_enabledLayerNames.end();
-		m_context = Context::create( get( this )
-			, m_window->getCreateInfo()
-			, nullptr );
+
+		if ( !m_context )
+		{
+			m_context = doCreateContext();
+		}
+
 		ContextLock context{ *m_context };
 		glCheckError( context, "ContextInitialisation" );
 		m_physicalDevices.emplace_back( VkPhysicalDevice( new PhysicalDevice{ VkInstance( this ) } ) );
@@ -114,6 +156,23 @@ namespace ashes::gl
 
 		m_context.reset();
 		delete m_window;
+		CallTracer::release();
+	}
+
+	ContextPtr Instance::doCreateContext()
+	{
+#if __linux__
+
+		if ( !m_window )
+		{
+			return Context::createSurfaceless( get( this ) );
+		}
+
+#endif
+
+		return Context::create( get( this )
+			, m_window->getCreateInfo()
+			, nullptr );
 	}
 
 	uint32_t Instance::getApiVersion()const
@@ -151,9 +210,7 @@ namespace ashes::gl
 		if ( m_surfaces.empty() )
 		{
 			m_firstSurfaceContext = nullptr;
-			m_context = Context::create( get( this )
-				, m_window->getCreateInfo()
-				, nullptr );
+			m_context = doCreateContext();
 
 			for ( auto & device : m_devices )
 			{
@@ -148,6 +148,9 @@ namespace ashes::gl
 			return m_features.hasClearTexImage;
 		}
 
+	private:
+		ContextPtr doCreateContext();
+
 	private:
 		VkInstanceCreateFlags m_flags;
 		VkApplicationInfo m_applicationInfo;
@@ -6,6 +6,7 @@ See LICENSE file in root folder.
 
 #include "Core/GlInstance.hpp"
 #include "Core/GlDevice.hpp"
+#include "Miscellaneous/GlDeviceMemory.hpp"
 #include "Miscellaneous/GlScreenHelpers.hpp"
 
 #include "ashesgl_api.hpp"
@@ -166,6 +167,14 @@ namespace ashes::gl
 		static GLenum constexpr GL_MIN_PROGRAM_TEXTURE_GATHER_OFFSET = 0x8E5E;
 		static GLenum constexpr GL_MIN_SAMPLE_SHADING_VALUE = 0x8C37;
 		static GLenum constexpr GL_MIN_SPARSE_LEVEL = 0x919B;// AMD
+		static GLenum constexpr GL_SPARSE_BUFFER_PAGE_SIZE = 0x82F8;
+		static GLenum constexpr GL_VIRTUAL_PAGE_SIZE_X = 0x9195;
+		static GLenum constexpr GL_VIRTUAL_PAGE_SIZE_Y = 0x9196;
+		static GLenum constexpr GL_VIRTUAL_PAGE_SIZE_Z = 0x9197;
+		static GLenum constexpr GL_NUM_VIRTUAL_PAGE_SIZES = 0x91A8;
+
+		// Minimum maxPushDescriptors value required by VK_KHR_push_descriptor.
+		static uint32_t constexpr MinPushDescriptors = 32u;
 
 		static GLenum constexpr GL_SAMPLES = 0x80A9;
 		static GLenum constexpr GL_NUM_SAMPLE_COUNTS = 0x9380;
@@ -272,6 +281,10 @@ namespace ashes::gl
 		static GLenum constexpr GL_VIEW_CLASS_BPTC_UNORM = 0x82D2;
 		static GLenum constexpr GL_VIEW_CLASS_BPTC_FLOAT = 0x82D3;
 
+		// The free memory queries, in kilobytes.
+		static GLenum constexpr GL_GPU_MEMORY_INFO_CURRENT_AVAILABLE_VIDMEM_NVX = 0x9049;
+		static GLenum constexpr GL_TEXTURE_FREE_MEMORY_ATI = 0x87FC;
+
 #if !defined( _WIN32 )
 		static GLenum constexpr GL_MAX_TEXTURE_SIZE = 0x0D33;
 		static GLenum constexpr GL_MAX_VIEWPORT_DIMS = 0x0D3A;
@@ -379,8 +392,27 @@ namespace ashes::gl
 #endif
 #if VK_KHR_maintenance1
 			VkExtensionProperties{ VK_KHR_MAINTENANCE1_EXTENSION_NAME, VK_KHR_MAINTENANCE1_SPEC_VERSION },
+#endif
+#if VK_KHR_descriptor_update_template
+			VkExtensionProperties{ VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME, VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_SPEC_VERSION },
+#endif
+#if VK_KHR_push_descriptor
+			VkExtensionProperties{ VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME, VK_KHR_PUSH_DESCRIPTOR_SPEC_VERSION },
+#endif
+#if VK_EXT_memory_budget
+			VkExtensionProperties{ VK_EXT_MEMORY_BUDGET_EXTENSION_NAME, VK_EXT_MEMORY_BUDGET_SPEC_VERSION },
 #endif
 		};
+#if VK_EXT_descriptor_indexing
+
+		if ( m_glFeatures.hasBindlessTextures )
+		{
+			auto result = extensions;
+			result.push_back( VkExtensionProperties{ VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME, VK_EXT_DESCRIPTOR_INDEXING_SPEC_VERSION } );
+			return result;
+		}
+
+#endif
 		return extensions;
 	}
 
@@ -482,7 +514,38 @@ namespace ashes::gl
 		, VkImageTiling tiling
 		, std::vector< VkSparseImageFormatProperties > & sparseImageFormatProperties )const
 	{
-		return VK_ERROR_FORMAT_NOT_SUPPORTED;
+		if ( !m_glFeatures.hasSparseResources
+			|| type != VK_IMAGE_TYPE_2D
+			|| samples != VK_SAMPLE_COUNT_1_BIT
+			|| tiling != VK_IMAGE_TILING_OPTIMAL )
+		{
+			return VK_ERROR_FORMAT_NOT_SUPPORTED;
+		}
+
+		ContextLock context{ get( m_instance )->getCurrentContext() };
+		auto internal = getInternalFormat( format );
+		GLint count{};
+		glLogCall( context, glGetInternalformativ, GL_TEXTURE_2D, internal, GL_NUM_VIRTUAL_PAGE_SIZES, 1, &count );
+
+		if ( count == 0 )
+		{
+			return VK_ERROR_FORMAT_NOT_SUPPORTED;
+		}
+
+		// Sparse images are always created with the first virtual page size (GL_VIRTUAL_PAGE_SIZE_INDEX_ARB = 0).
+		GLint x{};
+		GLint y{};
+		GLint z{};
+		glLogCall( context, glGetInternalformativ, GL_TEXTURE_2D, internal, GL_VIRTUAL_PAGE_SIZE_X, 1, &x );
+		glLogCall( context, glGetInternalformativ, GL_TEXTURE_2D, internal, GL_VIRTUAL_PAGE_SIZE_Y, 1, &y );
+		glLogCall( context, glGetInternalformativ, GL_TEXTURE_2D, internal, GL_VIRTUAL_PAGE_SIZE_Z, 1, &z );
+		sparseImageFormatProperties.push_back(
+			{
+				getAspectMask( format ),
+				{ uint32_t( x ), uint32_t( y ), uint32_t( z ) },
+				0u,
+			} );
+		return VK_SUCCESS;
 	}
 
 #if VK_VERSION_1_1
@@ -643,6 +706,127 @@ namespace ashes::gl
 
 #endif
 
+	void PhysicalDevice::updateFeaturesChain( void * next )const
+	{
+		while ( next )
+		{
+			auto base = reinterpret_cast< VkBaseOutStructure * >( next );
+			next = base->pNext;
+
+			switch ( base->sType )
+			{
+#if VK_EXT_descriptor_indexing
+			case VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT:
+				*reinterpret_cast< VkPhysicalDeviceDescriptorIndexingFeaturesEXT * >( base ) = m_descriptorIndexingFeatures;
+				base->pNext = static_cast< VkBaseOutStructure * >( next );
+				break;
+#endif
+			default:
+				break;
+			}
+		}
+	}
+
+	void PhysicalDevice::updateMemoryPropertiesChain( void * next )const
+	{
+		while ( next )
+		{
+			auto base = reinterpret_cast< VkBaseOutStructure * >( next );
+			next = base->pNext;
+
+			switch ( base->sType )
+			{
+#if VK_EXT_memory_budget
+			case VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT:
+				{
+					auto & budget = *reinterpret_cast< VkPhysicalDeviceMemoryBudgetPropertiesEXT * >( base );
+					getMemoryBudget( budget.heapUsage, budget.heapBudget );
+				}
+				break;
+#endif
+			default:
+				break;
+			}
+		}
+	}
+
+	void PhysicalDevice::getMemoryBudget( VkDeviceSize( &heapUsage )[VK_MAX_MEMORY_HEAPS]
+		, VkDeviceSize( &heapBudget )[VK_MAX_MEMORY_HEAPS] )const
+	{
+		static_assert( MemoryStats::MaxMemoryHeaps == VK_MAX_MEMORY_HEAPS );
+		auto stats = getMemoryStats();
+		auto & memoryProperties = getMemoryProperties();
+		// The free video memory, as seen by the driver, other processes allocations included.
+		VkDeviceSize available{};
+		bool hasAvailable = m_glFeatures.hasGpuMemoryInfo || m_glFeatures.hasMemInfo;
+
+		if ( hasAvailable )
+		{
+			ContextLock context{ get( m_instance )->getCurrentContext() };
+
+			if ( m_glFeatures.hasGpuMemoryInfo )
+			{
+				int32_t value{};
+				doGetValue( context, GL_GPU_MEMORY_INFO_CURRENT_AVAILABLE_VIDMEM_NVX, value );
+				available = VkDeviceSize( value ) * 1024u;
+			}
+			else
+			{
+				// Total free memory in the pool, largest free block, total and largest free auxiliary memory.
+				int32_t values[4]{};
+				glLogCall( context, glGetIntegerv
+					, GL_TEXTURE_FREE_MEMORY_ATI
+					, values );
+				available = VkDeviceSize( values[0] ) * 1024u;
+			}
+		}
+
+		for ( uint32_t i = 0u; i < VK_MAX_MEMORY_HEAPS; ++i )
+		{
+			heapUsage[i] = 0u;
+			heapBudget[i] = 0u;
+
+			if ( i < memoryProperties.memoryHeapCount )
+			{
+				auto & heap = memoryProperties.memoryHeaps[i];
+				heapUsage[i] = stats.memoryHeaps[i].bytes;
+				heapBudget[i] = heap.size;
+
+				if ( hasAvailable
+					&& ashes::checkFlag( heap.flags, VK_MEMORY_HEAP_DEVICE_LOCAL_BIT ) )
+				{
+					heapBudget[i] = std::min( heap.size, heapUsage[i] + available );
+				}
+			}
+		}
+	}
+
+	void PhysicalDevice::updatePropertiesChain( void * next )const
+	{
+		while ( next )
+		{
+			auto base = reinterpret_cast< VkBaseOutStructure * >( next );
+			next = base->pNext;
+
+			switch ( base->sType )
+			{
+#if VK_EXT_descriptor_indexing
+			case VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES_EXT:
+				*reinterpret_cast< VkPhysicalDeviceDescriptorIndexingPropertiesEXT * >( base ) = m_descriptorIndexingProperties;
+				base->pNext = static_cast< VkBaseOutStructure * >( next );
+				break;
+#endif
+#if VK_KHR_push_descriptor
+			case VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PUSH_DESCRIPTOR_PROPERTIES_KHR:
+				reinterpret_cast< VkPhysicalDevicePushDescriptorPropertiesKHR * >( base )->maxPushDescriptors = m_maxPushDescriptors;
+				break;
+#endif
+			default:
+				break;
+			}
+		}
+	}
+
 	bool PhysicalDevice::find( VkExtensionProperties const & name )const
 	{
 		return get( m_instance )->getExtensions().find( name );
@@ -679,11 +863,67 @@ namespace ashes::gl
 		doInitialiseProperties2( context );
 
 		m_glFeatures.has420PackExtensions = find( ARB_shading_language_420pack );
+		// Texture handles can't be replayed from a capture, as they are driver values.
+		m_glFeatures.hasBindlessTextures = find( ARB_bindless_texture )
+			&& find( ARB_texture_view )
+			&& find( ARB_shader_storage_buffer_object )
+			&& !Capture::isRequested();
 		m_glFeatures.hasCopyImage = find( ARB_copy_image );
+		m_glFeatures.hasDirectStateAccess = find( ARB_direct_state_access );
+		m_glFeatures.hasGpuMemoryInfo = find( NVX_gpu_memory_info );
+		m_glFeatures.hasMemInfo = find( ATI_meminfo );
 		m_glFeatures.hasProgramPipelines = find( ARB_separate_shader_objects );
+		m_glFeatures.hasSpirvShaders = get( m_instance )->isSPIRVSupported();
 		m_glFeatures.hasTextureStorage = find( ARB_texture_storage );
 		m_glFeatures.hasTextureViews = find( ARB_texture_view );
 		m_glFeatures.hasViewportArrays = find( ARB_viewport_array );
+		doInitialiseDescriptorIndexing( context );
+	}
+
+	void PhysicalDevice::doInitialiseDescriptorIndexing( ContextLock & context )
+	{
+#if VK_EXT_descriptor_indexing
+
+		m_descriptorIndexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+		m_descriptorIndexingProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES_EXT;
+
+		if ( !m_glFeatures.hasBindlessTextures )
+		{
+			return;
+		}
+
+		// Only the combined image samplers go through texture handles,
+		// ARB_bindless_texture doesn't guarantee non uniform handles.
+		// The other descriptor types keep their per draw binding, hence can't be updated after bind.
+		m_descriptorIndexingFeatures.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+		m_descriptorIndexingFeatures.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+		m_descriptorIndexingFeatures.descriptorBindingPartiallyBound = VK_TRUE;
+		m_descriptorIndexingFeatures.descriptorBindingVariableDescriptorCount = VK_TRUE;
+		m_descriptorIndexingFeatures.runtimeDescriptorArray = VK_TRUE;
+
+		uint32_t maxHandles{};
+		doGetValue( context, GL_MAX_SHADER_STORAGE_BLOCK_SIZE, maxHandles );
+		maxHandles /= uint32_t( sizeof( GLuint64 ) );
+		auto & limits = m_properties.limits;
+		auto & properties = m_descriptorIndexingProperties;
+		properties.maxUpdateAfterBindDescriptorsInAllPools = maxHandles;
+		properties.maxPerStageDescriptorUpdateAfterBindSamplers = maxHandles;
+		properties.maxPerStageDescriptorUpdateAfterBindUniformBuffers = limits.maxPerStageDescriptorUniformBuffers;
+		properties.maxPerStageDescriptorUpdateAfterBindStorageBuffers = limits.maxPerStageDescriptorStorageBuffers;
+		properties.maxPerStageDescriptorUpdateAfterBindSampledImages = maxHandles;
+		properties.maxPerStageDescriptorUpdateAfterBindStorageImages = limits.maxPerStageDescriptorStorageImages;
+		properties.maxPerStageDescriptorUpdateAfterBindInputAttachments = limits.maxPerStageDescriptorInputAttachments;
+		properties.maxPerStageUpdateAfterBindResources = maxHandles;
+		properties.maxDescriptorSetUpdateAfterBindSamplers = maxHandles;
+		properties.maxDescriptorSetUpdateAfterBindUniformBuffers = limits.maxDescriptorSetUniformBuffers;
+		properties.maxDescriptorSetUpdateAfterBindUniformBuffersDynamic = limits.maxDescriptorSetUniformBuffersDynamic;
+		properties.maxDescriptorSetUpdateAfterBindStorageBuffers = limits.maxDescriptorSetStorageBuffers;
+		properties.maxDescriptorSetUpdateAfterBindStorageBuffersDynamic = limits.maxDescriptorSetStorageBuffersDynamic;
+		properties.maxDescriptorSetUpdateAfterBindSampledImages = maxHandles;
+		properties.maxDescriptorSetUpdateAfterBindStorageImages = limits.maxDescriptorSetStorageImages;
+		properties.maxDescriptorSetUpdateAfterBindInputAttachments = limits.maxDescriptorSetInputAttachments;
+
+#endif
 	}
 
 	void PhysicalDevice::doInitialiseFeatures( ContextLock & context )
@@ -740,9 +980,14 @@ namespace ashes::gl
 		m_features.shaderInt16 = false;
 		m_features.shaderResourceResidency = false;// find( ARB_sparse_texture2 );
 		m_features.shaderResourceMinLod = false;// find( ARB_sparse_texture_clamp );
-		m_features.sparseBinding = false;// findAll( { ARB_sparse_buffer, ARB_sparse_texture2 } );
-		m_features.sparseResidencyBuffer = false;// find( ARB_sparse_buffer );
-		m_features.sparseResidencyImage2D = false;// find( ARB_sparse_texture2 );
+		// Sparse resources own their GL storage, whose pages are committed by vkQueueBindSparse.
+		// The commitments aren't recorded in a capture, hence the replay couldn't restore them.
+		// The sparse buffers are filled through glClearBufferSubData, having no device memory to map.
+		m_glFeatures.hasSparseResources = findAll( { ARB_sparse_buffer, ARB_sparse_texture, ARB_buffer_storage, ARB_texture_storage, ARB_clear_buffer_object } )
+			&& !Capture::isRequested();
+		m_features.sparseBinding = m_glFeatures.hasSparseResources;
+		m_features.sparseResidencyBuffer = m_glFeatures.hasSparseResources;
+		m_features.sparseResidencyImage2D = m_glFeatures.hasSparseResources;
 		m_features.sparseResidencyImage3D = false;// find( ARB_sparse_texture2 );
 		m_features.sparseResidency2Samples = false;// find( ARB_sparse_texture2 );
 		m_features.sparseResidency4Samples = false;// find( ARB_sparse_texture2 );
@@ -751,6 +996,11 @@ namespace ashes::gl
 		m_features.sparseResidencyAliased = false;
 		m_features.variableMultisampleRate = true;
 		m_features.inheritedQueries = true;
+
+		if ( m_glFeatures.hasSparseResources )
+		{
+			doGetValue( context, GL_SPARSE_BUFFER_PAGE_SIZE, m_sparseBufferPageSize );
+		}
 	}
 
 	void PhysicalDevice::doInitialiseProperties( ContextLock & context )
@@ -870,6 +1120,12 @@ namespace ashes::gl
 		m_properties.limits.optimalBufferCopyOffsetAlignment = NonAvailable< uint64_t >;
 		m_properties.limits.optimalBufferCopyRowPitchAlignment = NonAvailable< uint64_t >;
 		m_properties.limits.nonCoherentAtomSize = 64ull;
+		// Push descriptors only produce bind commands, hence they are bounded by the GL binding points.
+		m_maxPushDescriptors = std::max( MinPushDescriptors
+			, m_properties.limits.maxPerStageDescriptorSamplers
+				+ m_properties.limits.maxPerStageDescriptorUniformBuffers
+				+ m_properties.limits.maxPerStageDescriptorStorageBuffers
+				+ m_properties.limits.maxPerStageDescriptorStorageImages );
 
 		m_properties.sparseProperties.residencyAlignedMipSize = false;
 		m_properties.sparseProperties.residencyNonResidentStrict = false;
@@ -891,6 +1147,18 @@ namespace ashes::gl
 					1u,
 				}
 			} );
+		// Transfer only family, executed on a worker thread with a shared context.
+		m_queueProperties.push_back(
+			{
+				VK_QUEUE_TRANSFER_BIT,
+				1u,
+				64u,
+				{
+					1u,
+					1u,
+					1u,
+				}
+			} );
 	}
 
 	void PhysicalDevice::doInitialiseFormatProperties( ContextLock & context )
@@ -1398,11 +1666,21 @@ namespace ashes::gl
 		return get( physicalDevice )->getGlFeatures().has420PackExtensions;
 	}
 
+	bool hasBindlessTextures( VkPhysicalDevice physicalDevice )
+	{
+		return get( physicalDevice )->getGlFeatures().hasBindlessTextures;
+	}
+
 	bool hasCopyImage( VkPhysicalDevice physicalDevice )
 	{
 		return get( physicalDevice )->getGlFeatures().hasCopyImage;
 	}
 
+	bool hasDirectStateAccess( VkPhysicalDevice physicalDevice )
+	{
+		return get( physicalDevice )->getGlFeatures().hasDirectStateAccess;
+	}
+
 	bool hasProgramPipelines( VkPhysicalDevice physicalDevice )
 	{
 		return get( physicalDevice )->getGlFeatures().hasProgramPipelines;
@@ -1413,6 +1691,16 @@ namespace ashes::gl
 		return get( physicalDevice )->getFeatures().samplerAnisotropy;
 	}
 
+	bool hasSparseResources( VkPhysicalDevice physicalDevice )
+	{
+		return get( physicalDevice )->getGlFeatures().hasSparseResources;
+	}
+
+	bool hasSpirvShaders( VkPhysicalDevice physicalDevice )
+	{
+		return get( physicalDevice )->getGlFeatures().hasSpirvShaders;
+	}
+
 	bool hasTextureStorage( VkPhysicalDevice physicalDevice )
 	{
 		return get( physicalDevice )->getGlFeatures().hasTextureStorage;
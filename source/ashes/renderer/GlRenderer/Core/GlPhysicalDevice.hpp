@@ -63,6 +63,30 @@ namespace ashes::gl
 		VkResult getSparseImageFormatProperties2( VkPhysicalDeviceSparseImageFormatInfo2KHR const & formatInfo
 			, std::vector< VkSparseImageFormatProperties2KHR > & sparseImageFormatProperties )const;
 #endif
+		/**
+		*\brief
+		*	Fills the structures chained to VkPhysicalDeviceFeatures2 that the device knows about.
+		*/
+		void updateFeaturesChain( void * next )const;
+		/**
+		*\brief
+		*	Fills the structures chained to VkPhysicalDeviceProperties2 that the device knows about.
+		*/
+		void updatePropertiesChain( void * next )const;
+		/**
+		*\brief
+		*	Fills the structures chained to VkPhysicalDeviceMemoryProperties2 that the device knows about.
+		*/
+		void updateMemoryPropertiesChain( void * next )const;
+		/**
+		*\brief
+		*	Computes the memory heaps usage, from the live VkDeviceMemory objects, and their budget.
+		*\remarks
+		*	The device local heaps budget is their usage plus the free video memory,
+		*	when GL_NVX_gpu_memory_info or GL_ATI_meminfo can tell it, their size otherwise.
+		*/
+		void getMemoryBudget( VkDeviceSize( &heapUsage )[VK_MAX_MEMORY_HEAPS]
+			, VkDeviceSize( &heapBudget )[VK_MAX_MEMORY_HEAPS] )const;
 #ifdef VK_KHR_display
 		std::vector< VkDisplayPropertiesKHR > const & getDisplayProperties()const;
 		std::vector< VkDisplayPlanePropertiesKHR > getDisplayPlaneProperties()const;
@@ -84,6 +108,22 @@ namespace ashes::gl
 		{
 			return m_glFeatures;
 		}
+		/**
+		*\return
+		*	The ARB_sparse_buffer commitment granularity, 0 if sparse resources aren't supported.
+		*/
+		inline VkDeviceSize getSparseBufferPageSize()const
+		{
+			return m_sparseBufferPageSize;
+		}
+#if VK_EXT_descriptor_indexing
+
+		inline VkPhysicalDeviceDescriptorIndexingFeaturesEXT const & getDescriptorIndexingFeatures()const
+		{
+			return m_descriptorIndexingFeatures;
+		}
+
+#endif
 
 	private:
 		void doInitialise();
@@ -93,6 +133,7 @@ namespace ashes::gl
 		void doInitialiseFormatProperties( ContextLock & context );
 		void doInitialiseDisplayProperties( ContextLock & context );
 		void doInitialiseProperties2( ContextLock & context );
+		void doInitialiseDescriptorIndexing( ContextLock & context );
 		void doGetValue( ContextLock & context, GLenum name, int32_t & value )const;
 		void doGetValue( ContextLock & context, GLenum name, uint32_t & value )const;
 		void doGetValues( ContextLock & context, GLenum name, int32_t( &value )[2] )const;
@@ -124,6 +165,8 @@ namespace ashes::gl
 		VkPhysicalDeviceFeatures m_features{};
 		VkPhysicalDeviceProperties m_properties{};
 		GlPhysicalDeviceFeatures m_glFeatures{};
+		uint32_t m_sparseBufferPageSize{};
+		uint32_t m_maxPushDescriptors{};
 		std::vector< VkQueueFamilyProperties > m_queueProperties{};
 		mutable std::map< VkFormat, VkFormatProperties > m_formatProperties;
 		mutable std::map< size_t, VkImageFormatProperties > m_imageFormatProperties;
@@ -138,6 +181,10 @@ namespace ashes::gl
 		std::vector< VkQueueFamilyProperties2KHR > m_queueProperties2{};
 		mutable std::map< VkFormat, VkFormatProperties2KHR > m_formatProperties2;
 #endif
+#if VK_EXT_descriptor_indexing
+		VkPhysicalDeviceDescriptorIndexingFeaturesEXT m_descriptorIndexingFeatures{};
+		VkPhysicalDeviceDescriptorIndexingPropertiesEXT m_descriptorIndexingProperties{};
+#endif
 #ifdef VK_KHR_display
 		std::vector< std::string > m_displayNames;
 		std::vector< VkDisplayPropertiesKHR >m_displays;
@@ -146,9 +193,13 @@ namespace ashes::gl
 	};
 
 	bool has420PackExtensions( VkPhysicalDevice physicalDevice );
+	bool hasBindlessTextures( VkPhysicalDevice physicalDevice );
 	bool hasCopyImage( VkPhysicalDevice physicalDevice );
+	bool hasDirectStateAccess( VkPhysicalDevice physicalDevice );
 	bool hasProgramPipelines( VkPhysicalDevice physicalDevice );
 	bool hasSamplerAnisotropy( VkPhysicalDevice physicalDevice );
+	bool hasSparseResources( VkPhysicalDevice physicalDevice );
+	bool hasSpirvShaders( VkPhysicalDevice physicalDevice );
 	bool hasTextureStorage( VkPhysicalDevice physicalDevice );
 	bool hasTextureViews( VkPhysicalDevice physicalDevice );
 	bool hasViewportArrays( VkPhysicalDevice physicalDevice );
@@ -5,6 +5,8 @@
 
 #include "ashesgl_api.hpp"
 
+#include <algorithm>
+
 namespace ashes::gl
 {
 	DescriptorPool::DescriptorPool( VkDevice device
@@ -26,20 +28,39 @@ namespace ashes::gl
 
 	void DescriptorPool::registerSet( VkDescriptorSet set )
 	{
-		if ( checkFlag( m_flags, VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT ) )
-		{
-			assert( m_maxSets > m_sets.size() );
-			m_sets.push_back( set );
-		}
+		assert( m_maxSets > m_sets.size() );
+		m_sets.push_back( set );
 	}
 
 	VkResult DescriptorPool::reset( VkDescriptorPoolResetFlags flags )
 	{
+		for ( auto & set : m_sets )
+		{
+			delete get( set );
+		}
+
+		m_sets.clear();
 		return VK_SUCCESS;
 	}
 
 	VkResult DescriptorPool::free( VkDescriptorSetArray sets )
 	{
+		if ( checkFlag( m_flags, VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT ) )
+		{
+			for ( auto set : sets )
+			{
+				auto it = std::find( m_sets.begin()
+					, m_sets.end()
+					, set );
+
+				if ( it != m_sets.end() )
+				{
+					delete get( *it );
+					m_sets.erase( it );
+				}
+			}
+		}
+
 		return VK_SUCCESS;
 	}
 }
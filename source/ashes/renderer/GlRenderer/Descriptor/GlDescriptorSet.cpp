@@ -1,9 +1,13 @@
 #include "Descriptor/GlDescriptorSet.hpp"
 
 #include "Buffer/GlBuffer.hpp"
+#include "Core/GlDevice.hpp"
 #include "Descriptor/GlDescriptorPool.hpp"
+#include "Descriptor/GlDescriptorSetLayout.hpp"
 #include "Image/GlSampler.hpp"
 #include "Image/GlImage.hpp"
+#include "Image/GlImageView.hpp"
+#include "Miscellaneous/GlCallLogger.hpp"
 
 #include "ashesgl_api.hpp"
 
@@ -14,7 +18,8 @@
 namespace ashes::gl
 {
 	DescriptorSet::DescriptorSet( VkDescriptorPool pool
-		, VkDescriptorSetLayout layout )
+		, VkDescriptorSetLayout layout
+		, uint32_t variableDescriptorCount )
 		: m_pool{ pool }
 		, m_layout{ layout }
 	{
@@ -39,7 +44,18 @@ namespace ashes::gl
 				m_samplers.push_back( &write.second );
 				break;
 			case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
-				m_combinedTextureSamplers.push_back( &write.second );
+				if ( get( layout )->isBindless( write.first ) )
+				{
+					m_bindlessTextures.push_back( { write.first
+						, ( get( layout )->isVariable( write.first )
+							? variableDescriptorCount
+							: write.second.descriptorCount )
+						, GL_INVALID_INDEX } );
+				}
+				else
+				{
+					m_combinedTextureSamplers.push_back( &write.second );
+				}
 				break;
 			case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
 				m_sampledTextures.push_back( &write.second );
@@ -88,19 +104,71 @@ namespace ashes::gl
 			{
 				return lhs->binding < rhs->binding;
 			} );
+
+		if ( !m_bindlessTextures.empty() )
+		{
+			auto context = get( get( pool )->getDevice() )->getContext();
+
+			for ( auto & bindless : m_bindlessTextures )
+			{
+				glLogCall( context
+					, glGenBuffers
+					, 1
+					, &bindless.buffer );
+				glLogCall( context
+					, glBindBuffer
+					, GL_BUFFER_TARGET_COPY_WRITE
+					, bindless.buffer );
+				glLogCall( context
+					, glBufferData
+					, GL_BUFFER_TARGET_COPY_WRITE
+					, GLsizeiptr( std::max( 1u, bindless.descriptorCount ) * sizeof( GLuint64 ) )
+					, nullptr
+					, GL_BUFFER_DATA_USAGE_DYNAMIC_DRAW );
+			}
+
+			glLogCall( context
+				, glBindBuffer
+				, GL_BUFFER_TARGET_COPY_WRITE
+				, 0u );
+		}
 	}
 
 	DescriptorSet::~DescriptorSet()
 	{
-		for ( auto & inlineUbo : m_inlineUbos )
+		if ( !m_bindlessTextures.empty() )
 		{
-			deallocate( inlineUbo->buffer, nullptr );
-			deallocate( inlineUbo->memory, nullptr );
+			auto context = get( get( m_pool )->getDevice() )->getContext();
+
+			for ( auto & bindless : m_bindlessTextures )
+			{
+				glLogCall( context
+					, glDeleteBuffers
+					, 1
+					, &bindless.buffer );
+			}
 		}
 	}
 
 	void DescriptorSet::mergeWrites( LayoutBindingWrites & writes, VkWriteDescriptorSet const & write )
 	{
+#if VK_EXT_inline_uniform_block
+
+		if ( tryGet< VkWriteDescriptorSetInlineUniformBlockEXT >( write.pNext ) )
+		{
+			// The previous write of this block is replaced, and its storage recycled.
+			auto end = std::remove_if( writes.writes.begin()
+				, writes.writes.end()
+				, [&write]( VkWriteDescriptorSet const & lookup )
+				{
+					return lookup.dstArrayElement == write.dstArrayElement;
+				} );
+			writes.writes.erase( end, writes.writes.end() );
+			m_inlineUbos.erase( makeInlineUboKey( write.dstBinding, write.dstArrayElement ) );
+		}
+
+#endif
+
 		writes.writes.push_back( write );
 		auto & myWrite = writes.writes.back();
 
@@ -110,6 +178,12 @@ namespace ashes::gl
 			myWrite.pImageInfo = m_imagesInfos.back().data();
 		}
 
+		if ( myWrite.pTexelBufferView )
+		{
+			m_texelBufferViews.emplace_back( VkBufferViewArray{ myWrite.pTexelBufferView, myWrite.pTexelBufferView + myWrite.descriptorCount } );
+			myWrite.pTexelBufferView = m_texelBufferViews.back().data();
+		}
+
 #if VK_EXT_inline_uniform_block
 
 		auto inlineUniform = tryGet< VkWriteDescriptorSetInlineUniformBlockEXT >( myWrite.pNext );
@@ -119,18 +193,10 @@ namespace ashes::gl
 			writes.descriptorCount /= inlineUniform->dataSize;
 			myWrite.descriptorCount /= inlineUniform->dataSize;
 			auto device = get( m_pool )->getDevice();
-			auto inlineUbo = createInlineUbo( device
-				, *inlineUniform
-				, Instance::getMemoryProperties()
-				, ashes::gl::vkCreateBuffer
-				, ashes::gl::vkGetBufferMemoryRequirements
-				, ashes::gl::vkAllocateMemory
-				, ashes::gl::vkBindBufferMemory
-				, ashes::gl::vkMapMemory
-				, ashes::gl::vkFlushMappedMemoryRanges
-				, ashes::gl::vkUnmapMemory );
+			auto & inlineUbo = m_inlineUbos[makeInlineUboKey( myWrite.dstBinding, myWrite.dstArrayElement )];
+			inlineUbo = get( device )->getInlineUboAllocator().allocate( *inlineUniform );
+			assert( inlineUbo );
 			myWrite.pBufferInfo = &inlineUbo->info;
-			m_inlineUbos.emplace_back( std::move( inlineUbo ) );
 		}
 
 #endif
@@ -142,8 +208,57 @@ namespace ashes::gl
 		}
 	}
 
+	void DescriptorSet::updateHandles( BindlessBinding const & binding
+		, VkWriteDescriptorSet const & write )
+	{
+		assert( write.dstArrayElement + write.descriptorCount <= binding.descriptorCount );
+		auto device = get( m_pool )->getDevice();
+		auto context = get( device )->getContext();
+		auto & textureHandles = *get( device )->getTextureHandles();
+		std::vector< GLuint64 > handles;
+		handles.reserve( write.descriptorCount );
+
+		for ( uint32_t i = 0u; i < write.descriptorCount; ++i )
+		{
+			auto & imageInfo = write.pImageInfo[i];
+			handles.push_back( textureHandles.getHandle( context
+				, get( imageInfo.imageView )->getInternal()
+				, get( imageInfo.sampler )->getInternal() ) );
+		}
+
+		// Written right away, the GL commands already submitted still see the previous handles.
+		glLogCall( context
+			, glBindBuffer
+			, GL_BUFFER_TARGET_COPY_WRITE
+			, binding.buffer );
+		glLogCall( context
+			, glBufferSubData
+			, GL_BUFFER_TARGET_COPY_WRITE
+			, GLintptr( write.dstArrayElement * sizeof( GLuint64 ) )
+			, GLsizeiptr( handles.size() * sizeof( GLuint64 ) )
+			, handles.data() );
+		glLogCall( context
+			, glBindBuffer
+			, GL_BUFFER_TARGET_COPY_WRITE
+			, 0u );
+	}
+
 	void DescriptorSet::update( VkWriteDescriptorSet const & write )
 	{
+		auto bindless = std::find_if( m_bindlessTextures.begin()
+			, m_bindlessTextures.end()
+			, [&write]( BindlessBinding const & lookup )
+			{
+				return lookup.binding == write.dstBinding;
+			} );
+
+		if ( bindless != m_bindlessTextures.end() )
+		{
+			assert( write.dstSet == get( this ) );
+			updateHandles( *bindless, write );
+			return;
+		}
+
 		auto it = m_writes.find( write.dstBinding );
 		assert( it != m_writes.end() );
 		assert( it->second.descriptorType == write.descriptorType );
@@ -26,13 +26,28 @@ namespace ashes::gl
 	};
 	using LayoutBindingWritesArray = std::vector< LayoutBindingWrites * >;
 	using LayoutBindingWritesMap = std::map< uint32_t, LayoutBindingWrites >;
+	/**
+	*\brief
+	*	A combined image sampler binding read through ARB_bindless_texture handles.
+	*\remarks
+	*	The handles are written to the buffer as soon as the descriptors are updated,
+	*	hence the binding can be updated after having been bound.
+	*/
+	struct BindlessBinding
+	{
+		uint32_t binding;
+		uint32_t descriptorCount;
+		GLuint buffer;
+	};
+	using BindlessBindingArray = std::vector< BindlessBinding >;
 
 	class DescriptorSet
 		: public AutoIdIcdObject< DescriptorSet >
 	{
 	public:
 		DescriptorSet( VkDescriptorPool pool
-			, VkDescriptorSetLayout layout );
+			, VkDescriptorSetLayout layout
+			, uint32_t variableDescriptorCount );
 		~DescriptorSet();
 
 		void update( VkWriteDescriptorSet const & write );
@@ -48,6 +63,11 @@ namespace ashes::gl
 			return m_combinedTextureSamplers;
 		}
 
+		inline BindlessBindingArray const & getBindlessTextures()const
+		{
+			return m_bindlessTextures;
+		}
+
 		inline LayoutBindingWritesArray const & getSamplers()const
 		{
 			return m_samplers;
@@ -95,13 +115,15 @@ namespace ashes::gl
 
 	private:
 		void mergeWrites( LayoutBindingWrites & writes, VkWriteDescriptorSet const & write );
+		void updateHandles( BindlessBinding const & binding, VkWriteDescriptorSet const & write );
 
 	private:
 		VkDescriptorPool m_pool;
 		VkDescriptorSetLayout m_layout;
 		std::vector< std::vector< VkDescriptorImageInfo > > m_imagesInfos;
 		std::vector< std::vector< VkDescriptorBufferInfo > > m_buffersInfos;
-		InlineUboArray m_inlineUbos;
+		std::vector< VkBufferViewArray > m_texelBufferViews;
+		InlineUboMap m_inlineUbos;
 		LayoutBindingWritesMap m_writes;
 		LayoutBindingWritesArray m_combinedTextureSamplers;
 		LayoutBindingWritesArray m_samplers;
@@ -115,6 +137,7 @@ namespace ashes::gl
 		LayoutBindingWritesArray m_dynamicStorageBuffers;
 		LayoutBindingWritesArray m_dynamicBuffers;
 		LayoutBindingWritesArray m_inputAttachments;
+		BindlessBindingArray m_bindlessTextures;
 	};
 }
 
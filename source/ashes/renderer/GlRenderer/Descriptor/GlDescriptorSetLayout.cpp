@@ -1,11 +1,99 @@
 #include "Descriptor/GlDescriptorSetLayout.hpp"
 
+#include "Core/GlDevice.hpp"
+#include "Core/GlPhysicalDevice.hpp"
+
+#include "ashesgl_api.hpp"
+
+#include <ashes/common/VkTypeTraits.hpp>
+
+#include <string>
+
 namespace ashes::gl
 {
+#if VK_EXT_descriptor_indexing
+
+	namespace
+	{
+		bool isUpdateAfterBindSupported( VkPhysicalDeviceDescriptorIndexingFeaturesEXT const & features
+			, VkDescriptorType type )
+		{
+			switch ( type )
+			{
+			case VK_DESCRIPTOR_TYPE_SAMPLER:
+			case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
+			case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+				return features.descriptorBindingSampledImageUpdateAfterBind;
+			case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+				return features.descriptorBindingStorageImageUpdateAfterBind;
+			case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+				return features.descriptorBindingUniformBufferUpdateAfterBind;
+			case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+				return features.descriptorBindingStorageBufferUpdateAfterBind;
+			case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
+				return features.descriptorBindingUniformTexelBufferUpdateAfterBind;
+			case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:
+				return features.descriptorBindingStorageTexelBufferUpdateAfterBind;
+			default:
+				return false;
+			}
+		}
+	}
+
+#endif
+
 	DescriptorSetLayout::DescriptorSetLayout( VkDevice device
 		, VkDescriptorSetLayoutCreateInfo createInfo )
 		: m_createInfo{ std::move( createInfo ) }
 		, m_bindings{ makeVector( m_createInfo.pBindings, m_createInfo.bindingCount ) }
 	{
+#if VK_EXT_descriptor_indexing
+
+		auto bindingFlags = tryFind< VkDescriptorSetLayoutBindingFlagsCreateInfoEXT >( m_createInfo.pNext );
+
+		if ( bindingFlags && bindingFlags->bindingCount )
+		{
+			assert( bindingFlags->bindingCount == m_createInfo.bindingCount );
+			auto & features = get( get( device )->getPhysicalDevice() )->getDescriptorIndexingFeatures();
+			auto bindlessFlags = VkDescriptorBindingFlagsEXT( VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT
+				| VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT
+				| VK_DESCRIPTOR_BINDING_VARIABLE_DESCRIPTOR_COUNT_BIT_EXT );
+
+			for ( uint32_t i = 0u; i < bindingFlags->bindingCount; ++i )
+			{
+				auto & binding = m_bindings[i];
+				auto flags = bindingFlags->pBindingFlags[i];
+
+				if ( checkFlag( flags, VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT )
+					&& !isUpdateAfterBindSupported( features, binding.descriptorType ) )
+				{
+					auto name = "Update after bind on binding " + std::to_string( binding.binding )
+						+ ", unsupported for its descriptor type";
+					reportError( device
+						, VK_ERROR_FEATURE_NOT_PRESENT
+						, "Unsupported feature"
+						, name );
+					throw Exception{ VK_ERROR_FEATURE_NOT_PRESENT, name };
+				}
+
+				// Only the combined image samplers are stored as texture handles, the other
+				// descriptor types keep their per draw binding, which tolerates unbound descriptors.
+				if ( ( flags & bindlessFlags ) != 0
+					&& binding.descriptorType == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER
+					&& hasBindlessTextures( device ) )
+				{
+					m_bindless.insert( binding.binding );
+				}
+
+				if ( checkFlag( flags, VK_DESCRIPTOR_BINDING_VARIABLE_DESCRIPTOR_COUNT_BIT_EXT ) )
+				{
+					m_variableBinding = binding.binding;
+				}
+			}
+		}
+
+		m_createInfo.pNext = nullptr;
+
+#endif
 	}
 }
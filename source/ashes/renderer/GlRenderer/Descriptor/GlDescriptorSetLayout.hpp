@@ -10,6 +10,8 @@
 
 #include "renderer/GlRenderer/GlRendererPrerequisites.hpp"
 
+#include <set>
+
 namespace ashes::gl
 {
 	class DescriptorSetLayout
@@ -28,10 +30,28 @@ namespace ashes::gl
 		{
 			return m_bindings.end();
 		}
+		/**
+		*\return
+		*	\p true if the binding's descriptors are read through ARB_bindless_texture handles.
+		*/
+		bool isBindless( uint32_t binding )const
+		{
+			return m_bindless.end() != m_bindless.find( binding );
+		}
+		/**
+		*\return
+		*	\p true if the binding has a variable descriptor count.
+		*/
+		bool isVariable( uint32_t binding )const
+		{
+			return m_variableBinding == binding;
+		}
 
 	private:
 		VkDescriptorSetLayoutCreateInfo m_createInfo;
 		VkDescriptorSetLayoutBindingArray m_bindings;
+		std::set< uint32_t > m_bindless;
+		uint32_t m_variableBinding{ GL_INVALID_INDEX };
 	};
 }
 
@@ -0,0 +1,204 @@
+/*
+This file belongs to Ashes.
+See LICENSE file in root folder.
+*/
+#include "Descriptor/GlDescriptorUpdateTemplate.hpp"
+
+#include "ashesgl_api.hpp"
+
+#include <cstring>
+
+namespace ashes::gl
+{
+	namespace
+	{
+		template< typename InfoT >
+		InfoT const * readInfos( uint8_t const * src
+			, VkDescriptorUpdateTemplateEntry const & entry
+			, std::vector< InfoT > & infos )
+		{
+			auto index = infos.size();
+
+			for ( uint32_t i = 0u; i < entry.descriptorCount; ++i )
+			{
+				InfoT info;
+				std::memcpy( &info, src + i * entry.stride, sizeof( InfoT ) );
+				infos.push_back( info );
+			}
+
+			return infos.data() + index;
+		}
+	}
+
+	DescriptorUpdateTemplate::DescriptorUpdateTemplate( VkDevice device
+		, VkDescriptorUpdateTemplateCreateInfo createInfo )
+		: m_createInfo{ std::move( createInfo ) }
+		, m_entries{ makeVector( m_createInfo.pDescriptorUpdateEntries, m_createInfo.descriptorUpdateEntryCount ) }
+	{
+		m_createInfo.pNext = nullptr;
+		m_createInfo.pDescriptorUpdateEntries = m_entries.data();
+	}
+
+	TemplateWrites DescriptorUpdateTemplate::getWrites( VkDescriptorSet descriptorSet
+		, void const * data )const
+	{
+		TemplateWrites result;
+		size_t imagesCount{ 0u };
+		size_t buffersCount{ 0u };
+		size_t viewsCount{ 0u };
+		size_t inlineCount{ 0u };
+
+		for ( auto & entry : m_entries )
+		{
+			switch ( entry.descriptorType )
+			{
+			case VK_DESCRIPTOR_TYPE_SAMPLER:
+			case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
+			case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+			case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+			case VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT:
+				imagesCount += entry.descriptorCount;
+				break;
+			case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
+			case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:
+				viewsCount += entry.descriptorCount;
+				break;
+			case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+			case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+			case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
+			case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC:
+				buffersCount += entry.descriptorCount;
+				break;
+			default:
+				++inlineCount;
+				break;
+			}
+		}
+
+		// The writes point inside these arrays, which hence must not be reallocated.
+		result.writes.reserve( m_entries.size() );
+		result.imagesInfos.reserve( imagesCount );
+		result.buffersInfos.reserve( buffersCount );
+		result.texelBufferViews.reserve( viewsCount );
+#if VK_EXT_inline_uniform_block
+		result.inlineUniforms.reserve( inlineCount );
+#endif
+		auto buffer = reinterpret_cast< uint8_t const * >( data );
+
+		for ( auto & entry : m_entries )
+		{
+			auto src = buffer + entry.offset;
+			VkWriteDescriptorSet write
+			{
+				VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+				nullptr,
+				descriptorSet,
+				entry.dstBinding,
+				entry.dstArrayElement,
+				entry.descriptorCount,
+				entry.descriptorType,
+				nullptr,
+				nullptr,
+				nullptr,
+			};
+
+			switch ( entry.descriptorType )
+			{
+			case VK_DESCRIPTOR_TYPE_SAMPLER:
+			case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
+			case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+			case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+			case VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT:
+				write.pImageInfo = readInfos( src, entry, result.imagesInfos );
+				break;
+			case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
+			case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:
+				write.pTexelBufferView = readInfos( src, entry, result.texelBufferViews );
+				break;
+			case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+			case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+			case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
+			case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC:
+				write.pBufferInfo = readInfos( src, entry, result.buffersInfos );
+				break;
+#if VK_EXT_inline_uniform_block
+			case VK_DESCRIPTOR_TYPE_INLINE_UNIFORM_BLOCK_EXT:
+				// For inline uniform blocks, the descriptor count is the data size.
+				result.inlineUniforms.push_back( VkWriteDescriptorSetInlineUniformBlockEXT
+					{
+						VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET_INLINE_UNIFORM_BLOCK_EXT,
+						nullptr,
+						entry.descriptorCount,
+						src,
+					} );
+				write.pNext = &result.inlineUniforms.back();
+				break;
+#endif
+			default:
+				assert( false && "Unsupported descriptor type" );
+				continue;
+			}
+
+			result.writes.push_back( write );
+		}
+
+		return result;
+	}
+
+	TemplateWrites copyWrites( ArrayView< VkWriteDescriptorSet const > const & writes )
+	{
+		TemplateWrites result;
+		size_t imagesCount{ 0u };
+		size_t buffersCount{ 0u };
+		size_t viewsCount{ 0u };
+
+		for ( auto & write : writes )
+		{
+			imagesCount += write.pImageInfo ? write.descriptorCount : 0u;
+			buffersCount += write.pBufferInfo ? write.descriptorCount : 0u;
+			viewsCount += write.pTexelBufferView ? write.descriptorCount : 0u;
+		}
+
+		// The writes point inside these arrays, which hence must not be reallocated.
+		result.writes.reserve( writes.size() );
+		result.imagesInfos.reserve( imagesCount );
+		result.buffersInfos.reserve( buffersCount );
+		result.texelBufferViews.reserve( viewsCount );
+
+		for ( auto write : writes )
+		{
+			write.pNext = nullptr;
+
+			if ( write.pImageInfo )
+			{
+				auto index = result.imagesInfos.size();
+				result.imagesInfos.insert( result.imagesInfos.end()
+					, write.pImageInfo
+					, write.pImageInfo + write.descriptorCount );
+				write.pImageInfo = result.imagesInfos.data() + index;
+			}
+
+			if ( write.pBufferInfo )
+			{
+				auto index = result.buffersInfos.size();
+				result.buffersInfos.insert( result.buffersInfos.end()
+					, write.pBufferInfo
+					, write.pBufferInfo + write.descriptorCount );
+				write.pBufferInfo = result.buffersInfos.data() + index;
+			}
+
+			if ( write.pTexelBufferView )
+			{
+				auto index = result.texelBufferViews.size();
+				result.texelBufferViews.insert( result.texelBufferViews.end()
+					, write.pTexelBufferView
+					, write.pTexelBufferView + write.descriptorCount );
+				write.pTexelBufferView = result.texelBufferViews.data() + index;
+			}
+
+			result.writes.push_back( write );
+		}
+
+		return result;
+	}
+}
@@ -0,0 +1,59 @@
+/*
+This file belongs to Ashes.
+See LICENSE file in root folder
+*/
+#pragma once
+
+#include "renderer/GlRenderer/GlRendererPrerequisites.hpp"
+
+namespace ashes::gl
+{
+	/**
+	*\brief
+	*	Descriptor writes built from a template, with the storage they point to.
+	*/
+	struct TemplateWrites
+	{
+		VkWriteDescriptorSetArray writes;
+		VkDescriptorImageInfoArray imagesInfos;
+		VkDescriptorBufferInfoArray buffersInfos;
+		VkBufferViewArray texelBufferViews;
+#if VK_EXT_inline_uniform_block
+		std::vector< VkWriteDescriptorSetInlineUniformBlockEXT > inlineUniforms;
+#endif
+	};
+	/**
+	*\brief
+	*	Copies \p writes and the infos they point to, so that they can outlive the caller's arrays.
+	*\remarks
+	*	The inline uniform blocks writes can't be pushed, hence they aren't copied.
+	*/
+	TemplateWrites copyWrites( ArrayView< VkWriteDescriptorSet const > const & writes );
+
+	class DescriptorUpdateTemplate
+		: public AutoIdIcdObject< DescriptorUpdateTemplate >
+	{
+	public:
+		DescriptorUpdateTemplate( VkDevice device
+			, VkDescriptorUpdateTemplateCreateInfo createInfo );
+		/**
+		*\brief
+		*	Reads the descriptors from \p data, as described by the template entries.
+		*\param[in] descriptorSet
+		*	The written descriptor set, VK_NULL_HANDLE for push descriptors.
+		*\remarks
+		*	The inline uniform blocks writes point to \p data, which must then outlive them.
+		*/
+		TemplateWrites getWrites( VkDescriptorSet descriptorSet
+			, void const * data )const;
+
+		inline VkPipelineBindPoint getBindPoint()const
+		{
+			return m_createInfo.pipelineBindPoint;
+		}
+
+	private:
+		VkDescriptorUpdateTemplateCreateInfo m_createInfo;
+		std::vector< VkDescriptorUpdateTemplateEntry > m_entries;
+	};
+}
@@ -9,6 +9,9 @@ namespace ashes::gl
 		case GL_BUFFER_PARAMETER_SIZE:
 			return "GL_BUFFER_SIZE";
 
+		case GL_BUFFER_PARAMETER_USAGE:
+			return "GL_BUFFER_USAGE";
+
 		default:
 			assert( false && "Unsupported GlBufferParameter" );
 			return "GlBufferParameter_UNKNOWN";
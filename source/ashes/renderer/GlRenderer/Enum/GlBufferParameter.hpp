@@ -10,6 +10,7 @@ namespace ashes::gl
 		: GLenum
 	{
 		GL_BUFFER_PARAMETER_SIZE = 0x8764,
+		GL_BUFFER_PARAMETER_USAGE = 0x8765,
 	};
 	std::string getName( GlBufferParameter value );
 }
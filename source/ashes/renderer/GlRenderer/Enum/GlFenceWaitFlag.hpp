@@ -12,4 +12,14 @@ namespace ashes::gl
 		GL_WAIT_FLAG_SYNC_FLUSH_COMMANDS_BIT = 0x00000001,
 	};
 	std::string getName( GlFenceWaitFlag value );
+
+	enum GlFenceWaitResult
+	{
+		GL_SYNC_STATUS = 0x9114,
+		GL_UNSIGNALED = 0x9118,
+		GL_SIGNALED = 0x9119,
+		GL_WAIT_RESULT_ALREADY_SIGNALED = 0x911A,
+		GL_WAIT_RESULT_CONDITION_SATISFIED = 0x911C,
+		GL_WAIT_RESULT_TIMEOUT_EXPIRED = 0x911B,
+	};
 }
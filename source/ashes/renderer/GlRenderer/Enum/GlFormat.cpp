@@ -407,6 +407,9 @@ namespace ashes::gl
 		case GL_FORMAT_DS:
 			return "GL_DEPTH_STENCIL";
 
+		case GL_FORMAT_R_INTEGER:
+			return "GL_RED_INTEGER";
+
 		default:
 			assert( false && "Unupported GlFormat" );
 			return "GlFormat_UNKNOWN";
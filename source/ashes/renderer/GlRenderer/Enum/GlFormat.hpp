@@ -183,6 +183,7 @@ namespace ashes::gl
 		GL_FORMAT_BGRA = 0x80E1,
 		GL_FORMAT_RG = 0x8227,
 		GL_FORMAT_DS = 0x84F9,
+		GL_FORMAT_R_INTEGER = 0x8D94,
 	};
 	enum GlType
 		: GLenum
@@ -82,6 +82,12 @@ namespace ashes::gl
 			if ( ashes::checkFlag( value, GlMemoryPropertyFlag::GL_MEMORY_PROPERTY_PERSISTENT_BIT ) )
 			{
 				result += sep + "GL_MAP_PERSISTENT_BIT";
+				sep = " | ";
+			}
+
+			if ( ashes::checkFlag( value, GlMemoryPropertyFlag::GL_MEMORY_PROPERTY_SPARSE_STORAGE_BIT ) )
+			{
+				result += sep + "GL_SPARSE_STORAGE_BIT_ARB";
 			}
 
 			return result;
@@ -35,6 +35,7 @@ namespace ashes::gl
 			GL_MEMORY_PROPERTY_PERSISTENT_BIT = 0x00000040,
 			GL_MEMORY_PROPERTY_COHERENT_BIT = 0x00000080,
 			GL_MEMORY_PROPERTY_DYNAMIC_STORAGE_BIT = 0x0100,
+			GL_MEMORY_PROPERTY_SPARSE_STORAGE_BIT = 0x0400,
 		};
 		Ashes_ImplementFlag( GlMemoryPropertyFlag )
 		std::string getName( GlMemoryPropertyFlags value );
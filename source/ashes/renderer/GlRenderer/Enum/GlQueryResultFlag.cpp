@@ -12,6 +12,9 @@ namespace ashes::gl
 		case GL_QUERY_RESULT:
 			return "GL_QUERY_RESULT";
 
+		case GL_QUERY_RESULT_AVAILABLE:
+			return "GL_QUERY_RESULT_AVAILABLE";
+
 		case GL_QUERY_RESULT_NO_WAIT:
 			return "GL_QUERY_RESULT_NO_WAIT";
 
@@ -26,6 +29,12 @@ namespace ashes::gl
 		std::string result;
 		std::string sep;
 
+		// Not a flag, shares bits with GL_QUERY_RESULT.
+		if ( value == GL_QUERY_RESULT_AVAILABLE )
+		{
+			return getName( GL_QUERY_RESULT_AVAILABLE );
+		}
+
 		if ( checkFlag( value, GL_QUERY_RESULT ) )
 		{
 			result += sep + getName( GL_QUERY_RESULT );
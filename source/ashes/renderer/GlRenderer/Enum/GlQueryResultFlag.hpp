@@ -10,6 +10,7 @@ namespace ashes::gl
 	{
 		GL_QUERY_NONE = 0,
 		GL_QUERY_RESULT = 0x8866,
+		GL_QUERY_RESULT_AVAILABLE = 0x8867,
 		GL_QUERY_RESULT_NO_WAIT = 0x9194,
 	};
 	Ashes_ImplementFlag( GlQueryResultFlag )
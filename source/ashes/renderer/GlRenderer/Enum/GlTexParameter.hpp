@@ -20,6 +20,9 @@ namespace ashes::gl
 		GL_TEX_PARAMETER_SWIZZLE_G = 0x8E43,
 		GL_TEX_PARAMETER_SWIZZLE_B = 0x8E44,
 		GL_TEX_PARAMETER_SWIZZLE_A = 0x8E45,
+		GL_TEX_PARAMETER_SPARSE = 0x91A6,
+		GL_TEX_PARAMETER_VIRTUAL_PAGE_SIZE_INDEX = 0x91A7,
+		GL_TEX_PARAMETER_NUM_SPARSE_LEVELS = 0x91AA,
 	};
 
 	inline std::string getName( GlTexParameter value )
@@ -62,6 +65,15 @@ namespace ashes::gl
 		case GL_TEX_PARAMETER_SWIZZLE_A:
 			return "GL_TEXTURE_SWIZZLE_A";
 
+		case GL_TEX_PARAMETER_SPARSE:
+			return "GL_TEXTURE_SPARSE_ARB";
+
+		case GL_TEX_PARAMETER_VIRTUAL_PAGE_SIZE_INDEX:
+			return "GL_VIRTUAL_PAGE_SIZE_INDEX_ARB";
+
+		case GL_TEX_PARAMETER_NUM_SPARSE_LEVELS:
+			return "GL_NUM_SPARSE_LEVELS_ARB";
+
 		default:
 			assert( false && "Unsupported GlTexParameter" );
 			return "GlTexParameter_UNKNOWN";
@@ -138,7 +138,9 @@ namespace ashes::gl
 	class ContextStateStack;
 	class ExtensionsHandler;
 	class FrameBufferAttachment;
+	class FramebufferCache;
 	class GeometryBuffers;
+	class Profiler;
 	class ShaderProgram;
 
 	using ContextPtr = std::unique_ptr< Context >;
@@ -157,9 +159,17 @@ namespace ashes::gl
 	struct GlPhysicalDeviceFeatures
 	{
 		VkBool32 has420PackExtensions;
+		VkBool32 hasBindlessTextures;
 		VkBool32 hasCopyImage;
+		VkBool32 hasDirectStateAccess;
+		// GL_NVX_gpu_memory_info.
+		VkBool32 hasGpuMemoryInfo;
 		VkBool32 hasImmutableStorage;
+		// GL_ATI_meminfo.
+		VkBool32 hasMemInfo;
 		VkBool32 hasProgramPipelines;
+		VkBool32 hasSparseResources;
+		VkBool32 hasSpirvShaders;
 		VkBool32 hasTextureStorage;
 		VkBool32 hasTextureViews;
 		VkBool32 hasViewportArrays;
@@ -199,6 +209,21 @@ namespace ashes::gl
 	};
 
 	using FboAttachmentArray = std::vector< FboAttachment >;
+	/**
+	*\brief
+	*	An image subresource, attached alone to a framebuffer of the FramebufferCache.
+	*/
+	struct CachedAttachment
+	{
+		GLuint object;
+		GlAttachmentPoint point;
+		// The glFramebufferTexture2D target (a face target for cube maps), unused for layered attachments.
+		GlTextureType target;
+		uint32_t mipLevel;
+		uint32_t arrayLayer;
+		// Attached through glFramebufferTextureLayer.
+		uint32_t layered;
+	};
 
 	using DeviceMemoryDestroyFunc = std::function< void( GLuint ) >;
 	using DeviceMemoryDestroySignal = Signal< DeviceMemoryDestroyFunc >;
@@ -2,6 +2,7 @@
 
 #include "Command/GlCommandBuffer.hpp"
 #include "Core/GlDevice.hpp"
+#include "Core/GlPhysicalDevice.hpp"
 #include "Image/GlImageView.hpp"
 #include "Miscellaneous/GlCallLogger.hpp"
 #include "Miscellaneous/GlDeviceMemory.hpp"
@@ -208,25 +209,70 @@ namespace ashes::gl
 		, m_target{ convert( device, m_imageType, m_arrayLayers, m_flags, m_samples ) }
 		, m_swapchainImage{ swapchainImage }
 	{
+		if ( checkFlag( m_flags, VK_IMAGE_CREATE_SPARSE_BINDING_BIT )
+			&& hasSparseResources( m_device ) )
+		{
+			// Images without sparse texture support are bound as a whole, on their first opaque bind.
+			std::vector< VkSparseImageFormatProperties > formatProperties;
+			get( get( m_device )->getPhysicalDevice() )->getSparseImageFormatProperties( m_format
+				, m_imageType
+				, m_samples
+				, m_usage
+				, m_tiling
+				, formatProperties );
+			m_sparse = !formatProperties.empty();
+
+			if ( m_sparse )
+			{
+				m_sparsePageSize = formatProperties.front().imageGranularity;
+			}
+		}
+
 		auto context = get( m_device )->getContext();
-		glLogCall( context
-			, glGenTextures
-			, 1
-			, &m_internal );
-		glLogCall( context
-			, glBindTexture
-			, m_target
-			, m_internal );
-		glLogCall( context
-			, glBindTexture
-			, m_target
-			, 0 );
+
+		if ( hasDirectStateAccess( m_device ) )
+		{
+			glLogCall( context
+				, glCreateTextures
+				, m_target
+				, 1
+				, &m_internal );
+		}
+		else
+		{
+			glLogCall( context
+				, glGenTextures
+				, 1
+				, &m_internal );
+			glLogCall( context
+				, glBindTexture
+				, m_target
+				, m_internal );
+			glLogCall( context
+				, glBindTexture
+				, m_target
+				, 0 );
+		}
+
+		if ( m_sparse )
+		{
+			doInitialiseSparseStorage( context );
+		}
+
 		doInitialiseMemoryRequirements();
 	}
 
 	Image::~Image()
 	{
 		auto context = get( m_device )->getContext();
+		get( m_device )->getFramebufferCache().releaseTexture( context, m_internal );
+
+		// Sparse images aren't registered in their memory, which may be freed already.
+		if ( m_memory && !m_sparse )
+		{
+			get( m_memory )->unbindImage( get( this ) );
+		}
+
 		glLogCall( context
 			, glDeleteTextures
 			, 1
@@ -240,13 +286,114 @@ namespace ashes::gl
 
 	std::vector< VkSparseImageMemoryRequirements > Image::getSparseImageMemoryRequirements()const
 	{
-		return {};
+		std::vector< VkSparseImageMemoryRequirements > result;
+
+		if ( m_sparse )
+		{
+			VkSparseImageMemoryRequirements requirements{};
+			requirements.formatProperties = { getAspectMask( m_format ), m_sparsePageSize, 0u };
+			requirements.imageMipTailFirstLod = m_sparseLevels;
+
+			if ( m_sparseLevels < m_mipLevels )
+			{
+				requirements.imageMipTailSize = m_mipTailSize;
+				requirements.imageMipTailStride = m_mipTailSize;
+				requirements.imageMipTailOffset = getMipTailOffset();
+			}
+
+			result.push_back( requirements );
+		}
+
+		return result;
+	}
+
+	void Image::doInitialiseSparseStorage( ContextLock const & context )
+	{
+		// ARB_sparse_texture only allocates the virtual storage,
+		// the pages are then committed by vkQueueBindSparse.
+		auto internal = getInternalFormat( m_format );
+		glLogCall( context
+			, glBindTexture
+			, m_target
+			, m_internal );
+		glLogCall( context
+			, glTexParameteri
+			, m_target
+			, GL_TEX_PARAMETER_SPARSE
+			, GL_TRUE );
+		glLogCall( context
+			, glTexParameteri
+			, m_target
+			, GL_TEX_PARAMETER_VIRTUAL_PAGE_SIZE_INDEX
+			, 0 );
+
+		switch ( m_target )
+		{
+		case GL_TEXTURE_2D:
+		case GL_TEXTURE_CUBE:
+			glLogCall( context
+				, glTexStorage2D
+				, m_target
+				, GLsizei( m_mipLevels )
+				, internal
+				, m_extent.width
+				, m_extent.height );
+			break;
+		case GL_TEXTURE_2D_ARRAY:
+		case GL_TEXTURE_CUBE_ARRAY:
+			glLogCall( context
+				, glTexStorage3D
+				, m_target
+				, GLsizei( m_mipLevels )
+				, internal
+				, m_extent.width
+				, m_extent.height
+				, m_arrayLayers );
+			break;
+		default:
+			assert( false && "Unsupported sparse texture type" );
+			break;
+		}
+
+		GLint levels = 0;
+		glLogCall( context
+			, glGetTexParameteriv
+			, m_target
+			, GL_TEX_PARAMETER_NUM_SPARSE_LEVELS
+			, &levels );
+		m_sparseLevels = std::min( uint32_t( levels ), m_mipLevels );
+		glLogCall( context
+			, glBindTexture
+			, m_target
+			, 0 );
 	}
 
 	void Image::doInitialiseMemoryRequirements()
 	{
 		auto physicalDevice = get( get( m_device )->getPhysicalDevice() );
 		m_memoryRequirements.size = getTotalSize( getDimensions(), getFormat(), getArrayLayers(), getMipLevels() );
+
+		if ( m_sparse )
+		{
+			// The sparse block is a page, and the mip tail of each layer is bound as a whole,
+			// at the end of the opaque range.
+			m_memoryRequirements.alignment = getSize( m_sparsePageSize, getFormat() );
+			m_memoryRequirements.memoryTypeBits = physicalDevice->getMemoryTypeBits( VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT );
+
+			if ( m_sparseLevels < m_mipLevels )
+			{
+				m_mipTailSize = ashes::getAlignedSize( getTotalSize( getSubresourceDimensions( getDimensions(), m_sparseLevels )
+						, getFormat()
+						, 1u
+						, m_mipLevels - m_sparseLevels )
+					, m_memoryRequirements.alignment );
+			}
+
+			m_memoryRequirements.size = ashes::getAlignedSize( m_memoryRequirements.size, m_memoryRequirements.alignment )
+				+ m_mipTailSize * getArrayLayers();
+			return;
+		}
+
 		auto extent = ashes::getMinimalExtent3D( getFormat() );
 		m_memoryRequirements.alignment = getSize( extent, getFormat() );
 		m_memoryRequirements.memoryTypeBits = physicalDevice->getMemoryTypeBits( VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
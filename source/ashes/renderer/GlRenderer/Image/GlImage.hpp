@@ -84,9 +84,11 @@ namespace ashes::gl
 			return m_swapchainImage;
 		}
 
-		inline void setMemory( VkDeviceMemory memory )
+		inline void setMemory( VkDeviceMemory memory
+			, VkDeviceSize memoryOffset )
 		{
 			m_memory = memory;
+			m_memoryOffset = memoryOffset;
 		}
 
 		inline VkDeviceMemory getMemory()const
@@ -94,7 +96,37 @@ namespace ashes::gl
 			return m_memory;
 		}
 
+		inline VkDeviceSize getMemoryOffset()const
+		{
+			return m_memoryOffset;
+		}
+		/**
+		*\return
+		*	\p true if the image has ARB_sparse_texture storage, committed through vkQueueBindSparse.
+		*/
+		inline bool isSparse()const noexcept
+		{
+			return m_sparse;
+		}
+		/**
+		*\return
+		*	The number of mip levels committed page by page, the following ones form the mip tail.
+		*/
+		inline uint32_t getSparseLevels()const noexcept
+		{
+			return m_sparseLevels;
+		}
+		/**
+		*\return
+		*	The offset of the mip tails in the opaque range, its size if the image has no mip tail.
+		*/
+		inline VkDeviceSize getMipTailOffset()const noexcept
+		{
+			return m_memoryRequirements.size - m_mipTailSize * m_arrayLayers;
+		}
+
 	private:
+		void doInitialiseSparseStorage( ContextLock const & context );
 		void doInitialiseMemoryRequirements();
 
 	private:
@@ -113,7 +145,12 @@ namespace ashes::gl
 		GlTextureType m_target;
 		bool m_swapchainImage{ false };
 		VkDeviceMemory m_memory{ nullptr };
+		VkDeviceSize m_memoryOffset{ 0u };
 		VkMemoryRequirements m_memoryRequirements;
+		bool m_sparse{ false };
+		uint32_t m_sparseLevels{ 0u };
+		VkExtent3D m_sparsePageSize{};
+		VkDeviceSize m_mipTailSize{ 0u };
 	};
 }
 
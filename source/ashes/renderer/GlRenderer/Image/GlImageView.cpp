@@ -68,6 +68,7 @@ namespace ashes::gl
 			&& hasTextureViews( m_device ) )
 		{
 			auto context = get( m_device )->getContext();
+			// glTextureView needs a name that has never been bound, hence no glCreateTextures here.
 			glLogCall( context
 				, glGenTextures
 				, 1
@@ -82,79 +83,109 @@ namespace ashes::gl
 				, getSubresourceRange().levelCount
 				, getSubresourceRange().baseArrayLayer
 				, getSubresourceRange().layerCount );
-			glLogCall( context
-				, glBindTexture
-				, GlTextureType( m_glviewType )
-				, m_internal );
 
-			if ( getComponents().r != VK_COMPONENT_SWIZZLE_IDENTITY )
+			if ( hasDirectStateAccess( m_device ) )
 			{
-				glLogCall( context
-					, glTexParameteri
-					, GlTextureType( m_glviewType )
-					, GL_SWIZZLE_R
-					, convertComponentSwizzle( getComponents().r ) );
+				// The view's target is set by glTextureView, so no bind is needed to edit it.
+				doSetSwizzle( [&context, this]( GLenum name, GLint value )
+					{
+						glLogCall( context
+							, glTextureParameteri
+							, m_internal
+							, name
+							, value );
+					} );
 			}
-
-			if ( getComponents().g != VK_COMPONENT_SWIZZLE_IDENTITY )
+			else
 			{
 				glLogCall( context
-					, glTexParameteri
+					, glBindTexture
 					, GlTextureType( m_glviewType )
-					, GL_SWIZZLE_G
-					, convertComponentSwizzle( getComponents().g ) );
-			}
-
-			if ( getComponents().b != VK_COMPONENT_SWIZZLE_IDENTITY )
-			{
+					, m_internal );
+				doSetSwizzle( [&context, this]( GLenum name, GLint value )
+					{
+						glLogCall( context
+							, glTexParameteri
+							, GlTextureType( m_glviewType )
+							, name
+							, value );
+					} );
+#if !defined( NDEBUG )
+				int minLevel = 0;
+				glLogCall( context
+					, glGetTexParameteriv
+					, GlTextureType( m_glviewType )
+					, GL_TEX_PARAMETER_VIEW_MIN_LEVEL
+					, &minLevel );
+				assert( minLevel == getSubresourceRange().baseMipLevel );
+				int numLevels = 0;
+				glLogCall( context
+					, glGetTexParameteriv
+					, GlTextureType( m_glviewType )
+					, GL_TEX_PARAMETER_VIEW_NUM_LEVELS
+					, &numLevels );
+				assert( numLevels == getSubresourceRange().levelCount );
+				int minLayer = 0;
+				glLogCall( context
+					, glGetTexParameteriv
+					, GlTextureType( m_glviewType )
+					, GL_TEX_PARAMETER_VIEW_MIN_LAYER
+					, &minLayer );
+				assert( minLayer == getSubresourceRange().baseArrayLayer );
+				int numLayers = 0;
+				glLogCall( context
+					, glGetTexParameteriv
+					, GlTextureType( m_glviewType )
+					, GL_TEX_PARAMETER_VIEW_NUM_LAYERS
+					, &numLayers );
+				assert( numLayers == getSubresourceRange().layerCount );
+#endif
 				glLogCall( context
-					, glTexParameteri
+					, glBindTexture
 					, GlTextureType( m_glviewType )
-					, GL_SWIZZLE_B
-					, convertComponentSwizzle( getComponents().b ) );
+					, 0u );
 			}
 
-			if ( getComponents().a != VK_COMPONENT_SWIZZLE_IDENTITY )
+			if ( auto capture = get( m_device )->getCapture() )
 			{
-				glLogCall( context
-					, glTexParameteri
-					, GlTextureType( m_glviewType )
-					, GL_SWIZZLE_A
-					, convertComponentSwizzle( getComponents().a ) );
+				gl::capture::TextureViewDesc desc{ uint32_t( m_glviewType )
+					, get( createInfo.image )->getInternal()
+					, uint32_t( getInternalFormat( getFormat() ) )
+					, getSubresourceRange().baseMipLevel
+					, getSubresourceRange().levelCount
+					, getSubresourceRange().baseArrayLayer
+					, getSubresourceRange().layerCount
+					, {} };
+				doSetSwizzle( [&desc]( GLenum name, GLint value )
+					{
+						desc.swizzle[name - GL_SWIZZLE_R] = value;
+					} );
+				capture->registerTextureView( m_internal, desc );
 			}
+		}
+	}
 
-			int minLevel = 0;
-			glLogCall( context
-				, glGetTexParameteriv
-				, GlTextureType( m_glviewType )
-				, GL_TEX_PARAMETER_VIEW_MIN_LEVEL
-				, &minLevel );
-			assert( minLevel == getSubresourceRange().baseMipLevel );
-			int numLevels = 0;
-			glLogCall( context
-				, glGetTexParameteriv
-				, GlTextureType( m_glviewType )
-				, GL_TEX_PARAMETER_VIEW_NUM_LEVELS
-				, &numLevels );
-			assert( numLevels == getSubresourceRange().levelCount );
-			int minLayer = 0;
-			glLogCall( context
-				, glGetTexParameteriv
-				, GlTextureType( m_glviewType )
-				, GL_TEX_PARAMETER_VIEW_MIN_LAYER
-				, &minLayer );
-			assert( minLayer == getSubresourceRange().baseArrayLayer );
-			int numLayers = 0;
-			glLogCall( context
-				, glGetTexParameteriv
-				, GlTextureType( m_glviewType )
-				, GL_TEX_PARAMETER_VIEW_NUM_LAYERS
-				, &numLayers );
-			assert( numLayers == getSubresourceRange().layerCount );
-			glLogCall( context
-				, glBindTexture
-				, GlTextureType( m_glviewType )
-				, 0u );
+	template< typename SetParamFunc >
+	void ImageView::doSetSwizzle( SetParamFunc setParam )const
+	{
+		if ( getComponents().r != VK_COMPONENT_SWIZZLE_IDENTITY )
+		{
+			setParam( GL_SWIZZLE_R, convertComponentSwizzle( getComponents().r ) );
+		}
+
+		if ( getComponents().g != VK_COMPONENT_SWIZZLE_IDENTITY )
+		{
+			setParam( GL_SWIZZLE_G, convertComponentSwizzle( getComponents().g ) );
+		}
+
+		if ( getComponents().b != VK_COMPONENT_SWIZZLE_IDENTITY )
+		{
+			setParam( GL_SWIZZLE_B, convertComponentSwizzle( getComponents().b ) );
+		}
+
+		if ( getComponents().a != VK_COMPONENT_SWIZZLE_IDENTITY )
+		{
+			setParam( GL_SWIZZLE_A, convertComponentSwizzle( getComponents().a ) );
 		}
 	}
 
@@ -163,6 +194,14 @@ namespace ashes::gl
 		if ( hasTextureViews( m_device ) )
 		{
 			auto context = get( m_device )->getContext();
+
+			if ( auto handles = get( m_device )->getTextureHandles() )
+			{
+				handles->releaseTexture( context, m_internal );
+			}
+
+			get( m_device )->getFramebufferCache().releaseTexture( context, m_internal );
+
 			glLogCall( context
 				, glDeleteTextures
 				, 1
@@ -68,6 +68,10 @@ namespace ashes::gl
 			return m_image;
 		}
 
+	private:
+		template< typename SetParamFunc >
+		void doSetSwizzle( SetParamFunc setParam )const;
+
 	private:
 		VkDevice m_device;
 		VkImageViewCreateFlags m_flags;
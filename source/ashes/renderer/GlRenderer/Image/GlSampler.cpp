@@ -147,11 +147,22 @@ namespace ashes::gl
 				, ivalues );
 			break;
 		}
+
+		if ( auto capture = get( m_device )->getCapture() )
+		{
+			capture->registerSampler( m_internal );
+		}
 	}
 
 	Sampler::~Sampler()
 	{
 		auto context = get( m_device )->getContext();
+
+		if ( auto handles = get( m_device )->getTextureHandles() )
+		{
+			handles->releaseSampler( context, m_internal );
+		}
+
 		glLogCall( context
 			, glDeleteSamplers
 			, 1
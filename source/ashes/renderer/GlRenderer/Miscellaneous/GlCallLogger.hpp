@@ -52,6 +52,7 @@ See LICENSE file in root folder
 #include "renderer/GlRenderer/Enum/GlTextureViewType.hpp"
 #include "renderer/GlRenderer/Enum/GlTweak.hpp"
 #include "renderer/GlRenderer/Enum/GlWrapMode.hpp"
+#include "renderer/GlRenderer/Miscellaneous/GlCallTracer.hpp"
 
 #include <iostream>
 #include <iomanip>
@@ -491,22 +492,90 @@ namespace ashes::gl
 	}
 
 	template< typename ... ParamsT >
-	inline auto glCallCheckError( ContextLock const & context
+	inline bool glCallCheckError( ContextLock const & context
 		, char const * const name
 		, ParamsT ... params )
 	{
+		if ( !isErrorCheckEnabled() )
+		{
+			return true;
+		}
+
+		auto errorCode = getError( context );
+
+		if ( !errorCode )
+		{
+			return true;
+		}
+
+		// The call text is only built when an error is reported.
 		std::stringstream stream;
 		stream << name;
 		logParams( stream, std::forward< ParamsT >( params )... );
-		return glCheckError( context, stream.str() );
+		return glReportError( context, errorCode, stream.str() );
 	}
 
-	inline auto glCallCheckError( ContextLock const & context
+	inline bool glCallCheckError( ContextLock const & context
 		, char const * const name )
 	{
-		std::stringstream stream;
-		stream << name << "()";
-		return glCheckError( context, stream.str() );
+		if ( !isErrorCheckEnabled() )
+		{
+			return true;
+		}
+
+		auto errorCode = getError( context );
+
+		if ( !errorCode )
+		{
+			return true;
+		}
+
+		return glReportError( context, errorCode, std::string{ name } + "()" );
+	}
+
+	/**
+	*\brief
+	*	Traces, executes and, in debug builds, checks a GL call.
+	*\remarks
+	*	Going through a function makes the call arguments evaluated only once.
+	*/
+	template< typename FuncT, typename ... ParamsT >
+	inline bool callFunction( ContextLock const & context
+		, GlFunctionId id
+		, FuncT function
+		, char const * const name
+		, ParamsT ... params )
+	{
+		if ( CallTracer::isRecording() )
+		{
+			CallTracer::record( id, params... );
+		}
+
+		function( params... );
+#if defined( NDEBUG )
+		return true;
+#else
+		return glCallCheckError( context, name, params... );
+#endif
+	}
+
+	template< typename FuncT, typename ... ParamsT >
+	inline auto callNonVoidFunction( ContextLock const & context
+		, GlFunctionId id
+		, FuncT function
+		, char const * const name
+		, ParamsT ... params )
+	{
+		if ( CallTracer::isRecording() )
+		{
+			CallTracer::record( id, params... );
+		}
+
+		auto result = function( params... );
+#if !defined( NDEBUG )
+		glCallCheckError( context, name, params... );
+#endif
+		return result;
 	}
 
 #if AshesGL_LogCalls
@@ -520,27 +589,15 @@ namespace ashes::gl
 	executeNonVoidFunction( lock, ashes::gl::getContext( lock ).m_##name, #name )
 #	define glLogCommand( list, name )\
 	list.push_back( makeCmd< OpType::eLogCommand >( name ) );
-#elif defined( NDEBUG )
-#	define glLogEmptyCall( lock, name )\
-	( ( lock->m_##name() ), true )
-#	define glLogCall( lock, name, ... )\
-	( ( lock->m_##name( __VA_ARGS__ ) ), true )
-#	define glLogNonVoidCall( lock, name, ... )\
-	( lock->m_##name( __VA_ARGS__ ) )
-#	define glLogNonVoidEmptyCall( lock, name )\
-	( lock->m_##name() );
-#	define glLogCommand( list, name )
 #else
 #	define glLogEmptyCall( lock, name )\
-	( ( lock->m_##name() ), glCallCheckError( lock, #name ) )
+	ashes::gl::callFunction( lock, ashes::gl::GlFunctionId::name, lock->m_##name, #name )
 #	define glLogCall( lock, name, ... )\
-	( ( lock->m_##name( __VA_ARGS__ ) ), glCallCheckError( lock, #name, __VA_ARGS__ ) )
+	ashes::gl::callFunction( lock, ashes::gl::GlFunctionId::name, lock->m_##name, #name, __VA_ARGS__ )
 #	define glLogNonVoidCall( lock, name, ... )\
-	( lock->m_##name( __VA_ARGS__ ) );\
-	glCallCheckError( lock, #name, __VA_ARGS__ )
+	ashes::gl::callNonVoidFunction( lock, ashes::gl::GlFunctionId::name, lock->m_##name, #name, __VA_ARGS__ )
 #	define glLogNonVoidEmptyCall( lock, name )\
-	( lock->m_##name() );\
-	glCallCheckError( lock, #name )
+	ashes::gl::callNonVoidFunction( lock, ashes::gl::GlFunctionId::name, lock->m_##name, #name )
 #	define glLogCommand( list, name )
 #endif
 }
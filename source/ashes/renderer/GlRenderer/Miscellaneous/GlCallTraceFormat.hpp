@@ -0,0 +1,79 @@
+/*
+This file belongs to Ashes.
+See LICENSE file in root folder
+*/
+#pragma once
+
+#include <cstdint>
+
+namespace ashes::gl::trace
+{
+	/**
+	*\brief
+	*	Binary GL calls trace file layout, shared by the tracer and the decoder.
+	*\remarks
+	*	The file starts with a FileHeader, followed by the functions names,
+	*	each being a uint16_t length and the characters.
+	*	Then come the chunks, a ChunkHeader followed by ChunkHeader::wordCount
+	*	64 bits words, holding records from a single thread.
+	*	A record is:
+	*	- word 0: the timestamp, in nanoseconds since the trace start.
+	*	- word 1: the record info (see makeInfo).
+	*	- the arguments, one word each.
+	*/
+	char constexpr Magic[8] = { 'A', 'G', 'L', 'T', 'R', 'A', 'C', 'E' };
+	uint32_t constexpr Version = 1u;
+	// The function index of the records marking a frame end.
+	uint16_t constexpr FrameMarker = 0xFFFFu;
+	// The arguments types are stored on 2 bits each, in a 32 bits field.
+	uint32_t constexpr MaxArgs = 16u;
+
+	enum class ArgType
+		: uint32_t
+	{
+		eUnsigned,
+		eSigned,
+		eFloat,
+		ePointer,
+	};
+
+	struct FileHeader
+	{
+		char magic[8];
+		uint32_t version;
+		uint32_t functionCount;
+	};
+
+	struct ChunkHeader
+	{
+		uint32_t thread;
+		uint32_t wordCount;
+		// The records of this thread dropped since its previous chunk, because its ring was full.
+		uint64_t dropped;
+	};
+
+	inline uint64_t makeInfo( uint16_t function
+		, uint32_t argCount
+		, uint32_t argTypes )
+	{
+		return uint64_t( function )
+			| ( uint64_t( argCount & 0xFFu ) << 16u )
+			| ( uint64_t( argTypes ) << 32u );
+	}
+
+	inline uint16_t getFunction( uint64_t info )
+	{
+		return uint16_t( info & 0xFFFFu );
+	}
+
+	inline uint32_t getArgCount( uint64_t info )
+	{
+		return uint32_t( ( info >> 16u ) & 0xFFu );
+	}
+
+	inline ArgType getArgType( uint64_t info
+		, uint32_t index )
+	{
+		return ArgType( ( info >> ( 32u + 2u * index ) ) & 0x3u );
+	}
+}
@@ -0,0 +1,337 @@
+/*
+This file belongs to Ashes.
+See LICENSE file in root folder
+*/
+#include "Miscellaneous/GlCallTracer.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ashes::gl
+{
+	namespace
+	{
+		using Clock = std::chrono::steady_clock;
+
+		// Per thread ring size, in 64 bits words (8 MiB).
+		size_t constexpr RingSize = 1u << 20u;
+		auto constexpr DrainPeriod = std::chrono::milliseconds{ 10 };
+
+		char const * const FunctionNames[]
+		{
+#define GL_LIB_BASE_FUNCTION( fun )\
+			"gl"#fun,
+#define GL_LIB_FUNCTION( fun )\
+			"gl"#fun,
+#define GL_LIB_FUNCTION_EXT( fun, ... )\
+			"gl"#fun,
+#include "Miscellaneous/OpenGLFunctionsList.inl"
+		};
+		static_assert( sizeof( FunctionNames ) / sizeof( FunctionNames[0] ) == size_t( GlFunctionId::eCount ) );
+
+		/**
+		*\brief
+		*	Single producer (the recording thread), single consumer (the writer thread) ring.
+		*\remarks
+		*	The records are variable-length: two words, then one word per argument.
+		*/
+		struct ThreadRing
+		{
+			explicit ThreadRing( uint32_t index )
+				: index{ index }
+				, data( RingSize )
+			{
+			}
+
+			void push( uint64_t const * words
+				, uint32_t count )
+			{
+				auto head = m_head.load( std::memory_order_relaxed );
+				auto tail = m_tail.load( std::memory_order_acquire );
+
+				if ( head + count - tail > RingSize )
+				{
+					dropped.fetch_add( 1u, std::memory_order_relaxed );
+					return;
+				}
+
+				for ( uint32_t i = 0u; i < count; ++i )
+				{
+					data[( head + i ) & ( RingSize - 1u )] = words[i];
+				}
+
+				m_head.store( head + count, std::memory_order_release );
+			}
+
+			void pop( std::vector< uint64_t > & words )
+			{
+				auto tail = m_tail.load( std::memory_order_relaxed );
+				auto head = m_head.load( std::memory_order_acquire );
+				words.clear();
+
+				for ( auto i = tail; i < head; ++i )
+				{
+					words.push_back( data[i & ( RingSize - 1u )] );
+				}
+
+				m_tail.store( head, std::memory_order_release );
+			}
+
+			uint32_t index;
+			std::vector< uint64_t > data;
+			std::atomic< uint64_t > dropped{ 0u };
+
+		private:
+			std::atomic< uint64_t > m_head{ 0u };
+			std::atomic< uint64_t > m_tail{ 0u };
+		};
+
+		struct Session
+		{
+			std::mutex mutex;
+			std::condition_variable wake;
+			uint32_t users{ 0u };
+			std::atomic< bool > active{ false };
+			bool stop{ false };
+			std::ofstream file;
+			std::thread writer;
+			Clock::time_point start;
+			std::atomic< uint64_t > frame{ 0u };
+			uint64_t firstFrame{ 0u };
+			uint64_t endFrame{ ~uint64_t( 0u ) };
+			// The rings are never destroyed, since threads keep a pointer to theirs.
+			std::vector< std::unique_ptr< ThreadRing > > rings;
+		};
+
+		Session & getSession()
+		{
+			static Session result;
+			return result;
+		}
+
+		thread_local ThreadRing * t_ring = nullptr;
+
+		std::string getTracePath()
+		{
+			auto value = std::getenv( "ASHES_GL_TRACE" );
+
+			if ( !value
+				|| !*value
+				|| std::string{ value } == "0" )
+			{
+				return std::string{};
+			}
+
+			if ( std::string{ value } == "1" )
+			{
+				return "ashes_gl_trace.bin";
+			}
+
+			return value;
+		}
+
+		void readFramesRange( Session & session )
+		{
+			session.firstFrame = 0u;
+			session.endFrame = ~uint64_t( 0u );
+
+			if ( auto value = std::getenv( "ASHES_GL_TRACE_FRAMES" ) )
+			{
+				char * end{};
+				session.firstFrame = std::strtoull( value, &end, 10 );
+
+				if ( end && *end == ':' )
+				{
+					session.endFrame = session.firstFrame + std::strtoull( end + 1, nullptr, 10 );
+				}
+			}
+		}
+
+		void writeHeader( std::ofstream & file )
+		{
+			trace::FileHeader header{};
+			std::memcpy( header.magic, trace::Magic, sizeof( header.magic ) );
+			header.version = trace::Version;
+			header.functionCount = uint32_t( GlFunctionId::eCount );
+			file.write( reinterpret_cast< char const * >( &header ), sizeof( header ) );
+
+			for ( auto name : FunctionNames )
+			{
+				auto length = uint16_t( std::strlen( name ) );
+				file.write( reinterpret_cast< char const * >( &length ), sizeof( length ) );
+				file.write( name, length );
+			}
+		}
+
+		void drain( Session & session
+			, std::vector< ThreadRing * > const & rings
+			, std::vector< uint64_t > & words )
+		{
+			for ( auto ring : rings )
+			{
+				ring->pop( words );
+				auto dropped = ring->dropped.exchange( 0u, std::memory_order_relaxed );
+
+				if ( !words.empty() || dropped )
+				{
+					trace::ChunkHeader header{ ring->index, uint32_t( words.size() ), dropped };
+					session.file.write( reinterpret_cast< char const * >( &header ), sizeof( header ) );
+					session.file.write( reinterpret_cast< char const * >( words.data() )
+						, std::streamsize( words.size() * sizeof( uint64_t ) ) );
+				}
+			}
+		}
+
+		void runWriter( Session & session )
+		{
+			std::vector< ThreadRing * > rings;
+			std::vector< uint64_t > words;
+			words.reserve( RingSize );
+			bool stop{ false };
+
+			while ( !stop )
+			{
+				{
+					// Only the rings list is read under the lock, the recording threads
+					// registering their ring must not wait for the file writes.
+					std::unique_lock< std::mutex > lock{ session.mutex };
+					session.wake.wait_for( lock
+						, DrainPeriod
+						, [&session]()
+						{
+							return session.stop;
+						} );
+					stop = session.stop;
+					rings.clear();
+
+					for ( auto & ring : session.rings )
+					{
+						rings.push_back( ring.get() );
+					}
+				}
+
+				// The rings are lock-free, and the file is only closed once this thread is joined.
+				drain( session, rings, words );
+			}
+
+			session.file.flush();
+		}
+	}
+
+	//*********************************************************************************************
+
+	char const * getName( GlFunctionId value )
+	{
+		return value < GlFunctionId::eCount
+			? FunctionNames[size_t( value )]
+			: "glUnknown";
+	}
+
+	//*********************************************************************************************
+
+	void CallTracer::acquire()
+	{
+		auto & session = getSession();
+		std::unique_lock< std::mutex > lock{ session.mutex };
+
+		if ( session.users++ )
+		{
+			return;
+		}
+
+		auto path = getTracePath();
+
+		if ( path.empty() )
+		{
+			return;
+		}
+
+		session.file.open( path, std::ios::binary | std::ios::trunc );
+
+		if ( !session.file )
+		{
+			std::cerr << "Couldn't open GL trace file [" << path << "]" << std::endl;
+			return;
+		}
+
+		writeHeader( session.file );
+		readFramesRange( session );
+		session.start = Clock::now();
+		session.frame = 0u;
+		session.stop = false;
+		session.active = true;
+		session.writer = std::thread{ [&session]()
+			{
+				runWriter( session );
+			} };
+		m_recording.store( session.firstFrame == 0u
+			&& session.endFrame > 0u );
+	}
+
+	void CallTracer::release()
+	{
+		auto & session = getSession();
+		std::unique_lock< std::mutex > lock{ session.mutex };
+
+		if ( --session.users
+			|| !session.active )
+		{
+			return;
+		}
+
+		m_recording.store( false );
+		session.active = false;
+		session.stop = true;
+		lock.unlock();
+		session.wake.notify_one();
+		session.writer.join();
+		lock.lock();
+		session.file.close();
+	}
+
+	void CallTracer::frame()
+	{
+		auto & session = getSession();
+
+		if ( !session.active.load( std::memory_order_relaxed ) )
+		{
+			return;
+		}
+
+		if ( isRecording() )
+		{
+			uint64_t words[2];
+			words[1] = trace::makeInfo( trace::FrameMarker, 0u, 0u );
+			doRecord( words, 2u );
+		}
+
+		auto frame = ++session.frame;
+		m_recording.store( frame >= session.firstFrame
+				&& frame < session.endFrame
+			, std::memory_order_relaxed );
+	}
+
+	void CallTracer::doRecord( uint64_t * words
+		, uint32_t count )
+	{
+		auto & session = getSession();
+
+		if ( !t_ring )
+		{
+			std::unique_lock< std::mutex > lock{ session.mutex };
+			session.rings.push_back( std::make_unique< ThreadRing >( uint32_t( session.rings.size() ) ) );
+			t_ring = session.rings.back().get();
+		}
+
+		words[0] = uint64_t( std::chrono::duration_cast< std::chrono::nanoseconds >( Clock::now() - session.start ).count() );
+		t_ring->push( words, count );
+	}
+}
@@ -0,0 +1,153 @@
+/*
+This file belongs to Ashes.
+See LICENSE file in root folder
+*/
+#pragma once
+
+#include "renderer/GlRenderer/Miscellaneous/GlCallTraceFormat.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+namespace ashes::gl
+{
+	enum class GlFunctionId
+		: uint16_t
+	{
+#define GL_LIB_BASE_FUNCTION( fun )\
+		gl##fun,
+#define GL_LIB_FUNCTION( fun )\
+		gl##fun,
+#define GL_LIB_FUNCTION_EXT( fun, ... )\
+		gl##fun,
+#include "renderer/GlRenderer/Miscellaneous/OpenGLFunctionsList.inl"
+		eCount,
+	};
+	char const * getName( GlFunctionId value );
+
+	template< typename ParamT >
+	constexpr trace::ArgType getArgType()
+	{
+		if constexpr ( std::is_pointer_v< ParamT > || std::is_null_pointer_v< ParamT > )
+		{
+			return trace::ArgType::ePointer;
+		}
+		else if constexpr ( std::is_floating_point_v< ParamT > )
+		{
+			return trace::ArgType::eFloat;
+		}
+		else if constexpr ( std::is_enum_v< ParamT > )
+		{
+			return std::is_signed_v< std::underlying_type_t< ParamT > >
+				? trace::ArgType::eSigned
+				: trace::ArgType::eUnsigned;
+		}
+		else
+		{
+			return std::is_signed_v< ParamT >
+				? trace::ArgType::eSigned
+				: trace::ArgType::eUnsigned;
+		}
+	}
+
+	template< typename ParamT >
+	inline uint64_t packArg( ParamT value )
+	{
+		if constexpr ( std::is_null_pointer_v< ParamT > )
+		{
+			return 0u;
+		}
+		else if constexpr ( std::is_pointer_v< ParamT > )
+		{
+			return uint64_t( reinterpret_cast< uintptr_t >( value ) );
+		}
+		else if constexpr ( std::is_floating_point_v< ParamT > )
+		{
+			double converted = double( value );
+			uint64_t result;
+			std::memcpy( &result, &converted, sizeof( result ) );
+			return result;
+		}
+		else if constexpr ( std::is_enum_v< ParamT > )
+		{
+			return uint64_t( std::underlying_type_t< ParamT >( value ) );
+		}
+		else
+		{
+			return uint64_t( value );
+		}
+	}
+
+	/**
+	*\brief
+	*	Binary GL calls tracer.
+	*\remarks
+	*	Enabled at runtime, through the ASHES_GL_TRACE environment variable, which holds
+	*	the trace file path ("1" selects ashes_gl_trace.bin).
+	*	ASHES_GL_TRACE_FRAMES ("first[:count]") restricts the recording to a range of frames.
+	*	Each thread writes its variable-length records (timestamp, function and
+	*	arguments types, then one word per argument) to its own lock-free ring,
+	*	drained to the file by a writer thread.
+	*	When a ring is full, the records are dropped rather than blocking the caller.
+	*	The traces are read by the AshesGlTraceDecoder tool.
+	*/
+	class CallTracer
+	{
+	public:
+		/**
+		*\brief
+		*	Starts the tracing session, if requested and not already started.
+		*/
+		static void acquire();
+		/**
+		*\brief
+		*	Ends the tracing session, when its last user releases it.
+		*/
+		static void release();
+		/**
+		*\brief
+		*	Marks the end of a frame.
+		*/
+		static void frame();
+
+		static inline bool isRecording()
+		{
+			return m_recording.load( std::memory_order_relaxed );
+		}
+
+		template< typename ... ParamsT >
+		static inline bool record( GlFunctionId function
+			, ParamsT ... params )
+		{
+			uint64_t words[2u + trace::MaxArgs];
+			uint32_t count{ 0u };
+			uint32_t types{ 0u };
+			( doPack( words + 2u, count, types, params ), ... );
+			words[1] = trace::makeInfo( uint16_t( function ), count, types );
+			doRecord( words, 2u + count );
+			return true;
+		}
+
+	private:
+		template< typename ParamT >
+		static inline void doPack( uint64_t * args
+			, uint32_t & count
+			, uint32_t & types
+			, ParamT value )
+		{
+			if ( count < trace::MaxArgs )
+			{
+				types |= uint32_t( getArgType< ParamT >() ) << ( 2u * count );
+				args[count++] = packArg( value );
+			}
+		}
+
+		static void doRecord( uint64_t * words
+			, uint32_t count );
+
+	private:
+		static inline std::atomic< bool > m_recording{ false };
+	};
+}
@@ -0,0 +1,1237 @@
+/*
+This file belongs to Ashes.
+See LICENSE file in root folder
+*/
+#include "Miscellaneous/GlCapture.hpp"
+
+#include "Buffer/GlGeometryBuffers.hpp"
+#include "Command/GlQueue.hpp"
+#include "Command/Commands/GlBindDescriptorSetCommand.hpp"
+#include "Command/Commands/GlBindGeometryBuffersCommand.hpp"
+#include "Command/Commands/GlBindPipelineCommand.hpp"
+#include "Command/Commands/GlClearColourCommand.hpp"
+#include "Command/Commands/GlClearDepthStencilCommand.hpp"
+#include "Command/Commands/GlCopyImageCommand.hpp"
+#include "Command/Commands/GlPushConstantsCommand.hpp"
+#include "Core/GlContextState.hpp"
+#include "Core/GlDevice.hpp"
+#include "Image/GlImage.hpp"
+#include "Miscellaneous/GlCallLogger.hpp"
+#include "RenderPass/GlFrameBuffer.hpp"
+
+#include "ashesgl_api.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <type_traits>
+
+namespace ashes::gl
+{
+	namespace
+	{
+		GLenum constexpr GL_PACK_ALIGNMENT = 0x0D05;
+		GLenum constexpr GL_PIXEL_PACK_BUFFER_BINDING = 0x88ED;
+		GLenum constexpr GL_COPY_READ_BUFFER_BINDING = 0x8F36;
+
+		using Part = std::pair< void const *, size_t >;
+
+		/**
+		*\brief
+		*	Layout of the serialised context states, followed by the colour blend
+		*	attachments, the viewports, the scissors, and the dynamic states.
+		*\remarks
+		*	The pointers are nulled, so that identical states give identical keys.
+		*/
+		struct ContextStateHeader
+		{
+			VkPipelineColorBlendStateCreateInfo cbState;
+			VkPipelineDepthStencilStateCreateInfo dsState;
+			VkPipelineMultisampleStateCreateInfo msState;
+			VkPipelineTessellationStateCreateInfo tsState;
+			VkPipelineInputAssemblyStateCreateInfo iaState;
+			VkPipelineViewportStateCreateInfo vpState;
+			VkPipelineRasterizationStateCreateInfo rsState;
+			VkPipelineDynamicStateCreateInfo dyState;
+			VkSampleMask sampleMask;
+			uint32_t hasSampleMask;
+			uint32_t sRGB;
+			uint32_t viewportCount;
+			uint32_t scissorCount;
+		};
+
+		std::string getCapturePath()
+		{
+			auto value = std::getenv( "ASHES_GL_CAPTURE" );
+
+			if ( !value
+				|| !*value
+				|| std::strcmp( value, "0" ) == 0 )
+			{
+				return std::string{};
+			}
+
+			if ( std::strcmp( value, "1" ) == 0 )
+			{
+				return "ashes_gl_capture.bin";
+			}
+
+			return value;
+		}
+
+		GLenum getBindingQuery( GlTextureType target )
+		{
+			switch ( target )
+			{
+			case GL_TEXTURE_1D:
+				return 0x8068;
+			case GL_TEXTURE_2D:
+				return 0x8069;
+			case GL_TEXTURE_3D:
+				return 0x806A;
+			case GL_TEXTURE_1D_ARRAY:
+				return 0x8C1C;
+			case GL_TEXTURE_2D_ARRAY:
+				return 0x8C1D;
+			case GL_TEXTURE_CUBE:
+				return 0x8514;
+			case GL_TEXTURE_CUBE_ARRAY:
+				return 0x900A;
+			case GL_TEXTURE_2D_MULTISAMPLE:
+				return 0x9104;
+			case GL_TEXTURE_2D_MULTISAMPLE_ARRAY:
+				return 0x9105;
+			default:
+				return 0x8069;
+			}
+		}
+
+		template< typename ValueT >
+		void append( std::string & result
+			, ValueT const * values
+			, size_t count )
+		{
+			result.append( reinterpret_cast< char const * >( values ), count * sizeof( ValueT ) );
+		}
+
+		template< typename ValueT >
+		ValueT const * read( uint8_t const *& data
+			, size_t count )
+		{
+			auto result = reinterpret_cast< ValueT const * >( data );
+			data += count * sizeof( ValueT );
+			return result;
+		}
+
+		template< typename HandleT >
+		HandleT toHandle( uint64_t value )
+		{
+			if constexpr ( std::is_pointer_v< HandleT > )
+			{
+				return reinterpret_cast< HandleT >( uintptr_t( value ) );
+			}
+			else
+			{
+				return HandleT( value );
+			}
+		}
+	}
+
+	//*********************************************************************************************
+
+	void forEachObjectName( Command & cmd
+		, std::function< void( ObjectNamespace, uint32_t & ) > const & func )
+	{
+		switch ( cmd.op.type )
+		{
+		case OpType::eBindBuffer:
+			func( ObjectNamespace::eBuffer, map< OpType::eBindBuffer >( cmd ).name );
+			break;
+		case OpType::eBufferSubData:
+			func( ObjectNamespace::eBuffer, map< OpType::eBufferSubData >( cmd ).name );
+			break;
+		case OpType::eClearBufferSubData:
+			func( ObjectNamespace::eBuffer, map< OpType::eClearBufferSubData >( cmd ).name );
+			break;
+		case OpType::eBindBufferRange:
+			func( ObjectNamespace::eBuffer, map< OpType::eBindBufferRange >( cmd ).name );
+			break;
+		case OpType::eBindTexture:
+			func( ObjectNamespace::eTexture, map< OpType::eBindTexture >( cmd ).name );
+			break;
+		case OpType::eBindImage:
+			func( ObjectNamespace::eTexture, map< OpType::eBindImage >( cmd ).name );
+			break;
+		case OpType::eBindSampler:
+			func( ObjectNamespace::eSampler, map< OpType::eBindSampler >( cmd ).name );
+			break;
+		case OpType::eBindVextexArrayObject:
+			func( ObjectNamespace::eVertexArray, map< OpType::eBindVextexArrayObject >( cmd ).vao );
+			break;
+		case OpType::eUseProgram:
+			func( ObjectNamespace::eProgram, map< OpType::eUseProgram >( cmd ).program );
+			break;
+		case OpType::eUseProgramPipeline:
+			func( ObjectNamespace::ePipeline, map< OpType::eUseProgramPipeline >( cmd ).program );
+			break;
+		case OpType::eProgramUniform1fv:
+		case OpType::eProgramUniform2fv:
+		case OpType::eProgramUniform3fv:
+		case OpType::eProgramUniform4fv:
+		case OpType::eProgramUniform1iv:
+		case OpType::eProgramUniform2iv:
+		case OpType::eProgramUniform3iv:
+		case OpType::eProgramUniform4iv:
+		case OpType::eProgramUniform1uiv:
+		case OpType::eProgramUniform2uiv:
+		case OpType::eProgramUniform3uiv:
+		case OpType::eProgramUniform4uiv:
+		case OpType::eProgramUniformMatrix2fv:
+		case OpType::eProgramUniformMatrix3fv:
+		case OpType::eProgramUniformMatrix4fv:
+			// All the program uniform commands start with the program name.
+			func( ObjectNamespace::eProgram, map< OpType::eProgramUniform1fv >( cmd ).program );
+			break;
+		case OpType::eFramebufferTexture:
+			func( ObjectNamespace::eTexture, map< OpType::eFramebufferTexture >( cmd ).object );
+			break;
+		case OpType::eFramebufferTexture2D:
+			func( ObjectNamespace::eTexture, map< OpType::eFramebufferTexture2D >( cmd ).object );
+			break;
+		case OpType::eFramebufferTextureLayer:
+			func( ObjectNamespace::eTexture, map< OpType::eFramebufferTextureLayer >( cmd ).object );
+			break;
+		case OpType::eBindCachedFramebuffer:
+			func( ObjectNamespace::eTexture, map< OpType::eBindCachedFramebuffer >( cmd ).attach.object );
+			break;
+		case OpType::eClearTexColor:
+			func( ObjectNamespace::eTexture, map< OpType::eClearTexColor >( cmd ).name );
+			break;
+		case OpType::eClearTexDepth:
+			func( ObjectNamespace::eTexture, map< OpType::eClearTexDepth >( cmd ).name );
+			break;
+		case OpType::eClearTexStencil:
+			func( ObjectNamespace::eTexture, map< OpType::eClearTexStencil >( cmd ).name );
+			break;
+		case OpType::eClearTexDepthStencil:
+			func( ObjectNamespace::eTexture, map< OpType::eClearTexDepthStencil >( cmd ).name );
+			break;
+		case OpType::eCopyImageSubData:
+			func( ObjectNamespace::eTexture, map< OpType::eCopyImageSubData >( cmd ).srcName );
+			func( ObjectNamespace::eTexture, map< OpType::eCopyImageSubData >( cmd ).dstName );
+			break;
+		case OpType::eCopyImageSubData1D:
+			func( ObjectNamespace::eTexture, map< OpType::eCopyImageSubData1D >( cmd ).srcName );
+			func( ObjectNamespace::eTexture, map< OpType::eCopyImageSubData1D >( cmd ).dstName );
+			break;
+		case OpType::eCopyImageSubData2D:
+			func( ObjectNamespace::eTexture, map< OpType::eCopyImageSubData2D >( cmd ).srcName );
+			func( ObjectNamespace::eTexture, map< OpType::eCopyImageSubData2D >( cmd ).dstName );
+			break;
+		case OpType::eCopyImageSubData3D:
+			func( ObjectNamespace::eTexture, map< OpType::eCopyImageSubData3D >( cmd ).srcName );
+			func( ObjectNamespace::eTexture, map< OpType::eCopyImageSubData3D >( cmd ).dstName );
+			break;
+		default:
+			break;
+		}
+	}
+
+	std::string serialiseContextState( ContextState const & state )
+	{
+		ContextStateHeader header;
+		std::memset( &header, 0, sizeof( header ) );
+		header.cbState = state.cbState;
+		header.cbState.pNext = nullptr;
+		header.cbState.pAttachments = nullptr;
+		header.cbState.attachmentCount = uint32_t( state.cbStateAttachments.size() );
+		header.dsState = state.dsState;
+		header.dsState.pNext = nullptr;
+		header.msState = state.msState;
+		header.msState.pNext = nullptr;
+		header.msState.pSampleMask = nullptr;
+		header.tsState = state.tsState;
+		header.tsState.pNext = nullptr;
+		header.iaState = state.iaState;
+		header.iaState.pNext = nullptr;
+		header.vpState = state.vpState;
+		header.vpState.pNext = nullptr;
+		header.vpState.pViewports = nullptr;
+		header.vpState.pScissors = nullptr;
+		header.rsState = state.rsState;
+		header.rsState.pNext = nullptr;
+		header.dyState = state.dyState;
+		header.dyState.pNext = nullptr;
+		header.dyState.pDynamicStates = nullptr;
+		header.dyState.dynamicStateCount = uint32_t( state.dynamicStates.size() );
+		header.sampleMask = state.sampleMask ? *state.sampleMask : 0u;
+		header.hasSampleMask = state.sampleMask ? 1u : 0u;
+		header.sRGB = state.sRGB ? 1u : 0u;
+		header.viewportCount = state.vpState.pViewports ? state.vpState.viewportCount : 0u;
+		header.scissorCount = state.vpState.pScissors ? state.vpState.scissorCount : 0u;
+
+		std::string result;
+		append( result, &header, 1u );
+		append( result, state.cbStateAttachments.data(), state.cbStateAttachments.size() );
+		append( result, state.vpState.pViewports, header.viewportCount );
+		append( result, state.vpState.pScissors, header.scissorCount );
+		append( result, state.dynamicStates.data(), state.dynamicStates.size() );
+		return result;
+	}
+
+	std::unique_ptr< ContextState > deserialiseContextState( uint8_t const * data
+		, size_t size )
+	{
+		if ( size < sizeof( ContextStateHeader ) )
+		{
+			return nullptr;
+		}
+
+		auto header = *read< ContextStateHeader >( data, 1u );
+		auto expected = sizeof( ContextStateHeader )
+			+ header.cbState.attachmentCount * sizeof( VkPipelineColorBlendAttachmentState )
+			+ header.viewportCount * sizeof( VkViewport )
+			+ header.scissorCount * sizeof( VkRect2D )
+			+ header.dyState.dynamicStateCount * sizeof( VkDynamicState );
+
+		if ( size < expected )
+		{
+			return nullptr;
+		}
+
+		header.cbState.pAttachments = read< VkPipelineColorBlendAttachmentState >( data, header.cbState.attachmentCount );
+		header.vpState.pViewports = header.viewportCount
+			? read< VkViewport >( data, header.viewportCount )
+			: nullptr;
+		header.vpState.pScissors = header.scissorCount
+			? read< VkRect2D >( data, header.scissorCount )
+			: nullptr;
+		header.dyState.pDynamicStates = read< VkDynamicState >( data, header.dyState.dynamicStateCount );
+		auto result = std::make_unique< ContextState >( header.cbState
+			, &header.dsState
+			, &header.msState
+			, &header.tsState
+			, &header.iaState
+			, &header.vpState
+			, &header.rsState
+			, &header.dyState );
+
+		if ( header.hasSampleMask )
+		{
+			result->sampleMask = header.sampleMask;
+			result->msState.pSampleMask = &result->sampleMask.value();
+		}
+
+		result->sRGB = header.sRGB != 0u;
+		return result;
+	}
+
+	//*********************************************************************************************
+
+	Capture::Capture( VkDevice device )
+		: m_device{ device }
+		, m_path{ getCapturePath() }
+	{
+		if ( auto value = std::getenv( "ASHES_GL_CAPTURE_FRAMES" ) )
+		{
+			char * end{};
+			m_firstFrame = std::strtoull( value, &end, 10 );
+			m_endFrame = m_firstFrame + 1u;
+
+			if ( end && *end == ':' )
+			{
+				m_endFrame = m_firstFrame + std::strtoull( end + 1, nullptr, 10 );
+			}
+		}
+
+		if ( m_firstFrame == 0u
+			&& m_endFrame > 0u )
+		{
+			doStart();
+		}
+	}
+
+	Capture::~Capture()
+	{
+		std::unique_lock< std::recursive_mutex > lock{ m_mutex };
+
+		if ( isRecording() )
+		{
+			doStop();
+		}
+	}
+
+	bool Capture::isRequested()
+	{
+		return !getCapturePath().empty();
+	}
+
+	void Capture::registerBuffer( GLuint name )
+	{
+		std::unique_lock< std::recursive_mutex > lock{ m_mutex };
+		m_emitted[size_t( ObjectNamespace::eBuffer )].erase( name );
+	}
+
+	void Capture::registerTexture( GLuint name
+		, Image const & image )
+	{
+		std::unique_lock< std::recursive_mutex > lock{ m_mutex };
+		capture::TextureDesc desc{};
+		desc.target = uint32_t( image.getTarget() );
+		desc.internal = uint32_t( getInternalFormat( image.getFormat() ) );
+		desc.width = image.getDimensions().width;
+		desc.height = image.getDimensions().height;
+		desc.depth = image.getDimensions().depth;
+		desc.layers = image.getArrayLayers();
+		desc.levels = image.getMipLevels();
+		desc.samples = uint32_t( image.getSamples() );
+		m_textures[name] = TextureEntry{ desc, image.getFormat() };
+		m_views.erase( name );
+		m_textureBuffers.erase( name );
+		m_emitted[size_t( ObjectNamespace::eTexture )].erase( name );
+	}
+
+	void Capture::registerTextureView( GLuint name
+		, capture::TextureViewDesc const & desc )
+	{
+		std::unique_lock< std::recursive_mutex > lock{ m_mutex };
+		m_views[name] = desc;
+		m_textures.erase( name );
+		m_textureBuffers.erase( name );
+		m_emitted[size_t( ObjectNamespace::eTexture )].erase( name );
+	}
+
+	void Capture::registerTextureBuffer( GLuint name
+		, capture::TextureBufferDesc const & desc )
+	{
+		std::unique_lock< std::recursive_mutex > lock{ m_mutex };
+		m_textureBuffers[name] = desc;
+		m_textures.erase( name );
+		m_views.erase( name );
+		m_emitted[size_t( ObjectNamespace::eTexture )].erase( name );
+	}
+
+	void Capture::registerSampler( GLuint name )
+	{
+		std::unique_lock< std::recursive_mutex > lock{ m_mutex };
+		m_emitted[size_t( ObjectNamespace::eSampler )].erase( name );
+	}
+
+	void Capture::registerShader( GLuint name
+		, GLenum stage
+		, std::string const & source )
+	{
+		std::unique_lock< std::recursive_mutex > lock{ m_mutex };
+		m_shaders[name] = { uint32_t( stage ), source };
+	}
+
+	void Capture::registerProgram( GLuint name
+		, std::vector< GLuint > const & shaders )
+	{
+		std::unique_lock< std::recursive_mutex > lock{ m_mutex };
+		ProgramEntry entry{ false, {} };
+
+		for ( auto shader : shaders )
+		{
+			auto it = m_shaders.find( shader );
+
+			if ( it != m_shaders.end() )
+			{
+				entry.shaders.push_back( it->second );
+				// The shaders are deleted once linked, their names will be reused.
+				m_shaders.erase( it );
+			}
+		}
+
+		m_programs[name] = std::move( entry );
+		m_emitted[size_t( ObjectNamespace::eProgram )].erase( name );
+	}
+
+	void Capture::registerSeparateProgram( GLuint name
+		, GLenum stage
+		, std::string const & source )
+	{
+		std::unique_lock< std::recursive_mutex > lock{ m_mutex };
+		m_programs[name] = ProgramEntry{ true, { { uint32_t( stage ), source } } };
+		m_emitted[size_t( ObjectNamespace::eProgram )].erase( name );
+	}
+
+	void Capture::registerPipeline( GLuint name
+		, std::vector< capture::PipelineStageDesc > stages )
+	{
+		std::unique_lock< std::recursive_mutex > lock{ m_mutex };
+		m_pipelines[name] = std::move( stages );
+		m_emitted[size_t( ObjectNamespace::ePipeline )].erase( name );
+	}
+
+	void Capture::registerVertexArray( GLuint name
+		, GLuint ibo
+		, std::vector< capture::VertexAttribDesc > attributes )
+	{
+		std::unique_lock< std::recursive_mutex > lock{ m_mutex };
+		m_vertexArrays[name] = { ibo, std::move( attributes ) };
+		m_emitted[size_t( ObjectNamespace::eVertexArray )].erase( name );
+	}
+
+	void Capture::apply( ContextLock const & context
+		, CmdBuffer const & cmds )
+	{
+		if ( !isRecording() )
+		{
+			applyBuffer( context, cmds );
+			return;
+		}
+
+		std::unique_lock< std::recursive_mutex > lock{ m_mutex };
+
+		// The capture may have ended while waiting for the lock.
+		if ( !isRecording() )
+		{
+			applyBuffer( context, cmds );
+			return;
+		}
+
+		auto it = cmds.begin();
+		auto end = cmds.end();
+		Command const * pCmd = nullptr;
+
+		while ( map( it, end, pCmd ) )
+		{
+			auto & cmd = *pCmd;
+			it += cmd.op.size;
+			doCapture( context, cmd );
+			applyCommand( context, cmd );
+		}
+	}
+
+	void Capture::onBufferData( GLuint buffer
+		, VkDeviceSize offset
+		, VkDeviceSize size
+		, void const * data )
+	{
+		if ( !isRecording() )
+		{
+			return;
+		}
+
+		std::unique_lock< std::recursive_mutex > lock{ m_mutex };
+
+		if ( isRecording()
+			&& doIsEmitted( ObjectNamespace::eBuffer, buffer ) )
+		{
+			capture::BufferRange range{ offset, size };
+			doWriteRecord( capture::RecordType::eBufferData
+				, buffer
+				, { { &range, sizeof( range ) }, { data, size_t( size ) } } );
+		}
+	}
+
+	void Capture::onBufferReadback( GLuint buffer
+		, VkDeviceSize offset
+		, VkDeviceSize size )
+	{
+		if ( !isRecording() )
+		{
+			return;
+		}
+
+		std::unique_lock< std::recursive_mutex > lock{ m_mutex };
+
+		if ( isRecording()
+			&& doIsEmitted( ObjectNamespace::eBuffer, buffer ) )
+		{
+			capture::BufferRange range{ offset, size };
+			doWriteRecord( capture::RecordType::eBufferReadback
+				, buffer
+				, { { &range, sizeof( range ) } } );
+		}
+	}
+
+	void Capture::onTextureData( ContextLock const & context
+		, GLuint texture )
+	{
+		if ( !isRecording() )
+		{
+			return;
+		}
+
+		std::unique_lock< std::recursive_mutex > lock{ m_mutex };
+		auto it = m_textures.find( texture );
+
+		if ( isRecording()
+			&& it != m_textures.end()
+			&& doIsEmitted( ObjectNamespace::eTexture, texture ) )
+		{
+			doEmitTextureContent( context, texture, it->second, capture::RecordType::eTextureData );
+		}
+	}
+
+	void Capture::frame()
+	{
+		std::unique_lock< std::recursive_mutex > lock{ m_mutex };
+
+		if ( isRecording() )
+		{
+			// The frame record's id holds the count of commands dropped during the frame.
+			doWriteRecord( capture::RecordType::eFrame, m_skipped, {} );
+			m_skipped = 0u;
+		}
+
+		++m_frame;
+
+		if ( m_frame == m_endFrame
+			&& isRecording() )
+		{
+			doStop();
+		}
+		else if ( m_frame == m_firstFrame
+			&& m_frame < m_endFrame )
+		{
+			doStart();
+		}
+	}
+
+	void Capture::doStart()
+	{
+		m_file.open( m_path, std::ios::binary | std::ios::trunc );
+
+		if ( !m_file )
+		{
+			std::cerr << "Couldn't open GL capture file [" << m_path << "]" << std::endl;
+			return;
+		}
+
+		capture::FileHeader header{};
+		std::memcpy( header.magic, capture::Magic, sizeof( header.magic ) );
+		header.version = capture::Version;
+		header.pointerSize = uint32_t( sizeof( void * ) );
+		m_file.write( reinterpret_cast< char const * >( &header ), sizeof( header ) );
+
+		// Everything referenced from now on is described again.
+		for ( auto & emitted : m_emitted )
+		{
+			emitted.clear();
+		}
+
+		m_framebuffers.clear();
+		m_contextStates.clear();
+		m_pending.clear();
+		m_skipped = 0u;
+		m_recording.store( true );
+	}
+
+	void Capture::doStop()
+	{
+		doFlushCommands();
+		m_recording.store( false );
+		m_file.close();
+	}
+
+	void Capture::doCapture( ContextLock const & context
+		, Command const & cmd )
+	{
+		switch ( cmd.op.type )
+		{
+		case OpType::eUploadMemory:
+		case OpType::eDownloadMemory:
+		case OpType::eUpdateBuffer:
+		case OpType::eFillBuffer:
+			// Their effects are recorded by the device memory, as buffer or texture data.
+			return;
+		case OpType::eBeginProfileRegion:
+		case OpType::eEndProfileRegion:
+		case OpType::eBeginQuery:
+		case OpType::eEndQuery:
+		case OpType::eWriteTimestamp:
+		case OpType::eGetQueryResults:
+		case OpType::eSetEvent:
+		case OpType::eResetEvent:
+		case OpType::eWaitEvents:
+			// These reference Vulkan objects, which don't exist at replay time.
+			++m_skipped;
+			return;
+		default:
+			break;
+		}
+
+		auto words = reinterpret_cast< uint32_t const * >( &cmd );
+		m_scratch.assign( words, words + cmd.op.size );
+		auto & copy = *reinterpret_cast< Command * >( m_scratch.data() );
+
+		switch ( cmd.op.type )
+		{
+		case OpType::eBindVextexArray:
+			{
+				auto vao = map< OpType::eBindVextexArray >( cmd ).vao;
+				auto name = vao ? vao->getVao() : 0u;
+				doEmitVertexArray( context, name );
+				m_scratch = makeCmd< OpType::eBindVextexArrayObject >( name );
+			}
+			break;
+		case OpType::eBindContextState:
+			{
+				auto & bind = map< OpType::eBindContextState >( copy );
+				auto id = doEmitContextState( *bind.state );
+				bind.stack = nullptr;
+				bind.state = toHandle< ContextState * >( id );
+			}
+			break;
+		case OpType::eInitFramebuffer:
+			{
+				auto & init = map< OpType::eInitFramebuffer >( copy );
+				init.fbo = toHandle< GLuint * >( doGetFramebufferSlot( context, init.fbo, nullptr ) );
+			}
+			break;
+		case OpType::eCleanupFramebuffer:
+			{
+				auto & cleanup = map< OpType::eCleanupFramebuffer >( copy );
+				cleanup.fbo = toHandle< GLuint * >( doGetFramebufferSlot( context, cleanup.fbo, nullptr ) );
+			}
+			break;
+		case OpType::eBindFramebuffer:
+			{
+				auto & bind = map< OpType::eBindFramebuffer >( copy );
+				uint32_t slot = 0u;
+
+				// Slot 0 stands for the default framebuffer.
+				if ( bind.fbo != VK_NULL_HANDLE
+					&& get( bind.fbo )->getInternal() != 0u )
+				{
+					auto framebuffer = get( bind.fbo );
+					slot = doGetFramebufferSlot( context
+						, &framebuffer->getInternal()
+						, &framebuffer->getBindAttaches() );
+				}
+
+				bind.fbo = toHandle< VkFramebuffer >( slot );
+			}
+			break;
+		default:
+			forEachObjectName( copy
+				, [this, &context]( ObjectNamespace space, uint32_t & name )
+				{
+					doEmit( context, space, name );
+				} );
+			break;
+		}
+
+		m_pending.insert( m_pending.end(), m_scratch.begin(), m_scratch.end() );
+	}
+
+	void Capture::doWriteRecord( capture::RecordType type
+		, uint32_t id
+		, std::vector< Part > const & parts )
+	{
+		if ( type != capture::RecordType::eCommands )
+		{
+			doFlushCommands();
+		}
+
+		capture::RecordHeader header{ type, id, 0u };
+
+		for ( auto & part : parts )
+		{
+			header.size += part.second;
+		}
+
+		m_file.write( reinterpret_cast< char const * >( &header ), sizeof( header ) );
+
+		for ( auto & part : parts )
+		{
+			m_file.write( reinterpret_cast< char const * >( part.first ), std::streamsize( part.second ) );
+		}
+	}
+
+	void Capture::doFlushCommands()
+	{
+		if ( !m_pending.empty() )
+		{
+			doWriteRecord( capture::RecordType::eCommands
+				, 0u
+				, { { m_pending.data(), m_pending.size() * sizeof( uint32_t ) } } );
+			m_pending.clear();
+		}
+	}
+
+	bool Capture::doMarkEmitted( ObjectNamespace space
+		, GLuint name )
+	{
+		return m_emitted[size_t( space )].insert( name ).second;
+	}
+
+	bool Capture::doIsEmitted( ObjectNamespace space
+		, GLuint name )const
+	{
+		auto & emitted = m_emitted[size_t( space )];
+		return emitted.find( name ) != emitted.end();
+	}
+
+	void Capture::doEmit( ContextLock const & context
+		, ObjectNamespace space
+		, GLuint name )
+	{
+		if ( !name )
+		{
+			return;
+		}
+
+		switch ( space )
+		{
+		case ObjectNamespace::eBuffer:
+			doEmitBuffer( context, name );
+			break;
+		case ObjectNamespace::eTexture:
+			doEmitTexture( context, name );
+			break;
+		case ObjectNamespace::eSampler:
+			doEmitSampler( context, name );
+			break;
+		case ObjectNamespace::eProgram:
+			doEmitProgram( name );
+			break;
+		case ObjectNamespace::ePipeline:
+			doEmitPipeline( context, name );
+			break;
+		case ObjectNamespace::eVertexArray:
+			doEmitVertexArray( context, name );
+			break;
+		default:
+			break;
+		}
+	}
+
+	void Capture::doEmitBuffer( ContextLock const & context
+		, GLuint name )
+	{
+		if ( !name
+			|| !doMarkEmitted( ObjectNamespace::eBuffer, name ) )
+		{
+			return;
+		}
+
+		// The buffers are described from GL, which knows their size and usage.
+		GLint previous = 0;
+		glLogCall( context
+			, glGetIntegerv
+			, GL_COPY_READ_BUFFER_BINDING
+			, &previous );
+		glLogCall( context
+			, glBindBuffer
+			, GL_BUFFER_TARGET_COPY_READ
+			, name );
+		GLint size = 0;
+		GLint usage = 0;
+		glLogCall( context
+			, glGetBufferParameteriv
+			, GL_BUFFER_TARGET_COPY_READ
+			, GL_BUFFER_PARAMETER_SIZE
+			, &size );
+		glLogCall( context
+			, glGetBufferParameteriv
+			, GL_BUFFER_TARGET_COPY_READ
+			, GL_BUFFER_PARAMETER_USAGE
+			, &usage );
+
+		if ( size > 0 )
+		{
+			capture::BufferDesc desc{ uint32_t( usage ), 0u, uint64_t( size ) };
+			doWriteRecord( capture::RecordType::eBuffer
+				, name
+				, { { &desc, sizeof( desc ) } } );
+			ByteArray data( size_t( size ) );
+			glLogCall( context
+				, glGetBufferSubData
+				, GL_BUFFER_TARGET_COPY_READ
+				, 0
+				, GLsizeiptr( size )
+				, data.data() );
+			capture::BufferRange range{ 0u, uint64_t( size ) };
+			doWriteRecord( capture::RecordType::eBufferContent
+				, name
+				, { { &range, sizeof( range ) }, { data.data(), data.size() } } );
+		}
+
+		glLogCall( context
+			, glBindBuffer
+			, GL_BUFFER_TARGET_COPY_READ
+			, GLuint( previous ) );
+	}
+
+	void Capture::doEmitTexture( ContextLock const & context
+		, GLuint name )
+	{
+		if ( !name
+			|| !doMarkEmitted( ObjectNamespace::eTexture, name ) )
+		{
+			return;
+		}
+
+		auto viewIt = m_views.find( name );
+
+		if ( viewIt != m_views.end() )
+		{
+			auto desc = viewIt->second;
+			doEmitTexture( context, desc.texture );
+			doWriteRecord( capture::RecordType::eTextureView
+				, name
+				, { { &desc, sizeof( desc ) } } );
+			return;
+		}
+
+		auto bufferIt = m_textureBuffers.find( name );
+
+		if ( bufferIt != m_textureBuffers.end() )
+		{
+			auto desc = bufferIt->second;
+			doEmitBuffer( context, desc.buffer );
+			doWriteRecord( capture::RecordType::eTextureBuffer
+				, name
+				, { { &desc, sizeof( desc ) } } );
+			return;
+		}
+
+		auto textureIt = m_textures.find( name );
+
+		if ( textureIt != m_textures.end() )
+		{
+			doWriteRecord( capture::RecordType::eTexture
+				, name
+				, { { &textureIt->second.desc, sizeof( capture::TextureDesc ) } } );
+			doEmitTextureContent( context, name, textureIt->second, capture::RecordType::eTextureContent );
+		}
+	}
+
+	void Capture::doEmitTextureContent( ContextLock const & context
+		, GLuint name
+		, TextureEntry const & texture
+		, capture::RecordType type )
+	{
+		auto & desc = texture.desc;
+
+		// Multisample and depth/stencil textures can't be read back, their content is left undefined.
+		if ( desc.samples > 1u
+			|| ashes::isDepthOrStencilFormat( texture.format ) )
+		{
+			return;
+		}
+
+		auto target = GlTextureType( desc.target );
+		GLint previousTexture = 0;
+		GLint previousPack = 0;
+		GLint previousAlign = 0;
+		glLogCall( context
+			, glGetIntegerv
+			, getBindingQuery( target )
+			, &previousTexture );
+		glLogCall( context
+			, glGetIntegerv
+			, GL_PIXEL_PACK_BUFFER_BINDING
+			, &previousPack );
+		glLogCall( context
+			, glGetIntegerv
+			, GL_PACK_ALIGNMENT
+			, &previousAlign );
+		glLogCall( context
+			, glBindTexture
+			, target
+			, name );
+		glLogCall( context
+			, glBindBuffer
+			, GL_BUFFER_TARGET_PIXEL_PACK
+			, 0u );
+		glLogCall( context
+			, glPixelStorei
+			, GL_PACK_ALIGNMENT
+			, 1 );
+
+		auto compressed = ashes::isCompressedFormat( texture.format );
+		auto internal = GlInternal( desc.internal );
+		auto format = getFormat( internal );
+		auto glType = getType( internal );
+		auto faces = target == GL_TEXTURE_CUBE ? 6u : 1u;
+		ByteArray data;
+
+		for ( uint32_t level = 0u; level < desc.levels; ++level )
+		{
+			VkExtent3D extent{ std::max( 1u, desc.width >> level )
+				, std::max( 1u, desc.height >> level )
+				, 1u };
+
+			switch ( target )
+			{
+			case GL_TEXTURE_1D_ARRAY:
+				extent.height = desc.layers;
+				break;
+			case GL_TEXTURE_3D:
+				extent.depth = std::max( 1u, desc.depth >> level );
+				break;
+			case GL_TEXTURE_2D_ARRAY:
+			case GL_TEXTURE_CUBE_ARRAY:
+				extent.depth = desc.layers;
+				break;
+			default:
+				break;
+			}
+
+			for ( uint32_t face = 0u; face < faces; ++face )
+			{
+				auto levelTarget = target == GL_TEXTURE_CUBE
+					? GlTextureType( GL_TEXTURE_CUBE_POSITIVE_X + face )
+					: target;
+				capture::TextureContentDesc content{ uint32_t( levelTarget )
+					, level
+					, extent.width
+					, extent.height
+					, extent.depth
+					, uint32_t( format )
+					, uint32_t( glType )
+					, compressed ? 1u : 0u
+					, 0u };
+
+				if ( compressed )
+				{
+					GLint size = 0;
+					glLogCall( context
+						, glGetTexLevelParameteriv
+						, levelTarget
+						, GLint( level )
+						, GL_TEXTURE_COMPRESSED_IMAGE_SIZE
+						, &size );
+					content.size = uint64_t( std::max( 0, size ) );
+					data.resize( size_t( content.size ) );
+					glLogCall( context
+						, glGetCompressedTexImage
+						, levelTarget
+						, GLint( level )
+						, data.data() );
+				}
+				else
+				{
+					content.size = ashes::getSize( extent, texture.format );
+					data.resize( size_t( content.size ) );
+					glLogCall( context
+						, glGetTexImage
+						, levelTarget
+						, GLint( level )
+						, format
+						, glType
+						, data.data() );
+				}
+
+				doWriteRecord( type
+					, name
+					, { { &content, sizeof( content ) }, { data.data(), data.size() } } );
+			}
+		}
+
+		glLogCall( context
+			, glPixelStorei
+			, GL_PACK_ALIGNMENT
+			, previousAlign );
+		glLogCall( context
+			, glBindBuffer
+			, GL_BUFFER_TARGET_PIXEL_PACK
+			, GLuint( previousPack ) );
+		glLogCall( context
+			, glBindTexture
+			, target
+			, GLuint( previousTexture ) );
+	}
+
+	void Capture::doEmitSampler( ContextLock const & context
+		, GLuint name )
+	{
+		if ( !name
+			|| !doMarkEmitted( ObjectNamespace::eSampler, name ) )
+		{
+			return;
+		}
+
+		capture::SamplerDesc desc{};
+		glLogCall( context, glGetSamplerParameteriv, name, GL_SAMPLER_PARAMETER_MIN_FILTER, &desc.minFilter );
+		glLogCall( context, glGetSamplerParameteriv, name, GL_SAMPLER_PARAMETER_MAG_FILTER, &desc.magFilter );
+		glLogCall( context, glGetSamplerParameteriv, name, GL_SAMPLER_PARAMETER_WRAP_S, &desc.wrapS );
+		glLogCall( context, glGetSamplerParameteriv, name, GL_SAMPLER_PARAMETER_WRAP_T, &desc.wrapT );
+		glLogCall( context, glGetSamplerParameteriv, name, GL_SAMPLER_PARAMETER_WRAP_R, &desc.wrapR );
+		glLogCall( context, glGetSamplerParameteriv, name, GL_SAMPLER_PARAMETER_COMPARE_MODE, &desc.compareMode );
+		glLogCall( context, glGetSamplerParameteriv, name, GL_SAMPLER_PARAMETER_COMPARE_FUNC, &desc.compareFunc );
+		glLogCall( context, glGetSamplerParameterfv, name, GL_SAMPLER_PARAMETER_MIN_LOD, &desc.minLod );
+		glLogCall( context, glGetSamplerParameterfv, name, GL_SAMPLER_PARAMETER_MAX_LOD, &desc.maxLod );
+		glLogCall( context, glGetSamplerParameterfv, name, GL_SAMPLER_PARAMETER_LOD_BIAS, &desc.lodBias );
+		glLogCall( context, glGetSamplerParameterfv, name, GL_SAMPLER_PARAMETER_BORDER_COLOR, desc.borderColour );
+
+		if ( hasSamplerAnisotropy( m_device ) )
+		{
+			glLogCall( context, glGetSamplerParameterfv, name, GL_SAMPLER_PARAMETER_MAX_ANISOTROPY, &desc.maxAnisotropy );
+		}
+
+		doWriteRecord( capture::RecordType::eSampler
+			, name
+			, { { &desc, sizeof( desc ) } } );
+	}
+
+	void Capture::doEmitProgram( GLuint name )
+	{
+		if ( !name
+			|| !doMarkEmitted( ObjectNamespace::eProgram, name ) )
+		{
+			return;
+		}
+
+		auto it = m_programs.find( name );
+
+		if ( it == m_programs.end() )
+		{
+			return;
+		}
+
+		auto & entry = it->second;
+		capture::ProgramDesc desc{ entry.separable ? 1u : 0u, uint32_t( entry.shaders.size() ) };
+		std::vector< capture::ShaderDesc > shaders;
+		std::vector< Part > parts{ { &desc, sizeof( desc ) } };
+		shaders.reserve( entry.shaders.size() );
+
+		for ( auto & shader : entry.shaders )
+		{
+			shaders.push_back( { shader.first, uint32_t( shader.second.size() ) } );
+			parts.push_back( { &shaders.back(), sizeof( capture::ShaderDesc ) } );
+			parts.push_back( { shader.second.data(), shader.second.size() } );
+		}
+
+		doWriteRecord( capture::RecordType::eProgram, name, parts );
+	}
+
+	void Capture::doEmitPipeline( ContextLock const & context
+		, GLuint name )
+	{
+		if ( !name
+			|| !doMarkEmitted( ObjectNamespace::ePipeline, name ) )
+		{
+			return;
+		}
+
+		auto it = m_pipelines.find( name );
+
+		if ( it == m_pipelines.end() )
+		{
+			return;
+		}
+
+		for ( auto & stage : it->second )
+		{
+			doEmitProgram( stage.program );
+		}
+
+		capture::PipelineDesc desc{ uint32_t( it->second.size() ) };
+		doWriteRecord( capture::RecordType::ePipeline
+			, name
+			, { { &desc, sizeof( desc ) }, { it->second.data(), it->second.size() * sizeof( capture::PipelineStageDesc ) } } );
+	}
+
+	void Capture::doEmitVertexArray( ContextLock const & context
+		, GLuint name )
+	{
+		if ( !name
+			|| !doMarkEmitted( ObjectNamespace::eVertexArray, name ) )
+		{
+			return;
+		}
+
+		auto it = m_vertexArrays.find( name );
+
+		if ( it == m_vertexArrays.end() )
+		{
+			return;
+		}
+
+		auto & attributes = it->second.second;
+		doEmitBuffer( context, it->second.first );
+
+		for ( auto & attribute : attributes )
+		{
+			doEmitBuffer( context, attribute.buffer );
+		}
+
+		capture::VertexArrayDesc desc{ it->second.first, uint32_t( attributes.size() ) };
+		doWriteRecord( capture::RecordType::eVertexArray
+			, name
+			, { { &desc, sizeof( desc ) }, { attributes.data(), attributes.size() * sizeof( capture::VertexAttribDesc ) } } );
+	}
+
+	uint32_t Capture::doGetFramebufferSlot( ContextLock const & context
+		, GLuint * fbo
+		, CmdList const * attaches )
+	{
+		auto it = m_framebuffers.emplace( fbo, FramebufferSlot{} ).first;
+		auto & slot = it->second;
+
+		if ( !attaches )
+		{
+			// Lazily created framebuffer, its attachments are set by the commands.
+			if ( !slot.id )
+			{
+				slot.id = ++m_framebufferCount;
+				capture::FramebufferDesc desc{ 0u, 0u };
+				doWriteRecord( capture::RecordType::eFramebuffer
+					, slot.id
+					, { { &desc, sizeof( desc ) } } );
+			}
+
+			return slot.id;
+		}
+
+		UInt32Array words;
+
+		if ( *fbo != GL_INVALID_INDEX )
+		{
+			for ( auto & cmd : *attaches )
+			{
+				words.insert( words.end(), cmd.begin(), cmd.end() );
+			}
+		}
+
+		// The framebuffers are identified by their storage, which is reused by the later framebuffers.
+		if ( !slot.id
+			|| slot.words != words )
+		{
+			auto wordsIt = words.begin();
+			Command * pCmd = nullptr;
+
+			while ( map( wordsIt, words.end(), pCmd ) )
+			{
+				wordsIt += pCmd->op.size;
+				forEachObjectName( *pCmd
+					, [this, &context]( ObjectNamespace space, uint32_t & name )
+					{
+						doEmit( context, space, name );
+					} );
+			}
+
+			slot.id = ++m_framebufferCount;
+			slot.words = std::move( words );
+			capture::FramebufferDesc desc{ *fbo != GL_INVALID_INDEX ? 1u : 0u, uint32_t( slot.words.size() ) };
+			doWriteRecord( capture::RecordType::eFramebuffer
+				, slot.id
+				, { { &desc, sizeof( desc ) }, { slot.words.data(), slot.words.size() * sizeof( uint32_t ) } } );
+		}
+
+		return slot.id;
+	}
+
+	uint32_t Capture::doEmitContextState( ContextState const & state )
+	{
+		auto key = serialiseContextState( state );
+		auto it = m_contextStates.find( key );
+
+		if ( it == m_contextStates.end() )
+		{
+			auto id = uint32_t( m_contextStates.size() + 1u );
+			it = m_contextStates.emplace( key, id ).first;
+			doWriteRecord( capture::RecordType::eContextState
+				, id
+				, { { key.data(), key.size() } } );
+		}
+
+		return it->second;
+	}
+}
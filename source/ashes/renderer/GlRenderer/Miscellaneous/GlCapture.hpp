@@ -0,0 +1,225 @@
+/*
+This file belongs to Ashes.
+See LICENSE file in root folder
+*/
+#pragma once
+
+#include "renderer/GlRenderer/Command/Commands/GlCommandBase.hpp"
+#include "renderer/GlRenderer/Miscellaneous/GlCaptureFormat.hpp"
+
+#include <atomic>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace ashes::gl
+{
+	/**
+	*\brief
+	*	The GL objects namespaces, a name only identifies an object inside its namespace.
+	*/
+	enum class ObjectNamespace
+	{
+		eBuffer,
+		eTexture,
+		eSampler,
+		eProgram,
+		ePipeline,
+		eVertexArray,
+		eCount,
+	};
+	/**
+	*\brief
+	*	Calls \p func on each GL object name held by the command.
+	*\remarks
+	*	Shared by the capture, to describe the referenced objects, and by the replayer, to remap them.
+	*/
+	void forEachObjectName( Command & cmd
+		, std::function< void( ObjectNamespace, uint32_t & ) > const & func );
+	/**
+	*\brief
+	*	Serialises a context state, the result is also used as the state's identity in a capture.
+	*/
+	std::string serialiseContextState( ContextState const & state );
+	/**
+	*\brief
+	*	Rebuilds a context state serialised by serialiseContextState.
+	*\return
+	*	\p nullptr if the data is truncated.
+	*/
+	std::unique_ptr< ContextState > deserialiseContextState( uint8_t const * data
+		, size_t size );
+
+	/**
+	*\brief
+	*	Device wide GL command streams capture.
+	*\remarks
+	*	Enabled through the ASHES_GL_CAPTURE environment variable, which holds
+	*	the capture file path ("1" selects ashes_gl_capture.bin).
+	*	ASHES_GL_CAPTURE_FRAMES ("first[:count]") restricts the capture to a range of frames,
+	*	only the first frame being captured by default.
+	*	The submitted commands are written as they are applied, preceded by the description
+	*	and the content of the objects they reference, the first time they are referenced.
+	*	Host side updates of the captured buffers and textures are written in the timeline.
+	*	The captures are replayed by ashglReplayCapture (see the ashes-replay tool).
+	*/
+	class Capture
+	{
+	public:
+		explicit Capture( VkDevice device );
+		~Capture();
+		/**
+		*\return
+		*	\p true if the capture is requested through the environment.
+		*/
+		static bool isRequested();
+
+		inline bool isRecording()const
+		{
+			return m_recording.load( std::memory_order_relaxed );
+		}
+		/**
+		*\name
+		*	Objects registration, the descriptions that can't be queried back from GL.
+		*/
+		/**@{*/
+		void registerBuffer( GLuint name );
+		void registerTexture( GLuint name
+			, Image const & image );
+		void registerTextureView( GLuint name
+			, capture::TextureViewDesc const & desc );
+		void registerTextureBuffer( GLuint name
+			, capture::TextureBufferDesc const & desc );
+		void registerSampler( GLuint name );
+		void registerShader( GLuint name
+			, GLenum stage
+			, std::string const & source );
+		void registerProgram( GLuint name
+			, std::vector< GLuint > const & shaders );
+		void registerSeparateProgram( GLuint name
+			, GLenum stage
+			, std::string const & source );
+		void registerPipeline( GLuint name
+			, std::vector< capture::PipelineStageDesc > stages );
+		void registerVertexArray( GLuint name
+			, GLuint ibo
+			, std::vector< capture::VertexAttribDesc > attributes );
+		/**@}*/
+		/**
+		*\brief
+		*	Applies the commands, capturing them if the capture is running.
+		*/
+		void apply( ContextLock const & context
+			, CmdBuffer const & cmds );
+		/**
+		*\brief
+		*	Records a host update of a buffer, if it is already captured.
+		*/
+		void onBufferData( GLuint buffer
+			, VkDeviceSize offset
+			, VkDeviceSize size
+			, void const * data );
+		/**
+		*\brief
+		*	Records a host read back of a buffer, if it is already captured.
+		*/
+		void onBufferReadback( GLuint buffer
+			, VkDeviceSize offset
+			, VkDeviceSize size );
+		/**
+		*\brief
+		*	Records the new content of a texture updated from the host, if it is already captured.
+		*/
+		void onTextureData( ContextLock const & context
+			, GLuint texture );
+		/**
+		*\brief
+		*	Marks the end of a frame.
+		*/
+		void frame();
+
+	private:
+		struct TextureEntry
+		{
+			capture::TextureDesc desc;
+			VkFormat format;
+		};
+
+		struct ProgramEntry
+		{
+			bool separable;
+			std::vector< std::pair< uint32_t, std::string > > shaders;
+		};
+
+		struct FramebufferSlot
+		{
+			uint32_t id{ 0u };
+			UInt32Array words;
+		};
+
+		void doStart();
+		void doStop();
+		void doCapture( ContextLock const & context
+			, Command const & cmd );
+		void doWriteRecord( capture::RecordType type
+			, uint32_t id
+			, std::vector< std::pair< void const *, size_t > > const & parts );
+		void doFlushCommands();
+		bool doMarkEmitted( ObjectNamespace space
+			, GLuint name );
+		bool doIsEmitted( ObjectNamespace space
+			, GLuint name )const;
+		void doEmit( ContextLock const & context
+			, ObjectNamespace space
+			, GLuint name );
+		void doEmitBuffer( ContextLock const & context
+			, GLuint name );
+		void doEmitTexture( ContextLock const & context
+			, GLuint name );
+		void doEmitTextureContent( ContextLock const & context
+			, GLuint name
+			, TextureEntry const & texture
+			, capture::RecordType type );
+		void doEmitSampler( ContextLock const & context
+			, GLuint name );
+		void doEmitProgram( GLuint name );
+		void doEmitPipeline( ContextLock const & context
+			, GLuint name );
+		void doEmitVertexArray( ContextLock const & context
+			, GLuint name );
+		uint32_t doGetFramebufferSlot( ContextLock const & context
+			, GLuint * fbo
+			, CmdList const * attaches );
+		uint32_t doEmitContextState( ContextState const & state );
+
+	private:
+		VkDevice m_device;
+		std::recursive_mutex m_mutex;
+		std::atomic< bool > m_recording{ false };
+		std::string m_path;
+		std::ofstream m_file;
+		uint64_t m_frame{ 0u };
+		uint64_t m_firstFrame{ 0u };
+		uint64_t m_endFrame{ 1u };
+		uint32_t m_skipped{ 0u };
+		uint32_t m_framebufferCount{ 0u };
+		UInt32Array m_pending;
+		UInt32Array m_scratch;
+		std::set< GLuint > m_emitted[size_t( ObjectNamespace::eCount )];
+		std::map< GLuint, TextureEntry > m_textures;
+		std::map< GLuint, capture::TextureViewDesc > m_views;
+		std::map< GLuint, capture::TextureBufferDesc > m_textureBuffers;
+		std::map< GLuint, std::pair< uint32_t, std::string > > m_shaders;
+		std::map< GLuint, ProgramEntry > m_programs;
+		std::map< GLuint, std::vector< capture::PipelineStageDesc > > m_pipelines;
+		std::map< GLuint, std::pair< GLuint, std::vector< capture::VertexAttribDesc > > > m_vertexArrays;
+		std::map< GLuint *, FramebufferSlot > m_framebuffers;
+		std::map< std::string, uint32_t > m_contextStates;
+	};
+	using CapturePtr = std::unique_ptr< Capture >;
+}
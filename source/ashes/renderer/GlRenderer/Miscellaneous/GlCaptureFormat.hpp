@@ -0,0 +1,231 @@
+/*
+This file belongs to Ashes.
+See LICENSE file in root folder
+*/
+#pragma once
+
+#include <cstdint>
+
+namespace ashes::gl::capture
+{
+	/**
+	*\brief
+	*	GL command streams capture file layout, shared by the capture, the replayer and the replay tool.
+	*\remarks
+	*	The file starts with a FileHeader, followed by records, each being a RecordHeader
+	*	followed by RecordHeader::size bytes of payload.
+	*	The records are written in submission order: an object is described (and its
+	*	content snapshotted) right before the first command segment referencing it.
+	*	Object records use the captured GL name as identifier, the replayer remaps them.
+	*	The command segments hold the GL backend commands words, as they are applied,
+	*	so a capture can only be replayed by the same build of the GL renderer.
+	*/
+	char constexpr Magic[8] = { 'A', 'G', 'L', 'C', 'A', 'P', 'T', 'R' };
+	uint32_t constexpr Version = 1u;
+
+	enum class RecordType
+		: uint32_t
+	{
+		// BufferDesc.
+		eBuffer,
+		// TextureDesc.
+		eTexture,
+		// TextureViewDesc.
+		eTextureView,
+		// TextureBufferDesc.
+		eTextureBuffer,
+		// SamplerDesc.
+		eSampler,
+		// ProgramDesc, then ProgramDesc::shaderCount ShaderDesc, each followed by its source.
+		eProgram,
+		// PipelineDesc, then PipelineDesc::stageCount PipelineStageDesc.
+		ePipeline,
+		// VertexArrayDesc, then VertexArrayDesc::attributeCount VertexAttribDesc.
+		eVertexArray,
+		// FramebufferDesc, then FramebufferDesc::wordCount attachment commands words.
+		eFramebuffer,
+		// Serialised ContextState (see serialiseContextState).
+		eContextState,
+		// Initial content of a buffer, restored before each replay loop: BufferRange, then the data.
+		eBufferContent,
+		// Initial content of a texture level, restored before each replay loop: TextureContentDesc, then the data.
+		eTextureContent,
+		// Host update of a buffer, in the timeline: BufferRange, then the data.
+		eBufferData,
+		// Host update of a texture level, in the timeline: TextureContentDesc, then the data.
+		eTextureData,
+		// Host read back of a buffer, in the timeline: BufferRange.
+		eBufferReadback,
+		// Commands words.
+		eCommands,
+		// End of a captured frame, no payload, the id holds the count of commands dropped in the frame.
+		eFrame,
+	};
+
+	struct FileHeader
+	{
+		char magic[8];
+		uint32_t version;
+		// Size of a pointer, in the capturing process, the context states hold some.
+		uint32_t pointerSize;
+	};
+
+	struct RecordHeader
+	{
+		RecordType type;
+		// The captured object name, or the context state or framebuffer slot index.
+		uint32_t id;
+		uint64_t size;
+	};
+
+	struct BufferDesc
+	{
+		uint32_t usage;
+		uint32_t padding;
+		uint64_t size;
+	};
+
+	struct TextureDesc
+	{
+		uint32_t target;
+		uint32_t internal;
+		uint32_t width;
+		uint32_t height;
+		uint32_t depth;
+		uint32_t layers;
+		uint32_t levels;
+		uint32_t samples;
+	};
+
+	struct TextureViewDesc
+	{
+		uint32_t target;
+		uint32_t texture;
+		uint32_t internal;
+		uint32_t baseLevel;
+		uint32_t levelCount;
+		uint32_t baseLayer;
+		uint32_t layerCount;
+		// GL_TEXTURE_SWIZZLE_R, G, B, A values, 0 for identity.
+		int32_t swizzle[4];
+	};
+
+	struct TextureBufferDesc
+	{
+		uint32_t internal;
+		uint32_t buffer;
+		uint64_t offset;
+		// 0 for the whole buffer.
+		uint64_t range;
+	};
+
+	struct SamplerDesc
+	{
+		int32_t minFilter;
+		int32_t magFilter;
+		int32_t wrapS;
+		int32_t wrapT;
+		int32_t wrapR;
+		int32_t compareMode;
+		int32_t compareFunc;
+		float minLod;
+		float maxLod;
+		float lodBias;
+		// 0 when anisotropic filtering is not supported.
+		float maxAnisotropy;
+		float borderColour[4];
+	};
+
+	struct ProgramDesc
+	{
+		// Created through glCreateShaderProgramv (a single shader).
+		uint32_t separable;
+		uint32_t shaderCount;
+	};
+
+	struct ShaderDesc
+	{
+		uint32_t stage;
+		uint32_t length;
+	};
+
+	struct PipelineDesc
+	{
+		uint32_t stageCount;
+	};
+
+	struct PipelineStageDesc
+	{
+		uint32_t stages;
+		uint32_t program;
+	};
+
+	struct VertexArrayDesc
+	{
+		uint32_t ibo;
+		uint32_t attributeCount;
+	};
+
+	struct VertexAttribDesc
+	{
+		uint32_t location;
+		uint32_t buffer;
+		int32_t count;
+		uint32_t type;
+		uint32_t normalised;
+		uint32_t integer;
+		int32_t stride;
+		uint32_t divisor;
+		uint64_t offset;
+	};
+
+	struct FramebufferDesc
+	{
+		// The framebuffer is created with the object, else by the commands (lazily created blit framebuffers).
+		uint32_t created;
+		uint32_t wordCount;
+	};
+
+	struct BufferRange
+	{
+		uint64_t offset;
+		uint64_t size;
+	};
+
+	struct TextureContentDesc
+	{
+		// The texture target, or the cube face target.
+		uint32_t target;
+		uint32_t level;
+		uint32_t width;
+		uint32_t height;
+		uint32_t depth;
+		uint32_t format;
+		uint32_t type;
+		uint32_t compressed;
+		uint64_t size;
+	};
+
+	/**
+	*\brief
+	*	The replay results, as returned by ashglReplayCapture.
+	*/
+	struct ReplayStats
+	{
+		uint32_t frames;
+		uint32_t loops;
+		// Objects creation and initial uploads.
+		double setupMs;
+		// All loops, contents restoration included.
+		double totalMs;
+		// Frame times, the first loop excluded when more than one loop is run.
+		double minFrameMs;
+		double avgFrameMs;
+		double medianFrameMs;
+		double maxFrameMs;
+		// GL names referenced by the commands, that had no description in the capture.
+		uint32_t unmappedNames;
+		// Commands dropped at capture time (events, queries, debug regions...).
+		uint32_t skippedCommands;
+	};
+}
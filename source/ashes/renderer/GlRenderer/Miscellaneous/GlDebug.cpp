@@ -7,6 +7,8 @@
 #include "ashesgl_api.hpp"
 
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -65,35 +67,52 @@ namespace ashes::gl
 		}
 	}
 
+	bool isErrorCheckEnabled()
+	{
+		static bool const result = []()
+		{
+			auto value = std::getenv( "ASHES_GL_CHECK_ERRORS" );
+			return !value
+				|| std::strcmp( value, "0" ) != 0;
+		}();
+		return result;
+	}
+
+	uint32_t getError( ContextLock const & context )
+	{
+		return context->glGetError();
+	}
+
+	bool glReportError( ContextLock const & context
+		, uint32_t errorCode
+		, std::string const & text )
+	{
+		std::stringstream stream;
+		stream.imbue( std::locale{ "C" } );
+		stream << "OpenGL Error, on function: " << text;
+		reportError( context->getInstance()
+			, VkResult( errorCode )
+			, stream.str()
+			, getErrorName( errorCode, GL_DEBUG_TYPE_ERROR ) );
+#if AshesGL_LogCalls
+		stream << ", ID: 0x" << std::hex << errorCode << " (" << getErrorName( errorCode, GL_DEBUG_TYPE_ERROR ) << ")";
+		logStream( stream );
+#endif
+		context->glGetError();
+		return false;
+	}
+
 	bool glCheckError( ContextLock const & context
 		, std::string const & text )
 	{
-		bool result = true;
 		uint32_t errorCode = context->glGetError();
 
 		if ( errorCode )
 		{
-			{
-				std::stringstream stream;
-				stream.imbue( std::locale{ "C" } );
-				stream << "OpenGL Error, on function: " << text;
-				reportError( context->getInstance()
-					, VkResult( errorCode )
-					, stream.str()
-					, getErrorName( errorCode, GL_DEBUG_TYPE_ERROR ) );
-			}
-#if AshesGL_LogCalls
-			std::stringstream stream;
-			stream.imbue( std::locale{ "C" } );
-			stream << "OpenGL Error, on function: " << text;
-			stream << ", ID: 0x" << std::hex << errorCode << " (" << getErrorName( errorCode, GL_DEBUG_TYPE_ERROR ) << ")";
-			logStream( stream );
-#endif
-			errorCode = context->glGetError();
-			result = false;
+			return glReportError( context, errorCode, text );
 		}
 
-		return result;
+		return true;
 	}
 
 	void clearDebugFile()
@@ -25,6 +25,15 @@ namespace ashes::gl
 		std::string labelName;
 	};
 	std::string getErrorName( uint32_t code, uint32_t category );
+	/**
+	*\return
+	*	\p false if the GL errors checks are disabled, through ASHES_GL_CHECK_ERRORS=0.
+	*/
+	bool isErrorCheckEnabled();
+	uint32_t getError( ContextLock const & context );
+	bool glReportError( ContextLock const & context
+		, uint32_t errorCode
+		, std::string const & text );
 	bool glCheckError( ContextLock const & context
 		, std::string const & text );
 	void clearDebugFile();
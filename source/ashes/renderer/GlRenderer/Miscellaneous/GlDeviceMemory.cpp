@@ -15,6 +15,8 @@ See LICENSE file in root folder
 #include <algorithm>
 #include <cstring>
 #include <map>
+#include <mutex>
+#include <unordered_map>
 
 namespace ashes::gl
 {
@@ -38,7 +40,8 @@ namespace ashes::gl
 			GLsizeiptr size;
 			GlBufferDataUsageFlags flags;
 		};
-		using BufferAllocCont = std::vector< BufferAlloc >;
+		// Keyed by GL name, the registry is looked up on each buffer creation and deletion.
+		using BufferAllocCont = std::unordered_map< GLuint, BufferAlloc >;
 
 		BufferAllocCont & getAllocatedBuffers()
 		{
@@ -48,12 +51,37 @@ namespace ashes::gl
 
 		BufferAllocCont::iterator findBuffer( GLuint buffer )
 		{
-			return std::find_if( getAllocatedBuffers().begin()
-				, getAllocatedBuffers().end()
-				, [buffer]( BufferAlloc const & lookup )
-				{
-					return lookup.name == buffer;
-				} );
+			return getAllocatedBuffers().find( buffer );
+		}
+
+		struct MemoryAccounting
+		{
+			std::mutex mutex;
+			MemoryStats stats{};
+		};
+
+		MemoryAccounting & getAccounting()
+		{
+			static MemoryAccounting result;
+			return result;
+		}
+
+		// The usage must be one of getAccounting().stats members.
+		void addUsage( MemoryUsage & usage
+			, VkDeviceSize size )
+		{
+			std::lock_guard< std::mutex > lock{ getAccounting().mutex };
+			++usage.count;
+			usage.bytes += size;
+		}
+
+		void removeUsage( MemoryUsage & usage
+			, VkDeviceSize size )
+		{
+			std::lock_guard< std::mutex > lock{ getAccounting().mutex };
+			assert( usage.count > 0u && usage.bytes >= size );
+			--usage.count;
+			usage.bytes -= size;
 		}
 
 		GLint getBufferSize( ContextLock const & context
@@ -65,7 +93,7 @@ namespace ashes::gl
 
 			if ( it != getAllocatedBuffers().end() )
 			{
-				target = it->target;
+				target = it->second.target;
 			}
 
 			glLogCall( context
@@ -95,13 +123,15 @@ namespace ashes::gl
 		BufferAllocCont::iterator findBuffer( GLuint buffer
 			, GLsizeiptr size )
 		{
-			return std::find_if( getAllocatedBuffers().begin()
-				, getAllocatedBuffers().end()
-				, [buffer, size]( BufferAlloc const & lookup )
-				{
-					return lookup.name == buffer
-						&& lookup.size == size;
-				} );
+			auto it = findBuffer( buffer );
+
+			if ( it != getAllocatedBuffers().end()
+				&& it->second.size != size )
+			{
+				it = getAllocatedBuffers().end();
+			}
+
+			return it;
 		}
 
 		GLuint createBuffer( ContextLock const & context
@@ -109,11 +139,47 @@ namespace ashes::gl
 			, GLsizeiptr size
 			, GlBufferDataUsageFlags flags )
 		{
-			auto allocateBuffer = [&context]( GLuint result
+			// With direct state access, the buffer is created and allocated without being bound,
+			// and its size isn't queried back, since it is the requested one.
+			bool dsa = context->hasCreateBuffers()
+				&& context->hasNamedBufferData();
+			auto genBuffer = [&context, dsa]()
+			{
+				GLuint result;
+
+				if ( dsa )
+				{
+					glLogCall( context
+						, glCreateBuffers
+						, 1u
+						, &result );
+				}
+				else
+				{
+					glLogCall( context
+						, glGenBuffers
+						, 1u
+						, &result );
+				}
+
+				return result;
+			};
+			auto allocateBuffer = [&context, dsa]( GLuint result
 				, GlBufferTarget target
 				, GLsizeiptr size
 				, GlBufferDataUsageFlags flags )
 			{
+				if ( dsa )
+				{
+					glLogCall( context
+						, glNamedBufferData
+						, result
+						, size
+						, nullptr
+						, flags );
+					return result;
+				}
+
 				glLogCall( context
 					, glBindBuffer
 					, target
@@ -132,28 +198,28 @@ namespace ashes::gl
 			};
 
 			auto & cache = getAllocatedBuffers();
-			GLuint result;
-			glLogCall( context
-				, glGenBuffers
-				, 1u
-				, &result );
+			GLuint result = genBuffer();
 			auto it = findBuffer( result );
 
 			while ( it != cache.end() )
 			{
 				std::cerr << "Buffer " << result << " is being reused" << std::endl;
-				allocateBuffer( it->name, it->target, it->size, it->flags );
-				glLogCall( context
-					, glGenBuffers
-					, 1u
-					, &result );
+				allocateBuffer( it->second.name, it->second.target, it->second.size, it->second.flags );
+				result = genBuffer();
 				it = findBuffer( result );
 			}
 
 			allocateBuffer( result, target, size, flags );
-			GLint realSize = getBufferSize( context, target, result );
+			GLint realSize = GLint( size );
+
+			if ( !dsa )
+			{
+				realSize = getBufferSize( context, target, result );
+			}
+
 			assert( realSize >= size );
-			getAllocatedBuffers().push_back( { result, target, GLsizeiptr( realSize ), flags } );
+			cache.emplace( result, BufferAlloc{ result, target, GLsizeiptr( realSize ), flags } );
+			addUsage( getAccounting().stats.buffers, VkDeviceSize( realSize ) );
 			return result;
 		}
 
@@ -176,7 +242,20 @@ namespace ashes::gl
 		{
 			if ( buffer != GL_INVALID_INDEX )
 			{
-				GLint size = getBufferSize( context, buffer );
+				GLint size = 0;
+
+				if ( context->hasCreateBuffers() )
+				{
+					// The buffer was created with its tracked size, no need for a round-trip.
+					auto it = findBuffer( buffer );
+					size = it != getAllocatedBuffers().end()
+						? GLint( it->second.size )
+						: 0;
+				}
+				else
+				{
+					size = getBufferSize( context, buffer );
+				}
 
 				if ( size != 0 )
 				{
@@ -184,6 +263,7 @@ namespace ashes::gl
 
 					if ( it != getAllocatedBuffers().end() )
 					{
+						removeUsage( getAccounting().stats.buffers, VkDeviceSize( it->second.size ) );
 						getAllocatedBuffers().erase( it );
 
 						glLogCall( context
@@ -225,13 +305,18 @@ namespace ashes::gl
 				, m_internal{ getInternalFormat( m_texture->getFormat() ) }
 				, m_format{ getFormat( m_internal ) }
 				, m_type{ getType( m_internal ) }
+				, m_dsa{ hasDirectStateAccess( device ) && hasTextureStorage( device ) }
 			{
 				m_boundResource = get( texture )->getInternal();
 				auto context = get( m_device )->getContext();
-				glLogCall( context
-					, glBindTexture
-					, GlTextureType( m_boundTarget )
-					, m_boundResource );
+
+				if ( !m_dsa )
+				{
+					glLogCall( context
+						, glBindTexture
+						, GlTextureType( m_boundTarget )
+						, m_boundResource );
+				}
 
 				switch ( m_boundTarget )
 				{
@@ -280,20 +365,26 @@ namespace ashes::gl
 
 				if ( hasTextureStorage( device ) )
 				{
-					int levels = 0;
-					glLogCall( context
-						, glGetTexParameteriv
-						, GlTextureType( m_boundTarget )
-						, GL_TEX_PARAMETER_IMMUTABLE_LEVELS
-						, &levels );
-					assert( levels == m_texture->getMipLevels() );
-					int format = 0;
-					glLogCall( context
-						, glGetTexParameteriv
-						, GlTextureType( m_boundTarget )
-						, GL_TEX_PARAMETER_IMMUTABLE_FORMAT
-						, &format );
-					assert( format != 0 );
+#if !defined( NDEBUG )
+					// Verification queries, skipped with direct state access, since the texture isn't bound.
+					if ( !m_dsa )
+					{
+						int levels = 0;
+						glLogCall( context
+							, glGetTexParameteriv
+							, GlTextureType( m_boundTarget )
+							, GL_TEX_PARAMETER_IMMUTABLE_LEVELS
+							, &levels );
+						assert( levels == m_texture->getMipLevels() );
+						int format = 0;
+						glLogCall( context
+							, glGetTexParameteriv
+							, GlTextureType( m_boundTarget )
+							, GL_TEX_PARAMETER_IMMUTABLE_FORMAT
+							, &format );
+						assert( format != 0 );
+					}
+#endif
 				}
 				else
 				{
@@ -307,19 +398,22 @@ namespace ashes::gl
 						, m_boundTarget );
 				}
 
-				glLogCall( context
-					, glBindTexture
-					, GlTextureType( m_boundTarget )
-					, 0 );
+				if ( !m_dsa )
+				{
+					glLogCall( context
+						, glBindTexture
+						, GlTextureType( m_boundTarget )
+						, 0 );
+				}
 
-				if ( ashes::checkFlag( m_flags, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT ) )
+				if ( auto capture = get( m_device )->getCapture() )
 				{
-					// Create the PBO
-					m_buffer = createBuffer( context
-						, GL_BUFFER_TARGET_COPY_WRITE
-						, GLsizeiptr( m_allocateInfo.allocationSize )
-						, getBufferDataUsageFlags( m_flags ) );
+					capture->registerTexture( m_boundResource, *m_texture );
+				}
 
+				if ( ashes::checkFlag( m_flags, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT ) )
+				{
+					// No dedicated PBO, the transfers go through the device's staging ring.
 					// Prepare update regions, layer by layer.
 					uint32_t offset = 0;
 					VkBufferImageCopy bufferCopyRegion = {};
@@ -337,10 +431,98 @@ namespace ashes::gl
 						offset += levelSize;
 					}
 				}
+
+				addUsage( getAccounting().stats.images, m_allocateInfo.allocationSize );
 			}
 
 			~ImageMemory()
 			{
+				removeUsage( getAccounting().stats.images, m_allocateInfo.allocationSize );
+			}
+
+			void upload( ContextLock const & context
+				, ByteArray const & data
+				, VkDeviceSize offset
+				, VkDeviceSize size )const override
+			{
+				if ( !doClip( offset, size ) )
+				{
+					return;
+				}
+
+				// The texture is updated layer by layer, hence the whole layers covering the range are uploaded.
+				doSetupUpdateRegions( offset, size );
+
+				if ( m_beginRegion >= m_endRegion )
+				{
+					return;
+				}
+
+				auto begin = m_updateRegions[m_beginRegion].bufferOffset;
+				auto end = m_endRegion < m_updateRegions.size()
+					? m_updateRegions[m_endRegion].bufferOffset
+					: m_allocateInfo.allocationSize;
+				void * dst{ nullptr };
+
+				if ( lock( context, begin, end - begin, &dst ) == VK_SUCCESS )
+				{
+					std::memcpy( dst, data.data() + m_memoryOffset + begin, end - begin );
+					unlock( context );
+				}
+
+				if ( auto capture = get( m_device )->getCapture() )
+				{
+					capture->onTextureData( context, m_boundResource );
+				}
+			}
+
+			void download( ContextLock const & context
+				, ByteArray & data
+				, VkDeviceSize offset
+				, VkDeviceSize size )const override
+			{
+				assert( ashes::checkFlag( m_flags, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT )
+					&& "Unsupported action on a device local texture" );
+
+				if ( !doClip( offset, size ) )
+				{
+					return;
+				}
+
+				auto & ring = get( m_device )->getStagingRing();
+				auto chunk = ring.reserve( context, m_allocateInfo.allocationSize );
+				glLogCall( context
+					, glBindBuffer
+					, GL_BUFFER_TARGET_PIXEL_PACK
+					, chunk.buffer );
+				glLogCall( context
+					, glBindTexture
+					, GlTextureType( m_boundTarget )
+					, m_boundResource );
+				glLogCall( context
+					, glGetTexImage
+					, GlTextureType( m_boundTarget )
+					, 0
+					, m_format
+					, m_type
+					, getBufferOffset( intptr_t( chunk.offset ) ) );
+				glLogCall( context
+					, glBindTexture
+					, GlTextureType( m_boundTarget )
+					, 0u );
+				glLogCall( context
+					, glBindBuffer
+					, GL_BUFFER_TARGET_PIXEL_PACK
+					, 0u );
+				ring.wait( context );
+
+				if ( auto src = static_cast< uint8_t const * >( ring.map( context, chunk, GL_MEMORY_MAP_READ_BIT ) ) )
+				{
+					std::memcpy( data.data() + m_memoryOffset + offset, src + offset, size );
+					ring.unmap( context, chunk );
+				}
+
+				ring.release( context, chunk );
 			}
 
 			VkResult lock( ContextLock const & context
@@ -352,19 +534,20 @@ namespace ashes::gl
 					&& "Unsupported action on a device local texture" );
 
 				auto copySize = size == WholeSize
-					? m_allocateInfo.allocationSize
+					? m_allocateInfo.allocationSize - offset
 					: size;
-				glLogCall( context
-					, glBindBuffer
-					, GL_BUFFER_TARGET_PIXEL_UNPACK
-					, m_buffer );
-				doSetupUpdateRegions( offset, size );
-				auto result = mapBuffer( context
-					, GL_BUFFER_TARGET_PIXEL_UNPACK
-					, offset
-					, copySize
-					, m_mapFlags );
+				doSetupUpdateRegions( offset, copySize );
+				auto & ring = get( m_device )->getStagingRing();
+				m_chunk = ring.reserve( context, copySize );
+				m_lockOffset = offset;
+				auto result = ring.map( context, m_chunk, GL_MEMORY_MAP_WRITE_BIT );
 				*data = result;
+
+				if ( !result )
+				{
+					ring.release( context, m_chunk );
+				}
+
 				return result
 					? VK_SUCCESS
 					: VK_ERROR_MEMORY_MAP_FAILED;
@@ -375,23 +558,30 @@ namespace ashes::gl
 				assert( ashes::checkFlag( m_flags, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT )
 					&& "Unsupported action on a device local texture" );
 
+				auto & ring = get( m_device )->getStagingRing();
+				ring.unmap( context, m_chunk );
 				glLogCall( context
 					, glBindTexture
 					, GlTextureType( m_boundTarget )
 					, m_boundResource );
 				glLogCall( context
-					, glUnmapBuffer
-					, GL_BUFFER_TARGET_PIXEL_UNPACK );
+					, glBindBuffer
+					, GL_BUFFER_TARGET_PIXEL_UNPACK
+					, m_chunk.buffer );
 
 				for( size_t i = m_beginRegion; i < m_endRegion; ++i )
 				{
-					updateRegion( context, m_updateRegions[i] );
+					// Update regions are expressed in the image memory space, the chunk only holds the locked range.
+					auto region = m_updateRegions[i];
+					region.bufferOffset = m_chunk.offset + region.bufferOffset - m_lockOffset;
+					updateRegion( context, region );
 				}
 
 				glLogCall( context
 					, glBindBuffer
 					, GL_BUFFER_TARGET_PIXEL_UNPACK
 					, 0u );
+				ring.release( context, m_chunk );
 
 				if ( m_texture->getMipLevels() > 1
 					&& !isCompressedFormat( m_texture->getFormat() ) )
@@ -417,7 +607,16 @@ namespace ashes::gl
 		private:
 			void doSetImage1D( ContextLock const & context )
 			{
-				if ( hasTextureStorage( m_device ) )
+				if ( m_dsa )
+				{
+					glLogCall( context
+						, glTextureStorage1D
+						, m_boundResource
+						, GLsizei( m_texture->getMipLevels() )
+						, m_internal
+						, m_texture->getDimensions().width );
+				}
+				else if ( hasTextureStorage( m_device ) )
 				{
 					glLogCall( context
 						, glTexStorage1D
@@ -443,7 +642,17 @@ namespace ashes::gl
 
 			void doSetImage2D( ContextLock const & context )
 			{
-				if ( hasTextureStorage( m_device ) )
+				if ( m_dsa )
+				{
+					glLogCall( context
+						, glTextureStorage2D
+						, m_boundResource
+						, GLsizei( m_texture->getMipLevels() )
+						, m_internal
+						, m_texture->getDimensions().width
+						, m_texture->getDimensions().height );
+				}
+				else if ( hasTextureStorage( m_device ) )
 				{
 					glLogCall( context
 						, glTexStorage2D
@@ -489,7 +698,18 @@ namespace ashes::gl
 			void doSetImage3D( ContextLock const & context
 				, uint32_t depth )
 			{
-				if ( hasTextureStorage( m_device ) )
+				if ( m_dsa )
+				{
+					glLogCall( context
+						, glTextureStorage3D
+						, m_boundResource
+						, GLsizei( m_texture->getMipLevels() )
+						, m_internal
+						, m_texture->getDimensions().width
+						, m_texture->getDimensions().height
+						, depth );
+				}
+				else if ( hasTextureStorage( m_device ) )
 				{
 					glLogCall( context
 						, glTexStorage3D
@@ -519,7 +739,18 @@ namespace ashes::gl
 
 			void doSetImage2DMS( ContextLock const & context )
 			{
-				if ( hasTextureStorage( m_device ) )
+				if ( m_dsa )
+				{
+					glLogCall( context
+						, glTextureStorage2DMultisample
+						, m_boundResource
+						, GLsizei( m_texture->getSamples() )
+						, m_internal
+						, m_texture->getDimensions().width
+						, m_texture->getDimensions().height
+						, GL_TRUE );
+				}
+				else if ( hasTextureStorage( m_device ) )
 				{
 					glLogCall( context
 						, glTexStorage2DMultisample
@@ -545,7 +776,19 @@ namespace ashes::gl
 
 			void doSetImage3DMS( ContextLock const & context )
 			{
-				if ( hasTextureStorage( m_device ) )
+				if ( m_dsa )
+				{
+					glLogCall( context
+						, glTextureStorage3DMultisample
+						, m_boundResource
+						, GLsizei( m_texture->getSamples() )
+						, m_internal
+						, m_texture->getDimensions().width
+						, m_texture->getDimensions().height
+						, m_texture->getDimensions().depth
+						, GL_TRUE );
+				}
+				else if ( hasTextureStorage( m_device ) )
 				{
 					glLogCall( context
 						, glTexStorage3DMultisample
@@ -603,6 +846,7 @@ namespace ashes::gl
 						, VK_ERROR_VALIDATION_FAILED_EXT
 						, "OpenGL"
 						, "Invalid offset and/or size." );
+					m_endRegion = std::min( m_endRegion, m_updateRegions.size() );
 				}
 			}
 
@@ -773,9 +1017,12 @@ namespace ashes::gl
 			GlInternal m_internal;
 			GlFormat m_format;
 			GlType m_type;
+			bool m_dsa;
 			std::vector< VkBufferImageCopy > m_updateRegions;
 			mutable size_t m_beginRegion{ 0u };
 			mutable size_t m_endRegion{ 0u };
+			mutable StagingRing::Chunk m_chunk{};
+			mutable VkDeviceSize m_lockOffset{ 0u };
 		};
 
 		//************************************************************************************************
@@ -805,6 +1052,11 @@ namespace ashes::gl
 					, m_allocateInfo.allocationSize
 					, getBufferDataUsageFlags( m_flags ) );
 				m_boundResource = m_buffer;
+
+				if ( auto capture = get( m_device )->getCapture() )
+				{
+					capture->registerBuffer( m_buffer );
+				}
 			}
 
 			~BufferMemory()
@@ -857,6 +1109,18 @@ namespace ashes::gl
 		private:
 			mutable GLenum m_copyTarget;
 		};
+
+		template< typename ImagesT >
+		auto findImage( ImagesT & images
+			, VkImage image )
+		{
+			return std::find_if( images.begin()
+				, images.end()
+				, [image]( typename ImagesT::value_type const & lookup )
+				{
+					return lookup.first == image;
+				} );
+		}
 	}
 
 	//************************************************************************************************
@@ -893,27 +1157,31 @@ namespace ashes::gl
 		, VkDeviceSize offset
 		, VkDeviceSize size )const
 	{
-		if ( size == WholeSize )
+		if ( !doClip( offset, size ) )
 		{
-			assert( offset == 0ull );
-			size = m_allocateInfo.allocationSize;
+			return;
 		}
-		else
+
+		if ( m_align > 1u )
 		{
-			size = ashes::getAlignedSize( size, m_align );
-			offset = ashes::getAlignedSize( offset, m_align );
-			size = offset + size < m_allocateInfo.allocationSize
-				? size
-				: size = m_allocateInfo.allocationSize - offset;
+			auto alignedOffset = offset - ( offset % m_align );
+			size = std::min( ashes::getAlignedSize( size + offset - alignedOffset, m_align )
+				, m_allocateInfo.allocationSize - alignedOffset );
+			offset = alignedOffset;
 		}
 
 		void * dst{ nullptr };
 
 		if ( lock( context, offset, size, &dst ) == VK_SUCCESS )
 		{
-			std::memcpy( dst, data.data() + offset, size );
+			std::memcpy( dst, data.data() + m_memoryOffset + offset, size );
 			unlock( context );
 		}
+
+		if ( auto capture = get( m_device )->getCapture() )
+		{
+			capture->onBufferData( m_buffer, offset, size, data.data() + m_memoryOffset + offset );
+		}
 	}
 
 	void DeviceMemory::DeviceMemoryImpl::download( ContextLock const & context
@@ -921,19 +1189,42 @@ namespace ashes::gl
 		, VkDeviceSize offset
 		, VkDeviceSize size )const
 	{
-		if ( size == WholeSize )
+		if ( !doClip( offset, size ) )
 		{
-			assert( offset == 0ull );
-			size = m_allocateInfo.allocationSize;
+			return;
 		}
 
 		void * src{ nullptr };
 
 		if ( lock( context, offset, size, &src ) == VK_SUCCESS )
 		{
-			std::memcpy( data.data() + offset, src, size );
+			std::memcpy( data.data() + m_memoryOffset + offset, src, size );
 			unlock( context );
 		}
+
+		if ( auto capture = get( m_device )->getCapture() )
+		{
+			capture->onBufferReadback( m_buffer, offset, size );
+		}
+	}
+
+	bool DeviceMemory::DeviceMemoryImpl::doClip( VkDeviceSize & offset
+		, VkDeviceSize & size )const
+	{
+		auto bindingEnd = m_memoryOffset + m_allocateInfo.allocationSize;
+		auto begin = std::max( offset, m_memoryOffset );
+		auto end = ( size == WholeSize || offset + size > bindingEnd )
+			? bindingEnd
+			: offset + size;
+
+		if ( begin >= end )
+		{
+			return false;
+		}
+
+		offset = begin - m_memoryOffset;
+		size = end - begin;
+		return true;
 	}
 
 	//************************************************************************************************
@@ -949,10 +1240,21 @@ namespace ashes::gl
 		{
 			m_data.resize( allocateInfo.allocationSize );
 		}
+
+		addUsage( getAccounting().stats.memoryTypes[m_allocateInfo.memoryTypeIndex]
+			, m_allocateInfo.allocationSize );
 	}
 
 	DeviceMemory::~DeviceMemory()
 	{
+		// The images may outlive their memory, they must not reach it anymore.
+		for ( auto & image : m_images )
+		{
+			get( image.first )->setMemory( VK_NULL_HANDLE, 0u );
+		}
+
+		removeUsage( getAccounting().stats.memoryTypes[m_allocateInfo.memoryTypeIndex]
+			, m_allocateInfo.allocationSize );
 	}
 
 	VkResult DeviceMemory::bindToBuffer( VkBuffer buffer
@@ -962,24 +1264,28 @@ namespace ashes::gl
 
 		try
 		{
-			m_impl = std::make_unique< BufferMemory >( get( this )
-				, m_device
-				, m_allocateInfo
-				, get( buffer )->getTarget()
-				, memoryOffset );
-			get( buffer )->setInternal( m_impl->getInternal(), memoryOffset );
-			get( buffer )->setMemory( get( this ) );
-
-			if ( !m_data.empty() )
+			if ( !m_buffer )
 			{
-				auto context = get( m_device )->getContext();
-				m_impl->upload( context
-					, m_data
-					, 0u
-					, m_data.size() );
+				m_buffer = std::make_unique< BufferMemory >( get( this )
+					, m_device
+					, m_allocateInfo
+					, get( buffer )->getTarget()
+					, 0u );
+
+				if ( !m_data.empty() )
+				{
+					auto context = get( m_device )->getContext();
+					m_buffer->upload( context
+						, m_data
+						, 0u
+						, m_data.size() );
+				}
+
+				m_internal = m_buffer->getBuffer();
 			}
 
-			m_internal = m_impl->getBuffer();
+			get( buffer )->setInternal( m_buffer->getInternal(), memoryOffset );
+			get( buffer )->setMemory( get( this ) );
 			result = VK_SUCCESS;
 		}
 		catch ( Exception & exc )
@@ -1000,13 +1306,24 @@ namespace ashes::gl
 
 		try
 		{
-			m_impl = std::make_unique< ImageMemory >( get( this )
-				, m_device
-				, m_allocateInfo
-				, image
-				, memoryOffset );
-			get( image )->setMemory( get( this ) );
-			m_internal = m_impl->getBuffer();
+			auto it = findImage( m_images, image );
+
+			if ( it != m_images.end() )
+			{
+				return VK_SUCCESS;
+			}
+
+			// The image binding only covers the image's part of the memory.
+			auto allocateInfo = m_allocateInfo;
+			allocateInfo.allocationSize = std::min( get( image )->getMemoryRequirements().size
+				, m_allocateInfo.allocationSize - memoryOffset );
+			m_images.emplace_back( image
+				, std::make_unique< ImageMemory >( get( this )
+					, m_device
+					, allocateInfo
+					, image
+					, memoryOffset ) );
+			get( image )->setMemory( get( this ), memoryOffset );
 			result = VK_SUCCESS;
 		}
 		catch ( Exception & exc )
@@ -1020,20 +1337,60 @@ namespace ashes::gl
 		return result;
 	}
 
+	void DeviceMemory::unbindImage( VkImage image )
+	{
+		auto it = findImage( m_images, image );
+
+		if ( it != m_images.end() )
+		{
+			m_images.erase( it );
+		}
+	}
+
 	void DeviceMemory::upload( ContextLock const & context
 		, VkDeviceSize offset
 		, VkDeviceSize size )const
 	{
-		assert( m_impl && "VkDeviceMemory should be bound to a buffer or an image, at this point" );
-		m_impl->upload( context, m_data, offset, size );
+		assert( ( m_buffer || !m_images.empty() )
+			&& "VkDeviceMemory should be bound to a buffer or an image, at this point" );
+
+		if ( m_data.empty() )
+		{
+			return;
+		}
+
+		if ( m_buffer )
+		{
+			m_buffer->upload( context, m_data, offset, size );
+		}
+
+		for ( auto & image : m_images )
+		{
+			image.second->upload( context, m_data, offset, size );
+		}
 	}
 
 	void DeviceMemory::download( ContextLock const & context
 		, VkDeviceSize offset
 		, VkDeviceSize size )const
 	{
-		assert( m_impl && "VkDeviceMemory should be bound to a buffer or an image, at this point" );
-		m_impl->download( context, m_data, offset, size );
+		assert( ( m_buffer || !m_images.empty() )
+			&& "VkDeviceMemory should be bound to a buffer or an image, at this point" );
+
+		if ( m_data.empty() )
+		{
+			return;
+		}
+
+		if ( m_buffer )
+		{
+			m_buffer->download( context, m_data, offset, size );
+		}
+
+		for ( auto & image : m_images )
+		{
+			image.second->download( context, m_data, offset, size );
+		}
 	}
 
 	VkResult DeviceMemory::lock( ContextLock const & context
@@ -1045,8 +1402,8 @@ namespace ashes::gl
 		assert( !m_mapped && "VkDeviceMemory should not be mapped" );
 		*data = m_data.data() + offset;
 		m_mappedOffset = offset;
-		m_mappedSize = size == ~( 0ull )
-			? m_allocateInfo.allocationSize
+		m_mappedSize = size == WholeSize
+			? m_allocateInfo.allocationSize - offset
 			: size;
 		m_mapped = *data != nullptr;
 		m_dirty = true;
@@ -1059,7 +1416,7 @@ namespace ashes::gl
 	{
 		assert( m_mapped && "VkDeviceMemory should be mapped" );
 
-		if ( m_impl )
+		if ( m_buffer || !m_images.empty() )
 		{
 			upload( context, offset, size );
 		}
@@ -1074,9 +1431,9 @@ namespace ashes::gl
 		assert( m_mapped && "VkDeviceMemory should be mapped" );
 		m_dirty = true;
 
-		if ( m_impl )
+		if ( m_buffer || !m_images.empty() )
 		{
-			download( context, m_mappedOffset, m_mappedSize );
+			download( context, offset, size );
 		}
 
 		return VK_SUCCESS;
@@ -1087,11 +1444,34 @@ namespace ashes::gl
 		assert( m_mapped && "VkDeviceMemory should be mapped" );
 		m_mapped = false;
 
-		if ( m_impl )
+		if ( m_buffer || !m_images.empty() )
 		{
 			upload( context, m_mappedOffset, m_mappedSize );
 		}
 	}
 
 	//************************************************************************************************
+
+	MemoryStats getMemoryStats()
+	{
+		auto & accounting = getAccounting();
+		MemoryStats result;
+		{
+			std::lock_guard< std::mutex > lock{ accounting.mutex };
+			result = accounting.stats;
+		}
+		auto & memoryProperties = Instance::getMemoryProperties();
+
+		for ( uint32_t i = 0u; i < memoryProperties.memoryTypeCount; ++i )
+		{
+			auto & type = result.memoryTypes[i];
+			auto & heap = result.memoryHeaps[memoryProperties.memoryTypes[i].heapIndex];
+			heap.count += type.count;
+			heap.bytes += type.bytes;
+		}
+
+		return result;
+	}
+
+	//************************************************************************************************
 }
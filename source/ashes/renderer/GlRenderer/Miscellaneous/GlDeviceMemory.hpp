@@ -7,6 +7,7 @@ See LICENSE file in root folder
 #include "renderer/GlRenderer/GlRendererPrerequisites.hpp"
 
 #include "renderer/GlRenderer/Enum/GlMemoryMapFlag.hpp"
+#include "renderer/GlRenderer/Miscellaneous/GlMemoryStats.hpp"
 
 namespace ashes::gl
 {
@@ -24,12 +25,19 @@ namespace ashes::gl
 				, VkDeviceSize memoryOffset
 				, VkDeviceSize align );
 			virtual ~DeviceMemoryImpl();
-
-			void upload( ContextLock const & context
+			/**
+			*\brief
+			*	Uploads the part of the given range, expressed in the parent memory space, that is covered by this binding.
+			*/
+			virtual void upload( ContextLock const & context
 				, ByteArray const & data
 				, VkDeviceSize offset
 				, VkDeviceSize size )const;
-			void download( ContextLock const & context
+			/**
+			*\brief
+			*	Downloads the part of the given range, expressed in the parent memory space, that is covered by this binding.
+			*/
+			virtual void download( ContextLock const & context
 				, ByteArray & data
 				, VkDeviceSize offset
 				, VkDeviceSize size )const;
@@ -51,6 +59,9 @@ namespace ashes::gl
 			}
 
 		protected:
+			bool doClip( VkDeviceSize & offset
+				, VkDeviceSize & size )const;
+
 			VkDeviceMemory m_parent;
 			VkDevice m_device;
 			VkMemoryAllocateInfo m_allocateInfo;
@@ -71,6 +82,11 @@ namespace ashes::gl
 			, VkDeviceSize memoryOffset );
 		VkResult bindToImage( VkImage texture
 			, VkDeviceSize memoryOffset );
+		/**
+		*\brief
+		*	Removes the binding of the given image, which is being destroyed.
+		*/
+		void unbindImage( VkImage texture );
 
 		void upload( ContextLock const & context
 			, VkDeviceSize offset
@@ -104,14 +120,22 @@ namespace ashes::gl
 
 		GLuint getInternal()const
 		{
-			assert( m_impl );
-			return m_impl->getInternal();
+			assert( m_buffer );
+			return m_buffer->getInternal();
 		}
 
 		GLuint getBuffer()const
 		{
-			assert( m_impl );
-			return m_impl->getBuffer();
+			assert( m_buffer );
+			return m_buffer->getBuffer();
+		}
+		/**
+		*\return
+		*	\p true if the memory has a host copy, that must be refreshed after GPU writes.
+		*/
+		bool isHostVisible()const
+		{
+			return !m_data.empty();
 		}
 
 	public:
@@ -122,11 +146,20 @@ namespace ashes::gl
 		VkMemoryAllocateInfo m_allocateInfo;
 		VkMemoryPropertyFlags m_flags;
 		GlMemoryMapFlags m_mapFlags;
-		std::unique_ptr< DeviceMemoryImpl > m_impl;
+		// All the buffers bound to this memory share the same GL buffer, at their memory offset.
+		std::unique_ptr< DeviceMemoryImpl > m_buffer;
+		std::vector< std::pair< VkImage, std::unique_ptr< DeviceMemoryImpl > > > m_images;
 		mutable bool m_dirty = true;
 		mutable bool m_mapped = false;
 		mutable VkDeviceSize m_mappedOffset;
 		mutable VkDeviceSize m_mappedSize;
 		mutable ByteArray m_data;
 	};
+	/**
+	*\return
+	*	The live memory objects, GL buffers and texture storages counters.
+	*\remarks
+	*	The heaps budgets are left empty, they are filled by the physical device.
+	*/
+	MemoryStats getMemoryStats();
 }
@@ -132,10 +132,9 @@ namespace ashes::gl
 			getIntegerv( GL_SPIRV_SHADER_BINARY_FORMATS, reinterpret_cast< int * >( m_shaderBinaryFormats.data() ) );
 		}
 
-		// Currently disabled, because I need to parse SPIR-V to retrieve push constant blocks...
-		m_spirvSupported = false
-			&& ( find( ARB_gl_spirv )
-				|| hasSPIRVShaderBinaryFormat() );
+		// The modules SPIR-V can't handle (push constants, ...) still go through SPIRV-Cross.
+		m_spirvSupported = find( ARB_gl_spirv )
+			&& hasSPIRVShaderBinaryFormat();
 
 		m_features.hasTexBufferRange = find( ARB_texture_buffer_range );
 		m_features.hasImageTexture = findAll( { ARB_texture_storage, ARB_shader_image_load_store } );
@@ -15,8 +15,10 @@ namespace ashes::gl
 
 	makeGlExtension( AMDX_debug_output, 1, 1 );
 	makeGlExtension( ARB_base_instance, 3, 1 );
+	makeGlExtension( ARB_bindless_texture, 4, 0 );
 	makeGlExtension( ARB_blend_func_extended, 3, 2 );
 	makeGlExtension( ARB_buffer_storage, 4, 3 );
+	makeGlExtension( ARB_clear_buffer_object, 4, 3 );
 	makeGlExtension( ARB_clear_texture, 4, 3 );
 	makeGlExtension( ARB_clip_control, 4, 4 );
 	makeGlExtension( ARB_compute_shader, 4, 2 );
@@ -24,6 +26,7 @@ namespace ashes::gl
 	makeGlExtension( ARB_cull_distance, 4, 4 );
 	makeGlExtension( ARB_debug_output, 4, 0 );
 	makeGlExtension( ARB_depth_clamp, 3, 1 );
+	makeGlExtension( ARB_direct_state_access, 4, 5 );
 	makeGlExtension( ARB_draw_buffers_blend, 2, 0 );
 	makeGlExtension( ARB_draw_indirect, 3, 2 );
 	makeGlExtension( ARB_draw_instanced, 3, 0 );
@@ -47,6 +50,7 @@ namespace ashes::gl
 	makeGlExtension( ARB_shader_storage_buffer_object, 4, 2 );
 	makeGlExtension( ARB_shading_language_420pack, 4, 2 );
 	makeGlExtension( ARB_sparse_buffer, 4, 4 );
+	makeGlExtension( ARB_sparse_texture, 4, 4 );
 	makeGlExtension( ARB_sparse_texture2, 4, 5 );
 	makeGlExtension( ARB_sparse_texture_clamp, 4, 5 );
 	makeGlExtension( ARB_tessellation_shader, 3, 2 );
@@ -61,6 +65,7 @@ namespace ashes::gl
 	makeGlExtension( ARB_viewport_array, 3, 2 );
 	makeGlExtension( ARB_ES2_compatibility, 4, 0 );
 	makeGlExtension( ARB_ES3_compatibility, 4, 2 );
+	makeGlExtension( ATI_meminfo, 1, 1 );
 	makeGlExtension( EXT_draw_buffers2, 2, 0 );
 	makeGlExtension( EXT_polygon_offset_clamp, 3, 3 );
 	makeGlExtension( EXT_shader_image_load_formatted, 4, 3 );
@@ -69,6 +74,7 @@ namespace ashes::gl
 	makeGlExtension( KHR_debug, 4, 2 );
 	makeGlExtension( KHR_robustness, 3, 2 );
 	makeGlExtension( KHR_texture_compression_astc_ldr, 3, 2 );
+	makeGlExtension( NVX_gpu_memory_info, 2, 0 );
 #undef makeGlExtension
 
 	class ExtensionsHandler
@@ -0,0 +1,224 @@
+/*
+This file belongs to Ashes.
+See LICENSE file in root folder
+*/
+#include "Miscellaneous/GlFramebufferCache.hpp"
+
+#include "Core/GlDevice.hpp"
+#include "Image/GlImage.hpp"
+#include "Miscellaneous/GlCallLogger.hpp"
+#include "RenderPass/GlFrameBuffer.hpp"
+
+#include "ashesgl_api.hpp"
+
+#include <tuple>
+
+namespace ashes::gl
+{
+	namespace
+	{
+		static GLenum constexpr GL_DRAW_FRAMEBUFFER_BINDING = 0x8CA6;
+		static GLenum constexpr GL_READ_FRAMEBUFFER_BINDING = 0x8CAA;
+
+		bool isColourPoint( GlAttachmentPoint point )
+		{
+			return point >= GL_ATTACHMENT_POINT_COLOR0
+				&& point <= GL_ATTACHMENT_POINT_COLOR15;
+		}
+	}
+
+	bool FramebufferCache::AttachmentLess::operator()( CachedAttachment const & lhs
+		, CachedAttachment const & rhs )const
+	{
+		// The texture comes first, for releaseTexture to find its framebuffers in a single range.
+		return std::tie( lhs.object, lhs.point, lhs.target, lhs.mipLevel, lhs.arrayLayer, lhs.layered )
+			< std::tie( rhs.object, rhs.point, rhs.target, rhs.mipLevel, rhs.arrayLayer, rhs.layered );
+	}
+
+	FramebufferCache::FramebufferCache( VkDevice device )
+		: m_device{ device }
+	{
+	}
+
+	FramebufferCache::~FramebufferCache()
+	{
+		if ( !m_entries.empty() )
+		{
+			auto context = get( m_device )->getContext();
+			clear( context );
+		}
+	}
+
+	GLuint FramebufferCache::getFramebuffer( ContextLock const & context
+		, CachedAttachment const & attach )
+	{
+		std::unique_lock< std::mutex > lock{ m_mutex };
+		auto it = m_lookup.find( attach );
+
+		if ( it != m_lookup.end() )
+		{
+			m_entries.splice( m_entries.begin(), m_entries, it->second );
+			return it->second->fbo;
+		}
+
+		if ( m_entries.size() >= MaxFramebuffers )
+		{
+			doDelete( context, std::prev( m_entries.end() ) );
+		}
+
+		// The framebuffers are created while the commands are applied, between the binding
+		// of a command's read and draw framebuffers, hence those bindings are restored.
+		GLint drawFbo{};
+		GLint readFbo{};
+		glLogCall( context
+			, glGetIntegerv
+			, GL_DRAW_FRAMEBUFFER_BINDING
+			, &drawFbo );
+		glLogCall( context
+			, glGetIntegerv
+			, GL_READ_FRAMEBUFFER_BINDING
+			, &readFbo );
+		GLuint fbo{};
+		glLogCall( context
+			, glGenFramebuffers
+			, 1
+			, &fbo );
+		glLogCall( context
+			, glBindFramebuffer
+			, GL_FRAMEBUFFER
+			, fbo );
+
+		if ( attach.layered )
+		{
+			glLogCall( context
+				, glFramebufferTextureLayer
+				, GL_FRAMEBUFFER
+				, attach.point
+				, attach.object
+				, GLint( attach.mipLevel )
+				, GLint( attach.arrayLayer ) );
+		}
+		else
+		{
+			glLogCall( context
+				, glFramebufferTexture2D
+				, GL_FRAMEBUFFER
+				, attach.point
+				, attach.target
+				, attach.object
+				, GLint( attach.mipLevel ) );
+		}
+
+		// Depth and stencil framebuffers have no colour buffer, they would be incomplete otherwise.
+		GLenum buffer = isColourPoint( attach.point )
+			? GLenum( attach.point )
+			: GLenum( 0u );// GL_NONE
+		glLogCall( context
+			, glReadBuffer
+			, buffer );
+		glLogCall( context
+			, glDrawBuffers
+			, 1
+			, &buffer );
+
+		checkCompleteness( context->glCheckFramebufferStatus( GL_FRAMEBUFFER ) );
+		glLogCall( context
+			, glBindFramebuffer
+			, GL_DRAW_FRAMEBUFFER
+			, GLuint( drawFbo ) );
+		glLogCall( context
+			, glBindFramebuffer
+			, GL_READ_FRAMEBUFFER
+			, GLuint( readFbo ) );
+		m_entries.push_front( Entry{ attach, fbo } );
+		m_lookup.emplace( attach, m_entries.begin() );
+		return fbo;
+	}
+
+	void FramebufferCache::releaseTexture( ContextLock const & context
+		, GLuint texture )
+	{
+		std::unique_lock< std::mutex > lock{ m_mutex };
+		auto it = m_lookup.lower_bound( CachedAttachment{ texture } );
+
+		while ( it != m_lookup.end()
+			&& it->first.object == texture )
+		{
+			auto entry = it->second;
+			++it;
+			doDelete( context, entry );
+		}
+	}
+
+	void FramebufferCache::clear( ContextLock const & context )
+	{
+		std::unique_lock< std::mutex > lock{ m_mutex };
+
+		while ( !m_entries.empty() )
+		{
+			doDelete( context, m_entries.begin() );
+		}
+	}
+
+	void FramebufferCache::doDelete( ContextLock const & context
+		, EntryList::iterator it )
+	{
+		glLogCall( context
+			, glDeleteFramebuffers
+			, 1
+			, &it->fbo );
+		m_lookup.erase( it->attach );
+		m_entries.erase( it );
+	}
+
+	CachedAttachment makeCachedAttachment( VkImage image
+		, VkImageAspectFlags aspectMask
+		, uint32_t mipLevel
+		, uint32_t arrayLayer )
+	{
+		auto & img = *get( image );
+
+		// Before GL 4.5, glFramebufferTextureLayer rejects non array cube maps,
+		// so their faces are attached through glFramebufferTexture2D.
+		if ( img.getTarget() == GL_TEXTURE_CUBE
+			&& !hasDirectStateAccess( img.getDevice() ) )
+		{
+			return CachedAttachment
+			{
+				img.getInternal(),
+				getAttachmentPoint( aspectMask ),
+				GlTextureType( GL_TEXTURE_CUBE_POSITIVE_X + arrayLayer ),
+				mipLevel,
+				arrayLayer,
+				false,
+			};
+		}
+
+		return CachedAttachment
+		{
+			img.getInternal(),
+			getAttachmentPoint( aspectMask ),
+			( img.getSamples() > VK_SAMPLE_COUNT_1_BIT
+				? GL_TEXTURE_2D_MULTISAMPLE
+				: GL_TEXTURE_2D ),
+			mipLevel,
+			arrayLayer,
+			( img.getArrayLayers() > 1u
+				|| img.getType() == VK_IMAGE_TYPE_3D
+				|| checkFlag( img.getCreateFlags(), VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT ) ),
+		};
+	}
+
+	CachedAttachment makeCachedAttachment( FboAttachment const & attach )
+	{
+		return CachedAttachment
+		{
+			attach.object,
+			attach.point,
+			attach.target,
+			attach.mipLevel,
+			0u,
+			0u,
+		};
+	}
+}
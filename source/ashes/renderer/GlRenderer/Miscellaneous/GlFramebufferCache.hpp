@@ -0,0 +1,88 @@
+/*
+This file belongs to Ashes.
+See LICENSE file in root folder
+*/
+#pragma once
+
+#include "renderer/GlRenderer/GlRendererPrerequisites.hpp"
+
+#include <list>
+#include <map>
+#include <mutex>
+
+namespace ashes::gl
+{
+	/**
+	*\brief
+	*	Device wide LRU cache of the framebuffers used by the blits, resolves and readbacks.
+	*\remarks
+	*	Each framebuffer has a single image subresource attached, its read and draw buffers
+	*	are set, and its completeness is checked, once at creation.
+	*	The creation keeps the current read and draw framebuffer bindings.
+	*	The framebuffers are looked up when the commands are applied, so an evicted one is
+	*	simply recreated by the next command using it.
+	*/
+	class FramebufferCache
+	{
+	public:
+		static size_t constexpr MaxFramebuffers = 64u;
+
+	public:
+		FramebufferCache( VkDevice device );
+		~FramebufferCache();
+		/**
+		*\return
+		*	The framebuffer with the given subresource attached, created if needed.
+		*/
+		GLuint getFramebuffer( ContextLock const & context
+			, CachedAttachment const & attach );
+		/**
+		*\brief
+		*	Deletes the framebuffers using the given texture, which is about to be deleted.
+		*/
+		void releaseTexture( ContextLock const & context
+			, GLuint texture );
+		/**
+		*\brief
+		*	Deletes all the framebuffers, which aren't shared between GL contexts.
+		*/
+		void clear( ContextLock const & context );
+
+	private:
+		struct Entry
+		{
+			CachedAttachment attach;
+			GLuint fbo;
+		};
+		// Most recently used first.
+		using EntryList = std::list< Entry >;
+
+		struct AttachmentLess
+		{
+			bool operator()( CachedAttachment const & lhs
+				, CachedAttachment const & rhs )const;
+		};
+
+		void doDelete( ContextLock const & context
+			, EntryList::iterator it );
+
+	private:
+		VkDevice m_device;
+		std::mutex m_mutex;
+		EntryList m_entries;
+		std::map< CachedAttachment, EntryList::iterator, AttachmentLess > m_lookup;
+	};
+	/**
+	*\return
+	*	The attachment of the given image subresource, layered images being attached layer by layer.
+	*/
+	CachedAttachment makeCachedAttachment( VkImage image
+		, VkImageAspectFlags aspectMask
+		, uint32_t mipLevel
+		, uint32_t arrayLayer );
+	/**
+	*\return
+	*	The attachment of the texture attached to a framebuffer, at the same point.
+	*/
+	CachedAttachment makeCachedAttachment( FboAttachment const & attach );
+}
@@ -0,0 +1,41 @@
+/*
+This file belongs to Ashes.
+See LICENSE file in root folder
+*/
+#pragma once
+
+#include <cstdint>
+
+namespace ashes::gl
+{
+	/**
+	*\brief
+	*	Live objects count and their size.
+	*/
+	struct MemoryUsage
+	{
+		uint32_t count;
+		uint64_t bytes;
+	};
+	/**
+	*\brief
+	*	The GL renderer memory accounting, as returned by ashglGetMemoryStats.
+	*\remarks
+	*	The counters are process wide, they cover the memory of all the devices.
+	*/
+	struct MemoryStats
+	{
+		static uint32_t constexpr MaxMemoryTypes = 32u;
+		static uint32_t constexpr MaxMemoryHeaps = 16u;
+		// The VkDeviceMemory objects, indexed by memory type.
+		MemoryUsage memoryTypes[MaxMemoryTypes];
+		// The VkDeviceMemory objects, indexed by memory heap.
+		MemoryUsage memoryHeaps[MaxMemoryHeaps];
+		// The GL buffers backing the memory bound to buffers.
+		MemoryUsage buffers;
+		// The GL texture storages backing the memory bound to images.
+		MemoryUsage images;
+		// The budget of each memory heap, as reported through VK_EXT_memory_budget.
+		uint64_t heapBudgets[MaxMemoryHeaps];
+	};
+}
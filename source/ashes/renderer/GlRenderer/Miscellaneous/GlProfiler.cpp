@@ -0,0 +1,377 @@
+/*
+This file belongs to Ashes.
+See LICENSE file in root folder
+*/
+#include "Miscellaneous/GlProfiler.hpp"
+
+#include "Core/GlDevice.hpp"
+#include "Miscellaneous/GlCallLogger.hpp"
+
+#include "ashesgl_api.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+namespace ashes::gl
+{
+	namespace
+	{
+		// Tracks 0 and 1 are reserved, the CPU threads ones come after.
+		uint32_t constexpr GpuTrack = 0u;
+		uint32_t constexpr FrameTrack = 1u;
+		// GL queries are allocated by blocks of this size.
+		GLsizei constexpr QueriesBlockSize = 64;
+
+		std::string getPrefix()
+		{
+			auto value = std::getenv( "ASHES_GL_PROFILE" );
+
+			if ( !value || std::strcmp( value, "1" ) == 0 )
+			{
+				return "ashes_gl_profile";
+			}
+
+			return value;
+		}
+
+		uint32_t getFramesPerFile()
+		{
+			if ( auto value = std::getenv( "ASHES_GL_PROFILE_FRAMES" ) )
+			{
+				auto result = std::strtoul( value, nullptr, 10 );
+
+				if ( result )
+				{
+					return uint32_t( result );
+				}
+			}
+
+			return 100u;
+		}
+
+		void writeString( std::ostream & stream
+			, std::string const & value )
+		{
+			stream << '"';
+
+			for ( auto c : value )
+			{
+				if ( c == '"' || c == '\\' )
+				{
+					stream << '\\' << c;
+				}
+				else if ( uint8_t( c ) < 0x20u )
+				{
+					stream << ' ';
+				}
+				else
+				{
+					stream << c;
+				}
+			}
+
+			stream << '"';
+		}
+
+		void writeTrackName( std::ostream & stream
+			, uint32_t track
+			, std::string const & name )
+		{
+			stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << track
+				<< ",\"args\":{\"name\":";
+			writeString( stream, name );
+			stream << "}},\n";
+		}
+	}
+
+	//*********************************************************************************************
+
+	Profiler::CpuScope::CpuScope( Profiler * profiler
+		, char const * name )
+		: m_profiler{ profiler }
+		, m_name{ name }
+	{
+		if ( m_profiler )
+		{
+			m_begin = Clock::now();
+		}
+	}
+
+	Profiler::CpuScope::~CpuScope()
+	{
+		if ( m_profiler )
+		{
+			m_profiler->addCpuEvent( m_name, m_begin, Clock::now() );
+		}
+	}
+
+	//*********************************************************************************************
+
+	Profiler::Profiler( VkDevice device )
+		: m_device{ device }
+		, m_prefix{ getPrefix() }
+		, m_framesPerFile{ getFramesPerFile() }
+		, m_epoch{ Clock::now() }
+		, m_frameBegin{ m_epoch }
+	{
+	}
+
+	Profiler::~Profiler()
+	{
+		// At device teardown, the context may already be gone, along with its queries.
+		if ( get( m_device )->hasCurrentContext() )
+		{
+			auto context = get( m_device )->getContext();
+			doResolve( context, true );
+
+			if ( !m_queries.empty() )
+			{
+				glLogCall( context
+					, glDeleteQueries
+					, GLsizei( m_queries.size() )
+					, m_queries.data() );
+			}
+		}
+
+		doWrite();
+	}
+
+	bool Profiler::isRequested()
+	{
+		auto value = std::getenv( "ASHES_GL_PROFILE" );
+		return value
+			&& *value
+			&& std::strcmp( value, "0" ) != 0;
+	}
+
+	void Profiler::beginGpuRegion( ContextLock const & context
+		, std::string name )
+	{
+		// Query objects aren't shared between contexts, so the regions replayed by a queue worker are skipped.
+		if ( !get( m_device )->isDeviceContext( context.getContext() ) )
+		{
+			return;
+		}
+
+		std::unique_lock< std::mutex > lock{ m_mutex };
+
+		if ( !m_gpuEpoch )
+		{
+			// Synchronise the timelines, this stalls once, at the first region.
+			GLint64 gpuTime{};
+			glLogCall( context
+				, glGetInteger64v
+				, GLenum( GL_QUERY_TYPE_TIMESTAMP )
+				, &gpuTime );
+			m_gpuEpoch = int64_t( gpuTime ) - doGetTime( Clock::now() );
+		}
+
+		auto query = doGetQuery( context );
+		glLogCall( context
+			, glQueryCounter
+			, query
+			, GL_QUERY_TYPE_TIMESTAMP );
+		m_openRegions.push_back( { std::move( name ), query, GL_INVALID_INDEX } );
+	}
+
+	void Profiler::endGpuRegion( ContextLock const & context )
+	{
+		if ( !get( m_device )->isDeviceContext( context.getContext() ) )
+		{
+			return;
+		}
+
+		std::unique_lock< std::mutex > lock{ m_mutex };
+
+		// Regions opened in another command buffer are ignored.
+		if ( m_openRegions.empty() )
+		{
+			return;
+		}
+
+		auto region = std::move( m_openRegions.back() );
+		m_openRegions.pop_back();
+		region.end = doGetQuery( context );
+		glLogCall( context
+			, glQueryCounter
+			, region.end
+			, GL_QUERY_TYPE_TIMESTAMP );
+		m_pendingRegions.push_back( std::move( region ) );
+	}
+
+	void Profiler::resolve( ContextLock const & context )
+	{
+		if ( !get( m_device )->isDeviceContext( context.getContext() ) )
+		{
+			return;
+		}
+
+		doResolve( context, false );
+	}
+
+	void Profiler::addCpuEvent( std::string name
+		, Clock::time_point begin
+		, Clock::time_point end )
+	{
+		std::unique_lock< std::mutex > lock{ m_mutex };
+		m_events.push_back( { std::move( name )
+			, doGetCpuTrack()
+			, doGetTime( begin )
+			, std::chrono::duration_cast< std::chrono::nanoseconds >( end - begin ).count() } );
+	}
+
+	void Profiler::endFrame( ContextLock const & context )
+	{
+		doResolve( context, false );
+		std::unique_lock< std::mutex > lock{ m_mutex };
+		auto end = Clock::now();
+		m_events.push_back( { "Frame " + std::to_string( m_frame )
+			, FrameTrack
+			, doGetTime( m_frameBegin )
+			, std::chrono::duration_cast< std::chrono::nanoseconds >( end - m_frameBegin ).count() } );
+		m_frameBegin = end;
+		++m_frame;
+
+		if ( ( m_frame % m_framesPerFile ) == 0u )
+		{
+			// Still pending regions will go to the next file.
+			doWrite();
+		}
+	}
+
+	GLuint Profiler::doGetQuery( ContextLock const & context )
+	{
+		if ( m_freeQueries.empty() )
+		{
+			auto index = m_queries.size();
+			m_queries.resize( index + QueriesBlockSize );
+			glLogCall( context
+				, glGenQueries
+				, QueriesBlockSize
+				, m_queries.data() + index );
+			m_freeQueries.insert( m_freeQueries.end()
+				, m_queries.begin() + index
+				, m_queries.end() );
+		}
+
+		auto result = m_freeQueries.back();
+		m_freeQueries.pop_back();
+		return result;
+	}
+
+	void Profiler::doResolve( ContextLock const & context
+		, bool wait )
+	{
+		std::unique_lock< std::mutex > lock{ m_mutex };
+
+		while ( !m_pendingRegions.empty() )
+		{
+			auto & region = m_pendingRegions.front();
+
+			if ( !wait )
+			{
+				// The queries complete in order, so checking the end one is enough.
+				GLuint available{};
+				glLogCall( context
+					, glGetQueryObjectuiv
+					, region.end
+					, GL_QUERY_RESULT_AVAILABLE
+					, &available );
+
+				if ( !available )
+				{
+					break;
+				}
+			}
+
+			GLuint64 begin{};
+			GLuint64 end{};
+			glLogCall( context
+				, glGetQueryObjectui64v
+				, region.begin
+				, GL_QUERY_RESULT
+				, &begin );
+			glLogCall( context
+				, glGetQueryObjectui64v
+				, region.end
+				, GL_QUERY_RESULT
+				, &end );
+			m_events.push_back( { std::move( region.name )
+				, GpuTrack
+				, int64_t( begin ) - m_gpuEpoch.value()
+				, int64_t( end - begin ) } );
+			m_freeQueries.push_back( region.begin );
+			m_freeQueries.push_back( region.end );
+			m_pendingRegions.pop_front();
+		}
+	}
+
+	uint32_t Profiler::doGetCpuTrack()
+	{
+		auto id = std::this_thread::get_id();
+		auto it = m_cpuTracks.find( id );
+
+		if ( it == m_cpuTracks.end() )
+		{
+			it = m_cpuTracks.emplace( id, uint32_t( FrameTrack + 1u + m_cpuTracks.size() ) ).first;
+		}
+
+		return it->second;
+	}
+
+	int64_t Profiler::doGetTime( Clock::time_point value )const
+	{
+		return std::chrono::duration_cast< std::chrono::nanoseconds >( value - m_epoch ).count();
+	}
+
+	void Profiler::doWrite()
+	{
+		if ( m_events.empty() )
+		{
+			return;
+		}
+
+		auto fileName = m_prefix + "-" + std::to_string( m_fileIndex++ ) + ".json";
+		std::ofstream file{ fileName, std::ios::binary };
+
+		if ( !file )
+		{
+			std::cerr << "Couldn't open profile file [" << fileName << "]" << std::endl;
+			m_events.clear();
+			return;
+		}
+
+		file.imbue( std::locale{ "C" } );
+		file << std::fixed << std::setprecision( 3 );
+		file << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+		writeTrackName( file, GpuTrack, "GPU" );
+		writeTrackName( file, FrameTrack, "Frames" );
+
+		for ( auto & track : m_cpuTracks )
+		{
+			writeTrackName( file, track.second, "CPU " + std::to_string( track.second - FrameTrack ) );
+		}
+
+		auto first = true;
+
+		for ( auto & event : m_events )
+		{
+			file << ( first ? "" : ",\n" );
+			file << "{\"name\":";
+			writeString( file, event.name );
+			// Chrome trace timestamps are in microseconds.
+			file << ",\"cat\":\"" << ( event.track == GpuTrack ? "gpu" : "cpu" ) << "\""
+				<< ",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.track
+				<< ",\"ts\":" << double( event.begin ) / 1000.0
+				<< ",\"dur\":" << double( event.duration ) / 1000.0
+				<< "}";
+			first = false;
+		}
+
+		file << "\n]}\n";
+		m_events.clear();
+	}
+}
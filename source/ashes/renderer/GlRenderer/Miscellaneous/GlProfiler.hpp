@@ -0,0 +1,141 @@
+/*
+This file belongs to Ashes.
+See LICENSE file in root folder
+*/
+#pragma once
+
+#include "renderer/GlRenderer/GlRendererPrerequisites.hpp"
+
+#include <chrono>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace ashes::gl
+{
+	/**
+	*\brief
+	*	Device wide frame profiler, writing Chrome trace (and Perfetto) JSON files.
+	*\remarks
+	*	Enabled through the ASHES_GL_PROFILE environment variable, which holds the
+	*	output files prefix ("1" selects the default one), a file being written
+	*	every ASHES_GL_PROFILE_FRAMES presented frames (100 by default), and at
+	*	device destruction.
+	*	The debug labels and markers regions are measured on the GPU, with GL_TIMESTAMP
+	*	queries which are resolved asynchronously, without stalling the pipeline.
+	*	CPU side timings are recorded for command buffers recording, submits
+	*	replay, pipelines creation, and memory mapping.
+	*/
+	class Profiler
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		/**
+		*\brief
+		*	Records the CPU time spent in the enclosing scope.
+		*/
+		class CpuScope
+		{
+		public:
+			CpuScope( CpuScope const & ) = delete;
+			CpuScope & operator=( CpuScope const & ) = delete;
+			/**
+			*\param[in] profiler
+			*	The profiler, the scope does nothing if it is null.
+			*\param[in] name
+			*	The event name, must outlive the scope.
+			*/
+			CpuScope( Profiler * profiler
+				, char const * name );
+			~CpuScope();
+
+		private:
+			Profiler * m_profiler;
+			char const * m_name;
+			Clock::time_point m_begin;
+		};
+
+	public:
+		explicit Profiler( VkDevice device );
+		~Profiler();
+		/**
+		*\return
+		*	\p true if the profiling is requested through the environment.
+		*/
+		static bool isRequested();
+		/**
+		*\brief
+		*	Opens a GPU region, in the submitted commands.
+		*/
+		void beginGpuRegion( ContextLock const & context
+			, std::string name );
+		/**
+		*\brief
+		*	Closes the last opened GPU region.
+		*/
+		void endGpuRegion( ContextLock const & context );
+		/**
+		*\brief
+		*	Reads back the results of the completed GPU regions, without waiting for the others.
+		*/
+		void resolve( ContextLock const & context );
+		/**
+		*\brief
+		*	Records a CPU event, on the calling thread's track.
+		*/
+		void addCpuEvent( std::string name
+			, Clock::time_point begin
+			, Clock::time_point end );
+		/**
+		*\brief
+		*	Ends the current frame, and writes the trace file when enough frames have been recorded.
+		*/
+		void endFrame( ContextLock const & context );
+
+	private:
+		struct Event
+		{
+			std::string name;
+			uint32_t track;
+			// Nanoseconds, since the profiler creation.
+			int64_t begin;
+			int64_t duration;
+		};
+
+		struct GpuRegion
+		{
+			std::string name;
+			GLuint begin;
+			GLuint end;
+		};
+
+		GLuint doGetQuery( ContextLock const & context );
+		void doResolve( ContextLock const & context
+			, bool wait );
+		uint32_t doGetCpuTrack();
+		int64_t doGetTime( Clock::time_point value )const;
+		void doWrite();
+
+	private:
+		VkDevice m_device;
+		std::string m_prefix;
+		uint32_t m_framesPerFile;
+		Clock::time_point m_epoch;
+		// GPU time at m_epoch, to bring GPU timestamps in the CPU timeline.
+		Optional< int64_t > m_gpuEpoch;
+		std::mutex m_mutex;
+		std::vector< GLuint > m_queries;
+		std::vector< GLuint > m_freeQueries;
+		std::vector< GpuRegion > m_openRegions;
+		// Closed regions, in the order they have been submitted.
+		std::deque< GpuRegion > m_pendingRegions;
+		std::vector< Event > m_events;
+		std::map< std::thread::id, uint32_t > m_cpuTracks;
+		uint32_t m_frame{ 0u };
+		Clock::time_point m_frameBegin;
+		uint32_t m_fileIndex{ 0u };
+	};
+	using ProfilerPtr = std::unique_ptr< Profiler >;
+}
@@ -0,0 +1,1192 @@
+/*
+This file belongs to Ashes.
+See LICENSE file in root folder
+*/
+#include "Miscellaneous/GlReplay.hpp"
+
+#include "Command/GlQueue.hpp"
+#include "Command/Commands/GlBindPipelineCommand.hpp"
+#include "Core/GlContextState.hpp"
+#include "Core/GlDevice.hpp"
+#include "Miscellaneous/GlCallLogger.hpp"
+#include "Miscellaneous/GlFramebufferCache.hpp"
+
+#include "ashesgl_api.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+
+namespace ashes::gl
+{
+	namespace
+	{
+		using Clock = std::chrono::steady_clock;
+
+		GLenum constexpr GL_UNPACK_ALIGNMENT = 0x0CF5;
+		GLenum constexpr GL_PIXEL_UNPACK_BUFFER_BINDING = 0x88EF;
+		GLenum constexpr GL_COPY_READ_BUFFER_BINDING = 0x8F36;
+		GLenum constexpr GL_COPY_WRITE_BUFFER_BINDING = 0x8F37;
+
+		double getMilliseconds( Clock::time_point begin
+			, Clock::time_point end )
+		{
+			return std::chrono::duration< double, std::milli >( end - begin ).count();
+		}
+
+		template< typename ValueT >
+		bool read( uint8_t const *& data
+			, uint8_t const * end
+			, ValueT & value )
+		{
+			if ( size_t( end - data ) < sizeof( ValueT ) )
+			{
+				return false;
+			}
+
+			std::memcpy( &value, data, sizeof( ValueT ) );
+			data += sizeof( ValueT );
+			return true;
+		}
+
+		GLenum getBindingQuery( GlTextureType target )
+		{
+			switch ( target )
+			{
+			case GL_TEXTURE_1D:
+				return 0x8068;
+			case GL_TEXTURE_3D:
+				return 0x806A;
+			case GL_TEXTURE_1D_ARRAY:
+				return 0x8C1C;
+			case GL_TEXTURE_2D_ARRAY:
+				return 0x8C1D;
+			case GL_TEXTURE_CUBE:
+				return 0x8514;
+			case GL_TEXTURE_CUBE_ARRAY:
+				return 0x900A;
+			default:
+				return 0x8069;
+			}
+		}
+	}
+
+	Replayer::Replayer( VkDevice device )
+		: m_device{ device }
+		, m_stack{ device }
+	{
+	}
+
+	Replayer::~Replayer()
+	{
+		auto context = get( m_device )->getContext();
+
+		for ( auto & fbo : m_framebuffers )
+		{
+			if ( fbo != GL_INVALID_INDEX )
+			{
+				glLogCall( context
+					, glDeleteFramebuffers
+					, 1
+					, &fbo );
+			}
+		}
+
+		if ( !m_vertexArrays.empty() )
+		{
+			glLogCall( context
+				, glDeleteVertexArrays
+				, GLsizei( m_vertexArrays.size() )
+				, m_vertexArrays.data() );
+		}
+
+		if ( !m_pipelines.empty() )
+		{
+			glLogCall( context
+				, glDeleteProgramPipelines
+				, GLsizei( m_pipelines.size() )
+				, m_pipelines.data() );
+		}
+
+		for ( auto program : m_programs )
+		{
+			glLogCall( context
+				, glDeleteProgram
+				, program );
+		}
+
+		if ( !m_samplers.empty() )
+		{
+			glLogCall( context
+				, glDeleteSamplers
+				, GLsizei( m_samplers.size() )
+				, m_samplers.data() );
+		}
+
+		// The views are deleted with their textures, they are in the same list.
+		if ( !m_textures.empty() )
+		{
+			for ( auto texture : m_textures )
+			{
+				get( m_device )->getFramebufferCache().releaseTexture( context, texture );
+			}
+
+			glLogCall( context
+				, glDeleteTextures
+				, GLsizei( m_textures.size() )
+				, m_textures.data() );
+		}
+
+		if ( !m_buffers.empty() )
+		{
+			glLogCall( context
+				, glDeleteBuffers
+				, GLsizei( m_buffers.size() )
+				, m_buffers.data() );
+		}
+	}
+
+	bool Replayer::load( ContextLock const & context
+		, std::string const & fileName )
+	{
+		std::ifstream file{ fileName, std::ios::binary };
+
+		if ( !file )
+		{
+			std::cerr << "Couldn't open " << fileName << std::endl;
+			return false;
+		}
+
+		capture::FileHeader header{};
+
+		if ( !file.read( reinterpret_cast< char * >( &header ), sizeof( header ) )
+			|| std::memcmp( header.magic, capture::Magic, sizeof( header.magic ) ) != 0 )
+		{
+			std::cerr << fileName << " is not a GL capture file" << std::endl;
+			return false;
+		}
+
+		if ( header.version != capture::Version
+			|| header.pointerSize != sizeof( void * ) )
+		{
+			std::cerr << "Unsupported capture version " << header.version
+				<< " (" << header.pointerSize * 8u << " bits)" << std::endl;
+			return false;
+		}
+
+		auto begin = Clock::now();
+		capture::RecordHeader record{};
+		ByteArray data;
+
+		while ( file.read( reinterpret_cast< char * >( &record ), sizeof( record ) ) )
+		{
+			data.resize( size_t( record.size ) );
+
+			if ( !file.read( reinterpret_cast< char * >( data.data() ), std::streamsize( data.size() ) ) )
+			{
+				std::cerr << "Truncated record, the capture is incomplete" << std::endl;
+				break;
+			}
+
+			uint8_t const * ptr = data.data();
+			uint8_t const * end = data.data() + data.size();
+
+			switch ( record.type )
+			{
+			case capture::RecordType::eBuffer:
+				{
+					capture::BufferDesc desc{};
+
+					if ( read( ptr, end, desc ) )
+					{
+						doCreateBuffer( context, record.id, desc );
+					}
+				}
+				break;
+			case capture::RecordType::eTexture:
+				{
+					capture::TextureDesc desc{};
+
+					if ( read( ptr, end, desc ) )
+					{
+						doCreateTexture( context, record.id, desc );
+					}
+				}
+				break;
+			case capture::RecordType::eTextureView:
+				{
+					capture::TextureViewDesc desc{};
+
+					if ( read( ptr, end, desc ) )
+					{
+						doCreateTextureView( context, record.id, desc );
+					}
+				}
+				break;
+			case capture::RecordType::eTextureBuffer:
+				{
+					capture::TextureBufferDesc desc{};
+
+					if ( read( ptr, end, desc ) )
+					{
+						doCreateTextureBuffer( context, record.id, desc );
+					}
+				}
+				break;
+			case capture::RecordType::eSampler:
+				{
+					capture::SamplerDesc desc{};
+
+					if ( read( ptr, end, desc ) )
+					{
+						doCreateSampler( context, record.id, desc );
+					}
+				}
+				break;
+			case capture::RecordType::eProgram:
+				doCreateProgram( context, record.id, ptr, data.size() );
+				break;
+			case capture::RecordType::ePipeline:
+				doCreatePipeline( context, record.id, ptr, data.size() );
+				break;
+			case capture::RecordType::eVertexArray:
+				doCreateVertexArray( context, record.id, ptr, data.size() );
+				break;
+			case capture::RecordType::eFramebuffer:
+				doCreateFramebuffer( context, record.id, ptr, data.size() );
+				break;
+			case capture::RecordType::eContextState:
+				if ( record.id )
+				{
+					if ( m_contextStates.size() < record.id )
+					{
+						m_contextStates.resize( record.id );
+					}
+
+					m_contextStates[record.id - 1u] = deserialiseContextState( ptr, data.size() );
+				}
+				break;
+			case capture::RecordType::eBufferContent:
+				m_contents.push_back( { record.type, doGetName( ObjectNamespace::eBuffer, record.id ), data } );
+				break;
+			case capture::RecordType::eTextureContent:
+				m_contents.push_back( { record.type, doGetName( ObjectNamespace::eTexture, record.id ), data } );
+				break;
+			case capture::RecordType::eBufferData:
+			case capture::RecordType::eBufferReadback:
+				m_timeline.push_back( { record.type, doGetName( ObjectNamespace::eBuffer, record.id ), data } );
+				break;
+			case capture::RecordType::eTextureData:
+				m_timeline.push_back( { record.type, doGetName( ObjectNamespace::eTexture, record.id ), data } );
+				break;
+			case capture::RecordType::eCommands:
+				{
+					UInt32Array words( data.size() / sizeof( uint32_t ) );
+					std::memcpy( words.data(), data.data(), words.size() * sizeof( uint32_t ) );
+					doRemapCommands( words );
+					m_timeline.push_back( { record.type, GLuint( m_commands.size() ), {} } );
+					m_commands.push_back( std::move( words ) );
+				}
+				break;
+			case capture::RecordType::eFrame:
+				m_timeline.push_back( { record.type, record.id, {} } );
+				m_skipped += record.id;
+				++m_frames;
+				break;
+			default:
+				std::cerr << "Unknown record type " << uint32_t( record.type ) << std::endl;
+				break;
+			}
+		}
+
+		glLogEmptyCall( context
+			, glFinish );
+		m_setupMs = getMilliseconds( begin, Clock::now() );
+		return true;
+	}
+
+	void Replayer::run( ContextLock const & context
+		, uint32_t loops
+		, capture::ReplayStats & stats )
+	{
+		auto begin = Clock::now();
+		std::vector< double > frameTimes;
+		loops = std::max( 1u, loops );
+
+		for ( uint32_t loop = 0u; loop < loops; ++loop )
+		{
+			for ( auto & content : m_contents )
+			{
+				if ( content.type == capture::RecordType::eBufferContent )
+				{
+					doUploadBuffer( context, content.name, content.data.data(), content.data.size() );
+				}
+				else
+				{
+					doUploadTexture( context, content.name, content.data.data(), content.data.size() );
+				}
+			}
+
+			glLogEmptyCall( context
+				, glFinish );
+			auto frameBegin = Clock::now();
+
+			for ( auto & record : m_timeline )
+			{
+				switch ( record.type )
+				{
+				case capture::RecordType::eCommands:
+					doApplyCommands( context, m_commands[record.name] );
+					break;
+				case capture::RecordType::eBufferData:
+					doUploadBuffer( context, record.name, record.data.data(), record.data.size() );
+					break;
+				case capture::RecordType::eBufferReadback:
+					doReadBuffer( context, record.name, record.data.data(), record.data.size() );
+					break;
+				case capture::RecordType::eTextureData:
+					doUploadTexture( context, record.name, record.data.data(), record.data.size() );
+					break;
+				case capture::RecordType::eFrame:
+					{
+						glLogEmptyCall( context
+							, glFinish );
+						auto frameEnd = Clock::now();
+
+						// The first loop warms the driver's caches up, it is not representative.
+						if ( loop > 0u || loops == 1u )
+						{
+							frameTimes.push_back( getMilliseconds( frameBegin, frameEnd ) );
+						}
+
+						frameBegin = frameEnd;
+					}
+					break;
+				default:
+					break;
+				}
+			}
+		}
+
+		stats = capture::ReplayStats{};
+		stats.frames = m_frames;
+		stats.loops = loops;
+		stats.setupMs = m_setupMs;
+		stats.totalMs = getMilliseconds( begin, Clock::now() );
+		stats.unmappedNames = m_unmapped;
+		stats.skippedCommands = m_skipped;
+
+		if ( !frameTimes.empty() )
+		{
+			std::sort( frameTimes.begin(), frameTimes.end() );
+			stats.minFrameMs = frameTimes.front();
+			stats.maxFrameMs = frameTimes.back();
+			stats.medianFrameMs = frameTimes[frameTimes.size() / 2u];
+			stats.avgFrameMs = std::accumulate( frameTimes.begin(), frameTimes.end(), 0.0 ) / double( frameTimes.size() );
+		}
+	}
+
+	GLuint Replayer::doGetName( ObjectNamespace space
+		, uint32_t name )
+	{
+		if ( !name )
+		{
+			return 0u;
+		}
+
+		auto & names = m_names[size_t( space )];
+		auto it = names.find( name );
+
+		if ( it == names.end() )
+		{
+			++m_unmapped;
+			return 0u;
+		}
+
+		return it->second;
+	}
+
+	void Replayer::doSetName( ObjectNamespace space
+		, uint32_t name
+		, GLuint value )
+	{
+		m_names[size_t( space )][name] = value;
+	}
+
+	void Replayer::doRemap( Command & cmd )
+	{
+		switch ( cmd.op.type )
+		{
+		case OpType::eBindContextState:
+			{
+				auto & bind = map< OpType::eBindContextState >( cmd );
+				auto id = size_t( reinterpret_cast< uintptr_t >( bind.state ) );
+				bind.stack = &m_stack;
+				bind.state = ( id && id <= m_contextStates.size() )
+					? m_contextStates[id - 1u].get()
+					: nullptr;
+			}
+			break;
+		case OpType::eInitFramebuffer:
+		case OpType::eCleanupFramebuffer:
+			{
+				// Both commands have the same layout.
+				auto & init = map< OpType::eInitFramebuffer >( cmd );
+				auto slot = size_t( reinterpret_cast< uintptr_t >( init.fbo ) );
+
+				if ( m_framebuffers.size() < slot )
+				{
+					m_framebuffers.resize( slot, GL_INVALID_INDEX );
+				}
+
+				init.fbo = &m_framebuffers[slot - 1u];
+			}
+			break;
+		case OpType::eBindCachedFramebuffer:
+			{
+				// The captured cache pointer is meaningless here, the replaying device's cache is used.
+				auto & bind = map< OpType::eBindCachedFramebuffer >( cmd );
+				bind.cache = &get( m_device )->getFramebufferCache();
+				bind.attach.object = doGetName( ObjectNamespace::eTexture, bind.attach.object );
+			}
+			break;
+		default:
+			forEachObjectName( cmd
+				, [this]( ObjectNamespace space, uint32_t & name )
+				{
+					name = doGetName( space, name );
+				} );
+			break;
+		}
+	}
+
+	void Replayer::doRemapCommands( UInt32Array & words )
+	{
+		auto it = words.begin();
+		Command * pCmd = nullptr;
+
+		while ( map( it, words.end(), pCmd ) )
+		{
+			it += pCmd->op.size;
+			doRemap( *pCmd );
+		}
+	}
+
+	void Replayer::doCreateBuffer( ContextLock const & context
+		, uint32_t name
+		, capture::BufferDesc const & desc )
+	{
+		GLuint buffer{};
+		glLogCall( context
+			, glGenBuffers
+			, 1
+			, &buffer );
+		glLogCall( context
+			, glBindBuffer
+			, GL_BUFFER_TARGET_COPY_WRITE
+			, buffer );
+		glLogCall( context
+			, glBufferData
+			, GL_BUFFER_TARGET_COPY_WRITE
+			, GLsizeiptr( desc.size )
+			, nullptr
+			, GlBufferDataUsageFlags( desc.usage ) );
+		glLogCall( context
+			, glBindBuffer
+			, GL_BUFFER_TARGET_COPY_WRITE
+			, 0u );
+		m_buffers.push_back( buffer );
+		doSetName( ObjectNamespace::eBuffer, name, buffer );
+	}
+
+	void Replayer::doCreateTexture( ContextLock const & context
+		, uint32_t name
+		, capture::TextureDesc const & desc )
+	{
+		GLuint texture{};
+		auto target = GlTextureType( desc.target );
+		auto levels = GLsizei( desc.levels );
+		glLogCall( context
+			, glGenTextures
+			, 1
+			, &texture );
+		glLogCall( context
+			, glBindTexture
+			, target
+			, texture );
+
+		switch ( target )
+		{
+		case GL_TEXTURE_1D:
+			glLogCall( context
+				, glTexStorage1D
+				, target
+				, levels
+				, desc.internal
+				, GLsizei( desc.width ) );
+			break;
+		case GL_TEXTURE_2D:
+		case GL_TEXTURE_CUBE:
+			glLogCall( context
+				, glTexStorage2D
+				, target
+				, levels
+				, desc.internal
+				, GLsizei( desc.width )
+				, GLsizei( desc.height ) );
+			break;
+		case GL_TEXTURE_1D_ARRAY:
+			glLogCall( context
+				, glTexStorage2D
+				, target
+				, levels
+				, desc.internal
+				, GLsizei( desc.width )
+				, GLsizei( desc.layers ) );
+			break;
+		case GL_TEXTURE_3D:
+			glLogCall( context
+				, glTexStorage3D
+				, target
+				, levels
+				, desc.internal
+				, GLsizei( desc.width )
+				, GLsizei( desc.height )
+				, GLsizei( desc.depth ) );
+			break;
+		case GL_TEXTURE_2D_ARRAY:
+		case GL_TEXTURE_CUBE_ARRAY:
+			glLogCall( context
+				, glTexStorage3D
+				, target
+				, levels
+				, desc.internal
+				, GLsizei( desc.width )
+				, GLsizei( desc.height )
+				, GLsizei( desc.layers ) );
+			break;
+		case GL_TEXTURE_2D_MULTISAMPLE:
+			glLogCall( context
+				, glTexStorage2DMultisample
+				, target
+				, GLsizei( desc.samples )
+				, desc.internal
+				, GLsizei( desc.width )
+				, GLsizei( desc.height )
+				, GLboolean( GL_TRUE ) );
+			break;
+		case GL_TEXTURE_2D_MULTISAMPLE_ARRAY:
+			glLogCall( context
+				, glTexStorage3DMultisample
+				, target
+				, GLsizei( desc.samples )
+				, desc.internal
+				, GLsizei( desc.width )
+				, GLsizei( desc.height )
+				, GLsizei( desc.layers )
+				, GLboolean( GL_TRUE ) );
+			break;
+		default:
+			break;
+		}
+
+		glLogCall( context
+			, glBindTexture
+			, target
+			, 0u );
+		m_textures.push_back( texture );
+		m_textureInfos[texture] = { target, desc.internal };
+		doSetName( ObjectNamespace::eTexture, name, texture );
+	}
+
+	void Replayer::doCreateTextureView( ContextLock const & context
+		, uint32_t name
+		, capture::TextureViewDesc const & desc )
+	{
+		GLuint texture{};
+		glLogCall( context
+			, glGenTextures
+			, 1
+			, &texture );
+		glLogCall( context
+			, glTextureView
+			, texture
+			, gl4::GlTextureViewType( desc.target )
+			, doGetName( ObjectNamespace::eTexture, desc.texture )
+			, desc.internal
+			, desc.baseLevel
+			, desc.levelCount
+			, desc.baseLayer
+			, desc.layerCount );
+
+		if ( std::any_of( std::begin( desc.swizzle )
+			, std::end( desc.swizzle )
+			, []( int32_t value )
+			{
+				return value != 0;
+			} ) )
+		{
+			glLogCall( context
+				, glBindTexture
+				, GlTextureType( desc.target )
+				, texture );
+
+			for ( uint32_t i = 0u; i < 4u; ++i )
+			{
+				if ( desc.swizzle[i] )
+				{
+					glLogCall( context
+						, glTexParameteri
+						, GlTextureType( desc.target )
+						, GL_SWIZZLE_R + i
+						, desc.swizzle[i] );
+				}
+			}
+
+			glLogCall( context
+				, glBindTexture
+				, GlTextureType( desc.target )
+				, 0u );
+		}
+
+		m_textures.push_back( texture );
+		doSetName( ObjectNamespace::eTexture, name, texture );
+	}
+
+	void Replayer::doCreateTextureBuffer( ContextLock const & context
+		, uint32_t name
+		, capture::TextureBufferDesc const & desc )
+	{
+		GLuint texture{};
+		glLogCall( context
+			, glGenTextures
+			, 1
+			, &texture );
+		glLogCall( context
+			, glBindTexture
+			, GL_TEXTURE_BUFFER
+			, texture );
+
+		if ( desc.range )
+		{
+			glLogCall( context
+				, glTexBufferRange
+				, GL_TEXTURE_BUFFER
+				, desc.internal
+				, doGetName( ObjectNamespace::eBuffer, desc.buffer )
+				, GLintptr( desc.offset )
+				, GLsizeiptr( desc.range ) );
+		}
+		else
+		{
+			glLogCall( context
+				, glTexBuffer
+				, GL_TEXTURE_BUFFER
+				, desc.internal
+				, doGetName( ObjectNamespace::eBuffer, desc.buffer ) );
+		}
+
+		glLogCall( context
+			, glBindTexture
+			, GL_TEXTURE_BUFFER
+			, 0u );
+		m_textures.push_back( texture );
+		doSetName( ObjectNamespace::eTexture, name, texture );
+	}
+
+	void Replayer::doCreateSampler( ContextLock const & context
+		, uint32_t name
+		, capture::SamplerDesc const & desc )
+	{
+		GLuint sampler{};
+		glLogCall( context, glGenSamplers, 1, &sampler );
+		glLogCall( context, glSamplerParameteri, sampler, GL_SAMPLER_PARAMETER_MIN_FILTER, desc.minFilter );
+		glLogCall( context, glSamplerParameteri, sampler, GL_SAMPLER_PARAMETER_MAG_FILTER, desc.magFilter );
+		glLogCall( context, glSamplerParameteri, sampler, GL_SAMPLER_PARAMETER_WRAP_S, desc.wrapS );
+		glLogCall( context, glSamplerParameteri, sampler, GL_SAMPLER_PARAMETER_WRAP_T, desc.wrapT );
+		glLogCall( context, glSamplerParameteri, sampler, GL_SAMPLER_PARAMETER_WRAP_R, desc.wrapR );
+		glLogCall( context, glSamplerParameteri, sampler, GL_SAMPLER_PARAMETER_COMPARE_MODE, desc.compareMode );
+		glLogCall( context, glSamplerParameteri, sampler, GL_SAMPLER_PARAMETER_COMPARE_FUNC, desc.compareFunc );
+		glLogCall( context, glSamplerParameterf, sampler, GL_SAMPLER_PARAMETER_MIN_LOD, desc.minLod );
+		glLogCall( context, glSamplerParameterf, sampler, GL_SAMPLER_PARAMETER_MAX_LOD, desc.maxLod );
+		glLogCall( context, glSamplerParameterf, sampler, GL_SAMPLER_PARAMETER_LOD_BIAS, desc.lodBias );
+		glLogCall( context, glSamplerParameterfv, sampler, GL_SAMPLER_PARAMETER_BORDER_COLOR, desc.borderColour );
+
+		if ( desc.maxAnisotropy > 0.0f )
+		{
+			glLogCall( context, glSamplerParameterf, sampler, GL_SAMPLER_PARAMETER_MAX_ANISOTROPY, desc.maxAnisotropy );
+		}
+
+		m_samplers.push_back( sampler );
+		doSetName( ObjectNamespace::eSampler, name, sampler );
+	}
+
+	bool Replayer::doCreateProgram( ContextLock const & context
+		, uint32_t name
+		, uint8_t const * data
+		, size_t size )
+	{
+		auto end = data + size;
+		capture::ProgramDesc desc{};
+
+		if ( !read( data, end, desc ) )
+		{
+			return false;
+		}
+
+		std::vector< std::pair< GLenum, std::string > > shaders;
+
+		for ( uint32_t i = 0u; i < desc.shaderCount; ++i )
+		{
+			capture::ShaderDesc shader{};
+
+			if ( !read( data, end, shader )
+				|| size_t( end - data ) < shader.length )
+			{
+				return false;
+			}
+
+			shaders.emplace_back( GLenum( shader.stage )
+				, std::string( reinterpret_cast< char const * >( data ), shader.length ) );
+			data += shader.length;
+		}
+
+		GLuint program{};
+
+		if ( desc.separable )
+		{
+			if ( shaders.empty() )
+			{
+				return false;
+			}
+
+			char const * source = shaders.front().second.c_str();
+			program = glLogNonVoidCall( context
+				, glCreateShaderProgramv
+				, shaders.front().first
+				, 1
+				, &source );
+		}
+		else
+		{
+			program = glLogNonVoidEmptyCall( context
+				, glCreateProgram );
+			std::vector< GLuint > names;
+
+			for ( auto & shader : shaders )
+			{
+				auto shaderName = glLogNonVoidCall( context
+					, glCreateShader
+					, shader.first );
+				char const * source = shader.second.c_str();
+				auto length = GLint( shader.second.size() );
+				glLogCall( context
+					, glShaderSource
+					, shaderName
+					, 1
+					, &source
+					, &length );
+				glLogCall( context
+					, glCompileShader
+					, shaderName );
+				glLogCall( context
+					, glAttachShader
+					, program
+					, shaderName );
+				names.push_back( shaderName );
+			}
+
+			glLogCall( context
+				, glLinkProgram
+				, program );
+
+			for ( auto shaderName : names )
+			{
+				glLogCall( context
+					, glDeleteShader
+					, shaderName );
+			}
+		}
+
+		m_programs.push_back( program );
+		doSetName( ObjectNamespace::eProgram, name, program );
+		return true;
+	}
+
+	void Replayer::doCreatePipeline( ContextLock const & context
+		, uint32_t name
+		, uint8_t const * data
+		, size_t size )
+	{
+		auto end = data + size;
+		capture::PipelineDesc desc{};
+
+		if ( !read( data, end, desc ) )
+		{
+			return;
+		}
+
+		GLuint pipeline{};
+		glLogCall( context
+			, glGenProgramPipelines
+			, 1
+			, &pipeline );
+
+		for ( uint32_t i = 0u; i < desc.stageCount; ++i )
+		{
+			capture::PipelineStageDesc stage{};
+
+			if ( read( data, end, stage ) )
+			{
+				glLogCall( context
+					, glUseProgramStages
+					, pipeline
+					, GLbitfield( stage.stages )
+					, doGetName( ObjectNamespace::eProgram, stage.program ) );
+			}
+		}
+
+		m_pipelines.push_back( pipeline );
+		doSetName( ObjectNamespace::ePipeline, name, pipeline );
+	}
+
+	void Replayer::doCreateVertexArray( ContextLock const & context
+		, uint32_t name
+		, uint8_t const * data
+		, size_t size )
+	{
+		auto end = data + size;
+		capture::VertexArrayDesc desc{};
+
+		if ( !read( data, end, desc ) )
+		{
+			return;
+		}
+
+		GLuint vao{};
+		glLogCall( context
+			, glGenVertexArrays
+			, 1
+			, &vao );
+		glLogCall( context
+			, glBindVertexArray
+			, vao );
+
+		for ( uint32_t i = 0u; i < desc.attributeCount; ++i )
+		{
+			capture::VertexAttribDesc attribute{};
+
+			if ( !read( data, end, attribute ) )
+			{
+				break;
+			}
+
+			glLogCall( context
+				, glBindBuffer
+				, GL_BUFFER_TARGET_ARRAY
+				, doGetName( ObjectNamespace::eBuffer, attribute.buffer ) );
+			glLogCall( context
+				, glEnableVertexAttribArray
+				, attribute.location );
+
+			if ( attribute.integer )
+			{
+				glLogCall( context
+					, glVertexAttribIPointer
+					, attribute.location
+					, attribute.count
+					, attribute.type
+					, attribute.stride
+					, getBufferOffset( intptr_t( attribute.offset ) ) );
+			}
+			else
+			{
+				glLogCall( context
+					, glVertexAttribPointer
+					, attribute.location
+					, attribute.count
+					, attribute.type
+					, GLboolean( attribute.normalised ? GL_TRUE : GL_FALSE )
+					, attribute.stride
+					, getBufferOffset( intptr_t( attribute.offset ) ) );
+			}
+
+			if ( attribute.divisor )
+			{
+				glLogCall( context
+					, glVertexAttribDivisor
+					, attribute.location
+					, attribute.divisor );
+			}
+		}
+
+		glLogCall( context
+			, glBindBuffer
+			, GL_BUFFER_TARGET_ELEMENT_ARRAY
+			, doGetName( ObjectNamespace::eBuffer, desc.ibo ) );
+		glLogCall( context
+			, glBindVertexArray
+			, 0u );
+		glLogCall( context
+			, glBindBuffer
+			, GL_BUFFER_TARGET_ELEMENT_ARRAY
+			, 0u );
+		glLogCall( context
+			, glBindBuffer
+			, GL_BUFFER_TARGET_ARRAY
+			, 0u );
+		m_vertexArrays.push_back( vao );
+		doSetName( ObjectNamespace::eVertexArray, name, vao );
+	}
+
+	void Replayer::doCreateFramebuffer( ContextLock const & context
+		, uint32_t slot
+		, uint8_t const * data
+		, size_t size )
+	{
+		auto end = data + size;
+		capture::FramebufferDesc desc{};
+
+		if ( !slot
+			|| !read( data, end, desc ) )
+		{
+			return;
+		}
+
+		if ( m_framebuffers.size() < slot )
+		{
+			m_framebuffers.resize( slot, GL_INVALID_INDEX );
+		}
+
+		if ( !desc.created )
+		{
+			return;
+		}
+
+		UInt32Array words( std::min( size_t( desc.wordCount ), size_t( end - data ) / sizeof( uint32_t ) ) );
+		std::memcpy( words.data(), data, words.size() * sizeof( uint32_t ) );
+		doRemapCommands( words );
+		auto & fbo = m_framebuffers[slot - 1u];
+		glLogCall( context
+			, glGenFramebuffers
+			, 1
+			, &fbo );
+		glLogCall( context
+			, glBindFramebuffer
+			, GL_FRAMEBUFFER
+			, fbo );
+		doApplyCommands( context, words );
+		glLogCall( context
+			, glBindFramebuffer
+			, GL_FRAMEBUFFER
+			, 0u );
+	}
+
+	void Replayer::doUploadBuffer( ContextLock const & context
+		, GLuint name
+		, uint8_t const * data
+		, size_t size )
+	{
+		auto end = data + size;
+		capture::BufferRange range{};
+
+		if ( !name
+			|| !read( data, end, range )
+			|| size_t( end - data ) < range.size )
+		{
+			return;
+		}
+
+		GLint previous = 0;
+		glLogCall( context
+			, glGetIntegerv
+			, GL_COPY_WRITE_BUFFER_BINDING
+			, &previous );
+		glLogCall( context
+			, glBindBuffer
+			, GL_BUFFER_TARGET_COPY_WRITE
+			, name );
+		glLogCall( context
+			, glBufferSubData
+			, GL_BUFFER_TARGET_COPY_WRITE
+			, GLintptr( range.offset )
+			, GLsizeiptr( range.size )
+			, data );
+		glLogCall( context
+			, glBindBuffer
+			, GL_BUFFER_TARGET_COPY_WRITE
+			, GLuint( previous ) );
+	}
+
+	void Replayer::doReadBuffer( ContextLock const & context
+		, GLuint name
+		, uint8_t const * data
+		, size_t size )
+	{
+		auto end = data + size;
+		capture::BufferRange range{};
+
+		if ( !name
+			|| !read( data, end, range ) )
+		{
+			return;
+		}
+
+		m_scratch.resize( size_t( range.size ) );
+		GLint previous = 0;
+		glLogCall( context
+			, glGetIntegerv
+			, GL_COPY_READ_BUFFER_BINDING
+			, &previous );
+		glLogCall( context
+			, glBindBuffer
+			, GL_BUFFER_TARGET_COPY_READ
+			, name );
+		glLogCall( context
+			, glGetBufferSubData
+			, GL_BUFFER_TARGET_COPY_READ
+			, GLintptr( range.offset )
+			, GLsizeiptr( range.size )
+			, m_scratch.data() );
+		glLogCall( context
+			, glBindBuffer
+			, GL_BUFFER_TARGET_COPY_READ
+			, GLuint( previous ) );
+	}
+
+	void Replayer::doUploadTexture( ContextLock const & context
+		, GLuint name
+		, uint8_t const * data
+		, size_t size )
+	{
+		auto end = data + size;
+		capture::TextureContentDesc content{};
+		auto it = m_textureInfos.find( name );
+
+		if ( it == m_textureInfos.end()
+			|| !read( data, end, content )
+			|| size_t( end - data ) < content.size )
+		{
+			return;
+		}
+
+		auto bindTarget = it->second.target;
+		auto target = GlTextureType( content.target );
+		GLint previousTexture = 0;
+		GLint previousUnpack = 0;
+		GLint previousAlign = 0;
+		glLogCall( context
+			, glGetIntegerv
+			, getBindingQuery( bindTarget )
+			, &previousTexture );
+		glLogCall( context
+			, glGetIntegerv
+			, GL_PIXEL_UNPACK_BUFFER_BINDING
+			, &previousUnpack );
+		glLogCall( context
+			, glGetIntegerv
+			, GL_UNPACK_ALIGNMENT
+			, &previousAlign );
+		glLogCall( context
+			, glBindTexture
+			, bindTarget
+			, name );
+		glLogCall( context
+			, glBindBuffer
+			, GL_BUFFER_TARGET_PIXEL_UNPACK
+			, 0u );
+		glLogCall( context
+			, glPixelStorei
+			, GL_UNPACK_ALIGNMENT
+			, 1 );
+		auto level = GLint( content.level );
+		auto width = GLsizei( content.width );
+		auto height = GLsizei( content.height );
+		auto depth = GLsizei( content.depth );
+
+		switch ( bindTarget )
+		{
+		case GL_TEXTURE_1D:
+			if ( content.compressed )
+			{
+				glLogCall( context, glCompressedTexSubImage1D, target, level, 0, width, it->second.internal, GLsizei( content.size ), data );
+			}
+			else
+			{
+				glLogCall( context, glTexSubImage1D, target, level, 0, width, content.format, content.type, data );
+			}
+			break;
+		case GL_TEXTURE_3D:
+		case GL_TEXTURE_2D_ARRAY:
+		case GL_TEXTURE_CUBE_ARRAY:
+			if ( content.compressed )
+			{
+				glLogCall( context, glCompressedTexSubImage3D, target, level, 0, 0, 0, width, height, depth, it->second.internal, GLsizei( content.size ), data );
+			}
+			else
+			{
+				glLogCall( context, glTexSubImage3D, target, level, 0, 0, 0, width, height, depth, content.format, content.type, data );
+			}
+			break;
+		default:
+			if ( content.compressed )
+			{
+				glLogCall( context, glCompressedTexSubImage2D, target, level, 0, 0, width, height, it->second.internal, GLsizei( content.size ), data );
+			}
+			else
+			{
+				glLogCall( context, glTexSubImage2D, target, level, 0, 0, width, height, content.format, content.type, data );
+			}
+			break;
+		}
+
+		glLogCall( context
+			, glPixelStorei
+			, GL_UNPACK_ALIGNMENT
+			, previousAlign );
+		glLogCall( context
+			, glBindBuffer
+			, GL_BUFFER_TARGET_PIXEL_UNPACK
+			, GLuint( previousUnpack ) );
+		glLogCall( context
+			, glBindTexture
+			, bindTarget
+			, GLuint( previousTexture ) );
+	}
+
+	void Replayer::doApplyCommands( ContextLock const & context
+		, UInt32Array const & words )
+	{
+		auto it = words.begin();
+		auto end = words.end();
+		Command const * pCmd = nullptr;
+
+		while ( map( it, end, pCmd ) )
+		{
+			auto & cmd = *pCmd;
+			it += cmd.op.size;
+
+			if ( cmd.op.type == OpType::eBindFramebuffer )
+			{
+				// The framebuffer slot is held in place of the framebuffer handle.
+				auto & bind = map< OpType::eBindFramebuffer >( cmd );
+				auto slot = size_t( uint64_t( bind.fbo ) );
+				auto fbo = ( slot && slot <= m_framebuffers.size() && m_framebuffers[slot - 1u] != GL_INVALID_INDEX )
+					? m_framebuffers[slot - 1u]
+					: 0u;
+				glLogCall( context
+					, glBindFramebuffer
+					, bind.target
+					, fbo );
+			}
+			else if ( cmd.op.type != OpType::eBindContextState
+				|| map< OpType::eBindContextState >( cmd ).state )
+			{
+				applyCommand( context, cmd );
+			}
+		}
+	}
+}
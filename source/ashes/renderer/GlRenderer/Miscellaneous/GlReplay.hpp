@@ -0,0 +1,139 @@
+/*
+This file belongs to Ashes.
+See LICENSE file in root folder
+*/
+#pragma once
+
+#include "renderer/GlRenderer/Command/Commands/GlCommandBase.hpp"
+#include "renderer/GlRenderer/Core/GlContextStateStack.hpp"
+#include "renderer/GlRenderer/Miscellaneous/GlCapture.hpp"
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ashes::gl
+{
+	/**
+	*\brief
+	*	Replays a capture written by Capture, in a loop, and times its frames.
+	*\remarks
+	*	All the objects are created and the command segments remapped at load time,
+	*	their initial contents are restored, untimed, before each loop.
+	*	The capture must come from the same build of the GL renderer.
+	*/
+	class Replayer
+	{
+	public:
+		explicit Replayer( VkDevice device );
+		~Replayer();
+		/**
+		*\brief
+		*	Loads the capture, and creates the objects it describes.
+		*\return
+		*	\p false if the file couldn't be read, or doesn't come from a compatible build.
+		*/
+		bool load( ContextLock const & context
+			, std::string const & fileName );
+		/**
+		*\brief
+		*	Replays the loaded capture \p loops times.
+		*/
+		void run( ContextLock const & context
+			, uint32_t loops
+			, capture::ReplayStats & stats );
+
+	private:
+		struct Record
+		{
+			capture::RecordType type;
+			// The replayed object name, or the command segment index.
+			GLuint name;
+			ByteArray data;
+		};
+
+		struct TextureInfo
+		{
+			GlTextureType target;
+			GLenum internal;
+		};
+
+		GLuint doGetName( ObjectNamespace space
+			, uint32_t name );
+		void doSetName( ObjectNamespace space
+			, uint32_t name
+			, GLuint value );
+		void doRemap( Command & cmd );
+		void doRemapCommands( UInt32Array & words );
+		void doCreateBuffer( ContextLock const & context
+			, uint32_t name
+			, capture::BufferDesc const & desc );
+		void doCreateTexture( ContextLock const & context
+			, uint32_t name
+			, capture::TextureDesc const & desc );
+		void doCreateTextureView( ContextLock const & context
+			, uint32_t name
+			, capture::TextureViewDesc const & desc );
+		void doCreateTextureBuffer( ContextLock const & context
+			, uint32_t name
+			, capture::TextureBufferDesc const & desc );
+		void doCreateSampler( ContextLock const & context
+			, uint32_t name
+			, capture::SamplerDesc const & desc );
+		bool doCreateProgram( ContextLock const & context
+			, uint32_t name
+			, uint8_t const * data
+			, size_t size );
+		void doCreatePipeline( ContextLock const & context
+			, uint32_t name
+			, uint8_t const * data
+			, size_t size );
+		void doCreateVertexArray( ContextLock const & context
+			, uint32_t name
+			, uint8_t const * data
+			, size_t size );
+		void doCreateFramebuffer( ContextLock const & context
+			, uint32_t slot
+			, uint8_t const * data
+			, size_t size );
+		void doUploadBuffer( ContextLock const & context
+			, GLuint name
+			, uint8_t const * data
+			, size_t size );
+		void doReadBuffer( ContextLock const & context
+			, GLuint name
+			, uint8_t const * data
+			, size_t size );
+		void doUploadTexture( ContextLock const & context
+			, GLuint name
+			, uint8_t const * data
+			, size_t size );
+		void doApplyCommands( ContextLock const & context
+			, UInt32Array const & words );
+
+	private:
+		VkDevice m_device;
+		ContextStateStack m_stack;
+		std::map< uint32_t, GLuint > m_names[size_t( ObjectNamespace::eCount )];
+		std::map< GLuint, TextureInfo > m_textureInfos;
+		std::vector< std::unique_ptr< ContextState > > m_contextStates;
+		// Deque, for stable addresses: the framebuffer commands point to the names.
+		std::deque< GLuint > m_framebuffers;
+		std::vector< Record > m_contents;
+		std::vector< Record > m_timeline;
+		std::vector< UInt32Array > m_commands;
+		std::vector< GLuint > m_buffers;
+		std::vector< GLuint > m_textures;
+		std::vector< GLuint > m_samplers;
+		std::vector< GLuint > m_programs;
+		std::vector< GLuint > m_pipelines;
+		std::vector< GLuint > m_vertexArrays;
+		ByteArray m_scratch;
+		uint32_t m_frames{ 0u };
+		uint32_t m_unmapped{ 0u };
+		uint32_t m_skipped{ 0u };
+		double m_setupMs{ 0.0 };
+	};
+}
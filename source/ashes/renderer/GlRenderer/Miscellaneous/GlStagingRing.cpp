@@ -0,0 +1,338 @@
+/*
+This file belongs to Ashes.
+See LICENSE file in root folder
+*/
+#include "Miscellaneous/GlStagingRing.hpp"
+
+#include "Core/GlDevice.hpp"
+#include "Miscellaneous/GlCallLogger.hpp"
+
+#include "ashesgl_api.hpp"
+
+#include <algorithm>
+
+namespace ashes::gl
+{
+	namespace
+	{
+		VkDeviceSize getRingAlignment( VkDevice device )
+		{
+			auto & limits = get( device )->getLimits();
+			return std::max( { VkDeviceSize( 64u )
+				, limits.optimalBufferCopyOffsetAlignment
+				, limits.nonCoherentAtomSize } );
+		}
+	}
+
+	StagingRing::StagingRing( VkDevice device
+		, VkDeviceSize size
+		, bool persistent )
+		: m_device{ device }
+		, m_size{ size }
+		, m_align{ getRingAlignment( device ) }
+		, m_persistent{ persistent }
+	{
+	}
+
+	StagingRing::~StagingRing()
+	{
+		if ( m_buffer != GL_INVALID_INDEX )
+		{
+			auto context = get( m_device )->getContext();
+			doDestroy( context );
+		}
+	}
+
+	StagingRing::Chunk StagingRing::reserve( ContextLock const & context
+		, VkDeviceSize size )
+	{
+		std::unique_lock< std::mutex > lock{ m_mutex };
+		size = ashes::getAlignedSize( size, m_align );
+
+		if ( size > m_size )
+		{
+			// Too small, wait for every chunk to be given back, then grow.
+			while ( !m_reserved.empty() )
+			{
+				doRetire( context, lock );
+			}
+
+			if ( m_buffer != GL_INVALID_INDEX )
+			{
+				doDestroy( context );
+			}
+
+			m_size = std::max( size, m_size * 2u );
+		}
+
+		if ( m_buffer == GL_INVALID_INDEX )
+		{
+			doCreate( context );
+		}
+
+		VkDeviceSize offset{};
+
+		while ( !doFindSpace( size, offset ) )
+		{
+			doRetire( context, lock );
+		}
+
+		m_head = offset + size;
+		m_reserved.push_back( { offset, m_head, nullptr, false } );
+		return { m_buffer, offset, size };
+	}
+
+	void * StagingRing::map( ContextLock const & context
+		, Chunk const & chunk
+		, GlMemoryMapFlags flags )
+	{
+		if ( m_persistent )
+		{
+			return m_data + chunk.offset;
+		}
+
+		// The ring handles the synchronisation itself, but GL only allows
+		// unsynchronised mappings for writes.
+		if ( ashes::checkFlag( flags, GlMemoryMapFlag::GL_MEMORY_MAP_WRITE_BIT ) )
+		{
+			flags |= GlMemoryMapFlag::GL_MEMORY_MAP_UNSYNCHRONIZED_BIT;
+		}
+
+		glLogCall( context
+			, glBindBuffer
+			, GL_BUFFER_TARGET_COPY_WRITE
+			, chunk.buffer );
+		auto result = glLogNonVoidCall( context
+			, glMapBufferRange
+			, GL_BUFFER_TARGET_COPY_WRITE
+			, GLintptr( chunk.offset )
+			, GLsizeiptr( chunk.size )
+			, GLbitfield( flags ) );
+		glLogCall( context
+			, glBindBuffer
+			, GL_BUFFER_TARGET_COPY_WRITE
+			, 0u );
+		return result;
+	}
+
+	void StagingRing::unmap( ContextLock const & context
+		, Chunk const & chunk )
+	{
+		if ( m_persistent )
+		{
+			return;
+		}
+
+		glLogCall( context
+			, glBindBuffer
+			, GL_BUFFER_TARGET_COPY_WRITE
+			, chunk.buffer );
+		glLogCall( context
+			, glUnmapBuffer
+			, GL_BUFFER_TARGET_COPY_WRITE );
+		glLogCall( context
+			, glBindBuffer
+			, GL_BUFFER_TARGET_COPY_WRITE
+			, 0u );
+	}
+
+	void StagingRing::release( ContextLock const & context
+		, Chunk const & chunk )
+	{
+		auto sync = glLogNonVoidCall( context
+			, glFenceSync
+			, GL_WAIT_FLAG_SYNC_GPU_COMMANDS_COMPLETE
+			, 0u );
+		std::unique_lock< std::mutex > lock{ m_mutex };
+		auto it = std::find_if( m_reserved.begin()
+			, m_reserved.end()
+			, [&chunk]( Reserved const & lookup )
+			{
+				return lookup.offset == chunk.offset
+					&& !lookup.released;
+			} );
+		assert( it != m_reserved.end() );
+		it->sync = sync;
+		it->released = true;
+		m_released.notify_all();
+	}
+
+	void StagingRing::wait( ContextLock const & context )
+	{
+		auto sync = glLogNonVoidCall( context
+			, glFenceSync
+			, GL_WAIT_FLAG_SYNC_GPU_COMMANDS_COMPLETE
+			, 0u );
+		glLogNonVoidCall( context
+			, glClientWaitSync
+			, sync
+			, GL_WAIT_FLAG_SYNC_FLUSH_COMMANDS_BIT
+			, ~( 0ull ) );
+		glLogCall( context
+			, glDeleteSync
+			, sync );
+	}
+
+	void StagingRing::doCreate( ContextLock const & context )
+	{
+		glLogCall( context
+			, glGenBuffers
+			, 1
+			, &m_buffer );
+		glLogCall( context
+			, glBindBuffer
+			, GL_BUFFER_TARGET_COPY_WRITE
+			, m_buffer );
+
+		if ( m_persistent )
+		{
+			glLogCall( context
+				, glBufferStorage
+				, GL_BUFFER_TARGET_COPY_WRITE
+				, GLsizeiptr( m_size )
+				, nullptr
+				, ( gl4::GL_MEMORY_PROPERTY_READ_BIT
+					| gl4::GL_MEMORY_PROPERTY_WRITE_BIT
+					| gl4::GL_MEMORY_PROPERTY_PERSISTENT_BIT
+					| gl4::GL_MEMORY_PROPERTY_COHERENT_BIT ) );
+			m_data = static_cast< uint8_t * >( glLogNonVoidCall( context
+				, glMapBufferRange
+				, GL_BUFFER_TARGET_COPY_WRITE
+				, 0
+				, GLsizeiptr( m_size )
+				, GLbitfield( GL_MEMORY_MAP_READ_BIT
+					| GL_MEMORY_MAP_WRITE_BIT
+					| GL_MEMORY_MAP_PERSISTENT_BIT
+					| GL_MEMORY_MAP_COHERENT_BIT ) ) );
+		}
+		else
+		{
+			glLogCall( context
+				, glBufferData
+				, GL_BUFFER_TARGET_COPY_WRITE
+				, GLsizeiptr( m_size )
+				, nullptr
+				, GL_BUFFER_DATA_USAGE_STREAM_COPY );
+		}
+
+		glLogCall( context
+			, glBindBuffer
+			, GL_BUFFER_TARGET_COPY_WRITE
+			, 0u );
+		m_head = 0u;
+	}
+
+	void StagingRing::doDestroy( ContextLock const & context )
+	{
+		if ( m_data )
+		{
+			glLogCall( context
+				, glBindBuffer
+				, GL_BUFFER_TARGET_COPY_WRITE
+				, m_buffer );
+			glLogCall( context
+				, glUnmapBuffer
+				, GL_BUFFER_TARGET_COPY_WRITE );
+			glLogCall( context
+				, glBindBuffer
+				, GL_BUFFER_TARGET_COPY_WRITE
+				, 0u );
+			m_data = nullptr;
+		}
+
+		glLogCall( context
+			, glDeleteBuffers
+			, 1
+			, &m_buffer );
+		m_buffer = GL_INVALID_INDEX;
+	}
+
+	bool StagingRing::doFindSpace( VkDeviceSize size
+		, VkDeviceSize & offset )const
+	{
+		if ( m_reserved.empty() )
+		{
+			offset = 0u;
+			return size <= m_size;
+		}
+
+		auto tail = m_reserved.front().offset;
+
+		if ( m_head > tail )
+		{
+			if ( size <= m_size - m_head )
+			{
+				offset = m_head;
+				return true;
+			}
+
+			// Wrap around.
+			offset = 0u;
+			return size <= tail;
+		}
+
+		if ( m_head < tail )
+		{
+			offset = m_head;
+			return size <= tail - m_head;
+		}
+
+		// Head reached tail, the ring is full.
+		return false;
+	}
+
+	void StagingRing::doRetire( ContextLock const & context
+		, std::unique_lock< std::mutex > & lock )
+	{
+		// Another thread may still be filling the oldest chunk.
+		m_released.wait( lock
+			, [this]()
+			{
+				return m_reserved.empty()
+					|| m_reserved.front().released;
+			} );
+
+		if ( m_reserved.empty() )
+		{
+			return;
+		}
+
+		auto & front = m_reserved.front();
+		glLogNonVoidCall( context
+			, glClientWaitSync
+			, front.sync
+			, GL_WAIT_FLAG_SYNC_FLUSH_COMMANDS_BIT
+			, ~( 0ull ) );
+		glLogCall( context
+			, glDeleteSync
+			, front.sync );
+		m_reserved.pop_front();
+
+		// Also retire the following chunks, as long as their fence is already signaled.
+		while ( !m_reserved.empty()
+			&& m_reserved.front().released )
+		{
+			auto res = glLogNonVoidCall( context
+				, glClientWaitSync
+				, m_reserved.front().sync
+				, 0u
+				, 0ull );
+
+			if ( res != GL_WAIT_RESULT_ALREADY_SIGNALED
+				&& res != GL_WAIT_RESULT_CONDITION_SATISFIED )
+			{
+				break;
+			}
+
+			glLogCall( context
+				, glDeleteSync
+				, m_reserved.front().sync );
+			m_reserved.pop_front();
+		}
+
+		if ( m_reserved.empty() )
+		{
+			m_head = 0u;
+		}
+	}
+}
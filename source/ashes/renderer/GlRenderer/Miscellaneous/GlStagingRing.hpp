@@ -0,0 +1,98 @@
+/*
+This file belongs to Ashes.
+See LICENSE file in root folder
+*/
+#pragma once
+
+#include "renderer/GlRenderer/GlRendererPrerequisites.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+namespace ashes::gl
+{
+	/**
+	*\brief
+	*	Device wide staging buffer, used to transfer data between host visible images and their textures.
+	*\remarks
+	*	The ring is suballocated per map, and a chunk is recycled once the fence
+	*	inserted at its release is signaled.
+	*	When ARB_buffer_storage is available, the buffer is persistently mapped.
+	*/
+	class StagingRing
+	{
+	public:
+		struct Chunk
+		{
+			GLuint buffer;
+			VkDeviceSize offset;
+			VkDeviceSize size;
+		};
+
+	public:
+		StagingRing( VkDevice device
+			, VkDeviceSize size
+			, bool persistent );
+		~StagingRing();
+		/**
+		*\brief
+		*	Reserves a chunk, waiting for previously released chunks if needed.
+		*/
+		Chunk reserve( ContextLock const & context
+			, VkDeviceSize size );
+		/**
+		*\return
+		*	The host pointer to the chunk's data.
+		*/
+		void * map( ContextLock const & context
+			, Chunk const & chunk
+			, GlMemoryMapFlags flags );
+		/**
+		*\brief
+		*	Makes the chunk usable by GL commands again.
+		*/
+		void unmap( ContextLock const & context
+			, Chunk const & chunk );
+		/**
+		*\brief
+		*	Gives the chunk back to the ring, it will be reused once the commands using it are complete.
+		*/
+		void release( ContextLock const & context
+			, Chunk const & chunk );
+		/**
+		*\brief
+		*	Waits for the GL commands submitted so far, which use the ring.
+		*/
+		void wait( ContextLock const & context );
+
+	private:
+		struct Reserved
+		{
+			VkDeviceSize offset;
+			VkDeviceSize end;
+			GLsync sync;
+			bool released;
+		};
+
+		void doCreate( ContextLock const & context );
+		void doDestroy( ContextLock const & context );
+		bool doFindSpace( VkDeviceSize size
+			, VkDeviceSize & offset )const;
+		void doRetire( ContextLock const & context
+			, std::unique_lock< std::mutex > & lock );
+
+	private:
+		VkDevice m_device;
+		VkDeviceSize m_size;
+		VkDeviceSize m_align;
+		bool m_persistent;
+		std::mutex m_mutex;
+		std::condition_variable m_released;
+		GLuint m_buffer{ GL_INVALID_INDEX };
+		uint8_t * m_data{ nullptr };
+		VkDeviceSize m_head{ 0u };
+		// Reserved chunks, in ring order.
+		std::deque< Reserved > m_reserved;
+	};
+}
@@ -0,0 +1,97 @@
+/*
+This file belongs to Ashes.
+See LICENSE file in root folder
+*/
+#include "Miscellaneous/GlTextureHandles.hpp"
+
+#include "Core/GlDevice.hpp"
+#include "Miscellaneous/GlCallLogger.hpp"
+
+#include "ashesgl_api.hpp"
+
+namespace ashes::gl
+{
+	TextureHandles::TextureHandles( VkDevice device )
+		: m_device{ device }
+	{
+	}
+
+	template< typename PredicateT >
+	void TextureHandles::doRelease( ContextLock const & context
+		, PredicateT predicate )
+	{
+		auto it = m_handles.begin();
+
+		while ( it != m_handles.end() )
+		{
+			if ( predicate( it->first ) )
+			{
+				glLogCall( context
+					, glMakeTextureHandleNonResident
+					, it->second );
+				it = m_handles.erase( it );
+			}
+			else
+			{
+				++it;
+			}
+		}
+	}
+
+	TextureHandles::~TextureHandles()
+	{
+		if ( !m_handles.empty() )
+		{
+			auto context = get( m_device )->getContext();
+			doRelease( context
+				, []( Key const & )
+				{
+					return true;
+				} );
+		}
+	}
+
+	GLuint64 TextureHandles::getHandle( ContextLock const & context
+		, GLuint texture
+		, GLuint sampler )
+	{
+		std::unique_lock< std::mutex > lock{ m_mutex };
+		auto it = m_handles.find( Key{ texture, sampler } );
+
+		if ( it == m_handles.end() )
+		{
+			auto handle = glLogNonVoidCall( context
+				, glGetTextureSamplerHandle
+				, texture
+				, sampler );
+			glLogCall( context
+				, glMakeTextureHandleResident
+				, handle );
+			it = m_handles.emplace( Key{ texture, sampler }, handle ).first;
+		}
+
+		return it->second;
+	}
+
+	void TextureHandles::releaseTexture( ContextLock const & context
+		, GLuint texture )
+	{
+		std::unique_lock< std::mutex > lock{ m_mutex };
+		doRelease( context
+			, [texture]( Key const & key )
+			{
+				return key.first == texture;
+			} );
+	}
+
+	void TextureHandles::releaseSampler( ContextLock const & context
+		, GLuint sampler )
+	{
+		std::unique_lock< std::mutex > lock{ m_mutex };
+		doRelease( context
+			, [sampler]( Key const & key )
+			{
+				return key.second == sampler;
+			} );
+	}
+}
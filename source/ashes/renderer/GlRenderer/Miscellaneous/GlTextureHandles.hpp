@@ -0,0 +1,58 @@
+/*
+This file belongs to Ashes.
+See LICENSE file in root folder
+*/
+#pragma once
+
+#include "renderer/GlRenderer/GlRendererPrerequisites.hpp"
+
+#include <map>
+#include <mutex>
+
+namespace ashes::gl
+{
+	/**
+	*\brief
+	*	Device wide registry of the ARB_bindless_texture handles.
+	*\remarks
+	*	A handle is created, and made resident, the first time a texture/sampler pair is written
+	*	to a bindless descriptor, and stays resident until the texture or the sampler is destroyed.
+	*/
+	class TextureHandles
+	{
+	public:
+		TextureHandles( VkDevice device );
+		~TextureHandles();
+		/**
+		*\return
+		*	The resident handle for the given texture and sampler.
+		*/
+		GLuint64 getHandle( ContextLock const & context
+			, GLuint texture
+			, GLuint sampler );
+		/**
+		*\brief
+		*	Makes non resident the handles using the given texture, which is about to be deleted.
+		*/
+		void releaseTexture( ContextLock const & context
+			, GLuint texture );
+		/**
+		*\brief
+		*	Makes non resident the handles using the given sampler, which is about to be deleted.
+		*/
+		void releaseSampler( ContextLock const & context
+			, GLuint sampler );
+
+	private:
+		template< typename PredicateT >
+		void doRelease( ContextLock const & context
+			, PredicateT predicate );
+
+	private:
+		using Key = std::pair< GLuint, GLuint >;
+
+		VkDevice m_device;
+		std::mutex m_mutex;
+		std::map< Key, GLuint64 > m_handles;
+	};
+}
@@ -107,6 +107,11 @@ namespace ashes::gl
 		GL_PATCH_VERTICES = 0x8E72,
 	};
 
+	enum ProgramParameter
+	{
+		GL_PROGRAM_SEPARABLE = 0x8258,
+	};
+
 	enum ContextFlag
 	{
 		GL_CONTEXT_FLAG_FORWARD_COMPATIBLE_BIT = 0x0001,
@@ -153,7 +158,9 @@ namespace ashes::gl
 	using PFN_glBlendFuncSeparatei = void ( GLAPIENTRY * )( GLuint buf, GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha );
 	using PFN_glBlitFramebuffer = void ( GLAPIENTRY * )( GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter );
 	using PFN_glBufferData = void ( GLAPIENTRY * )( GlBufferTarget target, GLsizeiptr size, const void * data, GlBufferDataUsageFlags usage );
+	using PFN_glBufferPageCommitment = void ( GLAPIENTRY * )( GlBufferTarget target, GLintptr offset, GLsizeiptr size, GLboolean commit );
 	using PFN_glBufferStorage = void ( GLAPIENTRY * )( GlBufferTarget target, GLsizeiptr size, const void * data, gl4::GlMemoryPropertyFlags flags );
+	using PFN_glBufferSubData = void ( GLAPIENTRY * )( GlBufferTarget target, GLintptr offset, GLsizeiptr size, const void * data );
 	using PFN_glCheckFramebufferStatus = GLenum( GLAPIENTRY * )( GLenum target );
 	using PFN_glClear = void ( GLAPIENTRY * )( GLbitfield mask );
 	using PFN_glClearDepth = void ( GLAPIENTRY * )( GLdouble depth );
@@ -163,6 +170,7 @@ namespace ashes::gl
 	using PFN_glClearBufferiv = void ( GLAPIENTRY * )( GLenum buffer, GLint drawBuffer, const GLint* value );
 	using PFN_glClearBufferuiv = void ( GLAPIENTRY * )( GLenum buffer, GLint drawBuffer, const GLuint* value );
 	using PFN_glClearColor = void ( GLAPIENTRY * )( GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha );
+	using PFN_glClearBufferSubData = void ( GLAPIENTRY * )( GlBufferTarget target, GlInternal internalformat, GLintptr offset, GLsizeiptr size, GlFormat format, GlType type, const void * data );
 	using PFN_glClearTexImage = void ( GLAPIENTRY * )( GLuint texture, GLint level, GLenum format, GLenum type, const void *data );
 	using PFN_glClientWaitSync = GLenum( GLAPIENTRY * )( GLsync GLsync, GLbitfield flags, GLuint64 timeout );
 	using PFN_glClipControl = void ( GLAPIENTRY * )( GLenum origin, GLenum depth );
@@ -173,9 +181,11 @@ namespace ashes::gl
 	using PFN_glCompressedTexSubImage3D = void ( GLAPIENTRY * )( GlTextureType target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLsizei imageSize, const GLvoid * data );
 	using PFN_glCopyBufferSubData = void ( GLAPIENTRY * )( GlBufferTarget readtarget, GlBufferTarget writetarget, GLintptr readoffset, GLintptr writeoffset, GLsizeiptr size );
 	using PFN_glCopyImageSubData = void ( GLAPIENTRY * )( GLuint srcName, GlTextureType srcTarget, GLint srcLevel, GLint srcX, GLint srcY, GLint srcZ, GLuint dstName, GlTextureType dstTarget, GLint dstLevel, GLint dstX, GLint dstY, GLint dstZ, GLsizei srcWidth, GLsizei srcHeight, GLsizei srcDepth );
+	using PFN_glCreateBuffers = void ( GLAPIENTRY * )( GLsizei n, GLuint * buffers );
 	using PFN_glCreateProgram = GLuint( GLAPIENTRY * )( void );
 	using PFN_glCreateShader = GLuint( GLAPIENTRY * )( GLenum type );
 	using PFN_glCreateShaderProgramv = GLuint( GLAPIENTRY * )( GLenum type, GLsizei count, const char ** strings );
+	using PFN_glCreateTextures = void ( GLAPIENTRY * )( GlTextureType target, GLsizei n, GLuint * textures );
 	using PFN_glCullFace = void ( GLAPIENTRY * )( GLenum mode );
 	using PFN_glDebugMessageCallback = void ( GLAPIENTRY * )( PFNGLDEBUGPROC callback, void * userParam );
 	using PFN_glDebugMessageCallbackAMD = void ( GLAPIENTRY * )( PFNGLDEBUGAMDPROC callback, void * userParam );
@@ -227,6 +237,8 @@ namespace ashes::gl
 	using PFN_glGenerateMipmap = void ( GLAPIENTRY * )( GLenum target );
 	using PFN_glGenVertexArrays = void ( GLAPIENTRY * )( GLsizei n, GLuint * arrays );
 	using PFN_glGetBufferParameteriv = GLenum( GLAPIENTRY * )( GlBufferTarget target, GlBufferParameter value, GLint * data );
+	using PFN_glGetBufferSubData = void ( GLAPIENTRY * )( GlBufferTarget target, GLintptr offset, GLsizeiptr size, void * data );
+	using PFN_glGetCompressedTexImage = void ( GLAPIENTRY * )( GlTextureType target, GLint level, void * pixels );
 	using PFN_glGetError = GLenum( GLAPIENTRY * )( void );
 	using PFN_glGetFloatv = void ( GLAPIENTRY * )( GLenum pname, GLfloat * data );
 	using PFN_glGetFloati_v = void( GLAPIENTRY * )( GLenum target, GLuint index, GLfloat * data );
@@ -244,6 +256,8 @@ namespace ashes::gl
 	using PFN_glGetProgramResourceName = void ( GLAPIENTRY * )( GLuint program, GLenum programInterface, GLuint index, GLsizei bufSize, GLsizei * length, char * name );
 	using PFN_glGetQueryObjectui64v = void ( GLAPIENTRY * )( GLuint id, GLenum pname, GLuint64 * params );
 	using PFN_glGetQueryObjectuiv = void ( GLAPIENTRY * )( GLuint id, GLenum pname, GLuint * params );
+	using PFN_glGetSamplerParameterfv = void ( GLAPIENTRY * )( GLuint sampler, GLenum pname, GLfloat * params );
+	using PFN_glGetSamplerParameteriv = void ( GLAPIENTRY * )( GLuint sampler, GLenum pname, GLint * params );
 	using PFN_glGetShaderInfoLog = void ( GLAPIENTRY * )( GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* infoLog );
 	using PFN_glGetShaderiv = void ( GLAPIENTRY * )( GLuint shader, GLenum pname, GLint* param );
 	using PFN_glGetString = const GLubyte *( GLAPIENTRY * )( GLenum name ); 
@@ -254,17 +268,25 @@ namespace ashes::gl
 	using PFN_glGetTexLevelParameteriv = void ( GLAPIENTRY * )( GlTextureType target, GLint level, GLenum pname, GLint * params );
 	using PFN_glGetTexParameterfv = void ( GLAPIENTRY * )( GlTextureType target, GLenum pname, GLfloat * params );
 	using PFN_glGetTexParameteriv = void ( GLAPIENTRY * )( GlTextureType target, GLenum pname, GLint * params );
+	using PFN_glGetTextureSamplerHandle = GLuint64 ( GLAPIENTRY * )( GLuint texture, GLuint sampler );
 	using PFN_glInvalidateBufferSubData = void ( GLAPIENTRY * )( GLuint buffer, GLintptr offset, GLsizeiptr length );
+	using PFN_glInvalidateFramebuffer = void ( GLAPIENTRY * )( GlFrameBufferTarget target, GLsizei numAttachments, const GLenum * attachments );
+	using PFN_glInvalidateSubFramebuffer = void ( GLAPIENTRY * )( GlFrameBufferTarget target, GLsizei numAttachments, const GLenum * attachments, GLint x, GLint y, GLsizei width, GLsizei height );
 	using PFN_glIsBuffer = GLboolean ( GLAPIENTRY * )( GLuint buffer );
 	using PFN_glLineWidth = void ( GLAPIENTRY * )( GLfloat width );
 	using PFN_glLinkProgram = void ( GLAPIENTRY * )( GLuint program );
 	using PFN_glLogicOp = void ( GLAPIENTRY * )( GLenum opcode );
+	using PFN_glMakeTextureHandleNonResident = void ( GLAPIENTRY * )( GLuint64 handle );
+	using PFN_glMakeTextureHandleResident = void ( GLAPIENTRY * )( GLuint64 handle );
 	using PFN_glMapBuffer = void * ( GLAPIENTRY * )( GlBufferTarget target, GLbitfield access );
 	using PFN_glMapBufferRange = void * ( GLAPIENTRY * )( GlBufferTarget target, GLintptr offset, GLsizeiptr length, GLbitfield access );
 	using PFN_glMemoryBarrier = void ( GLAPIENTRY * )( GLbitfield barriers );
 	using PFN_glMinSampleShading = void ( GLAPIENTRY * )( GLfloat value );
+	using PFN_glMultiDrawArrays = void ( GLAPIENTRY * )( GLenum mode, const GLint * first, const GLsizei * count, GLsizei drawcount );
 	using PFN_glMultiDrawArraysIndirect = void ( GLAPIENTRY * )( GLenum mode, const void * indirect, GLsizei drawcount, GLsizei stride );
+	using PFN_glMultiDrawElementsBaseVertex = void ( GLAPIENTRY * )( GLenum mode, const GLsizei * count, GLenum type, const void * const * indices, GLsizei drawcount, const GLint * basevertex );
 	using PFN_glMultiDrawElementsIndirect = void ( GLAPIENTRY * )( GLenum mode, GLenum type, const void * indirect, GLsizei drawcount, GLsizei stride );
+	using PFN_glNamedBufferData = void ( GLAPIENTRY * )( GLuint buffer, GLsizeiptr size, const void * data, GlBufferDataUsageFlags usage );
 	using PFN_glObjectLabel = void ( GLAPIENTRY * )( GLenum identifier, GLuint name, GLsizei length, const char * label );
 	using PFN_glObjectPtrLabel = void ( GLAPIENTRY * )( void * ptr, GLsizei length, const char * label );
 	using PFN_glPatchParameteri = void ( GLAPIENTRY * )( GLenum pname, GLint value );
@@ -313,6 +335,7 @@ namespace ashes::gl
 	using PFN_glTexImage2DMultisample = void ( GLAPIENTRY * )( GlTextureType target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height, GLboolean fixedsamplelocations );
 	using PFN_glTexImage3D = void ( GLAPIENTRY * )( GlTextureType target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLenum format, GLenum type, const void * pixels );
 	using PFN_glTexImage3DMultisample = void ( GLAPIENTRY * )( GlTextureType target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth, GLboolean fixedsamplelocations );
+	using PFN_glTexPageCommitment = void ( GLAPIENTRY * )( GlTextureType target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLboolean commit );
 	using PFN_glTexParameteri = void( GLAPIENTRY * )( GlTextureType target, GLenum pname, GLint param );
 	using PFN_glTexParameterf = void( GLAPIENTRY * )( GlTextureType target, GLenum pname, GLfloat param );
 	using PFN_glTexSubImage1D = void ( GLAPIENTRY * )( GlTextureType target, GLint level, GLint xoffset, GLsizei width, GLenum format, GLenum type, const void *pixels );
@@ -323,6 +346,12 @@ namespace ashes::gl
 	using PFN_glTexStorage2DMultisample = void ( GLAPIENTRY * )( GlTextureType target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height, GLboolean fixedsamplelocations );
 	using PFN_glTexStorage3D = void ( GLAPIENTRY * )( GlTextureType target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth );
 	using PFN_glTexStorage3DMultisample = void ( GLAPIENTRY * )( GlTextureType target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth, GLboolean fixedsamplelocations );
+	using PFN_glTextureParameteri = void ( GLAPIENTRY * )( GLuint texture, GLenum pname, GLint param );
+	using PFN_glTextureStorage1D = void ( GLAPIENTRY * )( GLuint texture, GLsizei levels, GLenum internalformat, GLsizei width );
+	using PFN_glTextureStorage2D = void ( GLAPIENTRY * )( GLuint texture, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height );
+	using PFN_glTextureStorage2DMultisample = void ( GLAPIENTRY * )( GLuint texture, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height, GLboolean fixedsamplelocations );
+	using PFN_glTextureStorage3D = void ( GLAPIENTRY * )( GLuint texture, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth );
+	using PFN_glTextureStorage3DMultisample = void ( GLAPIENTRY * )( GLuint texture, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth, GLboolean fixedsamplelocations );
 	using PFN_glTextureView = void ( GLAPIENTRY * )( GLuint texture, gl4::GlTextureViewType target, GLuint origtexture, GLenum internalformat, GLuint minlevel, GLuint numlevels, GLuint minlayer, GLuint numlayers );
 	using PFN_glUniform1fv = void ( GLAPIENTRY * )( GLint location, GLsizei count, const GLfloat* value );
 	using PFN_glUniform1iv = void ( GLAPIENTRY * )( GLint location, GLsizei count, const GLint* value );
@@ -347,6 +376,7 @@ namespace ashes::gl
 	using PFN_glVertexAttribPointer = void ( GLAPIENTRY * )( GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer );
 	using PFN_glViewport = void ( GLAPIENTRY * )( GLint x, GLint y, GLsizei width, GLsizei height );
 	using PFN_glViewportArrayv = void ( GLAPIENTRY * )( GLuint first, GLsizei count, const GLfloat * v );
+	using PFN_glWaitSync = void ( GLAPIENTRY * )( GLsync sync, GLbitfield flags, GLuint64 timeout );
 }
 
 #endif
@@ -70,6 +70,7 @@ GL_LIB_FUNCTION( BlendEquationSeparate )
 GL_LIB_FUNCTION( BlendFuncSeparate )
 GL_LIB_FUNCTION( BlitFramebuffer )
 GL_LIB_FUNCTION( BufferData )
+GL_LIB_FUNCTION( BufferSubData )
 GL_LIB_FUNCTION( CheckFramebufferStatus )
 GL_LIB_FUNCTION( ClearBufferfi )
 GL_LIB_FUNCTION( ClearBufferfv )
@@ -113,6 +114,8 @@ GL_LIB_FUNCTION( GenSamplers )
 GL_LIB_FUNCTION( GenerateMipmap )
 GL_LIB_FUNCTION( GenVertexArrays )
 GL_LIB_FUNCTION( GetBufferParameteriv )
+GL_LIB_FUNCTION( GetBufferSubData )
+GL_LIB_FUNCTION( GetCompressedTexImage )
 GL_LIB_FUNCTION( GetInteger64v )
 GL_LIB_FUNCTION( GetProgramInfoLog )
 GL_LIB_FUNCTION( GetProgramInterfaceiv )
@@ -122,6 +125,8 @@ GL_LIB_FUNCTION( GetProgramResourceIndex )
 GL_LIB_FUNCTION( GetProgramResourceName )
 GL_LIB_FUNCTION( GetQueryObjectui64v )
 GL_LIB_FUNCTION( GetQueryObjectuiv )
+GL_LIB_FUNCTION( GetSamplerParameterfv )
+GL_LIB_FUNCTION( GetSamplerParameteriv )
 GL_LIB_FUNCTION( GetShaderInfoLog )
 GL_LIB_FUNCTION( GetShaderiv )
 GL_LIB_FUNCTION( GetStringi )
@@ -130,6 +135,8 @@ GL_LIB_FUNCTION( IsBuffer )
 GL_LIB_FUNCTION( LinkProgram )
 GL_LIB_FUNCTION( MapBuffer )
 GL_LIB_FUNCTION( MapBufferRange )
+GL_LIB_FUNCTION( MultiDrawArrays )
+GL_LIB_FUNCTION( MultiDrawElementsBaseVertex )
 GL_LIB_FUNCTION( PrimitiveRestartIndex )
 GL_LIB_FUNCTION( QueryCounter )
 GL_LIB_FUNCTION( SamplerParameterf )
@@ -165,6 +172,7 @@ GL_LIB_FUNCTION( UseProgram )
 GL_LIB_FUNCTION( VertexAttribDivisor )
 GL_LIB_FUNCTION( VertexAttribPointer )
 GL_LIB_FUNCTION( VertexAttribIPointer )
+GL_LIB_FUNCTION( WaitSync )
 
 #undef GL_LIB_FUNCTION
 
@@ -176,11 +184,15 @@ GL_LIB_FUNCTION_EXT( BindImageTexture, "ARB", ARB_shader_image_load_store )
 GL_LIB_FUNCTION_EXT( BindProgramPipeline, "ARB", ARB_separate_shader_objects )
 GL_LIB_FUNCTION_EXT( BlendEquationSeparatei, "ARB", ARB_draw_buffers_blend )
 GL_LIB_FUNCTION_EXT( BlendFuncSeparatei, "ARB", ARB_draw_buffers_blend )
+GL_LIB_FUNCTION_EXT( BufferPageCommitment, "ARB", ARB_sparse_buffer )
 GL_LIB_FUNCTION_EXT( BufferStorage, "ARB", ARB_buffer_storage )
+GL_LIB_FUNCTION_EXT( ClearBufferSubData, "ARB", ARB_clear_buffer_object )
 GL_LIB_FUNCTION_EXT( ClearTexImage, "ARB", ARB_clear_texture )
 GL_LIB_FUNCTION_EXT( ClipControl, "ARB", ARB_clip_control )
 GL_LIB_FUNCTION_EXT( CopyImageSubData, "ARB", ARB_copy_image )
+GL_LIB_FUNCTION_EXT( CreateBuffers, "ARB", ARB_direct_state_access )
 GL_LIB_FUNCTION_EXT( CreateShaderProgramv, "ARB", ARB_separate_shader_objects )
+GL_LIB_FUNCTION_EXT( CreateTextures, "ARB", ARB_direct_state_access )
 GL_LIB_FUNCTION_EXT( DebugMessageCallback, "KHR", KHR_debug, "ARB", ARB_debug_output )
 GL_LIB_FUNCTION_EXT( DebugMessageCallbackAMD, "AMDX", AMDX_debug_output )
 GL_LIB_FUNCTION_EXT( DeleteProgramPipelines, "ARB", ARB_separate_shader_objects )
@@ -195,11 +207,17 @@ GL_LIB_FUNCTION_EXT( GetIntegeri_v, "ARB", ARB_viewport_array )
 GL_LIB_FUNCTION_EXT( GetInteger64i_v, "ARB", ARB_viewport_array )
 GL_LIB_FUNCTION_EXT( GetInternalformativ, "ARB", ARB_internalformat_query )
 GL_LIB_FUNCTION_EXT( GetInternalformati64v, "ARB", ARB_internalformat_query2 )
+GL_LIB_FUNCTION_EXT( GetTextureSamplerHandle, "ARB", ARB_bindless_texture )
 GL_LIB_FUNCTION_EXT( InvalidateBufferSubData, "ARB", ARB_invalidate_subdata )
+GL_LIB_FUNCTION_EXT( InvalidateFramebuffer, "ARB", ARB_invalidate_subdata )
+GL_LIB_FUNCTION_EXT( InvalidateSubFramebuffer, "ARB", ARB_invalidate_subdata )
+GL_LIB_FUNCTION_EXT( MakeTextureHandleNonResident, "ARB", ARB_bindless_texture )
+GL_LIB_FUNCTION_EXT( MakeTextureHandleResident, "ARB", ARB_bindless_texture )
 GL_LIB_FUNCTION_EXT( MemoryBarrier, "ARB", ARB_shader_image_load_store )
 GL_LIB_FUNCTION_EXT( MinSampleShading, "ARB", ARB_sample_shading )
 GL_LIB_FUNCTION_EXT( MultiDrawArraysIndirect, "ARB", ARB_multi_draw_indirect )
 GL_LIB_FUNCTION_EXT( MultiDrawElementsIndirect, "ARB", ARB_multi_draw_indirect )
+GL_LIB_FUNCTION_EXT( NamedBufferData, "ARB", ARB_direct_state_access )
 GL_LIB_FUNCTION_EXT( ObjectLabel, "KHR", KHR_debug, "ARB", ARB_debug_output )
 GL_LIB_FUNCTION_EXT( ObjectPtrLabel, "KHR", KHR_debug, "ARB", ARB_debug_output )
 GL_LIB_FUNCTION_EXT( PatchParameteri, "ARB", ARB_tessellation_shader )
@@ -226,11 +244,18 @@ GL_LIB_FUNCTION_EXT( ScissorArrayv, "ARB", ARB_viewport_array )
 GL_LIB_FUNCTION_EXT( ShaderBinary, "ARB", ARB_ES2_compatibility )
 GL_LIB_FUNCTION_EXT( SpecializeShader, "ARB", ARB_gl_spirv )
 GL_LIB_FUNCTION_EXT( TexBufferRange, "ARB", ARB_texture_buffer_range )
+GL_LIB_FUNCTION_EXT( TexPageCommitment, "ARB", ARB_sparse_texture )
 GL_LIB_FUNCTION_EXT( TexStorage1D, "ARB", ARB_texture_storage )
 GL_LIB_FUNCTION_EXT( TexStorage2D, "ARB", ARB_texture_storage )
 GL_LIB_FUNCTION_EXT( TexStorage2DMultisample, "ARB", ARB_texture_storage_multisample )
 GL_LIB_FUNCTION_EXT( TexStorage3D, "ARB", ARB_texture_storage )
 GL_LIB_FUNCTION_EXT( TexStorage3DMultisample, "ARB", ARB_texture_storage_multisample )
+GL_LIB_FUNCTION_EXT( TextureParameteri, "ARB", ARB_direct_state_access )
+GL_LIB_FUNCTION_EXT( TextureStorage1D, "ARB", ARB_direct_state_access )
+GL_LIB_FUNCTION_EXT( TextureStorage2D, "ARB", ARB_direct_state_access )
+GL_LIB_FUNCTION_EXT( TextureStorage2DMultisample, "ARB", ARB_direct_state_access )
+GL_LIB_FUNCTION_EXT( TextureStorage3D, "ARB", ARB_direct_state_access )
+GL_LIB_FUNCTION_EXT( TextureStorage3DMultisample, "ARB", ARB_direct_state_access )
 GL_LIB_FUNCTION_EXT( TextureView, "ARB", ARB_texture_view )
 GL_LIB_FUNCTION_EXT( UseProgramStages, "ARB", ARB_separate_shader_objects )
 GL_LIB_FUNCTION_EXT( ViewportArrayv, "ARB", ARB_viewport_array )
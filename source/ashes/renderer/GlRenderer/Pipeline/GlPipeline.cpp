@@ -176,6 +176,31 @@ namespace ashes::gl
 			};
 		}
 
+		template< typename DescContT >
+		void doReworkWrite( uint32_t descriptorSetIndex
+			, VkWriteDescriptorSet const & write
+			, DescContT const & descs
+			, ShaderBindingMap & resultMap
+			, ShaderBindings & result )
+		{
+			ShaderBindingMap::const_iterator bindingIt;
+			auto desc = findDesc( write
+				, descriptorSetIndex
+				, descs
+				, resultMap
+				, bindingIt );
+			addReplaceBinding( descriptorSetIndex
+				, write.dstBinding
+				, convert( write.descriptorType
+					, write.descriptorCount
+					, ( desc
+						? getBinding( *desc )
+						: ( bindingIt != resultMap.end()
+							? bindingIt->second
+							: write.dstBinding ) ) )
+				, result );
+		}
+
 		template< typename DescContT >
 		void doReworkWrites( uint32_t descriptorSetIndex
 			, LayoutBindingWritesArray const & writesArray
@@ -187,22 +212,7 @@ namespace ashes::gl
 			{
 				for ( auto & write : array->writes )
 				{
-					ShaderBindingMap::const_iterator bindingIt;
-					auto desc = findDesc( write
-						, descriptorSetIndex
-						, descs
-						, resultMap
-						, bindingIt );
-					addReplaceBinding( descriptorSetIndex
-						, write.dstBinding
-						, convert( write.descriptorType
-							, write.descriptorCount
-							, ( desc
-								? getBinding( *desc )
-								: ( bindingIt != resultMap.end()
-									? bindingIt->second
-									: write.dstBinding ) ) )
-						, result );
+					doReworkWrite( descriptorSetIndex, write, descs, resultMap, result );
 				}
 			}
 		}
@@ -265,6 +275,44 @@ namespace ashes::gl
 
 			return result;
 		}
+
+		ShaderBindings doReworkPushBindings( ShaderBindings const & srcBindings
+			, ArrayView< VkWriteDescriptorSet const > const & writes
+			, uint32_t descriptorSetIndex
+			, ShaderDesc const & programLayout )
+		{
+			ShaderBindings result = srcBindings;
+
+			for ( auto & write : writes )
+			{
+				switch ( write.descriptorType )
+				{
+				case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+					doReworkWrite( descriptorSetIndex, write, programLayout.img, result.img, result );
+					break;
+				case VK_DESCRIPTOR_TYPE_SAMPLER:
+				case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
+				case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+				case VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT:
+					doReworkWrite( descriptorSetIndex, write, programLayout.tex, result.tex, result );
+					break;
+				case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
+				case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:
+					doReworkWrite( descriptorSetIndex, write, programLayout.tbo, result.tbo, result );
+					break;
+				case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+					doReworkWrite( descriptorSetIndex, write, programLayout.ubo, result.ubo, result );
+					break;
+				case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+					doReworkWrite( descriptorSetIndex, write, programLayout.sbo, result.sbo, result );
+					break;
+				default:
+					break;
+				}
+			}
+
+			return result;
+		}
 	}
 
 	Pipeline::Pipeline( VkDevice device
@@ -443,4 +491,39 @@ namespace ashes::gl
 
 		return pair.first->second;
 	}
+
+	ShaderBindings const & Pipeline::getPushDescriptorSetBindings( ArrayView< VkWriteDescriptorSet const > const & writes
+		, uint32_t descriptorSetIndex )const
+	{
+		auto & programLayout = isCompute()
+			? m_compPipeline->program
+			: m_backPipeline->program;
+
+		if ( !programLayout.isGlsl )
+		{
+			return get( m_layout )->getShaderBindings();
+		}
+
+		// The GLSL bindings depend on the written descriptors.
+		size_t key = std::hash< uint32_t >{}( descriptorSetIndex );
+
+		for ( auto & write : writes )
+		{
+			hashCombine( key, write.dstBinding );
+			hashCombine( key, uint32_t( write.descriptorType ) );
+			hashCombine( key, write.descriptorCount );
+		}
+
+		auto pair = m_pushBindings.emplace( key, ShaderBindings{} );
+
+		if ( pair.second )
+		{
+			pair.first->second = doReworkPushBindings( get( m_layout )->getShaderBindings()
+				, writes
+				, descriptorSetIndex
+				, programLayout );
+		}
+
+		return pair.first->second;
+	}
 }
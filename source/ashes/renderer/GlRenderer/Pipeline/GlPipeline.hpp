@@ -47,6 +47,8 @@ namespace ashes::gl
 		VkDescriptorSetLayoutArray const & getDescriptorsLayouts()const;
 		ShaderBindings const & getDescriptorSetBindings( VkDescriptorSet descriptorSet
 			, uint32_t descriptorSetIndex )const;
+		ShaderBindings const & getPushDescriptorSetBindings( ArrayView< VkWriteDescriptorSet const > const & writes
+			, uint32_t descriptorSetIndex )const;
 
 		inline bool isCompute()const
 		{
@@ -206,6 +208,7 @@ namespace ashes::gl
 		mutable std::vector< std::pair< size_t, GeometryBuffersPtr > > m_geometryBuffers;
 		mutable std::unordered_map< GLuint, DeviceMemoryDestroyConnection > m_connections;
 		mutable std::unordered_map< uint64_t, ShaderBindings > m_dsBindings;
+		mutable std::unordered_map< size_t, ShaderBindings > m_pushBindings;
 		size_t m_vertexInputStateHash;
 	};
 }
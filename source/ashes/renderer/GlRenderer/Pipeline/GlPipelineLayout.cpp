@@ -25,7 +25,16 @@ namespace ashes::gl
 		{
 			for ( auto & binding : *get( descriptorLayout ) )
 			{
-				addBinding( set, binding, m_shaderBindings, indices );
+				if ( get( descriptorLayout )->isBindless( binding.binding ) )
+				{
+					// The texture handles are read from a shader storage buffer.
+					m_bindlessBindings.emplace( makeShaderBindingKey( set, binding.binding ), indices.sbo );
+					++indices.sbo;
+				}
+				else
+				{
+					addBinding( set, binding, m_shaderBindings, indices );
+				}
 			}
 
 			++set;
@@ -61,9 +70,20 @@ namespace ashes::gl
 
 		if ( pair.second )
 		{
-			for ( auto & binding : *get( get( descriptorSet )->getLayout() ) )
+			auto layout = get( descriptorSet )->getLayout();
+
+			for ( auto & binding : *get( layout ) )
 			{
-				copyBinding( descriptorSetIndex, binding, m_shaderBindings, pair.first->second );
+				if ( get( layout )->isBindless( binding.binding ) )
+				{
+					auto it = m_bindlessBindings.find( makeShaderBindingKey( descriptorSetIndex, binding.binding ) );
+					assert( it != m_bindlessBindings.end() );
+					pair.first->second.sbo.insert( *it );
+				}
+				else
+				{
+					copyBinding( descriptorSetIndex, binding, m_shaderBindings, pair.first->second );
+				}
 			}
 		}
 
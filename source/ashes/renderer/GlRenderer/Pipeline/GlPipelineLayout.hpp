@@ -18,6 +18,15 @@ namespace ashes::gl
 			, VkPipelineLayoutCreateInfo createInfo );
 
 		ShaderBindings const & getShaderBindings()const;
+		/**
+		*\return
+		*	The shader storage buffer bindings of the texture handles, for the bindless descriptors.
+		*/
+		inline ShaderBindingMap const & getBindlessBindings()const
+		{
+			return m_bindlessBindings;
+		}
+
 		uint32_t getDescriptorSetIndex( VkDescriptorSet descriptorSet )const;
 		ShaderBindings const & getDecriptorSetBindings( VkDescriptorSet descriptorSet
 			, uint32_t descriptorSetIndex )const;
@@ -43,6 +52,7 @@ namespace ashes::gl
 		VkPushConstantRangeArray m_pushConstantRanges;
 		VkPipelineLayoutCreateInfo m_createInfo;
 		ShaderBindings m_shaderBindings;
+		ShaderBindingMap m_bindlessBindings;
 		mutable std::unordered_map< uint64_t, ShaderBindings > m_dsBindings;
 	};
 }
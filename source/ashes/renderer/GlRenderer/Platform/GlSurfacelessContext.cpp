@@ -0,0 +1,228 @@
+/*
+This file belongs to Ashes.
+See LICENSE file in root folder
+*/
+#include "Platform/GlSurfacelessContext.hpp"
+
+#if __linux__
+
+#include <EGL/eglext.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace ashes::gl
+{
+	namespace
+	{
+		bool hasEglExtension( EGLDisplay display
+			, char const * const name )
+		{
+			auto extensions = eglQueryString( display, EGL_EXTENSIONS );
+
+			if ( !extensions )
+			{
+				return false;
+			}
+
+			std::string const list{ " " + std::string{ extensions } + " " };
+			return list.find( " " + std::string{ name } + " " ) != std::string::npos;
+		}
+
+		EGLDisplay getSurfacelessDisplay()
+		{
+#if defined( EGL_MESA_platform_surfaceless ) && defined( EGL_EXT_platform_base )
+
+			if ( hasEglExtension( EGL_NO_DISPLAY, "EGL_MESA_platform_surfaceless" ) )
+			{
+				auto getPlatformDisplay = reinterpret_cast< PFNEGLGETPLATFORMDISPLAYEXTPROC >( eglGetProcAddress( "eglGetPlatformDisplayEXT" ) );
+
+				if ( getPlatformDisplay )
+				{
+					auto result = getPlatformDisplay( EGL_PLATFORM_SURFACELESS_MESA
+						, EGL_DEFAULT_DISPLAY
+						, nullptr );
+
+					if ( result != EGL_NO_DISPLAY )
+					{
+						return result;
+					}
+				}
+			}
+
+#endif
+
+			return eglGetDisplay( EGL_DEFAULT_DISPLAY );
+		}
+	}
+
+	SurfacelessContext::SurfacelessContext( VkInstance instance
+		, ContextImpl const * mainContext )
+		: ContextImpl{ instance, { 1u, 1u } }
+		, m_mainContext{ static_cast< SurfacelessContext const * >( mainContext ) }
+	{
+	}
+
+	SurfacelessContext::~SurfacelessContext()
+	{
+		doCleanup();
+	}
+
+	bool SurfacelessContext::isRequested()
+	{
+		if ( auto value = std::getenv( "ASHES_GL_HEADLESS" ) )
+		{
+			return std::strcmp( value, "0" ) != 0;
+		}
+
+		auto display = std::getenv( "DISPLAY" );
+		return !display || !*display;
+	}
+
+	void SurfacelessContext::preInitialise( int reqMajor, int reqMinor )
+	{
+		try
+		{
+			EGLBoolean ok = eglBindAPI( EGL_OPENGL_API );
+
+			if ( !ok )
+			{
+				throw std::runtime_error{ "Couldn't bind EGL API" };
+			}
+
+			m_display = getSurfacelessDisplay();
+
+			if ( m_display == EGL_NO_DISPLAY )
+			{
+				throw std::runtime_error{ "Couldn't get EGL display" };
+			}
+
+			EGLint major, minor;
+			ok = eglInitialize( m_display, &major, &minor );
+
+			if ( !ok )
+			{
+				throw std::runtime_error{ "Couldn't initialise EGL" };
+			}
+
+			const EGLint eglConfigAttribs[]
+			{
+				EGL_COLOR_BUFFER_TYPE, EGL_RGB_BUFFER,
+				EGL_RED_SIZE, 8,
+				EGL_GREEN_SIZE, 8,
+				EGL_BLUE_SIZE, 8,
+				EGL_ALPHA_SIZE, 8,
+
+				EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+				EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+
+				EGL_NONE,
+			};
+
+			EGLConfig config{ nullptr };
+			EGLint numConfigs{};
+			ok = eglChooseConfig( m_display
+				, eglConfigAttribs
+				, &config
+				, 1
+				, &numConfigs );
+
+			if ( !ok || numConfigs == 0 )
+			{
+				throw std::runtime_error{ "Failed to find suitable EGLConfig" };
+			}
+
+			// Without EGL_KHR_surfaceless_context, we still need a drawable to make the context current.
+			if ( !hasEglExtension( m_display, "EGL_KHR_surfaceless_context" ) )
+			{
+				const EGLint pbufferAttribs[]
+				{
+					EGL_WIDTH, 1,
+					EGL_HEIGHT, 1,
+					EGL_NONE,
+				};
+				m_surface = eglCreatePbufferSurface( m_display
+					, config
+					, pbufferAttribs );
+
+				if ( m_surface == EGL_NO_SURFACE )
+				{
+					throw std::runtime_error{ "EGL pbuffer surface creation failed" };
+				}
+			}
+
+			const EGLint eglContextAttribs[]
+			{
+				EGL_CONTEXT_MAJOR_VERSION, reqMajor,
+				EGL_CONTEXT_MINOR_VERSION, reqMinor,
+				EGL_NONE,
+			};
+			m_context = eglCreateContext( m_display
+				, config
+				, ( m_mainContext
+					? m_mainContext->m_context
+					: EGL_NO_CONTEXT )
+				, eglContextAttribs );
+
+			if ( m_context == EGL_NO_CONTEXT )
+			{
+				throw std::runtime_error{ "EGL Context creation failed" };
+			}
+
+			ok = eglMakeCurrent( m_display, m_surface, m_surface, m_context );
+
+			if ( !ok )
+			{
+				throw std::runtime_error{ "eglMakeCurrent() failed" };
+			}
+
+			eglMakeCurrent( m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT );
+		}
+		catch ( std::exception & )
+		{
+			doCleanup();
+			throw;
+		}
+	}
+
+	void SurfacelessContext::postInitialise()
+	{
+	}
+
+	void SurfacelessContext::enable()const
+	{
+		eglMakeCurrent( m_display, m_surface, m_surface, m_context );
+	}
+
+	void SurfacelessContext::disable()const
+	{
+		eglMakeCurrent( m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT );
+	}
+
+	void SurfacelessContext::swapBuffers()const
+	{
+	}
+
+	void SurfacelessContext::doCleanup()
+	{
+		if ( m_context != EGL_NO_CONTEXT )
+		{
+			eglDestroyContext( m_display, m_context );
+			m_context = EGL_NO_CONTEXT;
+		}
+
+		if ( m_surface != EGL_NO_SURFACE )
+		{
+			eglDestroySurface( m_display, m_surface );
+			m_surface = EGL_NO_SURFACE;
+		}
+
+		// The surfaceless display is shared process wide, other contexts may still live on it,
+		// hence it is not terminated here.
+		m_display = EGL_NO_DISPLAY;
+	}
+}
+
+#endif
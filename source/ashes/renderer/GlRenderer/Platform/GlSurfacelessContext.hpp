@@ -0,0 +1,63 @@
+/*
+This file belongs to Ashes.
+See LICENSE file in root folder
+*/
+#pragma once
+
+#include "renderer/GlRenderer/Core/GlContextImpl.hpp"
+
+#if __linux__
+
+#	include <EGL/egl.h>
+#	include <memory>
+
+namespace ashes::gl
+{
+	/**
+	*\brief
+	*	EGL context that doesn't need any window nor display server.
+	*\remarks
+	*	Uses EGL_MESA_platform_surfaceless when available, and makes the context
+	*	current without surface if EGL_KHR_surfaceless_context is supported,
+	*	falling back to a 1x1 pbuffer otherwise.
+	*/
+	class SurfacelessContext
+		: public ContextImpl
+	{
+	public:
+		SurfacelessContext( VkInstance instance
+			, ContextImpl const * mainContext );
+		~SurfacelessContext();
+
+		void preInitialise( int major, int minor )override;
+		void postInitialise()override;
+		void enable()const override;
+		void disable()const override;
+		void swapBuffers()const override;
+
+		/**
+		*\return
+		*	\p true if the instance context must be created without hidden window.
+		*\remarks
+		*	Driven by ASHES_GL_HEADLESS environment variable ("0" to disable, "1" to force),
+		*	defaults to \p true when no X display is available.
+		*/
+		static bool isRequested();
+
+		inline EGLContext getContext()const
+		{
+			return m_context;
+		}
+
+	private:
+		void doCleanup();
+
+	private:
+		EGLDisplay m_display{ EGL_NO_DISPLAY };
+		EGLContext m_context{ EGL_NO_CONTEXT };
+		EGLSurface m_surface{ EGL_NO_SURFACE };
+		SurfacelessContext const * m_mainContext{ nullptr };
+	};
+}
+
+#endif
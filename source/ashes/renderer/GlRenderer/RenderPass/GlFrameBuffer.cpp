@@ -405,6 +405,71 @@ namespace ashes::gl
 		return m_drawBuffers;
 	}
 
+	UInt32Array Framebuffer::getDiscardedAttaches( VkRenderPass renderPass
+		, bool load )const
+	{
+		UInt32Array result;
+
+		if ( getInternal() == GL_INVALID_INDEX )
+		{
+			return result;
+		}
+
+		auto & attaches = getAllAttaches();
+
+		for ( auto index = 0u; index < attaches.size() && index < m_attachments.size(); ++index )
+		{
+			auto attachDesc = get( renderPass )->findAttachment( index );
+			auto image = get( get( m_attachments[index] )->getImage() );
+
+			// Only the attachments really bound to the FBO can be invalidated,
+			// the resolve targets of a multisampled FBO are not.
+			if ( !attachDesc
+				|| !image->hasInternal()
+				|| m_multisampled != ( image->getSamples() > VK_SAMPLE_COUNT_1_BIT ) )
+			{
+				continue;
+			}
+
+			auto & attach = attaches[index];
+			bool discard = load
+				? attachDesc->loadOp == VK_ATTACHMENT_LOAD_OP_DONT_CARE
+				: attachDesc->storeOp == VK_ATTACHMENT_STORE_OP_DONT_CARE;
+			bool discardStencil = load
+				? attachDesc->stencilLoadOp == VK_ATTACHMENT_LOAD_OP_DONT_CARE
+				: attachDesc->stencilStoreOp == VK_ATTACHMENT_STORE_OP_DONT_CARE;
+
+			if ( isDepthStencilFormat( attachDesc->format ) )
+			{
+				if ( discard && discardStencil )
+				{
+					result.push_back( GL_ATTACHMENT_POINT_DEPTH_STENCIL );
+				}
+				else if ( discard )
+				{
+					result.push_back( GL_ATTACHMENT_POINT_DEPTH );
+				}
+				else if ( discardStencil )
+				{
+					result.push_back( GL_ATTACHMENT_POINT_STENCIL );
+				}
+			}
+			else if ( isStencilFormat( attachDesc->format ) )
+			{
+				if ( discardStencil )
+				{
+					result.push_back( GL_ATTACHMENT_POINT_STENCIL );
+				}
+			}
+			else if ( discard )
+			{
+				result.push_back( attach.point + attach.index );
+			}
+		}
+
+		return result;
+	}
+
 	bool Framebuffer::hasOnlySwapchainImage()const
 	{
 		return m_attachments.end() == std::find_if( m_attachments.begin()
@@ -30,6 +30,8 @@ namespace ashes::gl
 
 		UInt32Array getDrawBuffers( ArrayView < VkAttachmentReference const > const & attaches )const;
 		UInt32Array getDrawBuffers( ArrayView < VkAttachmentReference > const & attaches )const;
+		UInt32Array getDiscardedAttaches( VkRenderPass renderPass
+			, bool load )const;
 
 		bool hasOnlySwapchainImage()const;
 		bool hasSwapchainImage()const;
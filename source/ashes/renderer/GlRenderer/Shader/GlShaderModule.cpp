@@ -493,6 +493,119 @@ namespace ashes::gl
 			doReworkBindings( device, module, "SubpassInput", compiler, resources.subpass_inputs, bindings.tex, failOnError );
 		}
 
+		std::string getSamplerTypeName( spirv_cross::CompilerGLSL & compiler
+			, spirv_cross::SPIRType const & type )
+		{
+			std::string result;
+			auto & sampledType = compiler.get_type( type.image.type );
+
+			if ( sampledType.basetype == spirv_cross::SPIRType::Int )
+			{
+				result = "i";
+			}
+			else if ( sampledType.basetype == spirv_cross::SPIRType::UInt )
+			{
+				result = "u";
+			}
+
+			result += "sampler";
+
+			switch ( type.image.dim )
+			{
+			case spv::Dim1D:
+				result += "1D";
+				break;
+			case spv::Dim2D:
+				result += "2D";
+				break;
+			case spv::Dim3D:
+				result += "3D";
+				break;
+			case spv::DimCube:
+				result += "Cube";
+				break;
+			case spv::DimRect:
+				result += "2DRect";
+				break;
+			case spv::DimBuffer:
+				result += "Buffer";
+				break;
+			default:
+				assert( false && "Unsupported spv::Dim" );
+				break;
+			}
+
+			if ( type.image.ms )
+			{
+				result += "MS";
+			}
+
+			if ( type.image.arrayed )
+			{
+				result += "Array";
+			}
+
+			if ( type.image.depth )
+			{
+				result += "Shadow";
+			}
+
+			return result;
+		}
+
+		void doReworkBindless( VkPipelineLayout pipelineLayout
+			, spirv_cross::CompilerGLSL & compiler
+			, spirv_cross::ShaderResources & resources )
+		{
+			auto & bindings = get( pipelineLayout )->getBindlessBindings();
+
+			if ( bindings.empty() )
+			{
+				return;
+			}
+
+			bool found = false;
+			size_t index = 0u;
+
+			while ( index < resources.sampled_images.size() )
+			{
+				auto & resource = resources.sampled_images[index];
+				auto binding = compiler.get_decoration( resource.id, spv::DecorationBinding );
+				auto set = compiler.get_decoration( resource.id, spv::DecorationDescriptorSet );
+				auto it = bindings.find( makeShaderBindingKey( set, binding ) );
+
+				if ( it == bindings.end() )
+				{
+					++index;
+					continue;
+				}
+
+				// The sampler variable isn't declared anymore, it is replaced by
+				// a shader storage buffer member, holding the texture handles.
+				auto name = compiler.get_name( resource.id );
+
+				if ( name.empty() )
+				{
+					name = "bindless" + std::to_string( set ) + "_" + std::to_string( binding );
+					compiler.set_name( resource.id, name );
+				}
+
+				auto & type = compiler.get_type( resource.type_id );
+				compiler.add_header_line( "layout( binding = " + std::to_string( it->second ) + ", std430 ) readonly buffer Bindless_" + name
+					+ " { " + getSamplerTypeName( compiler, compiler.get_type( resource.base_type_id ) ) + " " + name
+					+ ( type.array.empty() ? std::string{} : std::string{ "[]" } ) + "; };" );
+				compiler.unset_decoration( resource.id, spv::DecorationDescriptorSet );
+				compiler.set_remapped_variable_state( resource.id, true );
+				resources.sampled_images.erase( resources.sampled_images.begin() + index );
+				found = true;
+			}
+
+			if ( found )
+			{
+				compiler.require_extension( "GL_ARB_bindless_texture" );
+			}
+		}
+
 		std::string getStagePrefix( VkShaderStageFlagBits stage )
 		{
 			switch ( stage )
@@ -649,6 +762,7 @@ namespace ashes::gl
 					gl3::updateUboNames( compiler, std::to_string( currentStage ) );
 				}
 
+				doReworkBindless( pipelineLayout, compiler, resources );
 				doReworkBindings( pipelineLayout, createFlags, module, compiler, resources );
 				doReworkIntermediateInOut( previousStage, currentStage, compiler, resources );
 				doReworkAbsoluteInOut( currentStage, compiler, resources );
@@ -786,6 +900,28 @@ namespace ashes::gl
 		, bool invertY )
 	{
 		auto context = get( m_device )->getContext();
+		NativeSpirv spirv;
+
+		// The capture stores GLSL sources, so it keeps the SPIRV-Cross path.
+		if ( hasSpirvShaders( m_device )
+			&& hasProgramPipelines( m_device )
+			&& !get( m_device )->getCapture()
+			&& rewriteSpirv( pipelineLayout
+				, createFlags
+				, get( this )
+				, m_code
+				, currentState
+				, invertY
+				, spirv ) )
+		{
+			m_source.clear();
+			m_constants.clear();
+			return compileSpirv( context
+				, pipeline
+				, currentState
+				, spirv );
+		}
+
 		ShaderDesc result{};
 		bool isGlsl;
 		m_source = common::compileSpvToGlsl( m_device
@@ -856,6 +992,14 @@ namespace ashes::gl
 		glLogCall( context
 			, glCompileShader
 			, shader );
+
+		if ( auto capture = get( m_device )->getCapture() )
+		{
+			capture->registerShader( shader
+				, GLenum( getShaderStage( state.stage ) )
+				, m_source );
+		}
+
 		ShaderDesc result{};
 
 		if ( gl3::checkCompileErrors( context
@@ -890,6 +1034,13 @@ namespace ashes::gl
 
 		if ( usable )
 		{
+			if ( auto capture = get( m_device )->getCapture() )
+			{
+				capture->registerSeparateProgram( programObject
+					, GLenum( getShaderStage( state.stage ) )
+					, m_source );
+			}
+
 			for ( auto & constant : m_constants )
 			{
 				constant.program = programObject;
@@ -913,5 +1064,86 @@ namespace ashes::gl
 		return ShaderDesc{ isGlsl };
 	}
 
+	ShaderDesc ShaderModule::compileSpirv( ContextLock const & context
+		, VkPipeline pipeline
+		, VkPipelineShaderStageCreateInfo const & state
+		, NativeSpirv const & spirv )
+	{
+		auto shader = glLogNonVoidCall( context
+			, glCreateShader
+			, getShaderStage( state.stage ) );
+		glLogCall( context
+			, glShaderBinary
+			, 1
+			, &shader
+			, GL_SHADER_BINARY_FORMAT_SPIR_V
+			, spirv.code.data()
+			, GLsizei( spirv.code.size() * sizeof( uint32_t ) ) );
+		glLogCall( context
+			, glSpecializeShader
+			, shader
+			, spirv.entryPoint.c_str()
+			, GLuint( spirv.constantIds.size() )
+			, spirv.constantIds.data()
+			, spirv.constantValues.data() );
+		auto description = "SPIR-V module, entry point " + spirv.entryPoint;
+		GLuint programObject = 0u;
+		bool usable = false;
+
+		if ( gl3::checkCompileErrors( context
+			, get( this )
+			, shader
+			, description ) )
+		{
+			programObject = glLogNonVoidCall( context
+				, glCreateProgram );
+			glLogCall( context
+				, glProgramParameteri
+				, programObject
+				, GL_PROGRAM_SEPARABLE
+				, GLint( GL_TRUE ) );
+			glLogCall( context
+				, glAttachShader
+				, programObject
+				, shader );
+			glLogCall( context
+				, glLinkProgram
+				, programObject );
+			usable = checkLinkErrors( context
+				, pipeline
+				, programObject
+				, 1u
+				, "Separate SPIR-V shader link"
+				, description );
+		}
+
+		// Flagged for deletion, it goes away with the program.
+		glLogCall( context
+			, glDeleteShader
+			, shader );
+
+		if ( usable )
+		{
+			auto result = getShaderDesc( context
+				, m_constants
+				, state.stage
+				, programObject
+				, true );
+			result.program = programObject;
+			result.isGlsl = false;
+			result.stageFlags = state.stage;
+			return result;
+		}
+
+		if ( programObject )
+		{
+			glLogCall( context
+				, glDeleteProgram
+				, programObject );
+		}
+
+		return ShaderDesc{ false };
+	}
+
 	//*************************************************************************
 }
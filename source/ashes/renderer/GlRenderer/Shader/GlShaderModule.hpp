@@ -6,6 +6,7 @@ See LICENSE file in root folder.
 
 #include "renderer/GlRenderer/GlRendererPrerequisites.hpp"
 #include "renderer/GlRenderer/Shader/GlShaderDesc.hpp"
+#include "renderer/GlRenderer/Shader/GlSpirvRewriter.hpp"
 
 namespace ashes::gl
 {
@@ -52,6 +53,10 @@ namespace ashes::gl
 			, VkPipeline pipeline
 			, VkPipelineShaderStageCreateInfo const & state
 			, bool isGlsl );
+		ShaderDesc compileSpirv( ContextLock const & context
+			, VkPipeline pipeline
+			, VkPipelineShaderStageCreateInfo const & state
+			, NativeSpirv const & spirv );
 
 	private:
 		VkDevice m_device;
@@ -276,6 +276,20 @@ namespace ashes::gl
 			, glBindProgramPipeline
 			, 0 );
 
+		if ( auto capture = get( m_device )->getCapture() )
+		{
+			std::vector< gl::capture::PipelineStageDesc > pipelineStages;
+			index = 0u;
+
+			for ( auto & desc : descs )
+			{
+				pipelineStages.push_back( { uint32_t( convert( stages[index].stage ) ), desc.program } );
+				++index;
+			}
+
+			capture->registerPipeline( program.program, std::move( pipelineStages ) );
+		}
+
 		constantsPcb.stageFlags = program.stageFlags;
 		uint32_t size = 0u;
 
@@ -338,6 +352,11 @@ namespace ashes::gl
 			program.stageFlags = stageFlags;
 		}
 
+		if ( auto capture = get( m_device )->getCapture() )
+		{
+			capture->registerProgram( programObject, modules );
+		}
+
 		for ( auto & shaderName : modules )
 		{
 			if ( shaderName )
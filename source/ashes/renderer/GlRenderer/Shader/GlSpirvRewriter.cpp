@@ -0,0 +1,748 @@
+/*
+This file belongs to Ashes.
+See LICENSE file in root folder.
+*/
+#include "Shader/GlSpirvRewriter.hpp"
+
+#include "Core/GlDevice.hpp"
+#include "Pipeline/GlPipelineLayout.hpp"
+
+#include <cstring>
+#include <map>
+#include <set>
+#include <sstream>
+
+#include "ashesgl_api.hpp"
+
+namespace ashes::gl
+{
+	namespace
+	{
+		// The subset of the SPIR-V enumerants the rewrite needs.
+		namespace spirv
+		{
+			static uint32_t constexpr MagicNumber = 0x07230203u;
+			static uint32_t constexpr Version10 = 0x00010000u;
+
+			enum Op : uint32_t
+			{
+				OpEntryPoint = 15,
+				OpCapability = 17,
+				OpTypeInt = 21,
+				OpTypeVector = 23,
+				OpTypeImage = 25,
+				OpTypeSampler = 26,
+				OpTypeSampledImage = 27,
+				OpTypeArray = 28,
+				OpTypeRuntimeArray = 29,
+				OpTypeStruct = 30,
+				OpTypePointer = 32,
+				OpConstant = 43,
+				OpFunction = 54,
+				OpFunctionEnd = 56,
+				OpVariable = 59,
+				OpLoad = 61,
+				OpStore = 62,
+				OpAccessChain = 65,
+				OpDecorate = 71,
+				OpMemberDecorate = 72,
+				OpCompositeConstruct = 80,
+				OpCompositeExtract = 81,
+				OpFNegate = 127,
+				OpFSub = 131,
+				OpFMul = 133,
+				OpLogicalNot = 168,
+				OpReturn = 253,
+			};
+
+			enum Decoration : uint32_t
+			{
+				DecorationSpecId = 1,
+				DecorationBlock = 2,
+				DecorationBufferBlock = 3,
+				DecorationBuiltIn = 11,
+				DecorationBinding = 33,
+				DecorationDescriptorSet = 34,
+			};
+
+			enum BuiltIn : uint32_t
+			{
+				BuiltInPosition = 0,
+				BuiltInFrontFacing = 17,
+				BuiltInInstanceIndex = 43,
+			};
+
+			enum StorageClass : uint32_t
+			{
+				StorageClassUniformConstant = 0,
+				StorageClassUniform = 2,
+				StorageClassOutput = 3,
+				StorageClassPushConstant = 9,
+				StorageClassStorageBuffer = 12,
+			};
+
+			enum ExecutionModel : uint32_t
+			{
+				ExecutionModelVertex = 0,
+				ExecutionModelFragment = 4,
+				ExecutionModelGLCompute = 5,
+			};
+
+			static uint32_t constexpr CapabilityInputAttachment = 40u;
+			static uint32_t constexpr DimSubpassData = 6u;
+			static uint32_t constexpr ImageSampledStorage = 2u;
+		}
+
+		enum class ResourceKind
+		{
+			eUniformBuffer,
+			eStorageBuffer,
+			eSampledImage,
+			eStorageImage,
+			eUnsupported,
+		};
+
+		struct ModuleInfo
+		{
+			// Type result id => instruction offset.
+			std::map< uint32_t, size_t > types;
+			// Variable result id => ( pointer type, storage class ).
+			std::map< uint32_t, std::pair< uint32_t, uint32_t > > variables;
+			std::map< uint32_t, uint32_t > bindings;
+			std::map< uint32_t, uint32_t > sets;
+			std::set< uint32_t > blocks;
+			std::set< uint32_t > bufferBlocks;
+			std::set< uint32_t > specIds;
+			uint32_t entryPoint{ 0u };
+			uint32_t positionVariable{ 0u };
+			uint32_t positionStruct{ 0u };
+			uint32_t positionMember{ 0u };
+			uint32_t frontFacingVariable{ 0u };
+			uint32_t intType{ 0u };
+			size_t firstFunction{ 0u };
+			bool supported{ true };
+		};
+
+		bool getExecutionModel( VkShaderStageFlagBits stage
+			, uint32_t & model )
+		{
+			switch ( stage )
+			{
+			case VK_SHADER_STAGE_VERTEX_BIT:
+				model = spirv::ExecutionModelVertex;
+				return true;
+			case VK_SHADER_STAGE_FRAGMENT_BIT:
+				model = spirv::ExecutionModelFragment;
+				return true;
+			case VK_SHADER_STAGE_COMPUTE_BIT:
+				model = spirv::ExecutionModelGLCompute;
+				return true;
+			default:
+				// The other stages would need their own gl_Position fixups.
+				return false;
+			}
+		}
+
+		std::string readString( uint32_t const * words
+			, uint32_t count )
+		{
+			auto begin = reinterpret_cast< char const * >( words );
+			auto size = strnlen( begin, count * sizeof( uint32_t ) );
+			return std::string( begin, begin + size );
+		}
+
+		bool parseModule( UInt32Array const & code
+			, uint32_t model
+			, char const * entryPointName
+			, ModuleInfo & info )
+		{
+			size_t offset = 5u;
+
+			while ( offset < code.size() && info.supported )
+			{
+				auto words = &code[offset];
+				auto op = words[0] & 0xFFFFu;
+				auto count = words[0] >> 16u;
+
+				if ( count == 0u || offset + count > code.size() )
+				{
+					return false;
+				}
+
+				switch ( op )
+				{
+				case spirv::OpCapability:
+					info.supported = words[1] != spirv::CapabilityInputAttachment;
+					break;
+				case spirv::OpEntryPoint:
+					if ( words[1] == model
+						&& readString( words + 3u, count - 3u ) == entryPointName )
+					{
+						info.entryPoint = words[2];
+					}
+					break;
+				case spirv::OpTypeInt:
+					if ( words[2] == 32u && !info.intType )
+					{
+						info.intType = words[1];
+					}
+					info.types[words[1]] = offset;
+					break;
+				case spirv::OpTypeVector:
+				case spirv::OpTypeImage:
+				case spirv::OpTypeSampler:
+				case spirv::OpTypeSampledImage:
+				case spirv::OpTypeArray:
+				case spirv::OpTypeRuntimeArray:
+				case spirv::OpTypeStruct:
+				case spirv::OpTypePointer:
+					info.types[words[1]] = offset;
+					break;
+				case spirv::OpVariable:
+					if ( !info.firstFunction )
+					{
+						info.variables[words[2]] = { words[1], words[3] };
+						info.supported = words[3] != spirv::StorageClassPushConstant;
+					}
+					break;
+				case spirv::OpFunction:
+					if ( !info.firstFunction )
+					{
+						info.firstFunction = offset;
+					}
+					break;
+				case spirv::OpDecorate:
+					switch ( words[2] )
+					{
+					case spirv::DecorationSpecId:
+						info.specIds.insert( words[3] );
+						break;
+					case spirv::DecorationBlock:
+						info.blocks.insert( words[1] );
+						break;
+					case spirv::DecorationBufferBlock:
+						info.bufferBlocks.insert( words[1] );
+						break;
+					case spirv::DecorationBinding:
+						info.bindings[words[1]] = words[3];
+						break;
+					case spirv::DecorationDescriptorSet:
+						info.sets[words[1]] = words[3];
+						break;
+					case spirv::DecorationBuiltIn:
+						if ( words[3] == spirv::BuiltInPosition )
+						{
+							info.positionVariable = words[1];
+						}
+						else if ( words[3] == spirv::BuiltInFrontFacing )
+						{
+							info.frontFacingVariable = words[1];
+						}
+						else if ( words[3] == spirv::BuiltInInstanceIndex )
+						{
+							// GL's InstanceIndex doesn't include the base instance.
+							info.supported = false;
+						}
+						break;
+					default:
+						break;
+					}
+					break;
+				case spirv::OpMemberDecorate:
+					if ( words[3] == spirv::DecorationBuiltIn )
+					{
+						if ( words[4] == spirv::BuiltInPosition )
+						{
+							info.positionStruct = words[1];
+							info.positionMember = words[2];
+						}
+						else if ( words[4] == spirv::BuiltInInstanceIndex )
+						{
+							info.supported = false;
+						}
+					}
+					break;
+				default:
+					break;
+				}
+
+				offset += count;
+			}
+
+			return info.supported
+				&& info.entryPoint != 0u
+				&& info.firstFunction != 0u;
+		}
+
+		uint32_t const * getType( UInt32Array const & code
+			, ModuleInfo const & info
+			, uint32_t id )
+		{
+			auto it = info.types.find( id );
+			return it == info.types.end()
+				? nullptr
+				: &code[it->second];
+		}
+
+		ResourceKind getResourceKind( UInt32Array const & code
+			, ModuleInfo const & info
+			, uint32_t variable )
+		{
+			auto varIt = info.variables.find( variable );
+
+			if ( varIt == info.variables.end() )
+			{
+				return ResourceKind::eUnsupported;
+			}
+
+			auto pointer = getType( code, info, varIt->second.first );
+
+			if ( !pointer || ( pointer[0] & 0xFFFFu ) != spirv::OpTypePointer )
+			{
+				return ResourceKind::eUnsupported;
+			}
+
+			auto typeId = pointer[3];
+			auto type = getType( code, info, typeId );
+
+			while ( type
+				&& ( ( type[0] & 0xFFFFu ) == spirv::OpTypeArray
+					|| ( type[0] & 0xFFFFu ) == spirv::OpTypeRuntimeArray ) )
+			{
+				typeId = type[2];
+				type = getType( code, info, typeId );
+			}
+
+			if ( !type )
+			{
+				return ResourceKind::eUnsupported;
+			}
+
+			switch ( varIt->second.second )
+			{
+			case spirv::StorageClassUniform:
+				if ( info.blocks.count( typeId ) )
+				{
+					return ResourceKind::eUniformBuffer;
+				}
+				if ( info.bufferBlocks.count( typeId ) )
+				{
+					return ResourceKind::eStorageBuffer;
+				}
+				return ResourceKind::eUnsupported;
+			case spirv::StorageClassStorageBuffer:
+				return ResourceKind::eStorageBuffer;
+			case spirv::StorageClassUniformConstant:
+				if ( ( type[0] & 0xFFFFu ) == spirv::OpTypeSampledImage )
+				{
+					return ResourceKind::eSampledImage;
+				}
+				// Separate images and samplers, and subpass inputs, don't exist in GL.
+				if ( ( type[0] & 0xFFFFu ) == spirv::OpTypeImage
+					&& type[3] != spirv::DimSubpassData
+					&& type[7] == spirv::ImageSampledStorage )
+				{
+					return ResourceKind::eStorageImage;
+				}
+				return ResourceKind::eUnsupported;
+			default:
+				return ResourceKind::eUnsupported;
+			}
+		}
+
+		void reportMissingBinding( VkShaderModule module
+			, std::string const & typeName
+			, uint32_t binding
+			, uint32_t set )
+		{
+			std::stringstream stream;
+			stream.imbue( std::locale{ "C" } );
+			stream << typeName << ", binding=" << binding << ", set=" << set;
+			reportError( module
+				, VK_ERROR_VALIDATION_FAILED_EXT
+				, "Missing binding"
+				, stream.str() );
+		}
+
+		bool remapBindings( UInt32Array const & code
+			, ModuleInfo const & info
+			, VkPipelineLayout pipelineLayout
+			, VkPipelineCreateFlags createFlags
+			, VkShaderModule module
+			, std::map< uint32_t, uint32_t > & result )
+		{
+			auto & bindings = get( pipelineLayout )->getShaderBindings();
+			auto failOnError = !( checkFlag( createFlags, VK_PIPELINE_CREATE_ALLOW_DERIVATIVES_BIT )
+				|| checkFlag( createFlags, VK_PIPELINE_CREATE_DERIVATIVE_BIT ) );
+
+			for ( auto & binding : info.bindings )
+			{
+				auto setIt = info.sets.find( binding.first );
+				auto set = setIt == info.sets.end()
+					? 0u
+					: setIt->second;
+				auto key = makeShaderBindingKey( set, binding.second );
+
+				if ( get( pipelineLayout )->getBindlessBindings().count( key ) )
+				{
+					// Texture handles read from a storage buffer can't be expressed without rewriting the accesses.
+					return false;
+				}
+
+				ShaderBindingMap const * map{ nullptr };
+				ShaderBindingMap const * fallback{ nullptr };
+				std::string typeName;
+
+				switch ( getResourceKind( code, info, binding.first ) )
+				{
+				case ResourceKind::eUniformBuffer:
+					map = &bindings.ubo;
+					typeName = "UniformBuffer";
+					break;
+				case ResourceKind::eStorageBuffer:
+					map = &bindings.sbo;
+					typeName = "StorageBuffer";
+					break;
+				case ResourceKind::eSampledImage:
+					map = &bindings.tex;
+					fallback = &bindings.tbo;
+					typeName = "CombinedSamplerImage";
+					break;
+				case ResourceKind::eStorageImage:
+					map = &bindings.img;
+					typeName = "StorageImage";
+					break;
+				default:
+					return false;
+				}
+
+				auto it = map->find( key );
+
+				if ( it != map->end() )
+				{
+					result[binding.first] = it->second;
+				}
+				else if ( fallback && ( it = fallback->find( key ) ) != fallback->end() )
+				{
+					result[binding.first] = it->second;
+				}
+				else if ( failOnError )
+				{
+					reportMissingBinding( module, typeName, binding.second, set );
+				}
+			}
+
+			return true;
+		}
+
+		bool getSpecialisation( ModuleInfo const & info
+			, VkSpecializationInfo const * specialisation
+			, NativeSpirv & result )
+		{
+			if ( !specialisation )
+			{
+				return true;
+			}
+
+			for ( auto & entry : makeArrayView( specialisation->pMapEntries, specialisation->mapEntryCount ) )
+			{
+				if ( info.specIds.count( entry.constantID ) )
+				{
+					// glSpecializeShader only takes 32 bits values.
+					if ( entry.size != sizeof( uint32_t ) )
+					{
+						return false;
+					}
+
+					uint32_t value;
+					std::memcpy( &value
+						, reinterpret_cast< uint8_t const * >( specialisation->pData ) + entry.offset
+						, sizeof( uint32_t ) );
+					result.constantIds.push_back( entry.constantID );
+					result.constantValues.push_back( value );
+				}
+			}
+
+			return true;
+		}
+
+		class SpirvWriter
+		{
+		public:
+			SpirvWriter( UInt32Array & code
+				, uint32_t bound )
+				: m_code{ code }
+				, m_bound{ bound }
+			{
+			}
+
+			uint32_t newId()
+			{
+				return m_bound++;
+			}
+
+			void emit( uint32_t op
+				, std::initializer_list< uint32_t > operands )
+			{
+				m_code.push_back( ( uint32_t( operands.size() + 1u ) << 16u ) | op );
+				m_code.insert( m_code.end(), operands.begin(), operands.end() );
+			}
+
+			void copy( uint32_t const * words
+				, uint32_t count )
+			{
+				m_code.insert( m_code.end(), words, words + count );
+			}
+
+			uint32_t getBound()const
+			{
+				return m_bound;
+			}
+
+		private:
+			UInt32Array & m_code;
+			uint32_t m_bound;
+		};
+
+		struct PositionFixup
+		{
+			uint32_t variable{ 0u };
+			uint32_t floatType{ 0u };
+			uint32_t vec4Type{ 0u };
+			uint32_t pointerType{ 0u };
+			uint32_t member{ 0u };
+			uint32_t two{ 0u };
+			bool chained{ false };
+		};
+
+		// Finds the gl_Position output, and declares what the fixup needs.
+		bool preparePositionFixup( UInt32Array const & code
+			, ModuleInfo const & info
+			, SpirvWriter & writer
+			, PositionFixup & fixup )
+		{
+			if ( info.positionStruct )
+			{
+				auto structType = getType( code, info, info.positionStruct );
+
+				if ( !structType )
+				{
+					return false;
+				}
+
+				fixup.vec4Type = structType[2u + info.positionMember];
+				fixup.chained = true;
+
+				for ( auto & variable : info.variables )
+				{
+					auto pointer = getType( code, info, variable.second.first );
+
+					if ( variable.second.second == spirv::StorageClassOutput
+						&& pointer
+						&& pointer[3] == info.positionStruct )
+					{
+						fixup.variable = variable.first;
+					}
+				}
+			}
+			else if ( info.positionVariable )
+			{
+				auto varIt = info.variables.find( info.positionVariable );
+				auto pointer = varIt == info.variables.end()
+					? nullptr
+					: getType( code, info, varIt->second.first );
+
+				if ( !pointer )
+				{
+					return false;
+				}
+
+				fixup.variable = info.positionVariable;
+				fixup.vec4Type = pointer[3];
+			}
+
+			if ( !fixup.variable )
+			{
+				// gl_Position isn't written, nothing to fix up.
+				return true;
+			}
+
+			auto vec4Type = getType( code, info, fixup.vec4Type );
+
+			if ( !vec4Type
+				|| ( vec4Type[0] & 0xFFFFu ) != spirv::OpTypeVector
+				|| vec4Type[3] != 4u )
+			{
+				return false;
+			}
+
+			fixup.floatType = vec4Type[2];
+			fixup.two = writer.newId();
+			writer.emit( spirv::OpConstant, { fixup.floatType, fixup.two, 0x40000000u } );
+
+			if ( fixup.chained )
+			{
+				auto intType = info.intType;
+
+				if ( !intType )
+				{
+					intType = writer.newId();
+					writer.emit( spirv::OpTypeInt, { intType, 32u, 1u } );
+				}
+
+				fixup.pointerType = writer.newId();
+				writer.emit( spirv::OpTypePointer, { fixup.pointerType, spirv::StorageClassOutput, fixup.vec4Type } );
+				auto member = writer.newId();
+				writer.emit( spirv::OpConstant, { intType, member, info.positionMember } );
+				fixup.member = member;
+			}
+
+			return true;
+		}
+
+		// gl_Position.z = 2.0 * gl_Position.z - gl_Position.w;
+		// gl_Position.y = -gl_Position.y; (if invertY)
+		void writePositionFixup( PositionFixup const & fixup
+			, bool invertY
+			, SpirvWriter & writer )
+		{
+			auto pointer = fixup.variable;
+
+			if ( fixup.chained )
+			{
+				pointer = writer.newId();
+				writer.emit( spirv::OpAccessChain, { fixup.pointerType, pointer, fixup.variable, fixup.member } );
+			}
+
+			auto value = writer.newId();
+			writer.emit( spirv::OpLoad, { fixup.vec4Type, value, pointer } );
+			uint32_t components[4];
+
+			for ( uint32_t i = 0u; i < 4u; ++i )
+			{
+				components[i] = writer.newId();
+				writer.emit( spirv::OpCompositeExtract, { fixup.floatType, components[i], value, i } );
+			}
+
+			auto doubled = writer.newId();
+			writer.emit( spirv::OpFMul, { fixup.floatType, doubled, components[2], fixup.two } );
+			auto z = writer.newId();
+			writer.emit( spirv::OpFSub, { fixup.floatType, z, doubled, components[3] } );
+			auto y = components[1];
+
+			if ( invertY )
+			{
+				y = writer.newId();
+				writer.emit( spirv::OpFNegate, { fixup.floatType, y, components[1] } );
+			}
+
+			auto result = writer.newId();
+			writer.emit( spirv::OpCompositeConstruct, { fixup.vec4Type, result, components[0], y, z, components[3] } );
+			writer.emit( spirv::OpStore, { pointer, result } );
+		}
+	}
+
+	bool rewriteSpirv( VkPipelineLayout pipelineLayout
+		, VkPipelineCreateFlags createFlags
+		, VkShaderModule module
+		, UInt32Array const & code
+		, VkPipelineShaderStageCreateInfo const & state
+		, bool invertY
+		, NativeSpirv & result )
+	{
+		uint32_t model;
+
+		// GL only has to support SPIR-V 1.0.
+		if ( code.size() < 5u
+			|| code[0] != spirv::MagicNumber
+			|| code[1] > spirv::Version10
+			|| !getExecutionModel( state.stage, model ) )
+		{
+			return false;
+		}
+
+		ModuleInfo info;
+		std::map< uint32_t, uint32_t > bindings;
+
+		if ( !parseModule( code, model, state.pName, info )
+			|| !remapBindings( code, info, pipelineLayout, createFlags, module, bindings )
+			|| !getSpecialisation( info, state.pSpecializationInfo, result ) )
+		{
+			return false;
+		}
+
+		result.entryPoint = state.pName;
+		result.code.clear();
+		result.code.reserve( code.size() + 64u );
+		result.code.insert( result.code.end(), code.begin(), code.begin() + 5u );
+		SpirvWriter writer{ result.code, code[3] };
+		auto fixPosition = model == spirv::ExecutionModelVertex;
+		auto invertFrontFacing = model == spirv::ExecutionModelFragment
+			&& !invertY
+			&& info.frontFacingVariable != 0u;
+		PositionFixup fixup;
+		bool inEntryPoint = false;
+		size_t offset = 5u;
+
+		while ( offset < code.size() )
+		{
+			auto words = &code[offset];
+			auto op = words[0] & 0xFFFFu;
+			auto count = words[0] >> 16u;
+
+			if ( op == spirv::OpDecorate
+				&& words[2] == spirv::DecorationDescriptorSet )
+			{
+				// Stripped, GL bindings are flat.
+			}
+			else if ( op == spirv::OpDecorate
+				&& words[2] == spirv::DecorationBinding
+				&& bindings.count( words[1] ) )
+			{
+				writer.emit( op, { words[1], words[2], bindings[words[1]] } );
+			}
+			else if ( op == spirv::OpFunction )
+			{
+				if ( offset == info.firstFunction
+					&& fixPosition
+					&& !preparePositionFixup( code, info, writer, fixup ) )
+				{
+					return false;
+				}
+
+				inEntryPoint = words[2] == info.entryPoint;
+				writer.copy( words, count );
+			}
+			else if ( op == spirv::OpFunctionEnd )
+			{
+				inEntryPoint = false;
+				writer.copy( words, count );
+			}
+			else if ( op == spirv::OpReturn
+				&& inEntryPoint
+				&& fixup.variable )
+			{
+				writePositionFixup( fixup, invertY, writer );
+				writer.copy( words, count );
+			}
+			else if ( op == spirv::OpLoad
+				&& invertFrontFacing
+				&& words[3] == info.frontFacingVariable )
+			{
+				// The loaded value keeps its id, for its users, but becomes !gl_FrontFacing.
+				auto loaded = writer.newId();
+				writer.emit( op, { words[1], loaded, words[3] } );
+				writer.emit( spirv::OpLogicalNot, { words[1], words[2], loaded } );
+			}
+			else
+			{
+				writer.copy( words, count );
+			}
+
+			offset += count;
+		}
+
+		result.code[3] = writer.getBound();
+		return true;
+	}
+}
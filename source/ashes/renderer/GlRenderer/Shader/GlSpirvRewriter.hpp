@@ -0,0 +1,42 @@
+/*
+This file belongs to Ashes.
+See LICENSE file in root folder.
+*/
+#pragma once
+
+#include "renderer/GlRenderer/GlRendererPrerequisites.hpp"
+
+namespace ashes::gl
+{
+	/**
+	*\brief
+	*	A SPIR-V module ready to be loaded through glShaderBinary and glSpecializeShader.
+	*/
+	struct NativeSpirv
+	{
+		UInt32Array code;
+		std::string entryPoint;
+		UInt32Array constantIds;
+		UInt32Array constantValues;
+	};
+	/**
+	*\brief
+	*	Rewrites a Vulkan SPIR-V module so that GL_ARB_gl_spirv can load it directly.
+	*\remarks
+	*	Applies, on the SPIR-V itself, what the SPIRV-Cross path does on the generated GLSL:
+	*	the descriptor set/binding decorations are remapped to the pipeline layout GL bindings,
+	*	the vertex stage gl_Position is fixed up to GL clip space (and flipped if \p invertY),
+	*	and the fragment stage gl_FrontFacing is inverted if \p invertY is \p false.
+	*\return
+	*	\p false if the module uses something GL SPIR-V can't express
+	*	(push constants, separate images and samplers, subpass inputs, ...),
+	*	the module must then go through SPIRV-Cross.
+	*/
+	bool rewriteSpirv( VkPipelineLayout pipelineLayout
+		, VkPipelineCreateFlags createFlags
+		, VkShaderModule module
+		, UInt32Array const & code
+		, VkPipelineShaderStageCreateInfo const & state
+		, bool invertY
+		, NativeSpirv & result );
+}
@@ -8,18 +8,10 @@ See LICENSE file in root folder.
 
 #include "ashesgl_api.hpp"
 
+#include <chrono>
+
 namespace ashes::gl
 {
-	enum GlFenceWaitResult
-	{
-		GL_SYNC_STATUS = 0x9114,
-		GL_UNSIGNALED = 0x9118,
-		GL_SIGNALED = 0x9119,
-		GL_WAIT_RESULT_ALREADY_SIGNALED = 0x911A,
-		GL_WAIT_RESULT_CONDITION_SATISFIED = 0x911C,
-		GL_WAIT_RESULT_TIMEOUT_EXPIRED = 0x911B,
-	};
-
 	Fence::Fence( VkDevice device
 		, VkFenceCreateFlags flags )
 		: m_device{ device }
@@ -42,11 +34,28 @@ namespace ashes::gl
 	VkResult Fence::wait( ContextLock & context
 		, uint64_t timeout )const
 	{
+		auto begin = std::chrono::steady_clock::now();
+		GLsync sync{ nullptr };
+
+		if ( !doWaitPending( timeout, sync ) )
+		{
+			return VK_TIMEOUT;
+		}
+
+		// The pending wait consumed part of the caller's timeout.
+		if ( timeout < uint64_t( std::chrono::nanoseconds::max().count() / 2 ) )
+		{
+			auto elapsed = uint64_t( std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now() - begin ).count() );
+			timeout = elapsed < timeout
+				? timeout - elapsed
+				: 0u;
+		}
+
 		glLogEmptyCall( context
 			, glFlush );
 		auto res = glLogNonVoidCall( context
 			, glClientWaitSync
-			, m_fence
+			, sync
 			, GL_WAIT_FLAG_SYNC_FLUSH_COMMANDS_BIT
 			, timeout );
 		return ( res == GL_WAIT_RESULT_ALREADY_SIGNALED || res == GL_WAIT_RESULT_CONDITION_SATISFIED )
@@ -75,11 +84,24 @@ namespace ashes::gl
 
 	VkResult Fence::getStatus( ContextLock & context )const
 	{
+		GLsync sync{ nullptr };
+
+		{
+			std::unique_lock< std::mutex > lock{ m_mutex };
+
+			if ( m_pending )
+			{
+				return VK_NOT_READY;
+			}
+
+			sync = m_fence;
+		}
+
 		GLint value;
 		GLsizei size;
 		glLogCall( context
 			, glGetSynciv
-			, m_fence
+			, sync
 			, GL_SYNC_STATUS
 			, GLsizei( sizeof( value ) )
 			, &size
@@ -94,4 +116,57 @@ namespace ashes::gl
 		auto context = get( m_device )->getContext();
 		reset( context );
 	}
+
+	void Fence::prepareSignal()const
+	{
+		std::unique_lock< std::mutex > lock{ m_mutex };
+		m_pending = true;
+	}
+
+	void Fence::signal( ContextLock & context )const
+	{
+		auto sync = glLogNonVoidCall( context
+			, glFenceSync
+			, GL_WAIT_FLAG_SYNC_GPU_COMMANDS_COMPLETE
+			, 0u );
+		glLogEmptyCall( context
+			, glFlush );
+
+		{
+			std::unique_lock< std::mutex > lock{ m_mutex };
+			glLogCall( context
+				, glDeleteSync
+				, m_fence );
+			m_fence = sync;
+			m_pending = false;
+		}
+
+		m_signaled.notify_all();
+	}
+
+	bool Fence::doWaitPending( uint64_t timeout
+		, GLsync & sync )const
+	{
+		std::unique_lock< std::mutex > lock{ m_mutex };
+		auto isSignaled = [this]()
+		{
+			return !m_pending;
+		};
+
+		// Avoid overflows in the clock computations, for "infinite" timeouts.
+		if ( timeout >= uint64_t( std::chrono::nanoseconds::max().count() / 2 ) )
+		{
+			m_signaled.wait( lock, isSignaled );
+		}
+		else if ( !m_signaled.wait_for( lock
+			, std::chrono::nanoseconds( timeout )
+			, isSignaled ) )
+		{
+			return false;
+		}
+
+		// signal() replaces the sync object under the mutex, from the queue worker thread.
+		sync = m_fence;
+		return true;
+	}
 }
@@ -6,6 +6,9 @@ See LICENSE file in root folder
 
 #include "renderer/GlRenderer/GlRendererPrerequisites.hpp"
 
+#include <condition_variable>
+#include <mutex>
+
 namespace ashes::gl
 {
 	class Fence
@@ -22,14 +25,39 @@ namespace ashes::gl
 		void reset( ContextLock & context )const;
 		VkResult getStatus( ContextLock & context )const;
 		void reset()const;
+		/**
+		*\brief
+		*	Tells the fence a submit has been made to an asynchronous queue.
+		*\remarks
+		*	Waits on the fence will then block until signal() is called.
+		*/
+		void prepareSignal()const;
+		/**
+		*\brief
+		*	Replaces the fence sync by one inserted in the given context's command stream.
+		*/
+		void signal( ContextLock & context )const;
 
 		inline GLsync getInternal()const
 		{
 			return m_fence;
 		}
 
+	private:
+		/**
+		*\brief
+		*	Waits for the asynchronous submit, if any, to signal the fence.
+		*\param[out] sync
+		*	Receives the sync object to wait on, when the function returns \p true.
+		*/
+		bool doWaitPending( uint64_t timeout
+			, GLsync & sync )const;
+
 	private:
 		mutable GLsync m_fence{ nullptr };
 		VkDevice m_device;
+		mutable std::mutex m_mutex;
+		mutable std::condition_variable m_signaled;
+		mutable bool m_pending{ false };
 	};
 }
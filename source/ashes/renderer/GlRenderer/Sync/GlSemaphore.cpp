@@ -6,9 +6,89 @@ See LICENSE file in root folder.
 
 #include "Core/GlDevice.hpp"
 
+#include "ashesgl_api.hpp"
+
 namespace ashes::gl
 {
+	namespace
+	{
+		GLuint64 constexpr GL_TIMEOUT_IGNORED = 0xFFFFFFFFFFFFFFFFull;
+	}
+
 	Semaphore::Semaphore( VkDevice device )
+		: m_device{ device }
+	{
+	}
+
+	Semaphore::~Semaphore()
+	{
+		if ( m_sync )
+		{
+			auto context = get( m_device )->getContext();
+			glLogCall( context
+				, glDeleteSync
+				, m_sync );
+		}
+	}
+
+	void Semaphore::prepareSignal()const
+	{
+		std::unique_lock< std::mutex > lock{ m_mutex };
+		m_pending = true;
+	}
+
+	void Semaphore::signal( ContextLock const & context )const
 	{
+		auto sync = glLogNonVoidCall( context
+			, glFenceSync
+			, GL_WAIT_FLAG_SYNC_GPU_COMMANDS_COMPLETE
+			, 0u );
+		// The sync object must be flushed before another context can wait on it.
+		glLogEmptyCall( context
+			, glFlush );
+
+		{
+			std::unique_lock< std::mutex > lock{ m_mutex };
+
+			if ( m_sync )
+			{
+				glLogCall( context
+					, glDeleteSync
+					, m_sync );
+			}
+
+			m_sync = sync;
+			m_pending = false;
+		}
+
+		m_signaled.notify_all();
+	}
+
+	void Semaphore::wait( ContextLock const & context )const
+	{
+		GLsync sync{ nullptr };
+
+		{
+			std::unique_lock< std::mutex > lock{ m_mutex };
+			m_signaled.wait( lock
+				, [this]()
+				{
+					return !m_pending;
+				} );
+			sync = m_sync;
+			m_sync = nullptr;
+		}
+
+		if ( sync )
+		{
+			glLogCall( context
+				, glWaitSync
+				, sync
+				, 0u
+				, GL_TIMEOUT_IGNORED );
+			glLogCall( context
+				, glDeleteSync
+				, sync );
+		}
 	}
 }
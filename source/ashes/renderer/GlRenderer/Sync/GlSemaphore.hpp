@@ -6,6 +6,9 @@ See LICENSE file in root folder.
 
 #include "renderer/GlRenderer/GlRendererPrerequisites.hpp"
 
+#include <condition_variable>
+#include <mutex>
+
 namespace ashes::gl
 {
 	class Semaphore
@@ -13,5 +16,30 @@ namespace ashes::gl
 	{
 	public:
 		explicit Semaphore( VkDevice device );
+		~Semaphore();
+		/**
+		*\brief
+		*	Tells the semaphore a signal operation has been submitted to an asynchronous queue.
+		*\remarks
+		*	Waits on the semaphore will then block until signal() is called.
+		*/
+		void prepareSignal()const;
+		/**
+		*\brief
+		*	Inserts a fence sync in the given context's command stream.
+		*/
+		void signal( ContextLock const & context )const;
+		/**
+		*\brief
+		*	Makes the given context's command stream wait for the last signal operation.
+		*/
+		void wait( ContextLock const & context )const;
+
+	private:
+		VkDevice m_device;
+		mutable std::mutex m_mutex;
+		mutable std::condition_variable m_signaled;
+		mutable bool m_pending{ false };
+		mutable GLsync m_sync{ nullptr };
 	};
 }
@@ -4,9 +4,14 @@
 
 #include <renderer/GlRenderer/Miscellaneous/GlWindow.hpp>
 #include <renderer/GlRenderer/Miscellaneous/GlExtensionsHandler.hpp>
+#include <renderer/GlRenderer/Miscellaneous/GlReplay.hpp>
+#if __linux__
+#	include <renderer/GlRenderer/Platform/GlSurfacelessContext.hpp>
+#endif
 
 #include <ashes/common/Exception.hpp>
 
+#include <algorithm>
 #include <cstring>
 #include <iostream>
 
@@ -301,6 +306,7 @@ namespace ashes::gl
 		VkMemoryMapFlags flags,
 		void** ppData )
 	{
+		Profiler::CpuScope scope{ get( device )->getProfiler(), "MapMemory" };
 		auto context = get( device )->getContext();
 		return get( memory )->lock( context, offset, size, flags, ppData );
 	}
@@ -309,6 +315,7 @@ namespace ashes::gl
 		VkDevice device,
 		VkDeviceMemory memory )
 	{
+		Profiler::CpuScope scope{ get( device )->getProfiler(), "UnmapMemory" };
 		auto context = get( device )->getContext();
 		get( memory )->unlock( context );
 	}
@@ -781,6 +788,7 @@ namespace ashes::gl
 		VkPipeline* pPipelines )
 	{
 		assert( pPipelines );
+		Profiler::CpuScope scope{ get( device )->getProfiler(), "CreateGraphicsPipelines" };
 		VkResult result = VK_SUCCESS;
 
 		for ( uint32_t i = 0u; i < createInfoCount; ++i )
@@ -809,6 +817,7 @@ namespace ashes::gl
 		VkPipeline* pPipelines )
 	{
 		assert( pPipelines );
+		Profiler::CpuScope scope{ get( device )->getProfiler(), "CreateComputePipelines" };
 		VkResult result = VK_SUCCESS;
 
 		for ( uint32_t i = 0u; i < createInfoCount; ++i )
@@ -935,6 +944,15 @@ namespace ashes::gl
 	{
 		VkResult result = VK_SUCCESS;
 		auto itLayout = pAllocateInfo->pSetLayouts;
+		uint32_t const * itVariableCount{ nullptr };
+#if VK_EXT_descriptor_indexing
+		auto variableCounts = tryFind< VkDescriptorSetVariableDescriptorCountAllocateInfoEXT >( pAllocateInfo->pNext );
+
+		if ( variableCounts && variableCounts->descriptorSetCount )
+		{
+			itVariableCount = variableCounts->pDescriptorCounts;
+		}
+#endif
 
 		for ( auto itSet = pDescriptorSets;
 			itSet != pDescriptorSets + pAllocateInfo->descriptorSetCount;
@@ -945,7 +963,8 @@ namespace ashes::gl
 				result = allocate( *itSet
 					, nullptr
 					, pAllocateInfo->descriptorPool
-					, *itLayout );
+					, *itLayout
+					, ( itVariableCount ? *itVariableCount++ : 0u ) );
 			}
 		}
 
@@ -1736,14 +1755,20 @@ namespace ashes::gl
 		VkPhysicalDevice physicalDevice,
 		VkPhysicalDeviceFeatures2 * pFeatures )
 	{
+		auto next = pFeatures->pNext;
 		*pFeatures = get( physicalDevice )->getFeatures2();
+		pFeatures->pNext = next;
+		get( physicalDevice )->updateFeaturesChain( next );
 	}
 
 	void VKAPI_CALL vkGetPhysicalDeviceProperties2(
 		VkPhysicalDevice physicalDevice,
 		VkPhysicalDeviceProperties2 * pProperties )
 	{
+		auto next = pProperties->pNext;
 		*pProperties = get( physicalDevice )->getProperties2();
+		pProperties->pNext = next;
+		get( physicalDevice )->updatePropertiesChain( next );
 	}
 
 	void VKAPI_CALL vkGetPhysicalDeviceFormatProperties2(
@@ -1784,7 +1809,10 @@ namespace ashes::gl
 		VkPhysicalDevice physicalDevice,
 		VkPhysicalDeviceMemoryProperties2 * pMemoryProperties )
 	{
+		auto next = pMemoryProperties->pNext;
 		*pMemoryProperties = get( physicalDevice )->getMemoryProperties2();
+		pMemoryProperties->pNext = next;
+		get( physicalDevice )->updateMemoryPropertiesChain( next );
 	}
 
 	void VKAPI_CALL vkGetPhysicalDeviceSparseImageFormatProperties2(
@@ -1845,7 +1873,11 @@ namespace ashes::gl
 		const VkAllocationCallbacks* pAllocator,
 		VkDescriptorUpdateTemplate* pDescriptorUpdateTemplate )
 	{
-		return reportUnsupported( device, "vkCreateDescriptorUpdateTemplate" );
+		assert( pDescriptorUpdateTemplate );
+		return allocate( *pDescriptorUpdateTemplate
+			, pAllocator
+			, device
+			, *pCreateInfo );
 	}
 
 	void VKAPI_CALL vkDestroyDescriptorUpdateTemplate(
@@ -1853,7 +1885,7 @@ namespace ashes::gl
 		VkDescriptorUpdateTemplate descriptorUpdateTemplate,
 		const VkAllocationCallbacks* pAllocator )
 	{
-		reportUnsupported( device, "vkDestroyDescriptorUpdateTemplate" );
+		deallocate( descriptorUpdateTemplate, pAllocator );
 	}
 
 	void VKAPI_CALL vkUpdateDescriptorSetWithTemplate(
@@ -1862,7 +1894,12 @@ namespace ashes::gl
 		VkDescriptorUpdateTemplate descriptorUpdateTemplate,
 		const void* pData )
 	{
-		reportUnsupported( device, "vkUpdateDescriptorSetWithTemplate" );
+		auto writes = get( descriptorUpdateTemplate )->getWrites( descriptorSet, pData );
+
+		for ( auto & write : writes.writes )
+		{
+			get( descriptorSet )->update( write );
+		}
 	}
 
 	void VKAPI_CALL vkGetPhysicalDeviceExternalBufferProperties(
@@ -2377,14 +2414,20 @@ namespace ashes::gl
 		VkPhysicalDevice physicalDevice,
 		VkPhysicalDeviceFeatures2KHR * pFeatures )
 	{
+		auto next = pFeatures->pNext;
 		*pFeatures = get( physicalDevice )->getFeatures2();
+		pFeatures->pNext = next;
+		get( physicalDevice )->updateFeaturesChain( next );
 	}
 
 	void VKAPI_CALL vkGetPhysicalDeviceProperties2KHR(
 		VkPhysicalDevice physicalDevice,
 		VkPhysicalDeviceProperties2KHR * pProperties )
 	{
+		auto next = pProperties->pNext;
 		*pProperties = get( physicalDevice )->getProperties2();
+		pProperties->pNext = next;
+		get( physicalDevice )->updatePropertiesChain( next );
 	}
 
 	void VKAPI_CALL vkGetPhysicalDeviceFormatProperties2KHR(
@@ -2425,7 +2468,10 @@ namespace ashes::gl
 		VkPhysicalDevice physicalDevice,
 		VkPhysicalDeviceMemoryProperties2KHR * pMemoryProperties )
 	{
+		auto next = pMemoryProperties->pNext;
 		*pMemoryProperties = get( physicalDevice )->getMemoryProperties2();
+		pMemoryProperties->pNext = next;
+		get( physicalDevice )->updateMemoryPropertiesChain( next );
 	}
 
 	void VKAPI_CALL vkGetPhysicalDeviceSparseImageFormatProperties2KHR(
@@ -2588,7 +2634,10 @@ namespace ashes::gl
 		uint32_t descriptorWriteCount,
 		const VkWriteDescriptorSet* pDescriptorWrites )
 	{
-		reportUnsupported( commandBuffer, "vkCmdPushDescriptorSetKHR" );
+		get( commandBuffer )->pushDescriptorSet( pipelineBindPoint
+			, layout
+			, set
+			, makeArrayView( pDescriptorWrites, descriptorWriteCount ) );
 	}
 
 	void VKAPI_CALL vkCmdPushDescriptorSetWithTemplateKHR(
@@ -2598,7 +2647,11 @@ namespace ashes::gl
 		uint32_t set,
 		const void* pData )
 	{
-		reportUnsupported( commandBuffer, "vkCmdPushDescriptorSetWithTemplateKHR" );
+		auto const writes = get( descriptorUpdateTemplate )->getWrites( VK_NULL_HANDLE, pData );
+		get( commandBuffer )->pushDescriptorSet( get( descriptorUpdateTemplate )->getBindPoint()
+			, layout
+			, set
+			, makeArrayView( writes.writes.data(), writes.writes.size() ) );
 	}
 
 #endif
@@ -2612,7 +2665,11 @@ namespace ashes::gl
 		const VkAllocationCallbacks* pAllocator,
 		VkDescriptorUpdateTemplate* pDescriptorUpdateTemplate )
 	{
-		return reportUnsupported( device, "vkCreateDescriptorUpdateTemplateKHR" );
+		assert( pDescriptorUpdateTemplate );
+		return allocate( *pDescriptorUpdateTemplate
+			, pAllocator
+			, device
+			, *pCreateInfo );
 	}
 
 	void VKAPI_CALL vkDestroyDescriptorUpdateTemplateKHR(
@@ -2620,7 +2677,7 @@ namespace ashes::gl
 		VkDescriptorUpdateTemplate descriptorUpdateTemplate,
 		const VkAllocationCallbacks* pAllocator )
 	{
-		reportUnsupported( device, "vkDestroyDescriptorUpdateTemplateKHR" );
+		deallocate( descriptorUpdateTemplate, pAllocator );
 	}
 
 	void VKAPI_CALL vkUpdateDescriptorSetWithTemplateKHR(
@@ -2629,7 +2686,12 @@ namespace ashes::gl
 		VkDescriptorUpdateTemplate descriptorUpdateTemplate,
 		const void* pData )
 	{
-		reportUnsupported( device, "vkUpdateDescriptorSetWithTemplateKHR" );
+		auto writes = get( descriptorUpdateTemplate )->getWrites( descriptorSet, pData );
+
+		for ( auto & write : writes.writes )
+		{
+			get( descriptorSet )->update( write );
+		}
 	}
 
 #endif
@@ -4108,6 +4170,31 @@ namespace ashes::gl
 		return result;
 	}
 
+	bool doProbeSurfaceless( gl::ExtensionsHandler & extensions )
+	{
+#if __linux__
+
+		if ( gl::SurfacelessContext::isRequested() )
+		{
+			try
+			{
+				gl::SurfacelessContext context{ VK_NULL_HANDLE, nullptr };
+				context.preInitialise( MinMajor, MinMinor );
+				context.enable();
+				extensions.initialise();
+				context.disable();
+				return true;
+			}
+			catch ( std::exception & exc )
+			{
+				std::cerr << exc.what() << std::endl;
+			}
+		}
+
+#endif
+		return false;
+	}
+
 	struct GlLibrary
 	{
 		AshPluginDescription description
@@ -4130,8 +4217,12 @@ namespace ashes::gl
 
 				try
 				{
-					gl::RenderWindow window{ MinMajor, MinMinor, "Gl4Init" };
-					extensions.initialise();
+					if ( !doProbeSurfaceless( extensions ) )
+					{
+						gl::RenderWindow window{ MinMajor, MinMinor, "Gl4Init" };
+						extensions.initialise();
+					}
+
 					supported = extensions.getMajor() > MinMajor
 						|| ( extensions.getMajor() == MinMajor && extensions.getMinor() >= MinMinor );
 				}
@@ -4306,6 +4397,58 @@ extern "C"
 
 		return result;
 	}
+	/**
+	*\brief
+	*	Replays a GL command streams capture (see ASHES_GL_CAPTURE) on the given device.
+	*\param[in] fileName
+	*	The capture file.
+	*\param[in] loops
+	*	The number of times the capture is replayed.
+	*\param[out] pStats
+	*	Receives the replay timings.
+	*/
+	GlRenderer_API VkResult VKAPI_PTR ashglReplayCapture( VkDevice device
+		, char const * fileName
+		, uint32_t loops
+		, ashes::gl::capture::ReplayStats * pStats )
+	{
+		if ( !device || !fileName || !pStats )
+		{
+			return VK_ERROR_INITIALIZATION_FAILED;
+		}
+
+		auto context = ashes::gl::get( device )->getContext();
+		ashes::gl::Replayer replayer{ device };
+
+		if ( !replayer.load( context, fileName ) )
+		{
+			return VK_ERROR_INITIALIZATION_FAILED;
+		}
+
+		replayer.run( context, loops, *pStats );
+		return VK_SUCCESS;
+	}
+	/**
+	*\brief
+	*	Retrieves the live GL memory objects counters, and the memory heaps budgets.
+	*\param[out] pStats
+	*	Receives the counters, which cover all the devices.
+	*/
+	GlRenderer_API VkResult VKAPI_PTR ashglGetMemoryStats( VkDevice device
+		, ashes::gl::MemoryStats * pStats )
+	{
+		if ( !device || !pStats )
+		{
+			return VK_ERROR_INITIALIZATION_FAILED;
+		}
+
+		*pStats = ashes::gl::getMemoryStats();
+		VkDeviceSize heapUsage[VK_MAX_MEMORY_HEAPS];
+		VkDeviceSize heapBudget[VK_MAX_MEMORY_HEAPS];
+		ashes::gl::get( ashes::gl::get( device )->getPhysicalDevice() )->getMemoryBudget( heapUsage, heapBudget );
+		std::copy( std::begin( heapBudget ), std::end( heapBudget ), pStats->heapBudgets );
+		return VK_SUCCESS;
+	}
 
 #ifdef __cplusplus
 }
@@ -18,6 +18,7 @@ See LICENSE file in root folder.
 #include "Descriptor/GlDescriptorPool.hpp"
 #include "Descriptor/GlDescriptorSet.hpp"
 #include "Descriptor/GlDescriptorSetLayout.hpp"
+#include "Descriptor/GlDescriptorUpdateTemplate.hpp"
 #include "Miscellaneous/GlDeviceMemory.hpp"
 #include "Miscellaneous/GlQueryPool.hpp"
 #include "Image/GlImage.hpp"
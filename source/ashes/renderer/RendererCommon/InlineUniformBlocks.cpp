@@ -6,47 +6,207 @@
 */
 #include "renderer/RendererCommon/InlineUniformBlocks.hpp"
 
+#include <algorithm>
 #include <cstring>
 
 namespace ashes
 {
-	InlineUboPtr createInlineUbo( VkDevice device
-		, VkWriteDescriptorSetInlineUniformBlockEXT const & inlineUniform
+	namespace
+	{
+		VkDeviceSize constexpr PageSize = 64u * 1024u;
+		uint32_t constexpr DedicatedClass = ~0u;
+
+		VkDeviceSize getPowerOfTwo( VkDeviceSize value )
+		{
+			VkDeviceSize result = 1u;
+
+			while ( result < value )
+			{
+				result <<= 1u;
+			}
+
+			return result;
+		}
+	}
+
+	//*********************************************************************************************
+
+	InlineUbo::InlineUbo( InlineUboAllocator & allocator
+		, VkDescriptorBufferInfo info
+		, VkDeviceMemory memory
+		, uint8_t * data
+		, uint32_t sizeClass )
+		: allocator{ allocator }
+		, info{ std::move( info ) }
+		, memory{ memory }
+		, data{ data }
+		, sizeClass{ sizeClass }
+	{
+	}
+
+	InlineUbo::~InlineUbo()
+	{
+		allocator.release( *this );
+	}
+
+	//*********************************************************************************************
+
+	InlineUboAllocator::InlineUboAllocator( VkDevice device
 		, VkPhysicalDeviceMemoryProperties const & memoryProperties
-		, PFN_vkCreateBuffer createBuffer
-		, PFN_vkGetBufferMemoryRequirements getMemoryRequirements
-		, PFN_vkAllocateMemory allocateMemory
-		, PFN_vkBindBufferMemory bindMemory
-		, PFN_vkMapMemory mapMemory
-		, PFN_vkFlushMappedMemoryRanges flushMemory
-		, PFN_vkUnmapMemory unmapMemory )
+		, VkDeviceSize alignment
+		, InlineUboFunctions functions )
+		: m_device{ device }
+		, m_memoryProperties{ memoryProperties }
+		, m_alignment{ getPowerOfTwo( std::max< VkDeviceSize >( 16u, alignment ) ) }
+		, m_functions{ std::move( functions ) }
+	{
+		m_free.resize( doGetSizeClass( std::max( PageSize, m_alignment ) ) + 1u );
+	}
+
+	InlineUboAllocator::~InlineUboAllocator()
+	{
+		for ( auto & page : m_pages )
+		{
+			doDestroyPage( page );
+		}
+
+		for ( auto & dedicated : m_dedicated )
+		{
+			doDestroyPage( dedicated.second );
+		}
+	}
+
+	InlineUboPtr InlineUboAllocator::allocate( VkWriteDescriptorSetInlineUniformBlockEXT const & inlineUniform )
+	{
+		auto size = getAlignedSize( VkDeviceSize( inlineUniform.dataSize ), m_alignment );
+		auto sizeClass = doGetSizeClass( size );
+		Slot slot{};
+		std::unique_lock< std::mutex > lock{ m_mutex };
+
+		if ( sizeClass < m_free.size() )
+		{
+			auto & free = m_free[sizeClass];
+
+			if ( free.empty() )
+			{
+				// Carve a new page into slots of this class.
+				Page page{};
+				auto pageSize = std::max( PageSize, m_alignment );
+
+				if ( !doCreatePage( pageSize, page ) )
+				{
+					return nullptr;
+				}
+
+				auto slotSize = m_alignment << sizeClass;
+
+				for ( auto offset = pageSize; offset >= slotSize; offset -= slotSize )
+				{
+					free.push_back( Slot{ page.buffer
+						, page.memory
+						, offset - slotSize
+						, page.data + offset - slotSize } );
+				}
+
+				m_pages.push_back( page );
+			}
+
+			slot = free.back();
+			free.pop_back();
+			size = m_alignment << sizeClass;
+		}
+		else
+		{
+			Page page{};
+
+			if ( !doCreatePage( size, page ) )
+			{
+				return nullptr;
+			}
+
+			sizeClass = DedicatedClass;
+			slot = Slot{ page.buffer, page.memory, 0u, page.data };
+			m_dedicated.emplace( page.buffer, page );
+		}
+
+		lock.unlock();
+		std::memcpy( slot.data, inlineUniform.pData, inlineUniform.dataSize );
+		VkMappedMemoryRange range
+		{
+			VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE,
+			nullptr,
+			slot.memory,
+			slot.offset,
+			size
+		};
+		m_functions.flushMemory( m_device, 1u, &range );
+		return std::make_unique< InlineUbo >( *this
+			, VkDescriptorBufferInfo{ slot.buffer, slot.offset, size }
+			, slot.memory
+			, slot.data
+			, sizeClass );
+	}
+
+	void InlineUboAllocator::release( InlineUbo const & ubo )
+	{
+		std::lock_guard< std::mutex > lock{ m_mutex };
+
+		if ( ubo.sizeClass == DedicatedClass )
+		{
+			auto it = m_dedicated.find( ubo.info.buffer );
+			assert( it != m_dedicated.end() );
+			doDestroyPage( it->second );
+			m_dedicated.erase( it );
+		}
+		else
+		{
+			m_free[ubo.sizeClass].push_back( Slot{ ubo.info.buffer
+				, ubo.memory
+				, ubo.info.offset
+				, ubo.data } );
+		}
+	}
+
+	uint32_t InlineUboAllocator::doGetSizeClass( VkDeviceSize size )const
+	{
+		uint32_t result = 0u;
+
+		while ( ( m_alignment << result ) < size )
+		{
+			++result;
+		}
+
+		return result;
+	}
+
+	bool InlineUboAllocator::doCreatePage( VkDeviceSize size
+		, Page & page )
 	{
-		InlineUboPtr inlineUbo = std::make_unique< InlineUbo >();
 		VkBufferCreateInfo buffer
 		{
 			VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
 			nullptr,
 			0u,
-			inlineUniform.dataSize,
+			size,
 			VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
 			VK_SHARING_MODE_EXCLUSIVE,
 			0u,
 			nullptr,
 		};
-		auto res = createBuffer( device
+		auto res = m_functions.createBuffer( m_device
 			, &buffer
 			, nullptr
-			, &inlineUbo->buffer );
+			, &page.buffer );
 
 		if ( res == VK_SUCCESS )
 		{
 			VkMemoryRequirements requirements;
-			getMemoryRequirements( device
-				, inlineUbo->buffer
+			m_functions.getMemoryRequirements( m_device
+				, page.buffer
 				, &requirements );
 			auto deduced = deduceMemoryType( requirements.memoryTypeBits
 				, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT
-				, memoryProperties );
+				, m_memoryProperties );
 			VkMemoryAllocateInfo allocate
 			{
 				VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
@@ -54,44 +214,52 @@ namespace ashes
 				requirements.size,
 				deduced
 			};
-			res = allocateMemory( device
+			res = m_functions.allocateMemory( m_device
 				, &allocate
 				, nullptr
-				, &inlineUbo->memory );
+				, &page.memory );
+		}
 
-			if ( res == VK_SUCCESS )
-			{
-				res = bindMemory( device, inlineUbo->buffer, inlineUbo->memory, 0u );
+		if ( res == VK_SUCCESS )
+		{
+			res = m_functions.bindMemory( m_device, page.buffer, page.memory, 0u );
+		}
 
-				if ( res == VK_SUCCESS )
-				{
-					uint8_t * buffer{ nullptr };
-
-					if ( mapMemory( device, inlineUbo->memory, 0, requirements.size, 0u, reinterpret_cast< void ** >( &buffer ) ) == VK_SUCCESS )
-					{
-						std::memcpy( buffer, inlineUniform.pData, inlineUniform.dataSize );
-						VkMappedMemoryRange range
-						{
-							VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE,
-							nullptr,
-							inlineUbo->memory,
-							0u,
-							requirements.size
-						};
-						flushMemory( device, 1u, &range );
-						unmapMemory( device, inlineUbo->memory );
-					}
-
-					inlineUbo->info =
-					{
-						inlineUbo->buffer,
-						0u,
-						requirements.size,
-					};
-				}
-			}
+		if ( res == VK_SUCCESS )
+		{
+			// Pages stay mapped until their destruction, the slots being written independently.
+			res = m_functions.mapMemory( m_device
+				, page.memory
+				, 0u
+				, WholeSize
+				, 0u
+				, reinterpret_cast< void ** >( &page.data ) );
+		}
+
+		if ( res != VK_SUCCESS )
+		{
+			doDestroyPage( page );
+			return false;
+		}
+
+		return true;
+	}
+
+	void InlineUboAllocator::doDestroyPage( Page const & page )
+	{
+		if ( page.data )
+		{
+			m_functions.unmapMemory( m_device, page.memory );
+		}
+
+		if ( page.buffer )
+		{
+			m_functions.destroyBuffer( m_device, page.buffer, nullptr );
 		}
 
-		return inlineUbo;
+		if ( page.memory )
+		{
+			m_functions.freeMemory( m_device, page.memory, nullptr );
+		}
 	}
 }
@@ -12,29 +12,112 @@
 
 #include <ashes/ashes.hpp>
 
+#include <map>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 namespace ashes
 {
+	class InlineUboAllocator;
+
 	struct InlineUbo
 	{
-		VkBuffer buffer;
-		VkDeviceMemory memory;
+		InlineUbo( InlineUboAllocator & allocator
+			, VkDescriptorBufferInfo info
+			, VkDeviceMemory memory
+			, uint8_t * data
+			, uint32_t sizeClass );
+		~InlineUbo();
+
+		InlineUboAllocator & allocator;
 		VkDescriptorBufferInfo info;
+		VkDeviceMemory memory;
+		uint8_t * data;
+		uint32_t sizeClass;
 	};
 	using InlineUboPtr = std::unique_ptr< InlineUbo >;
-	using InlineUboArray = std::vector< InlineUboPtr >;
-
-	InlineUboPtr createInlineUbo( VkDevice device
-		, VkWriteDescriptorSetInlineUniformBlockEXT const & inlineUniform
-		, VkPhysicalDeviceMemoryProperties const & memoryProperties
-		, PFN_vkCreateBuffer createBuffer
-		, PFN_vkGetBufferMemoryRequirements getMemoryRequirements
-		, PFN_vkAllocateMemory allocateMemory
-		, PFN_vkBindBufferMemory bindMemory
-		, PFN_vkMapMemory mapMemory
-		, PFN_vkFlushMappedMemoryRanges flushMemory
-		, PFN_vkUnmapMemory unmapMemory );
+	// Indexed by ( binding << 32 ) | dstArrayElement.
+	using InlineUboMap = std::map< uint64_t, InlineUboPtr >;
 
+	inline uint64_t makeInlineUboKey( uint32_t binding
+		, uint32_t arrayElement )
+	{
+		return ( uint64_t( binding ) << 32u ) | uint64_t( arrayElement );
+	}
+
+	struct InlineUboFunctions
+	{
+		PFN_vkCreateBuffer createBuffer;
+		PFN_vkDestroyBuffer destroyBuffer;
+		PFN_vkGetBufferMemoryRequirements getMemoryRequirements;
+		PFN_vkAllocateMemory allocateMemory;
+		PFN_vkFreeMemory freeMemory;
+		PFN_vkBindBufferMemory bindMemory;
+		PFN_vkMapMemory mapMemory;
+		PFN_vkFlushMappedMemoryRanges flushMemory;
+		PFN_vkUnmapMemory unmapMemory;
+	};
+	/**
+	*\brief
+	*	Device wide storage for inline uniform blocks.
+	*\remarks
+	*	Blocks are suballocated from persistently mapped pages, each page being
+	*	split in slots of a single power of two size.
+	*	A slot goes back to its size class free list when the descriptor set
+	*	write owning it is replaced, or when the set is destroyed (freed, or
+	*	its pool reset).
+	*	Blocks larger than a page get a buffer of their own.
+	*/
+	class InlineUboAllocator
+	{
+	public:
+		InlineUboAllocator( VkDevice device
+			, VkPhysicalDeviceMemoryProperties const & memoryProperties
+			, VkDeviceSize alignment
+			, InlineUboFunctions functions );
+		~InlineUboAllocator();
+		/**
+		*\brief
+		*	Allocates a slot and fills it with the write's data.
+		*/
+		InlineUboPtr allocate( VkWriteDescriptorSetInlineUniformBlockEXT const & inlineUniform );
+
+	private:
+		friend struct InlineUbo;
+
+		struct Page
+		{
+			VkBuffer buffer{};
+			VkDeviceMemory memory{};
+			uint8_t * data{};
+		};
+
+		struct Slot
+		{
+			VkBuffer buffer;
+			VkDeviceMemory memory;
+			VkDeviceSize offset;
+			uint8_t * data;
+		};
+
+		void release( InlineUbo const & ubo );
+		uint32_t doGetSizeClass( VkDeviceSize size )const;
+		bool doCreatePage( VkDeviceSize size
+			, Page & page );
+		void doDestroyPage( Page const & page );
+
+	private:
+		VkDevice m_device;
+		VkPhysicalDeviceMemoryProperties m_memoryProperties;
+		VkDeviceSize m_alignment;
+		InlineUboFunctions m_functions;
+		std::mutex m_mutex;
+		std::vector< Page > m_pages;
+		// Free slots, per size class.
+		std::vector< std::vector< Slot > > m_free;
+		// Blocks larger than a page, indexed by their buffer.
+		std::map< VkBuffer, Page > m_dedicated;
+	};
+	using InlineUboAllocatorPtr = std::unique_ptr< InlineUboAllocator >;
 }
@@ -53,13 +53,20 @@ namespace ashes
 	}
 
 	void BufferBase::bindMemory( DeviceMemoryPtr memory )
+	{
+		bindMemory( std::make_unique< MemoryAllocation >( std::move( memory )
+			, 0u
+			, WholeSize ) );
+	}
+
+	void BufferBase::bindMemory( MemoryAllocationPtr allocation )
 	{
 		assert( !m_storage && "A resource can only be bound once to a device memory object." );
-		m_storage = std::move( memory );
+		m_storage = std::move( allocation );
 		auto res = m_device.vkBindBufferMemory( m_device
 			, m_internal
-			, static_cast< DeviceMemory const & >( *m_storage )
-			, 0 );
+			, m_storage->getMemory()
+			, m_storage->getOffset() );
 		checkError( res, "Buffer memory binding" );
 	}
 
@@ -28,6 +28,11 @@ namespace ashes
 		m_buffer->bindMemory( std::move( memory ) );
 	}
 
+	void UniformBuffer::bindMemory( MemoryAllocationPtr allocation )
+	{
+		m_buffer->bindMemory( std::move( allocation ) );
+	}
+
 	VkMemoryRequirements UniformBuffer::getMemoryRequirements()const
 	{
 		return m_buffer->getMemoryRequirements();
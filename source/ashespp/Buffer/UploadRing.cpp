@@ -0,0 +1,322 @@
+/*
+This file belongs to Ashes.
+See LICENSE file in root folder.
+*/
+#include "ashespp/Buffer/UploadRing.hpp"
+
+#include "ashespp/Command/CommandBuffer.hpp"
+#include "ashespp/Command/CommandPool.hpp"
+#include "ashespp/Command/Queue.hpp"
+#include "ashespp/Core/Device.hpp"
+#include "ashespp/Image/Image.hpp"
+#include "ashespp/Image/ImageView.hpp"
+#include "ashespp/Sync/Fence.hpp"
+
+#include <ashes/common/Exception.hpp>
+
+#include <cstring>
+#include <numeric>
+
+namespace ashes
+{
+	namespace
+	{
+		VkDeviceSize alignUp( VkDeviceSize value
+			, VkDeviceSize align )
+		{
+			return ( ( value + align - 1u ) / align ) * align;
+		}
+
+		DeviceMemoryPtr allocateRingMemory( Device const & device
+			, BufferBase const & buffer
+			, bool & coherent )
+		{
+			auto requirements = buffer.getMemoryRequirements();
+			uint32_t deduced{};
+
+			try
+			{
+				deduced = device.deduceMemoryType( requirements.memoryTypeBits
+					, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT );
+				coherent = true;
+			}
+			catch ( Exception & )
+			{
+				deduced = device.deduceMemoryType( requirements.memoryTypeBits
+					, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT );
+				coherent = false;
+			}
+
+			return device.allocateMemory( VkMemoryAllocateInfo
+				{
+					VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+					nullptr,
+					requirements.size,
+					deduced
+				} );
+		}
+	}
+
+	UploadRing::UploadRing( Device const & device
+		, Queue const & queue
+		, VkDeviceSize size
+		, uint32_t batchCount )
+		: m_device{ device }
+		, m_queue{ queue }
+		, m_size{ size }
+		, m_commandPool{ device.createCommandPool( queue.getFamilyIndex()
+			, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT | VK_COMMAND_POOL_CREATE_TRANSIENT_BIT ) }
+		, m_buffer{ device.createBuffer( size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT ) }
+		, m_storage{ allocateRingMemory( device, *m_buffer, m_coherent ) }
+		, m_batches( std::max( 1u, batchCount ) )
+	{
+		m_buffer->bindMemory( m_storage );
+		m_mapped = m_buffer->lock( 0u, WholeSize, 0u );
+
+		if ( !m_mapped )
+		{
+			throw Exception{ VK_ERROR_MEMORY_MAP_FAILED, "Upload ring storage memory mapping" };
+		}
+
+		for ( auto & batch : m_batches )
+		{
+			batch.commandBuffer = m_commandPool->createCommandBuffer( VK_COMMAND_BUFFER_LEVEL_PRIMARY );
+			batch.fence = m_device.createFence();
+		}
+	}
+
+	UploadRing::~UploadRing()
+	{
+		waitIdle();
+		m_buffer->unlock();
+	}
+
+	UploadRing::Ticket UploadRing::uploadBufferData( uint8_t const * const data
+		, VkDeviceSize size
+		, VkDeviceSize offset
+		, BufferBase const & buffer
+		, VkAccessFlags dstAccessFlags
+		, VkPipelineStageFlags dstStageFlags )
+	{
+		auto srcOffset = doAllocate( size
+			, std::max< VkDeviceSize >( 4u, m_device.getProperties().limits.optimalBufferCopyOffsetAlignment ) );
+		doCopy( data, size, srcOffset );
+		auto & commandBuffer = doGetCommandBuffer();
+		commandBuffer.memoryBarrier( buffer.getCompatibleStageFlags()
+			, VK_PIPELINE_STAGE_TRANSFER_BIT
+			, buffer.makeTransferDestination() );
+		commandBuffer.copyBuffer( VkBufferCopy{ srcOffset, offset, size }
+			, *m_buffer
+			, buffer );
+		commandBuffer.memoryBarrier( VK_PIPELINE_STAGE_TRANSFER_BIT
+			, dstStageFlags
+			, buffer.makeMemoryTransitionBarrier( dstAccessFlags ) );
+		return Ticket{ m_recording->id };
+	}
+
+	UploadRing::Ticket UploadRing::uploadTextureData( VkImageSubresourceLayers const & subresourceLayers
+		, VkFormat format
+		, VkOffset3D const & offset
+		, VkExtent3D const & extent
+		, uint8_t const * const data
+		, ImageView const & view
+		, VkPipelineStageFlags dstStageFlags )
+	{
+		// Copy offsets must be a multiple of both 4 and the texel block size.
+		auto alignment = std::lcm( std::lcm( VkDeviceSize( 4u ), getMinimalSize( format ) )
+			, std::max< VkDeviceSize >( 1u, m_device.getProperties().limits.optimalBufferCopyOffsetAlignment ) );
+		auto size = getSize( extent, format ) * subresourceLayers.layerCount;
+		auto srcOffset = doAllocate( size, alignment );
+		doCopy( data, size, srcOffset );
+		auto & commandBuffer = doGetCommandBuffer();
+		commandBuffer.memoryBarrier( VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT
+			, VK_PIPELINE_STAGE_TRANSFER_BIT
+			, view.makeTransferDestination( VK_IMAGE_LAYOUT_UNDEFINED ) );
+		commandBuffer.copyToImage( VkBufferImageCopy
+			{
+				srcOffset,
+				0u,
+				0u,
+				subresourceLayers,
+				offset,
+				extent,
+			}
+			, *m_buffer
+			, *view.image );
+		commandBuffer.memoryBarrier( VK_PIPELINE_STAGE_TRANSFER_BIT
+			, dstStageFlags
+			, view.makeShaderInputResource( VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL ) );
+		return Ticket{ m_recording->id };
+	}
+
+	UploadRing::Ticket UploadRing::uploadTextureData( VkFormat format
+		, uint8_t const * const data
+		, ImageView const & view
+		, VkPipelineStageFlags dstStageFlags )
+	{
+		auto & range = view->subresourceRange;
+		auto extent = getSubresourceDimensions( view.image->getDimensions()
+			, range.baseMipLevel );
+		return uploadTextureData( VkImageSubresourceLayers
+			{
+				getAspectMask( view->format ),
+				range.baseMipLevel,
+				range.baseArrayLayer,
+				range.layerCount,
+			}
+			, format
+			, VkOffset3D{}
+			, extent
+			, data
+			, view
+			, dstStageFlags );
+	}
+
+	UploadRing::Ticket UploadRing::flush()
+	{
+		if ( m_recording )
+		{
+			doSubmit();
+		}
+
+		return Ticket{ m_nextId - 1u };
+	}
+
+	bool UploadRing::isComplete( Ticket const & ticket )
+	{
+		doPoll();
+		return ticket.batch <= m_completed;
+	}
+
+	void UploadRing::wait( Ticket const & ticket )
+	{
+		if ( m_recording && ticket.batch >= m_recording->id )
+		{
+			doSubmit();
+		}
+
+		doRetire( ticket.batch );
+	}
+
+	void UploadRing::waitIdle()
+	{
+		wait( flush() );
+	}
+
+	CommandBuffer const & UploadRing::doGetCommandBuffer()
+	{
+		if ( !m_recording )
+		{
+			auto id = m_nextId;
+			auto & batch = m_batches[id % m_batches.size()];
+			// The batch previously using this slot must be done before it is rerecorded.
+			doRetire( batch.id );
+			batch.id = id;
+			batch.commandBuffer->reset();
+			batch.commandBuffer->begin( VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT );
+			m_recording = &batch;
+			++m_nextId;
+		}
+
+		return *m_recording->commandBuffer;
+	}
+
+	VkDeviceSize UploadRing::doAllocate( VkDeviceSize size
+		, VkDeviceSize alignment )
+	{
+		if ( size > m_size )
+		{
+			throw Exception{ VK_ERROR_OUT_OF_DEVICE_MEMORY, "Upload is larger than the upload ring" };
+		}
+
+		while ( true )
+		{
+			auto physical = m_head % m_size;
+			auto aligned = alignUp( physical, alignment );
+			auto position = ( aligned + size > m_size )
+				? m_head - physical + m_size
+				: m_head - physical + aligned;
+
+			if ( position + size - m_tail <= m_size )
+			{
+				m_head = position + size;
+				return position % m_size;
+			}
+
+			if ( m_tail == m_head )
+			{
+				// Nothing in flight, restart from the beginning of the ring.
+				m_head = m_head - physical + m_size;
+				m_tail = m_head;
+			}
+			else if ( m_completed + 1u < m_nextId - ( m_recording ? 1u : 0u ) )
+			{
+				// Reclaim the oldest submitted batch.
+				doRetire( m_completed + 1u );
+			}
+			else
+			{
+				// Only the batch being recorded holds ring space.
+				assert( m_recording );
+				doSubmit();
+			}
+		}
+	}
+
+	void UploadRing::doCopy( uint8_t const * const data
+		, VkDeviceSize size
+		, VkDeviceSize offset )
+	{
+		std::memcpy( m_mapped + offset, data, size );
+
+		if ( !m_coherent )
+		{
+			auto atomSize = m_device.getProperties().limits.nonCoherentAtomSize;
+			auto begin = ( offset / atomSize ) * atomSize;
+			auto end = std::min( alignUp( offset + size, atomSize ), m_size );
+			m_buffer->flush( begin, end - begin );
+		}
+	}
+
+	void UploadRing::doSubmit()
+	{
+		auto & batch = *m_recording;
+		m_recording = nullptr;
+		batch.end = m_head;
+		batch.commandBuffer->end();
+		batch.fence->reset();
+		m_queue.submit( *batch.commandBuffer
+			, batch.fence.get() );
+	}
+
+	void UploadRing::doRetire( uint64_t id )
+	{
+		assert( !m_recording || id < m_recording->id );
+
+		while ( m_completed < id )
+		{
+			auto & batch = m_batches[( m_completed + 1u ) % m_batches.size()];
+			batch.fence->wait( MaxTimeout );
+			m_tail = batch.end;
+			++m_completed;
+		}
+	}
+
+	void UploadRing::doPoll()
+	{
+		auto submitted = m_nextId - ( m_recording ? 2u : 1u );
+
+		while ( m_completed < submitted )
+		{
+			auto & batch = m_batches[( m_completed + 1u ) % m_batches.size()];
+
+			if ( batch.fence->wait( 0u ) != WaitResult::eSuccess )
+			{
+				break;
+			}
+
+			m_tail = batch.end;
+			++m_completed;
+		}
+	}
+}
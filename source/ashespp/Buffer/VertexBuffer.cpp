@@ -23,6 +23,11 @@ namespace ashes
 		m_buffer->bindMemory( std::move( memory ) );
 	}
 
+	void VertexBufferBase::bindMemory( MemoryAllocationPtr allocation )
+	{
+		m_buffer->bindMemory( std::move( allocation ) );
+	}
+
 	VkMemoryRequirements VertexBufferBase::getMemoryRequirements()const
 	{
 		return m_buffer->getMemoryRequirements();
@@ -90,7 +90,8 @@ namespace ashes
 
 	void CommandBuffer::executeCommands( CommandBufferCRefArray const & commands )const
 	{
-		auto vkCommands = makeVkArray< VkCommandBuffer >( commands );
+		SmallArray< VkCommandBuffer > vkCommands;
+		fillVkArray( commands, vkCommands );
 		m_device.vkCmdExecuteCommands( m_internal
 			, uint32_t( vkCommands.size() )
 			, vkCommands.data() );
@@ -146,15 +147,29 @@ namespace ashes
 
 	void CommandBuffer::bindVertexBuffers( uint32_t firstBinding
 		, BufferCRefArray const & buffers
-		, UInt64Array offsets )const
+		, UInt64Array const & offsets )const
 	{
+		SmallArray< VkBuffer > vkBuffers;
+		fillVkArray( buffers, vkBuffers );
 		m_device.vkCmdBindVertexBuffers( m_internal
 			, firstBinding
-			, uint32_t( buffers.size() )
-			, makeVkArray< VkBuffer >( buffers ).data()
+			, uint32_t( vkBuffers.size() )
+			, vkBuffers.data()
 			, offsets.data() );
 	}
 
+	void CommandBuffer::bindVertexBuffers( uint32_t firstBinding
+		, ArrayView< VkBuffer const > buffers
+		, ArrayView< VkDeviceSize const > offsets )const
+	{
+		assert( buffers.size() == offsets.size() );
+		m_device.vkCmdBindVertexBuffers( m_internal
+			, firstBinding
+			, uint32_t( buffers.size() )
+			, buffers.begin()
+			, offsets.begin() );
+	}
+
 	void CommandBuffer::bindIndexBuffer( BufferBase const & buffer
 		, uint64_t offset
 		, VkIndexType indexType )const
@@ -170,17 +185,34 @@ namespace ashes
 		, UInt32Array const & dynamicOffsets
 		, VkPipelineBindPoint bindingPoint )const
 	{
-		auto vkDescriptors = makeVkArray< VkDescriptorSet >( descriptorSets );
+		SmallArray< VkDescriptorSet > vkDescriptors;
+		fillVkArray( descriptorSets, vkDescriptors );
 		m_device.vkCmdBindDescriptorSets( m_internal
 			, bindingPoint
 			, layout
 			, descriptorSets.begin()->get().getBindingPoint()
-			, uint32_t( descriptorSets.size() )
+			, uint32_t( vkDescriptors.size() )
 			, vkDescriptors.data()
 			, uint32_t( dynamicOffsets.size() )
 			, dynamicOffsets.data() );
 	}
 
+	void CommandBuffer::bindDescriptorSets( uint32_t firstSet
+		, ArrayView< VkDescriptorSet const > descriptorSets
+		, PipelineLayout const & layout
+		, ArrayView< uint32_t const > dynamicOffsets
+		, VkPipelineBindPoint bindingPoint )const
+	{
+		m_device.vkCmdBindDescriptorSets( m_internal
+			, bindingPoint
+			, layout
+			, firstSet
+			, uint32_t( descriptorSets.size() )
+			, descriptorSets.begin()
+			, uint32_t( dynamicOffsets.size() )
+			, dynamicOffsets.begin() );
+	}
+
 	void CommandBuffer::setViewport( uint32_t firstViewport
 		, VkViewportArray const & viewports )const
 	{
@@ -199,6 +231,24 @@ namespace ashes
 			, scissors.data() );
 	}
 
+	void CommandBuffer::setViewport( uint32_t firstViewport
+		, ArrayView< VkViewport const > viewports )const
+	{
+		m_device.vkCmdSetViewport( m_internal
+			, firstViewport
+			, uint32_t( viewports.size() )
+			, viewports.begin() );
+	}
+
+	void CommandBuffer::setScissor( uint32_t firstScissor
+		, ArrayView< VkRect2D const > scissors )const
+	{
+		m_device.vkCmdSetScissor( m_internal
+			, firstScissor
+			, uint32_t( scissors.size() )
+			, scissors.begin() );
+	}
+
 	void CommandBuffer::draw( uint32_t vtxCount
 		, uint32_t instCount
 		, uint32_t firstVertex
@@ -428,7 +478,8 @@ namespace ashes
 		, VkBufferMemoryBarrierArray const & bufferMemoryBarriers
 		, VkImageMemoryBarrierArray const & imageMemoryBarriers )const
 	{
-		auto vkevents = makeVkArray< VkEvent >( events );
+		SmallArray< VkEvent > vkevents;
+		fillVkArray( events, vkevents );
 		m_device.vkCmdWaitEvents( m_internal
 			, uint32_t( vkevents.size() )
 			, vkevents.data()
@@ -492,9 +543,43 @@ namespace ashes
 		, BufferBase const & buffer
 		, uint64_t offset )const
 	{
-		bindVertexBuffers( binding
-			, BufferCRefArray{ buffer }
-			, UInt64Array{ offset } );
+		VkBuffer vkBuffer = buffer;
+		m_device.vkCmdBindVertexBuffers( m_internal
+			, binding
+			, 1u
+			, &vkBuffer
+			, &offset );
+	}
+
+	void CommandBuffer::bindDescriptorSet( DescriptorSet const & descriptorSet
+		, PipelineLayout const & layout
+		, UInt32Array const & dynamicOffsets
+		, VkPipelineBindPoint bindingPoint )const
+	{
+		VkDescriptorSet vkDescriptorSet = descriptorSet;
+		m_device.vkCmdBindDescriptorSets( m_internal
+			, bindingPoint
+			, layout
+			, descriptorSet.getBindingPoint()
+			, 1u
+			, &vkDescriptorSet
+			, uint32_t( dynamicOffsets.size() )
+			, dynamicOffsets.data() );
+	}
+
+	void CommandBuffer::bindDescriptorSet( DescriptorSet const & descriptorSet
+		, PipelineLayout const & layout
+		, VkPipelineBindPoint bindingPoint )const
+	{
+		VkDescriptorSet vkDescriptorSet = descriptorSet;
+		m_device.vkCmdBindDescriptorSets( m_internal
+			, bindingPoint
+			, layout
+			, descriptorSet.getBindingPoint()
+			, 1u
+			, &vkDescriptorSet
+			, 0u
+			, nullptr );
 	}
 
 	void CommandBuffer::copyToImage( VkBufferImageCopy const & copyInfo
@@ -12,6 +12,30 @@ See LICENSE file in root folder.
 
 namespace ashes
 {
+	namespace
+	{
+		template< typename ValueT >
+		ValueT const * getData( ArrayView< ValueT const > const & view )
+		{
+			return view.empty()
+				? nullptr
+				: view.begin();
+		}
+
+		template< typename ValueT >
+		ArrayView< ValueT const > makeSingleView( ValueT const & value )
+		{
+			return ArrayView< ValueT const >{ &value, &value + 1u };
+		}
+
+		template< typename ContainerT >
+		auto makeView( ContainerT const & values )->ArrayView< typename ContainerT::value_type const >
+		{
+			using ValueT = typename ContainerT::value_type;
+			return ArrayView< ValueT const >{ values.data(), values.data() + values.size() };
+		}
+	}
+
 	Queue::Queue( Device const & device
 		, uint32_t familyIndex
 		, uint32_t index )
@@ -31,15 +55,30 @@ namespace ashes
 		unregisterObject( m_device, this );
 	}
 
-	VkResult Queue::present( SwapChain const & swapChain
-		, uint32_t imageIndex
-		, Semaphore const & semaphoreToWait )const
+	void Queue::submit( ArrayView< VkCommandBuffer const > commandBuffers
+		, ArrayView< VkSemaphore const > semaphoresToWait
+		, ArrayView< VkPipelineStageFlags const > semaphoresStage
+		, ArrayView< VkSemaphore const > semaphoresToSignal
+		, VkFence fence )const
 	{
-		UInt32Array indices;
-		indices.push_back( imageIndex );
-		return present( SwapChainCRefArray{ { std::ref( swapChain ) } }
-			, indices
-			, SemaphoreCRefArray{ { std::ref( semaphoreToWait ) } } ).front();
+		VkSubmitInfo submitInfo
+		{
+			VK_STRUCTURE_TYPE_SUBMIT_INFO,
+			nullptr,
+			static_cast< uint32_t >( semaphoresToWait.size() ),        // waitSemaphoreCount
+			getData( semaphoresToWait ),                               // pWaitSemaphores
+			getData( semaphoresStage ),                                // pWaitDstStageMask
+			static_cast< uint32_t >( commandBuffers.size() ),          // commandBufferCount
+			getData( commandBuffers ),                                 // pCommandBuffers
+			static_cast< uint32_t >( semaphoresToSignal.size() ),      // signalSemaphoreCount
+			getData( semaphoresToSignal )                              // pSignalSemaphores
+		};
+		DEBUG_DUMP( submitInfo );
+		auto res = m_device.vkQueueSubmit( m_internal
+			, 1u
+			, &submitInfo
+			, fence );
+		checkError( res, "Queue submit" );
 	}
 
 	void Queue::submit( CommandBufferCRefArray const & commandBuffers
@@ -48,66 +87,99 @@ namespace ashes
 		, SemaphoreCRefArray const & semaphoresToSignal
 		, Fence const * fence )const
 	{
-		auto vkCommandBuffers = makeVkArray< VkCommandBuffer >( commandBuffers );
-		auto vkSemaphoresToWait = makeVkArray< VkSemaphore >( semaphoresToWait );
-		auto vkSemaphoresToSignal = makeVkArray< VkSemaphore >( semaphoresToSignal );
+		SmallArray< VkCommandBuffer > vkCommandBuffers;
+		SmallArray< VkSemaphore > vkSemaphoresToWait;
+		SmallArray< VkSemaphore > vkSemaphoresToSignal;
+		fillVkArray( commandBuffers, vkCommandBuffers );
+		fillVkArray( semaphoresToWait, vkSemaphoresToWait );
+		fillVkArray( semaphoresToSignal, vkSemaphoresToSignal );
+		submit( makeView( vkCommandBuffers )
+			, makeView( vkSemaphoresToWait )
+			, makeView( semaphoresStage )
+			, makeView( vkSemaphoresToSignal )
+			, fence ? static_cast< VkFence >( *fence ) : VK_NULL_HANDLE );
+	}
 
-		std::vector< VkSubmitInfo > submitInfo
-		{
-			{
-				VK_STRUCTURE_TYPE_SUBMIT_INFO,
-				nullptr,
-				static_cast< uint32_t >( vkSemaphoresToWait.size() ),      // waitSemaphoreCount
-				vkSemaphoresToWait.empty()                                 // pWaitSemaphores
-					? nullptr
-					: vkSemaphoresToWait.data(),
-				semaphoresStage.empty()                                    // pWaitDstStageMask
-					? nullptr
-					: semaphoresStage.data(),
-				static_cast< uint32_t >( vkCommandBuffers.size() ),        // commandBufferCount
-				vkCommandBuffers.empty()                                   // pCommandBuffers
-					? nullptr
-					: vkCommandBuffers.data(),
-				static_cast< uint32_t >( vkSemaphoresToSignal.size() ),    // signalSemaphoreCount
-				vkSemaphoresToSignal.empty()                               // pSignalSemaphores
-					? nullptr
-					: vkSemaphoresToSignal.data()
-			}
-		};
-		DEBUG_DUMP( submitInfo );
-		auto res = m_device.vkQueueSubmit( m_internal
-			, static_cast< uint32_t >( submitInfo.size() )
-			, submitInfo.data()
+	void Queue::submit( CommandBuffer const & commandBuffer
+		, Fence const * fence )const
+	{
+		VkCommandBuffer vkCommandBuffer = commandBuffer;
+		submit( makeSingleView( vkCommandBuffer )
+			, {}
+			, {}
+			, {}
 			, fence ? static_cast< VkFence >( *fence ) : VK_NULL_HANDLE );
-		checkError( res, "Queue submit" );
 	}
 
-	VkResultArray Queue::present( SwapChainCRefArray const & swapChains
-		, UInt32Array const & imagesIndex
-		, SemaphoreCRefArray const & semaphoresToWait )const
+	void Queue::submit( CommandBuffer const & commandBuffer
+		, Semaphore const & semaphoreToWait
+		, VkPipelineStageFlags const & semaphoreStage
+		, Semaphore const & semaphoreToSignal
+		, Fence const * fence )const
+	{
+		VkCommandBuffer vkCommandBuffer = commandBuffer;
+		VkSemaphore vkSemaphoreToWait = semaphoreToWait;
+		VkSemaphore vkSemaphoreToSignal = semaphoreToSignal;
+		submit( makeSingleView( vkCommandBuffer )
+			, makeSingleView( vkSemaphoreToWait )
+			, makeSingleView( semaphoreStage )
+			, makeSingleView( vkSemaphoreToSignal )
+			, fence ? static_cast< VkFence >( *fence ) : VK_NULL_HANDLE );
+	}
+
+	VkResult Queue::present( ArrayView< VkSwapchainKHR const > swapChains
+		, ArrayView< uint32_t const > imagesIndex
+		, ArrayView< VkSemaphore const > semaphoresToWait
+		, VkResult * results )const
 	{
 		assert( swapChains.size() == imagesIndex.size() );
-		auto vkSwapchains = makeVkArray< VkSwapchainKHR >( swapChains );
-		auto vkSemaphoresToWait = makeVkArray< VkSemaphore >( semaphoresToWait );
-		std::vector< VkResult > results;
-		results.resize( swapChains.size() );
 		VkPresentInfoKHR presentInfo
 		{
 			VK_STRUCTURE_TYPE_PRESENT_INFO_KHR,
 			nullptr,
-			static_cast< uint32_t >( vkSemaphoresToWait.size() ),    // waitSemaphoreCount
-			vkSemaphoresToWait.data(),                               // pWaitSemaphores
-			static_cast< uint32_t >( imagesIndex.size() ),           // swapchainCount
-			vkSwapchains.data(),                                     // pSwapchains
-			imagesIndex.data(),                                      // pImageIndices
-			results.data()                                           // pResults
+			static_cast< uint32_t >( semaphoresToWait.size() ),      // waitSemaphoreCount
+			getData( semaphoresToWait ),                             // pWaitSemaphores
+			static_cast< uint32_t >( swapChains.size() ),            // swapchainCount
+			getData( swapChains ),                                   // pSwapchains
+			getData( imagesIndex ),                                  // pImageIndices
+			results                                                  // pResults
 		};
 		DEBUG_DUMP( presentInfo );
-		checkError( m_device.vkQueuePresentKHR( m_internal, &presentInfo )
-			, "Queue present" );
+		auto res = m_device.vkQueuePresentKHR( m_internal, &presentInfo );
+		checkError( res, "Queue present" );
+		return res;
+	}
+
+	VkResultArray Queue::present( SwapChainCRefArray const & swapChains
+		, UInt32Array const & imagesIndex
+		, SemaphoreCRefArray const & semaphoresToWait )const
+	{
+		SmallArray< VkSwapchainKHR > vkSwapchains;
+		SmallArray< VkSemaphore > vkSemaphoresToWait;
+		fillVkArray( swapChains, vkSwapchains );
+		fillVkArray( semaphoresToWait, vkSemaphoresToWait );
+		VkResultArray results( swapChains.size() );
+		present( makeView( vkSwapchains )
+			, makeView( imagesIndex )
+			, makeView( vkSemaphoresToWait )
+			, results.data() );
 		return results;
 	}
 
+	VkResult Queue::present( SwapChain const & swapChain
+		, uint32_t imageIndex
+		, Semaphore const & semaphoreToWait )const
+	{
+		VkSwapchainKHR vkSwapchain = swapChain;
+		VkSemaphore vkSemaphoreToWait = semaphoreToWait;
+		VkResult result{ VK_SUCCESS };
+		present( makeSingleView( vkSwapchain )
+			, makeSingleView( imageIndex )
+			, makeSingleView( vkSemaphoreToWait )
+			, &result );
+		return result;
+	}
+
 	void Queue::waitIdle()const
 	{
 		auto res = m_device.vkQueueWaitIdle( m_internal );
@@ -14,6 +14,7 @@ See LICENSE file in root folder.
 #include "ashespp/Image/Sampler.hpp"
 #include "ashespp/Image/StagingTexture.hpp"
 #include "ashespp/Miscellaneous/QueryPool.hpp"
+#include "ashespp/Pipeline/PipelineCache.hpp"
 #include "ashespp/Pipeline/PipelineLayout.hpp"
 #include "ashespp/RenderPass/RenderPass.hpp"
 #include "ashespp/Shader/ShaderModule.hpp"
@@ -117,6 +118,17 @@ namespace ashes
 			, std::move( createInfo ) );
 	}
 
+	PipelineCachePtr Device::createPipelineCache( ByteArray const & initialData )const
+	{
+		return std::make_unique< PipelineCache >( *this
+			, initialData );
+	}
+
+	PipelineCachePtr Device::createPipelineCache( std::string const & filePath )const
+	{
+		return createPipelineCache( PipelineCache::load( m_properties, filePath ) );
+	}
+
 	PipelineLayoutPtr Device::createPipelineLayout( DescriptorSetLayoutCRefArray const & setLayouts
 		, VkPushConstantRangeArray const & pushConstantRanges )const
 	{
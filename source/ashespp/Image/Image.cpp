@@ -243,13 +243,20 @@ namespace ashes
 	}
 
 	void Image::bindMemory( DeviceMemoryPtr memory )
+	{
+		bindMemory( std::make_unique< MemoryAllocation >( std::move( memory )
+			, 0u
+			, WholeSize ) );
+	}
+
+	void Image::bindMemory( MemoryAllocationPtr allocation )
 	{
 		assert( !m_storage && "A resource can only be bound once to a device memory object." );
-		m_storage = std::move( memory );
+		m_storage = std::move( allocation );
 		auto res = m_device->vkBindImageMemory( *m_device
 			, m_internal
-			, *m_storage
-			, 0 );
+			, m_storage->getMemory()
+			, m_storage->getOffset() );
 		checkError( res, "Image storage binding" );
 	}
 
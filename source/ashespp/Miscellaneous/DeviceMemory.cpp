@@ -52,7 +52,7 @@ namespace ashes
 			VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE,
 			nullptr,
 			m_internal,                                       // memory
-			0,                                                // offset
+			offset,                                           // offset
 			size                                              // size
 		};
 		DEBUG_DUMP( mappedRange );
@@ -68,7 +68,7 @@ namespace ashes
 			VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE,
 			nullptr,
 			m_internal,                                       // memory
-			0,                                                // offset
+			offset,                                           // offset
 			size                                              // size
 		};
 		DEBUG_DUMP( mappedRange );
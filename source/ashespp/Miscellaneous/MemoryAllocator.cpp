@@ -0,0 +1,496 @@
+/*
+This file belongs to Ashes.
+See LICENSE file in root folder
+*/
+#include "ashespp/Miscellaneous/MemoryAllocator.hpp"
+
+#include "ashespp/Buffer/Buffer.hpp"
+#include "ashespp/Core/Device.hpp"
+#include "ashespp/Image/Image.hpp"
+
+#include <ashes/common/Exception.hpp>
+
+#include <algorithm>
+#include <set>
+#include <unordered_map>
+
+namespace ashes
+{
+	namespace
+	{
+		VkDeviceSize constexpr MinBlockOrder = 8u;
+
+		uint32_t getOrder( VkDeviceSize size )
+		{
+			uint32_t result = 0u;
+
+			while ( ( VkDeviceSize( 1u ) << result ) < size )
+			{
+				++result;
+			}
+
+			return result;
+		}
+
+		bool isHostVisible( Device const & device
+			, uint32_t memoryTypeIndex )
+		{
+			return checkFlag( device.getMemoryProperties().memoryTypes[memoryTypeIndex].propertyFlags
+				, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT );
+		}
+
+		VkDeviceSize getHeapSize( Device const & device
+			, uint32_t memoryTypeIndex )
+		{
+			auto & properties = device.getMemoryProperties();
+			return properties.memoryHeaps[properties.memoryTypes[memoryTypeIndex].heapIndex].size;
+		}
+
+		void add( MemoryStatistics & lhs
+			, MemoryStatistics const & rhs )
+		{
+			lhs.blockCount += rhs.blockCount;
+			lhs.dedicatedCount += rhs.dedicatedCount;
+			lhs.allocationCount += rhs.allocationCount;
+			lhs.blockBytes += rhs.blockBytes;
+			lhs.dedicatedBytes += rhs.dedicatedBytes;
+			lhs.usedBytes += rhs.usedBytes;
+			lhs.requestedBytes += rhs.requestedBytes;
+		}
+	}
+
+	//*********************************************************************************************
+
+	MemoryAllocation::MemoryAllocation( DeviceMemoryPtr memory
+		, VkDeviceSize offset
+		, VkDeviceSize size
+		, uint8_t * mapped
+		, std::function< void() > release )
+		: m_memory{ std::move( memory ) }
+		, m_offset{ offset }
+		, m_size{ size }
+		, m_mapped{ mapped }
+		, m_release{ std::move( release ) }
+	{
+	}
+
+	MemoryAllocation::~MemoryAllocation()
+	{
+		if ( m_release )
+		{
+			m_release();
+		}
+	}
+
+	uint8_t * MemoryAllocation::lock( VkDeviceSize offset
+		, VkDeviceSize size
+		, VkMemoryMapFlags flags )const
+	{
+		if ( m_mapped )
+		{
+			return m_mapped + m_offset + offset;
+		}
+
+		return m_memory->lock( m_offset + offset
+			, doGetSize( offset, size )
+			, flags );
+	}
+
+	void MemoryAllocation::invalidate( VkDeviceSize offset
+		, VkDeviceSize size )const
+	{
+		m_memory->invalidate( m_offset + offset
+			, doGetSize( offset, size ) );
+	}
+
+	void MemoryAllocation::flush( VkDeviceSize offset
+		, VkDeviceSize size )const
+	{
+		m_memory->flush( m_offset + offset
+			, doGetSize( offset, size ) );
+	}
+
+	void MemoryAllocation::unlock()const
+	{
+		if ( !m_mapped )
+		{
+			m_memory->unlock();
+		}
+	}
+
+	VkDeviceSize MemoryAllocation::doGetSize( VkDeviceSize offset
+		, VkDeviceSize size )const
+	{
+		// A whole size must not spill over the neighbouring allocations.
+		return ( size == WholeSize && m_size != WholeSize )
+			? m_size - offset
+			: size;
+	}
+
+	//*********************************************************************************************
+
+	LinearMemoryPool::LinearMemoryPool( Device const & device
+		, uint32_t memoryTypeIndex
+		, VkDeviceSize size )
+		: m_memoryTypeIndex{ memoryTypeIndex }
+		, m_size{ size }
+		, m_atomSize{ device.getProperties().limits.nonCoherentAtomSize }
+		, m_memory{ device.allocateMemory( VkMemoryAllocateInfo
+			{
+				VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+				nullptr,
+				size,
+				memoryTypeIndex,
+			} ) }
+	{
+		if ( isHostVisible( device, memoryTypeIndex ) )
+		{
+			m_mapped = m_memory->lock( 0u, WholeSize, 0u );
+		}
+	}
+
+	LinearMemoryPool::~LinearMemoryPool()
+	{
+		if ( m_mapped )
+		{
+			m_memory->unlock();
+		}
+	}
+
+	MemoryAllocationPtr LinearMemoryPool::allocate( VkMemoryRequirements const & requirements )
+	{
+		if ( !( requirements.memoryTypeBits & ( 1u << m_memoryTypeIndex ) ) )
+		{
+			return nullptr;
+		}
+
+		// Flushed and invalidated ranges are rounded to the atom size, they must not reach the neighbouring allocations.
+		auto alignment = std::max( requirements.alignment, m_atomSize );
+		auto offset = getAlignedSize( m_head, alignment );
+
+		if ( offset + requirements.size > m_size )
+		{
+			return nullptr;
+		}
+
+		auto size = std::min( getAlignedSize( requirements.size, alignment )
+			, m_size - offset );
+		m_head = offset + size;
+		return std::make_unique< MemoryAllocation >( m_memory
+			, offset
+			, size
+			, m_mapped );
+	}
+
+	void LinearMemoryPool::reset()
+	{
+		m_head = 0u;
+	}
+
+	//*********************************************************************************************
+
+	/**
+	*\brief
+	*	A device memory object, split using a binary buddy allocator.
+	*/
+	class MemoryAllocator::Block
+	{
+	public:
+		Block( Device const & device
+			, uint32_t memoryTypeIndex
+			, VkDeviceSize size )
+			: m_memory{ device.allocateMemory( VkMemoryAllocateInfo
+				{
+					VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+					nullptr,
+					size,
+					memoryTypeIndex,
+				} ) }
+			, m_maxOrder{ getOrder( size ) }
+			, m_freeLists( m_maxOrder + 1u )
+		{
+			m_freeLists[m_maxOrder].insert( 0u );
+
+			if ( isHostVisible( device, memoryTypeIndex ) )
+			{
+				m_mapped = m_memory->lock( 0u, WholeSize, 0u );
+			}
+		}
+
+		~Block()
+		{
+			if ( m_mapped )
+			{
+				m_memory->unlock();
+			}
+		}
+		/**
+		*\return
+		*	The allocated size, 0 if no range was available.
+		*/
+		VkDeviceSize allocate( VkDeviceSize size
+			, VkDeviceSize alignment
+			, VkDeviceSize minSize
+			, VkDeviceSize & offset )
+		{
+			// Buddy ranges are aligned on their size, hence the alignment is honoured by the size.
+			auto order = getOrder( std::max( { size, alignment, minSize } ) );
+			auto current = order;
+
+			while ( current <= m_maxOrder && m_freeLists[current].empty() )
+			{
+				++current;
+			}
+
+			if ( current > m_maxOrder )
+			{
+				return 0u;
+			}
+
+			offset = *m_freeLists[current].begin();
+			m_freeLists[current].erase( m_freeLists[current].begin() );
+
+			while ( current > order )
+			{
+				--current;
+				m_freeLists[current].insert( offset + ( VkDeviceSize( 1u ) << current ) );
+			}
+
+			m_allocated.emplace( offset, order );
+			return VkDeviceSize( 1u ) << order;
+		}
+
+		void deallocate( VkDeviceSize offset )
+		{
+			auto it = m_allocated.find( offset );
+			assert( it != m_allocated.end() );
+			auto order = it->second;
+			m_allocated.erase( it );
+
+			while ( order < m_maxOrder
+				&& m_freeLists[order].erase( offset ^ ( VkDeviceSize( 1u ) << order ) ) )
+			{
+				offset &= ~( VkDeviceSize( 1u ) << order );
+				++order;
+			}
+
+			m_freeLists[order].insert( offset );
+		}
+
+		bool empty()const
+		{
+			return m_allocated.empty();
+		}
+
+		DeviceMemoryPtr const & getMemory()const
+		{
+			return m_memory;
+		}
+
+		uint8_t * getMapped()const
+		{
+			return m_mapped;
+		}
+
+	private:
+		DeviceMemoryPtr m_memory;
+		uint8_t * m_mapped{ nullptr };
+		uint32_t m_maxOrder;
+		std::vector< std::set< VkDeviceSize > > m_freeLists;
+		std::unordered_map< VkDeviceSize, uint32_t > m_allocated;
+	};
+
+	//*********************************************************************************************
+
+	MemoryAllocator::MemoryAllocator( Device const & device
+		, VkDeviceSize blockSize
+		, VkDeviceSize dedicatedThreshold )
+		: m_device{ device }
+		, m_blockSize{ VkDeviceSize( 1u ) << getOrder( blockSize ) }
+		, m_dedicatedThreshold{ std::min( dedicatedThreshold, m_blockSize / 2u ) }
+		, m_state{ std::make_shared< State >() }
+	{
+	}
+
+	MemoryAllocator::~MemoryAllocator()
+	{
+	}
+
+	MemoryAllocationPtr MemoryAllocator::allocate( VkMemoryRequirements const & requirements
+		, VkMemoryPropertyFlags flags
+		, bool linear )
+	{
+		if ( requirements.size >= m_dedicatedThreshold )
+		{
+			return allocateDedicated( requirements, flags );
+		}
+
+		auto memoryTypeIndex = m_device.deduceMemoryType( requirements.memoryTypeBits, flags );
+		auto minSize = std::max( VkDeviceSize( 1u ) << MinBlockOrder
+			, m_device.getProperties().limits.nonCoherentAtomSize );
+		// Small heaps get smaller blocks, to avoid exhausting them.
+		auto blockSize = std::max( minSize
+			, std::min( m_blockSize
+				, VkDeviceSize( 1u ) << getOrder( getHeapSize( m_device, memoryTypeIndex ) / 8u ) ) );
+
+		if ( requirements.size > blockSize / 2u )
+		{
+			return allocateDedicated( requirements, flags );
+		}
+
+		auto state = m_state;
+		std::lock_guard< std::mutex > lock{ state->mutex };
+		auto & pool = m_pools[memoryTypeIndex * 2u + ( linear ? 1u : 0u )];
+		auto & statistics = state->statistics[memoryTypeIndex];
+		BlockPtr block;
+		VkDeviceSize offset{};
+		VkDeviceSize allocated{};
+
+		for ( auto & current : pool )
+		{
+			allocated = current->allocate( requirements.size
+				, requirements.alignment
+				, minSize
+				, offset );
+
+			if ( allocated )
+			{
+				block = current;
+				break;
+			}
+		}
+
+		if ( !block )
+		{
+			block = std::make_shared< Block >( m_device, memoryTypeIndex, blockSize );
+			pool.push_back( block );
+			++statistics.blockCount;
+			statistics.blockBytes += blockSize;
+			allocated = block->allocate( requirements.size
+				, requirements.alignment
+				, minSize
+				, offset );
+			assert( allocated );
+		}
+
+		++statistics.allocationCount;
+		statistics.usedBytes += allocated;
+		statistics.requestedBytes += requirements.size;
+		auto size = requirements.size;
+		return std::make_unique< MemoryAllocation >( block->getMemory()
+			, offset
+			, allocated
+			, block->getMapped()
+			, [state, block, memoryTypeIndex, offset, allocated, size]()
+			{
+				std::lock_guard< std::mutex > lock{ state->mutex };
+				auto & statistics = state->statistics[memoryTypeIndex];
+				block->deallocate( offset );
+				--statistics.allocationCount;
+				statistics.usedBytes -= allocated;
+				statistics.requestedBytes -= size;
+			} );
+	}
+
+	MemoryAllocationPtr MemoryAllocator::allocate( BufferBase const & buffer
+		, VkMemoryPropertyFlags flags )
+	{
+		return allocate( buffer.getMemoryRequirements()
+			, flags
+			, true );
+	}
+
+	MemoryAllocationPtr MemoryAllocator::allocate( Image const & image
+		, VkMemoryPropertyFlags flags )
+	{
+		return allocate( image.getMemoryRequirements()
+			, flags
+			, image.getTiling() == VK_IMAGE_TILING_LINEAR );
+	}
+
+	MemoryAllocationPtr MemoryAllocator::allocateDedicated( VkMemoryRequirements const & requirements
+		, VkMemoryPropertyFlags flags )
+	{
+		auto memoryTypeIndex = m_device.deduceMemoryType( requirements.memoryTypeBits, flags );
+		auto memory = m_device.allocateMemory( VkMemoryAllocateInfo
+			{
+				VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+				nullptr,
+				requirements.size,
+				memoryTypeIndex,
+			} );
+		auto state = m_state;
+		auto size = requirements.size;
+		{
+			std::lock_guard< std::mutex > lock{ state->mutex };
+			auto & statistics = state->statistics[memoryTypeIndex];
+			++statistics.dedicatedCount;
+			statistics.dedicatedBytes += size;
+		}
+		return std::make_unique< MemoryAllocation >( std::move( memory )
+			, 0u
+			, WholeSize
+			, nullptr
+			, [state, memoryTypeIndex, size]()
+			{
+				std::lock_guard< std::mutex > lock{ state->mutex };
+				auto & statistics = state->statistics[memoryTypeIndex];
+				--statistics.dedicatedCount;
+				statistics.dedicatedBytes -= size;
+			} );
+	}
+
+	LinearMemoryPoolPtr MemoryAllocator::createLinearPool( VkDeviceSize size
+		, uint32_t memoryTypeBits
+		, VkMemoryPropertyFlags flags )const
+	{
+		return std::make_unique< LinearMemoryPool >( m_device
+			, m_device.deduceMemoryType( memoryTypeBits, flags )
+			, size );
+	}
+
+	void MemoryAllocator::trim()
+	{
+		std::lock_guard< std::mutex > lock{ m_state->mutex };
+
+		for ( uint32_t index = 0u; index < m_pools.size(); ++index )
+		{
+			auto & pool = m_pools[index];
+			auto & statistics = m_state->statistics[index / 2u];
+			auto it = pool.begin();
+
+			while ( it != pool.end() )
+			{
+				if ( ( *it )->empty() )
+				{
+					--statistics.blockCount;
+					statistics.blockBytes -= ( *it )->getMemory()->getSize();
+					it = pool.erase( it );
+				}
+				else
+				{
+					++it;
+				}
+			}
+		}
+	}
+
+	MemoryStatistics MemoryAllocator::getStatistics()const
+	{
+		std::lock_guard< std::mutex > lock{ m_state->mutex };
+		MemoryStatistics result;
+
+		for ( auto & statistics : m_state->statistics )
+		{
+			add( result, statistics );
+		}
+
+		return result;
+	}
+
+	MemoryStatistics MemoryAllocator::getStatistics( uint32_t memoryTypeIndex )const
+	{
+		std::lock_guard< std::mutex > lock{ m_state->mutex };
+		return m_state->statistics[memoryTypeIndex];
+	}
+}
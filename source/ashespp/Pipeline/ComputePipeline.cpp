@@ -16,7 +16,9 @@ namespace ashes
 		DEBUG_DUMP( m_createInfo );
 		DEBUG_WRITE( "pipeline.log" );
 		auto res = m_device.vkCreateComputePipelines( m_device
-			, VK_NULL_HANDLE
+			, ( m_createInfo.pipelineCache != VK_NULL_HANDLE
+				? m_createInfo.pipelineCache
+				: m_device.getPipelineCache() )
 			, 1
 			, &static_cast< VkComputePipelineCreateInfo const & >( m_createInfo )
 			, nullptr
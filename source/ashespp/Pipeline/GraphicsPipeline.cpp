@@ -18,7 +18,9 @@ namespace ashes
 		DEBUG_DUMP( m_createInfo );
 		DEBUG_WRITE( "pipeline.log" );
 		auto res = m_device.vkCreateGraphicsPipelines( m_device
-			, VK_NULL_HANDLE
+			, ( m_createInfo.pipelineCache != VK_NULL_HANDLE
+				? m_createInfo.pipelineCache
+				: m_device.getPipelineCache() )
 			, 1
 			, &static_cast< VkGraphicsPipelineCreateInfo const & >( m_createInfo )
 			, nullptr
@@ -0,0 +1,199 @@
+/*
+This file belongs to Ashes.
+See LICENSE file in root folder.
+*/
+#include "ashespp/Pipeline/PipelineCache.hpp"
+
+#include "ashespp/Core/Device.hpp"
+
+#include <cstring>
+#include <fstream>
+
+namespace ashes
+{
+	namespace
+	{
+		// "ASPC", little endian.
+		uint32_t constexpr FileMagic = 0x43505341u;
+		uint32_t constexpr FileVersion = 1u;
+
+		/**
+		*\brief
+		*	Precedes the cache data in files, the Vulkan cache header
+		*	doesn't hold the driver version.
+		*/
+		struct FileHeader
+		{
+			uint32_t magic;
+			uint32_t version;
+			uint32_t vendorID;
+			uint32_t deviceID;
+			uint32_t driverVersion;
+			uint8_t pipelineCacheUUID[VK_UUID_SIZE];
+			uint64_t dataSize;
+		};
+
+		/**
+		*\brief
+		*	VkPipelineCacheHeaderVersionOne layout, as found at the start of the cache data.
+		*/
+		struct CacheHeader
+		{
+			uint32_t headerSize;
+			uint32_t headerVersion;
+			uint32_t vendorID;
+			uint32_t deviceID;
+			uint8_t pipelineCacheUUID[VK_UUID_SIZE];
+		};
+	}
+
+	PipelineCache::PipelineCache( Device const & device
+		, ByteArray const & initialData )
+		: m_device{ device }
+	{
+		auto compatible = isCompatible( m_device.getProperties(), initialData );
+		VkPipelineCacheCreateInfo createInfo
+		{
+			VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+			nullptr,
+			0u,
+			( compatible
+				? initialData.size()
+				: 0u ),
+			( compatible
+				? initialData.data()
+				: nullptr ),
+		};
+		auto res = m_device.vkCreatePipelineCache( m_device
+			, &createInfo
+			, nullptr
+			, &m_internal );
+		checkError( res, "PipelineCache creation" );
+		registerObject( m_device, "PipelineCache", this );
+	}
+
+	PipelineCache::~PipelineCache()
+	{
+		unregisterObject( m_device, this );
+		m_device.vkDestroyPipelineCache( m_device
+			, m_internal
+			, nullptr );
+	}
+
+	ByteArray PipelineCache::getData()const
+	{
+		size_t size{};
+		auto res = m_device.vkGetPipelineCacheData( m_device
+			, m_internal
+			, &size
+			, nullptr );
+		checkError( res, "PipelineCache data size retrieval" );
+		ByteArray result( size );
+
+		if ( size )
+		{
+			res = m_device.vkGetPipelineCacheData( m_device
+				, m_internal
+				, &size
+				, result.data() );
+			checkError( res, "PipelineCache data retrieval" );
+			result.resize( size );
+		}
+
+		return result;
+	}
+
+	void PipelineCache::merge( PipelineCacheCRefArray const & caches )const
+	{
+		if ( caches.empty() )
+		{
+			return;
+		}
+
+		auto vkcaches = makeVkArray< VkPipelineCache >( caches );
+		auto res = m_device.vkMergePipelineCaches( m_device
+			, m_internal
+			, uint32_t( vkcaches.size() )
+			, vkcaches.data() );
+		checkError( res, "PipelineCache merge" );
+	}
+
+	bool PipelineCache::save( std::string const & filePath )const
+	{
+		auto data = getData();
+
+		if ( !isCompatible( m_device.getProperties(), data ) )
+		{
+			// Nothing worth saving, the backend doesn't implement caches.
+			return false;
+		}
+
+		auto & properties = m_device.getProperties();
+		FileHeader header{ FileMagic
+			, FileVersion
+			, properties.vendorID
+			, properties.deviceID
+			, properties.driverVersion
+			, {}
+			, uint64_t( data.size() ) };
+		std::memcpy( header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE );
+		std::ofstream file{ filePath, std::ios::binary | std::ios::trunc };
+
+		if ( !file )
+		{
+			return false;
+		}
+
+		file.write( reinterpret_cast< char const * >( &header ), sizeof( header ) );
+		file.write( reinterpret_cast< char const * >( data.data() ), std::streamsize( data.size() ) );
+		return bool( file );
+	}
+
+	ByteArray PipelineCache::load( VkPhysicalDeviceProperties const & properties
+		, std::string const & filePath )
+	{
+		std::ifstream file{ filePath, std::ios::binary };
+		FileHeader header{};
+
+		if ( !file
+			|| !file.read( reinterpret_cast< char * >( &header ), sizeof( header ) )
+			|| header.magic != FileMagic
+			|| header.version != FileVersion
+			|| header.vendorID != properties.vendorID
+			|| header.deviceID != properties.deviceID
+			|| header.driverVersion != properties.driverVersion
+			|| std::memcmp( header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE ) )
+		{
+			return {};
+		}
+
+		ByteArray result( size_t( header.dataSize ) );
+
+		if ( !file.read( reinterpret_cast< char * >( result.data() ), std::streamsize( result.size() ) )
+			|| !isCompatible( properties, result ) )
+		{
+			return {};
+		}
+
+		return result;
+	}
+
+	bool PipelineCache::isCompatible( VkPhysicalDeviceProperties const & properties
+		, ByteArray const & data )
+	{
+		CacheHeader header{};
+
+		if ( data.size() < sizeof( header ) )
+		{
+			return false;
+		}
+
+		std::memcpy( &header, data.data(), sizeof( header ) );
+		return header.headerSize >= sizeof( header )
+			&& header.headerSize <= data.size()
+			&& header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE
+			&& header.vendorID == properties.vendorID
+			&& header.deviceID == properties.deviceID
+			&& !std::memcmp( header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE );
+	}
+}
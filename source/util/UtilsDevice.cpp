@@ -153,7 +153,8 @@ namespace utils
 	}
 
 	Device::Device( ashes::Instance const & instance
-		, ashes::Surface const & surface )
+		, ashes::Surface const & surface
+		, std::string pipelineCachePath )
 		: m_gpu{ surface.getGpu() }
 		, m_createInfos{ doGetDeviceCreateInfo( instance
 			, surface
@@ -164,7 +165,23 @@ namespace utils
 		, m_device{ instance.createDevice( surface.getGpu()
 			, std::move( m_createInfos ) ) }
 		, m_memoryProperties{ m_gpu.getMemoryProperties() }
+		, m_pipelineCachePath{ std::move( pipelineCachePath ) }
+		, m_allocator{ std::make_unique< ashes::MemoryAllocator >( *m_device ) }
 	{
+		if ( !m_pipelineCachePath.empty() )
+		{
+			m_pipelineCache = m_device->createPipelineCache( m_pipelineCachePath );
+			m_device->setPipelineCache( *m_pipelineCache );
+		}
+	}
+
+	Device::~Device()
+	{
+		if ( m_pipelineCache )
+		{
+			m_pipelineCache->save( m_pipelineCachePath );
+			m_device->setPipelineCache( VK_NULL_HANDLE );
+		}
 	}
 
 	ashes::BufferBasePtr Device::createBuffer( uint32_t size
@@ -172,10 +189,7 @@ namespace utils
 		, VkMemoryPropertyFlags flags )const
 	{
 		auto result = m_device->createBuffer( size, usage );
-		auto requirements = result->getMemoryRequirements();
-		uint32_t deduced = deduceMemoryType( requirements.memoryTypeBits
-			, flags );
-		result->bindMemory( m_device->allocateMemory( { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO, nullptr, requirements.size, deduced } ) );
+		result->bindMemory( m_allocator->allocate( *result, flags ) );
 		return result;
 	}
 
@@ -183,10 +197,7 @@ namespace utils
 		, VkMemoryPropertyFlags flags )const
 	{
 		auto result = m_device->createImage( createInfo );
-		auto requirements = result->getMemoryRequirements();
-		uint32_t deduced = deduceMemoryType( requirements.memoryTypeBits
-			, flags );
-		result->bindMemory( m_device->allocateMemory( { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO, nullptr, requirements.size, deduced } ) );
+		result->bindMemory( m_allocator->allocate( *result, flags ) );
 		return result;
 	}
 
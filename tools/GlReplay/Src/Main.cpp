@@ -0,0 +1,297 @@
+/*
+This file belongs to Ashes.
+See LICENSE file in root folder
+*/
+#include <ashes/ashes.h>
+#include <ashes/common/DynamicLibrary.hpp>
+#include <ashes/common/FileUtils.hpp>
+
+#include <renderer/GlRenderer/Miscellaneous/GlCaptureFormat.hpp>
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+	namespace capture = ashes::gl::capture;
+
+	using PFN_ashglReplayCapture = VkResult( VKAPI_PTR * )( VkDevice, char const *, uint32_t, capture::ReplayStats * );
+
+	struct Options
+	{
+		std::string file;
+		std::string plugin;
+		uint32_t loops{ 10u };
+	};
+
+	void printUsage()
+	{
+		std::cout << "Usage: ashes-replay [options] <capture file>\n"
+			<< "  Replays the GL command streams captured with ASHES_GL_CAPTURE, and times its frames.\n"
+			<< "Options:\n"
+			<< "  --loops <n>       The number of times the capture is replayed (default 10).\n"
+			<< "                    The first loop is excluded from the frame times when more than one is run.\n"
+			<< "  --plugin <path>   The GL renderer plugin (default: the one next to this executable).\n";
+	}
+
+	bool parseOptions( int argc
+		, char ** argv
+		, Options & options )
+	{
+		for ( int i = 1; i < argc; ++i )
+		{
+			std::string arg = argv[i];
+
+			if ( arg == "--loops" && i + 1 < argc )
+			{
+				options.loops = uint32_t( std::stoul( argv[++i] ) );
+			}
+			else if ( arg == "--plugin" && i + 1 < argc )
+			{
+				options.plugin = argv[++i];
+			}
+			else if ( arg == "--help" || arg == "-h" )
+			{
+				return false;
+			}
+			else if ( !arg.empty() && arg[0] != '-' )
+			{
+				options.file = arg;
+			}
+			else
+			{
+				std::cerr << "Unknown option " << arg << "\n";
+				return false;
+			}
+		}
+
+		return !options.file.empty();
+	}
+
+	void setEnvironment( char const * name
+		, char const * value )
+	{
+#if defined( _WIN32 )
+		_putenv_s( name, value );
+#else
+		setenv( name, value, 1 );
+#endif
+	}
+
+	std::string getDefaultPluginPath()
+	{
+#if defined( _WIN32 )
+		std::string prefix{ "ashes" };
+		std::string ext{ ".dll" };
+#elif defined( __APPLE__ )
+		std::string prefix{ "libashes" };
+		std::string ext{ ".dylib" };
+#else
+		std::string prefix{ "libashes" };
+		std::string ext{ ".so" };
+#endif
+#if defined( NDEBUG )
+		std::string postfix{ "Renderer" };
+#else
+		std::string postfix{ "Rendererd" };
+#endif
+		return ashes::getExecutableDirectory() / ( prefix + "Gl" + postfix + ext );
+	}
+
+	template< typename FuncT >
+	bool getProcAddr( PFN_vkGetInstanceProcAddr getInstanceProcAddr
+		, VkInstance instance
+		, char const * name
+		, FuncT & function )
+	{
+		function = reinterpret_cast< FuncT >( getInstanceProcAddr( instance, name ) );
+
+		if ( !function )
+		{
+			std::cerr << "Couldn't retrieve " << name << "\n";
+		}
+
+		return function != nullptr;
+	}
+
+	bool replay( Options const & options
+		, PFN_vkGetInstanceProcAddr getInstanceProcAddr
+		, PFN_ashglReplayCapture replayCapture
+		, capture::ReplayStats & stats )
+	{
+		PFN_vkCreateInstance createInstance{};
+
+		if ( !getProcAddr( getInstanceProcAddr, nullptr, "vkCreateInstance", createInstance ) )
+		{
+			return false;
+		}
+
+		VkApplicationInfo appInfo{ VK_STRUCTURE_TYPE_APPLICATION_INFO
+			, nullptr
+			, "ashes-replay"
+			, 1u
+			, "Ashes"
+			, 1u
+			, VK_API_VERSION_1_0 };
+		VkInstanceCreateInfo instanceInfo{ VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO
+			, nullptr
+			, 0u
+			, &appInfo
+			, 0u
+			, nullptr
+			, 0u
+			, nullptr };
+		VkInstance instance{};
+
+		if ( createInstance( &instanceInfo, nullptr, &instance ) != VK_SUCCESS )
+		{
+			std::cerr << "Couldn't create the instance\n";
+			return false;
+		}
+
+		PFN_vkDestroyInstance destroyInstance{};
+		PFN_vkEnumeratePhysicalDevices enumeratePhysicalDevices{};
+		PFN_vkCreateDevice createDevice{};
+		PFN_vkDestroyDevice destroyDevice{};
+		bool result = getProcAddr( getInstanceProcAddr, instance, "vkDestroyInstance", destroyInstance )
+			&& getProcAddr( getInstanceProcAddr, instance, "vkEnumeratePhysicalDevices", enumeratePhysicalDevices )
+			&& getProcAddr( getInstanceProcAddr, instance, "vkCreateDevice", createDevice )
+			&& getProcAddr( getInstanceProcAddr, instance, "vkDestroyDevice", destroyDevice );
+		VkPhysicalDevice physicalDevice{};
+		uint32_t count = 1u;
+
+		if ( result )
+		{
+			result = enumeratePhysicalDevices( instance, &count, &physicalDevice ) >= VK_SUCCESS
+				&& count > 0u;
+
+			if ( !result )
+			{
+				std::cerr << "No physical device\n";
+			}
+		}
+
+		if ( result )
+		{
+			float priority = 1.0f;
+			VkDeviceQueueCreateInfo queueInfo{ VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO
+				, nullptr
+				, 0u
+				, 0u
+				, 1u
+				, &priority };
+			VkDeviceCreateInfo deviceInfo{ VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO
+				, nullptr
+				, 0u
+				, 1u
+				, &queueInfo
+				, 0u
+				, nullptr
+				, 0u
+				, nullptr
+				, nullptr };
+			VkDevice device{};
+			result = createDevice( physicalDevice, &deviceInfo, nullptr, &device ) == VK_SUCCESS;
+
+			if ( result )
+			{
+				result = replayCapture( device
+					, options.file.c_str()
+					, options.loops
+					, &stats ) == VK_SUCCESS;
+				destroyDevice( device, nullptr );
+			}
+			else
+			{
+				std::cerr << "Couldn't create the device\n";
+			}
+		}
+
+		if ( destroyInstance )
+		{
+			destroyInstance( instance, nullptr );
+		}
+
+		return result;
+	}
+
+	void printStats( capture::ReplayStats const & stats )
+	{
+		std::cout << std::fixed << std::setprecision( 3 )
+			<< "Frames: " << stats.frames
+			<< ", loops: " << stats.loops
+			<< ", setup: " << stats.setupMs << " ms"
+			<< ", total: " << stats.totalMs << " ms\n"
+			<< "Frame times (ms): min " << stats.minFrameMs
+			<< ", avg " << stats.avgFrameMs
+			<< ", median " << stats.medianFrameMs
+			<< ", max " << stats.maxFrameMs << "\n";
+
+		if ( stats.unmappedNames || stats.skippedCommands )
+		{
+			std::cout << "Unmapped GL names: " << stats.unmappedNames
+				<< ", commands dropped at capture: " << stats.skippedCommands << "\n";
+		}
+	}
+}
+
+int main( int argc, char ** argv )
+{
+	Options options;
+
+	if ( !parseOptions( argc, argv, options ) )
+	{
+		printUsage();
+		return EXIT_FAILURE;
+	}
+
+	// The replay doesn't present, and mustn't capture itself.
+	setEnvironment( "ASHES_GL_HEADLESS", "1" );
+	setEnvironment( "ASHES_GL_CAPTURE", "0" );
+
+	if ( options.plugin.empty() )
+	{
+		options.plugin = getDefaultPluginPath();
+	}
+
+	try
+	{
+		ashes::DynamicLibrary library{ options.plugin };
+		PFN_ashGetPluginDescription getDescription{};
+		PFN_ashglReplayCapture replayCapture{};
+
+		if ( !library.getFunction( "ashGetPluginDescription", getDescription )
+			|| !library.getFunction( "ashglReplayCapture", replayCapture ) )
+		{
+			std::cerr << options.plugin << " is not a GL renderer plugin\n";
+			return EXIT_FAILURE;
+		}
+
+		AshPluginDescription description{};
+
+		if ( getDescription( &description ) != VK_SUCCESS )
+		{
+			std::cerr << "Couldn't initialise the GL renderer plugin\n";
+			return EXIT_FAILURE;
+		}
+
+		capture::ReplayStats stats{};
+
+		if ( !replay( options, description.getInstanceProcAddr, replayCapture, stats ) )
+		{
+			return EXIT_FAILURE;
+		}
+
+		printStats( stats );
+	}
+	catch ( std::exception & exc )
+	{
+		std::cerr << exc.what() << "\n";
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
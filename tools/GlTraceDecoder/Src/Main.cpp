@@ -0,0 +1,473 @@
+/*
+This file belongs to Ashes.
+See LICENSE file in root folder
+*/
+#include <renderer/GlRenderer/Miscellaneous/GlCallTraceFormat.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace
+{
+	namespace trace = ashes::gl::trace;
+
+	struct Record
+	{
+		uint64_t time;
+		uint32_t thread;
+		uint64_t info;
+		std::vector< uint64_t > args;
+	};
+
+	struct Trace
+	{
+		std::vector< std::string > functions;
+		std::vector< Record > records;
+		std::map< uint32_t, uint64_t > dropped;
+	};
+
+	struct Options
+	{
+		std::string file;
+		bool dump{ false };
+		bool summary{ false };
+		bool frames{ false };
+		uint32_t top{ 5u };
+	};
+
+	// Gaps longer than this are considered idle time, and not attributed to the previous call.
+	uint64_t constexpr MaxGapNs = 1000000u;
+
+	void printUsage()
+	{
+		std::cout << "Usage: AshesGlTraceDecoder [options] <trace file>\n"
+			<< "  Decodes the GL calls traces recorded with ASHES_GL_TRACE.\n"
+			<< "Options:\n"
+			<< "  --dump      Prints every call, with its arguments.\n"
+			<< "  --summary   Prints the calls count and estimated time per function (default).\n"
+			<< "  --frames    Prints the calls count and the hottest functions, per frame.\n"
+			<< "  --top <n>   The number of functions listed per frame (default 5).\n";
+	}
+
+	bool parseOptions( int argc
+		, char ** argv
+		, Options & options )
+	{
+		for ( int i = 1; i < argc; ++i )
+		{
+			std::string arg = argv[i];
+
+			if ( arg == "--dump" )
+			{
+				options.dump = true;
+			}
+			else if ( arg == "--summary" )
+			{
+				options.summary = true;
+			}
+			else if ( arg == "--frames" )
+			{
+				options.frames = true;
+			}
+			else if ( arg == "--top" && i + 1 < argc )
+			{
+				options.top = uint32_t( std::stoul( argv[++i] ) );
+			}
+			else if ( arg == "--help" || arg == "-h" )
+			{
+				return false;
+			}
+			else if ( !arg.empty() && arg[0] != '-' )
+			{
+				options.file = arg;
+			}
+			else
+			{
+				std::cerr << "Unknown option " << arg << "\n";
+				return false;
+			}
+		}
+
+		if ( !options.dump && !options.frames )
+		{
+			options.summary = true;
+		}
+
+		return !options.file.empty();
+	}
+
+	template< typename ValueT >
+	bool read( std::istream & stream
+		, ValueT & value )
+	{
+		return bool( stream.read( reinterpret_cast< char * >( &value ), sizeof( ValueT ) ) );
+	}
+
+	bool load( std::string const & fileName
+		, Trace & result )
+	{
+		std::ifstream file{ fileName, std::ios::binary };
+
+		if ( !file )
+		{
+			std::cerr << "Couldn't open " << fileName << "\n";
+			return false;
+		}
+
+		trace::FileHeader header{};
+
+		if ( !read( file, header )
+			|| std::memcmp( header.magic, trace::Magic, sizeof( header.magic ) ) != 0 )
+		{
+			std::cerr << fileName << " is not a GL trace file\n";
+			return false;
+		}
+
+		if ( header.version != trace::Version )
+		{
+			std::cerr << "Unsupported trace version " << header.version << "\n";
+			return false;
+		}
+
+		for ( uint32_t i = 0u; i < header.functionCount; ++i )
+		{
+			uint16_t length{};
+
+			if ( !read( file, length ) )
+			{
+				std::cerr << "Truncated functions table\n";
+				return false;
+			}
+
+			std::string name( length, '\0' );
+			file.read( &name[0], length );
+			result.functions.push_back( std::move( name ) );
+		}
+
+		trace::ChunkHeader chunk{};
+		std::vector< uint64_t > words;
+
+		while ( read( file, chunk ) )
+		{
+			words.resize( chunk.wordCount );
+
+			if ( !file.read( reinterpret_cast< char * >( words.data() )
+				, std::streamsize( words.size() * sizeof( uint64_t ) ) ) )
+			{
+				std::cerr << "Truncated chunk, the trace is incomplete\n";
+				break;
+			}
+
+			result.dropped[chunk.thread] += chunk.dropped;
+			size_t index = 0u;
+
+			while ( index + 2u <= words.size() )
+			{
+				Record record{ words[index], chunk.thread, words[index + 1u], {} };
+				auto count = trace::getArgCount( record.info );
+				index += 2u;
+
+				if ( index + count > words.size() )
+				{
+					std::cerr << "Malformed record, in thread " << chunk.thread << "\n";
+					break;
+				}
+
+				record.args.assign( words.begin() + index, words.begin() + index + count );
+				index += count;
+				result.records.push_back( std::move( record ) );
+			}
+		}
+
+		// The chunks of the different threads are interleaved, bring the records back in time order.
+		std::stable_sort( result.records.begin()
+			, result.records.end()
+			, []( Record const & lhs, Record const & rhs )
+			{
+				return lhs.time < rhs.time;
+			} );
+		return true;
+	}
+
+	bool isFrameMarker( Record const & record )
+	{
+		return trace::getFunction( record.info ) == trace::FrameMarker;
+	}
+
+	std::string const & getName( Trace const & trace
+		, Record const & record )
+	{
+		static std::string const unknown = "<unknown>";
+		auto function = trace::getFunction( record.info );
+		return function < trace.functions.size()
+			? trace.functions[function]
+			: unknown;
+	}
+
+	void printArg( std::ostream & stream
+		, trace::ArgType type
+		, uint64_t value )
+	{
+		switch ( type )
+		{
+		case trace::ArgType::eSigned:
+			stream << int64_t( value );
+			break;
+		case trace::ArgType::eFloat:
+			{
+				double converted;
+				std::memcpy( &converted, &value, sizeof( converted ) );
+				stream << std::defaultfloat << converted << std::fixed;
+			}
+			break;
+		case trace::ArgType::ePointer:
+			if ( value )
+			{
+				stream << "0x" << std::hex << value << std::dec;
+			}
+			else
+			{
+				stream << "nullptr";
+			}
+			break;
+		default:
+			// Most GL enums are above 0xFF, they are more readable in hexadecimal.
+			if ( value > 0xFFu )
+			{
+				stream << "0x" << std::hex << std::uppercase << value << std::nouppercase << std::dec;
+			}
+			else
+			{
+				stream << value;
+			}
+			break;
+		}
+	}
+
+	void dump( Trace const & trace )
+	{
+		uint64_t frame{ 0u };
+		std::cout << std::fixed << std::setprecision( 6 );
+
+		for ( auto & record : trace.records )
+		{
+			std::cout << std::setw( 14 ) << double( record.time ) / 1000000.0 << " ms"
+				<< " [T" << record.thread << "] ";
+
+			if ( isFrameMarker( record ) )
+			{
+				std::cout << "---- end of frame " << frame++ << " ----\n";
+				continue;
+			}
+
+			std::cout << getName( trace, record ) << "(";
+
+			for ( uint32_t i = 0u; i < record.args.size(); ++i )
+			{
+				std::cout << ( i ? ", " : "" );
+				printArg( std::cout
+					, trace::getArgType( record.info, i )
+					, record.args[i] );
+			}
+
+			std::cout << ")\n";
+		}
+	}
+
+	struct FunctionStats
+	{
+		uint64_t calls{ 0u };
+		uint64_t timeNs{ 0u };
+	};
+
+	/**
+	*\brief
+	*	Estimates the time spent in each call, as the time until the next call on the same thread.
+	*/
+	std::vector< uint64_t > estimateDurations( Trace const & trace )
+	{
+		std::vector< uint64_t > result( trace.records.size(), 0u );
+		std::map< uint32_t, size_t > previous;
+
+		for ( size_t i = 0u; i < trace.records.size(); ++i )
+		{
+			auto & record = trace.records[i];
+			auto it = previous.find( record.thread );
+
+			if ( it != previous.end() )
+			{
+				auto gap = record.time - trace.records[it->second].time;
+				result[it->second] = gap <= MaxGapNs ? gap : 0u;
+			}
+
+			previous[record.thread] = i;
+		}
+
+		return result;
+	}
+
+	void printTable( std::string const & indent
+		, std::vector< std::pair< std::string, FunctionStats > > const & stats
+		, uint64_t frames
+		, size_t max )
+	{
+		std::string const title = "Function";
+		size_t width = title.size();
+
+		for ( size_t i = 0u; i < stats.size() && i < max; ++i )
+		{
+			width = std::max( width, stats[i].first.size() );
+		}
+
+		std::cout << indent << std::left << std::setw( int( width ) ) << title << std::right
+			<< std::setw( 12 ) << "calls"
+			<< std::setw( 14 ) << "calls/frame"
+			<< std::setw( 14 ) << "est. ms" << "\n";
+
+		for ( size_t i = 0u; i < stats.size() && i < max; ++i )
+		{
+			auto & stat = stats[i];
+			std::cout << indent << std::left << std::setw( int( width ) ) << stat.first << std::right
+				<< std::setw( 12 ) << stat.second.calls
+				<< std::setw( 14 ) << std::fixed << std::setprecision( 1 ) << double( stat.second.calls ) / double( std::max( frames, uint64_t( 1u ) ) )
+				<< std::setw( 14 ) << std::setprecision( 3 ) << double( stat.second.timeNs ) / 1000000.0 << "\n";
+		}
+	}
+
+	std::vector< std::pair< std::string, FunctionStats > > sort( std::map< std::string, FunctionStats > const & stats )
+	{
+		std::vector< std::pair< std::string, FunctionStats > > result{ stats.begin(), stats.end() };
+		std::stable_sort( result.begin()
+			, result.end()
+			, []( auto const & lhs, auto const & rhs )
+			{
+				return lhs.second.calls > rhs.second.calls;
+			} );
+		return result;
+	}
+
+	void summarise( Trace const & trace )
+	{
+		auto durations = estimateDurations( trace );
+		std::map< std::string, FunctionStats > stats;
+		uint64_t frames{ 0u };
+		uint64_t calls{ 0u };
+		uint64_t dropped{ 0u };
+
+		for ( size_t i = 0u; i < trace.records.size(); ++i )
+		{
+			auto & record = trace.records[i];
+
+			if ( isFrameMarker( record ) )
+			{
+				++frames;
+				continue;
+			}
+
+			auto & stat = stats[getName( trace, record )];
+			++stat.calls;
+			stat.timeNs += durations[i];
+			++calls;
+		}
+
+		for ( auto & thread : trace.dropped )
+		{
+			dropped += thread.second;
+		}
+
+		auto duration = trace.records.empty()
+			? 0u
+			: trace.records.back().time - trace.records.front().time;
+		std::cout << "Calls: " << calls
+			<< ", threads: " << trace.dropped.size()
+			<< ", frames: " << frames
+			<< ", duration: " << std::fixed << std::setprecision( 3 ) << double( duration ) / 1000000.0 << " ms"
+			<< ", dropped: " << dropped << "\n";
+		std::cout << "(est. ms: time until the next call on the same thread, gaps over "
+			<< MaxGapNs / 1000000u << " ms being ignored)\n\n";
+		printTable( std::string{}, sort( stats ), frames, stats.size() );
+	}
+
+	void summariseFrames( Trace const & trace
+		, uint32_t top )
+	{
+		auto durations = estimateDurations( trace );
+		std::map< std::string, FunctionStats > stats;
+		uint64_t frame{ 0u };
+		uint64_t calls{ 0u };
+		uint64_t begin = trace.records.empty()
+			? 0u
+			: trace.records.front().time;
+
+		for ( size_t i = 0u; i < trace.records.size(); ++i )
+		{
+			auto & record = trace.records[i];
+
+			if ( !isFrameMarker( record ) )
+			{
+				auto & stat = stats[getName( trace, record )];
+				++stat.calls;
+				stat.timeNs += durations[i];
+				++calls;
+				continue;
+			}
+
+			std::cout << "Frame " << frame
+				<< ": " << calls << " calls"
+				<< ", " << std::fixed << std::setprecision( 3 ) << double( record.time - begin ) / 1000000.0 << " ms\n";
+			printTable( "  ", sort( stats ), 1u, top );
+			std::cout << "\n";
+			stats.clear();
+			calls = 0u;
+			begin = record.time;
+			++frame;
+		}
+
+		if ( calls )
+		{
+			std::cout << "Incomplete frame " << frame << ": " << calls << " calls\n";
+			printTable( "  ", sort( stats ), 1u, top );
+		}
+	}
+}
+
+int main( int argc, char ** argv )
+{
+	Options options;
+
+	if ( !parseOptions( argc, argv, options ) )
+	{
+		printUsage();
+		return EXIT_FAILURE;
+	}
+
+	Trace trace;
+
+	if ( !load( options.file, trace ) )
+	{
+		return EXIT_FAILURE;
+	}
+
+	if ( options.dump )
+	{
+		dump( trace );
+	}
+
+	if ( options.summary )
+	{
+		summarise( trace );
+	}
+
+	if ( options.frames )
+	{
+		summariseFrames( trace, options.top );
+	}
+
+	return EXIT_SUCCESS;
+}